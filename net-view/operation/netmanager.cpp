@@ -4,11 +4,13 @@
 
 #include "netmanager.h"
 
+#include "configsetting.h"
 #include "netitem.h"
 #include "networkconst.h"
 #include "private/netitemprivate.h"
 #include "private/netmanager_p.h"
 #include "private/netmanagerthreadprivate.h"
+#include "private/netsharedbackend.h"
 
 #include <QCoreApplication>
 #include <QDebug>
@@ -26,6 +28,8 @@ static void NetItemRegisterMetaType()
     qRegisterMetaType<NetConnectionStatus>("NetConnectionStatus");
     qRegisterMetaType<NetType::NetDeviceStatus>("NetDeviceStatus");
     qRegisterMetaType<NetManager::CmdType>("NetManager::CmdType");
+    qRegisterMetaType<NetDataChangeList>("NetDataChangeList");
+    qRegisterMetaType<NetWirelessRecordList>("NetWirelessRecordList");
 }
 
 NetManager::NetManager(NetType::NetManagerFlags flags, QObject *parent)
@@ -69,6 +73,30 @@ void NetManager::setEnabled(bool enabled)
     d->setEnabled(enabled);
 }
 
+void NetManager::setDataChangedInterval(int ms)
+{
+    Q_D(NetManager);
+    d->setDataChangedInterval(ms);
+}
+
+int NetManager::dataChangedQueueDepth() const
+{
+    Q_D(const NetManager);
+    return d->dataChangedQueueDepth();
+}
+
+void NetManager::setWirelessPageSize(int size)
+{
+    Q_D(NetManager);
+    d->setWirelessPageSize(size);
+}
+
+void NetManager::fetchMoreWireless()
+{
+    Q_D(NetManager);
+    d->fetchMoreWireless();
+}
+
 NetType::NetManagerFlags NetManager::flags() const
 {
     Q_D(const NetManager);
@@ -213,6 +241,11 @@ NetManagerPrivate::NetManagerPrivate(NetManager *manager)
     , m_secretAgent(false)
     , m_autoAddConnection(false)
     , m_managerThread(new NetManagerThreadPrivate)
+    , m_sharedServer(nullptr)
+    , m_sharedClient(nullptr)
+    , m_enabled(true)
+    , m_autoScanEnabled(false)
+    , m_wirelessPageSize(0)
     , m_passwordRequestData(nullptr)
     , m_supportWireless(false)
     , q_ptr(manager)
@@ -229,14 +262,16 @@ NetManagerPrivate::NetManagerPrivate(NetManager *manager)
         m_deviceCount[i] = 0;
     }
     connect(m_managerThread, &NetManagerThreadPrivate::itemAdded, this, &NetManagerPrivate::onItemAdded, Qt::QueuedConnection);
+    connect(m_managerThread, &NetManagerThreadPrivate::wirelessRecordsAdded, this, &NetManagerPrivate::onWirelessRecordsAdded, Qt::QueuedConnection);
     connect(m_managerThread, &NetManagerThreadPrivate::itemRemoved, this, &NetManagerPrivate::onItemRemoved, Qt::QueuedConnection);
     connect(m_managerThread, &NetManagerThreadPrivate::dataChanged, this, &NetManagerPrivate::onDataChanged, Qt::QueuedConnection);
-    connect(m_managerThread, &NetManagerThreadPrivate::request, this, &NetManagerPrivate::sendRequest, Qt::QueuedConnection);
+    connect(m_managerThread, &NetManagerThreadPrivate::dataChangedBatch, this, &NetManagerPrivate::onDataChangedBatch, Qt::QueuedConnection);
+    connect(m_managerThread, &NetManagerThreadPrivate::request, this, &NetManagerPrivate::onRequest, Qt::QueuedConnection);
     connect(m_managerThread, &NetManagerThreadPrivate::requestInputPassword, this, &NetManagerPrivate::onRequestPassword, Qt::QueuedConnection);
-    connect(m_managerThread, &NetManagerThreadPrivate::networkNotify, q_ptr, &NetManager::networkNotify, Qt::QueuedConnection);
+    connect(m_managerThread, &NetManagerThreadPrivate::networkNotify, this, &NetManagerPrivate::onNetworkNotify, Qt::QueuedConnection);
     connect(q_ptr, &NetManager::languageChange, m_managerThread, &NetManagerThreadPrivate::retranslate, Qt::QueuedConnection);
     connect(q_ptr, &NetManager::languageChange, this, &NetManagerPrivate::retranslateUi);
-    connect(m_managerThread, &NetManagerThreadPrivate::toControlCenter, q_ptr, &NetManager::toControlCenter, Qt::QueuedConnection);
+    connect(m_managerThread, &NetManagerThreadPrivate::toControlCenter, this, &NetManagerPrivate::onToControlCenter, Qt::QueuedConnection);
     connect(m_managerThread, &NetManagerThreadPrivate::netCheckAvailableChanged, q_ptr, &NetManager::netCheckAvailableChanged, Qt::QueuedConnection);
     connect(m_managerThread, &NetManagerThreadPrivate::supportWirelessChanged, this, &NetManagerPrivate::onSupportWirelessChanged, Qt::QueuedConnection);
 }
@@ -249,6 +284,7 @@ NetManagerPrivate::~NetManagerPrivate()
     delete m_deleteItem;
     delete m_root;
     m_root = nullptr;
+    m_handleItems.clear();
     m_dataMap.clear();
 }
 
@@ -259,12 +295,38 @@ void NetManagerPrivate::setAutoScanInterval(int ms)
 
 void NetManagerPrivate::setAutoScanEnabled(bool enabled)
 {
-    m_managerThread->setAutoScanEnabled(enabled);
+    m_autoScanEnabled = enabled;
+    updateAutoScanEnabled();
 }
 
 void NetManagerPrivate::setEnabled(bool enabled)
 {
-    m_managerThread->setEnabled(enabled);
+    m_enabled = enabled;
+    updateEnabled();
+}
+
+void NetManagerPrivate::setDataChangedInterval(int ms)
+{
+    m_managerThread->setDataChangedInterval(ms);
+}
+
+int NetManagerPrivate::dataChangedQueueDepth() const
+{
+    return m_managerThread->dataChangedQueueDepth();
+}
+
+void NetManagerPrivate::setWirelessPageSize(int size)
+{
+    m_wirelessPageSize = size;
+}
+
+void NetManagerPrivate::fetchMoreWireless()
+{
+    for (const QString &devPath : m_wirelessRecords.devices()) {
+        NetWirelessOtherItemPrivate *otherItem = NetItemPrivate::toItem<NetWirelessOtherItemPrivate>(findItem(devPath + ":Other"));
+        if (otherItem && otherItem->isExpanded())
+            loadWireless(devPath, m_wirelessPageSize);
+    }
 }
 
 void NetManagerPrivate::setServerKey(const QString &serverKey)
@@ -274,7 +336,12 @@ void NetManagerPrivate::setServerKey(const QString &serverKey)
 
 void NetManagerPrivate::init(NetType::NetManagerFlags flags)
 {
-    m_managerThread->init(flags);
+    m_flags = flags;
+    if (ConfigSetting::instance()->sharedNetManagerBackend()) {
+        initSharedBackend();
+    } else {
+        m_managerThread->init(flags);
+    }
     if (flags.testFlags(NetType::Net_AirplaneTips)) {
         NetAirplaneModeTipsItemPrivate *airplaneTipsItem = NetItemNew(AirplaneModeTipsItem, "NetAirplaneModeTipsItem");
         airplaneTipsItem->updatelinkActivatedText("airplaneMode");
@@ -285,12 +352,12 @@ void NetManagerPrivate::init(NetType::NetManagerFlags flags)
 
 NetType::NetManagerFlags NetManagerPrivate::flags() const
 {
-    return m_managerThread->flags();
+    return m_flags;
 }
 
 bool NetManagerPrivate::netCheckAvailable()
 {
-    return m_managerThread->NetCheckAvailable();
+    return m_sharedClient ? m_sharedClient->netCheckAvailable() : m_managerThread->NetCheckAvailable();
 }
 
 QString NetManagerPrivate::wpaEapAuthen() const
@@ -306,6 +373,8 @@ QString NetManagerPrivate::wpaEapAuthmethod() const
 void NetManagerPrivate::exec(NetManager::CmdType cmd, const QString &id, const QVariantMap &param)
 {
     qCInfo(DNC) << "UI request exec cmd: " << cmd << ", id: " << id << ", param keys: " << param.keys();
+    if (m_sharedServer)
+        m_sharedServer->clearIssuer(id);
     if (!id.isEmpty() && !m_showInputId.isEmpty() && m_showInputId != id) {
         // 有显示输入框，新的请求不是原处理
         clearPasswordRequest(m_showInputId);
@@ -355,7 +424,7 @@ void NetManagerPrivate::exec(NetManager::CmdType cmd, const QString &id, const Q
             sendRequest(NetManager::InputError, id, validMap);
             break;
         }
-        NetItemPrivate *item = findItem(id);
+        NetItemPrivate *item = findWirelessItem(id);
         if (item) {
             switch (item->itemType()) {
             case NetType::NetItemType::WirelessHiddenItem: {
@@ -435,7 +504,7 @@ void NetManagerPrivate::exec(NetManager::CmdType cmd, const QString &id, const Q
         }
     } break;
     case NetManager::ConnectOrInfo: {
-        NetItemPrivate *item = findItem(id);
+        NetItemPrivate *item = findWirelessItem(id);
         if (item) {
             m_managerThread->connectOrInfo(id, item->itemType(), param);
         } else {
@@ -443,13 +512,13 @@ void NetManagerPrivate::exec(NetManager::CmdType cmd, const QString &id, const Q
         }
     } break;
     case NetManager::ConnectInfo: {
-        NetItemPrivate *item = findItem(id);
+        NetItemPrivate *item = findWirelessItem(id);
         if (item) {
             m_managerThread->getConnectInfo(id, item->itemType(), param);
         }
     } break;
     case NetManager::SetConnectInfo: {
-        NetItemPrivate *item = findItem(id);
+        NetItemPrivate *item = findWirelessItem(id);
         if (item) {
             m_managerThread->setConnectInfo(id, item->itemType(), param);
         } else {
@@ -494,6 +563,13 @@ void NetManagerPrivate::onItemAdded(const QString &parentID, NetItemPrivate *ite
     QString itemParentID = parentID;
     if (item->itemType() == NetType::NetItemType::WirelessItem) {
         NetWirelessItemPrivate *wirelessItem = NetItemPrivate::toItem<NetWirelessItemPrivate>(item);
+        if (!wirelessItem->hasConnection() && deferWireless(parentID)) {
+            if (m_sharedServer)
+                m_sharedServer->itemAdded(parentID, item);
+            m_wirelessRecords.add(parentID, NetWirelessRecords::fromItem(wirelessItem));
+            delete wirelessItem;
+            return;
+        }
         itemParentID = parentID + (wirelessItem->hasConnection() ? ":Mine" : ":Other");
     }
     NetItemPrivate *parentItem = findItem(itemParentID);
@@ -502,12 +578,22 @@ void NetManagerPrivate::onItemAdded(const QString &parentID, NetItemPrivate *ite
         delete NetItemPrivate::toItem<NetItemPrivate>(item);
         return;
     }
-    addItem(item, parentItem);
+    if (item->itemType() == NetType::NetItemType::VPNTipsItem)
+        NetItemPrivate::toItem<NetVPNTipsItemPrivate>(item)->updatetipsLinkEnabled(m_flags.testFlags(NetType::Net_tipsLinkEnabled));
+    // 共享后端时子线程按所有进程的标记创建数据项，本进程不需要的项只保存数据，不加入列表
+    const NetType::NetManagerFlags flags = NetSharedBackend::itemFlags(item->itemType(), parentID);
+    addItem(item, (flags & ~m_flags) ? nullptr : parentItem);
+    if (m_sharedServer)
+        m_sharedServer->itemAdded(parentID, item);
     switch (item->itemType()) {
     case NetType::NetItemType::WirelessDeviceItem: { // 无线设备添加隐藏网络
         addItem(NetItemNew(WirelessMineItem, item->id() + ":Mine"), nullptr);
         NetWirelessOtherItemPrivate *otherItem = NetItemNew(WirelessOtherItem, item->id() + ":Other");
         otherItem->updateexpanded(true);
+        const QString devPath = item->id();
+        connect(qobject_cast<NetWirelessOtherItem *>(otherItem->item()), &NetWirelessOtherItem::expandedChanged, this, [this, devPath](bool expanded) {
+            onOtherExpandedChanged(devPath, expanded);
+        });
         addItem(otherItem, item);
         addItem(NetItemNew(WirelessHiddenItem, item->id() + ":Hidden"), otherItem);
         ++m_deviceCount[WirelessDeviceIndex];
@@ -527,18 +613,43 @@ void NetManagerPrivate::onItemAdded(const QString &parentID, NetItemPrivate *ite
     updateControl();
 }
 
+void NetManagerPrivate::onWirelessRecordsAdded(const QString &devPath, const NetWirelessRecordList &records)
+{
+    if (!findItem(devPath + ":Other")) {
+        qCWarning(DNC) << "Wireless records added, The device not found:" << devPath << ", count:" << records.size();
+        return;
+    }
+    for (const NetWirelessRecord &record : records) {
+        if (m_sharedServer)
+            m_sharedServer->itemAdded(devPath, NetType::NetItemType::WirelessItem, record.id, NetWirelessRecords::properties(record));
+        if (deferWireless(devPath)) {
+            m_wirelessRecords.add(devPath, record);
+        } else {
+            addWirelessItem(devPath, NetWirelessRecords::newItem(record, false));
+        }
+    }
+}
+
 void NetManagerPrivate::onItemRemoved(const QString &id)
 {
+    if (m_wirelessRecords.remove(id)) {
+        if (m_sharedServer)
+            m_sharedServer->itemRemoved(id);
+        return;
+    }
     NetItemPrivate *item = findItem(id);
     if (!item) {
         qCWarning(DNC) << "Item removed, item: " << id << "not find!";
         return;
     }
+    if (m_sharedServer)
+        m_sharedServer->itemRemoved(id);
 
     NetItemPrivate *mine = nullptr;
     switch (item->itemType()) {
     case NetType::NetItemType::WirelessDeviceItem: { // 无线设备添加隐藏网络
         --m_deviceCount[WirelessDeviceIndex];
+        m_wirelessRecords.removeDevice(item->id());
         // 我的网络和其他网络要单独删除,可能在m_dataMap中但不在列表中
         removeAndDeleteItem(findItem(item->id() + ":Mine"));
         removeAndDeleteItem(findItem(item->id() + ":Other"));
@@ -564,6 +675,16 @@ void NetManagerPrivate::onItemRemoved(const QString &id)
 
 void NetManagerPrivate::onDataChanged(int dataType, const QString &id, const QVariant &value)
 {
+    updateData(dataType, id, 0, value);
+}
+
+void NetManagerPrivate::updateData(int dataType, const QString &id, quint32 handle, const QVariant &value)
+{
+    if (m_sharedServer)
+        m_sharedServer->dataChanged(dataType, id, value);
+    // 共享后端时子线程可能按其他进程的标记发出飞行模式的数据
+    if (id == "Root" && !m_flags.testFlags(NetType::Net_Airplane))
+        return;
     switch (dataType) {
     case NetManagerThreadPrivate::portalUrlChanged: {
         updatePortalUrl(id, value.toString());
@@ -588,12 +709,15 @@ void NetManagerPrivate::onDataChanged(int dataType, const QString &id, const QVa
         }
     } break;
     case NetManagerThreadPrivate::NameChanged: {
-        NetItemPrivate *item = findItem(id);
-        if (item)
+        NetItemPrivate *item = findItem(handle, id);
+        if (item) {
             item->updatename(value.toString());
+        } else if (NetWirelessRecord *record = m_wirelessRecords.find(id)) {
+            record->name = value.toString();
+        }
     } break;
     case NetManagerThreadPrivate::EnabledChanged: {
-        NetControlItemPrivate *item = NetItemPrivate::toItem<NetControlItemPrivate>(findItem(id));
+        NetControlItemPrivate *item = NetItemPrivate::toItem<NetControlItemPrivate>(findItem(handle, id));
         if (item) {
             item->updateenabled(value.toBool());
             updateControlEnabled(item->itemType());
@@ -603,8 +727,11 @@ void NetManagerPrivate::onDataChanged(int dataType, const QString &id, const QVa
         }
     } break;
     case NetManagerThreadPrivate::DeviceAvailableChanged: {
-        NetControlItemPrivate *item = NetItemPrivate::toItem<NetControlItemPrivate>(findItem(id));
+        NetControlItemPrivate *item = NetItemPrivate::toItem<NetControlItemPrivate>(findItem(handle, id));
         if (item) {
+            // 总是显示系统代理时不处理系统代理是否存在
+            if (item->itemType() == NetType::SystemProxyControlItem && m_flags.testFlags(NetType::Net_SysProxyAlwaysShow))
+                return;
             item->updateenabledable(value.toBool());
             if (item->itemType() == NetType::SystemProxyControlItem || item->itemType() == NetType::VPNControlItem) {
                 updateItemVisible(item->id(), value.toBool());
@@ -614,37 +741,46 @@ void NetManagerPrivate::onDataChanged(int dataType, const QString &id, const QVa
         }
     } break;
     case NetManagerThreadPrivate::ConnectionStatusChanged: {
-        NetConnectionItemPrivate *item = NetItemPrivate::toItem<NetConnectionItemPrivate>(findItem(id));
+        NetConnectionItemPrivate *item = NetItemPrivate::toItem<NetConnectionItemPrivate>(findItem(handle, id));
         if (item)
             item->updatestatus(value.value<NetType::NetConnectionStatus>());
     } break;
     case NetManagerThreadPrivate::WirelessStatusChanged: {
-        NetWirelessItemPrivate *item = NetItemPrivate::toItem<NetWirelessItemPrivate>(findItem(id));
+        NetWirelessItemPrivate *item = NetItemPrivate::toItem<NetWirelessItemPrivate>(findItem(handle, id));
         if (item) {
             NetType::NetConnectionStatus state = value.value<NetType::NetConnectionStatus>();
             item->updatestatus(state);
+        } else if (NetWirelessRecord *record = m_wirelessRecords.find(id)) {
+            record->status = value.value<NetType::NetConnectionStatus>();
         }
     } break;
     case NetManagerThreadPrivate::StrengthChanged: {
-        NetWirelessItemPrivate *item = NetItemPrivate::toItem<NetWirelessItemPrivate>(findItem(id));
-        if (item)
+        NetWirelessItemPrivate *item = NetItemPrivate::toItem<NetWirelessItemPrivate>(findItem(handle, id));
+        if (item) {
             item->updatestrength(value.toInt());
+        } else if (NetWirelessRecord *record = m_wirelessRecords.find(id)) {
+            record->strength = value.toInt();
+        }
     } break;
     case NetManagerThreadPrivate::SecuredChanged: {
-        NetWirelessItemPrivate *item = NetItemPrivate::toItem<NetWirelessItemPrivate>(findItem(id));
-        if (item)
+        NetWirelessItemPrivate *item = NetItemPrivate::toItem<NetWirelessItemPrivate>(findItem(handle, id));
+        if (item) {
             item->updatesecure(value.toBool());
+        } else if (NetWirelessRecord *record = m_wirelessRecords.find(id)) {
+            record->secure = value.toBool();
+        }
     } break;
     case NetManagerThreadPrivate::IPChanged: {
-        NetDeviceItemPrivate *item = NetItemPrivate::toItem<NetDeviceItemPrivate>(findItem(id));
+        NetDeviceItemPrivate *item = NetItemPrivate::toItem<NetDeviceItemPrivate>(findItem(handle, id));
         if (item)
             item->updateips(value.toStringList());
     } break;
     case NetManagerThreadPrivate::DeviceStatusChanged: {
-        NetDeviceItemPrivate *item = NetItemPrivate::toItem<NetDeviceItemPrivate>(findItem(id));
+        NetDeviceItemPrivate *item = NetItemPrivate::toItem<NetDeviceItemPrivate>(findItem(handle, id));
         if (item) {
             NetType::NetDeviceStatus deviceStatus = value.value<NetType::NetDeviceStatus>();
-            if (item->status() != NetType::NetDeviceStatus::DS_IpConflicted && deviceStatus == NetType::NetDeviceStatus::DS_IpConflicted) {
+            // 共享后端时通知由维护数据的进程发出
+            if (!m_sharedClient && item->status() != NetType::NetDeviceStatus::DS_IpConflicted && deviceStatus == NetType::NetDeviceStatus::DS_IpConflicted) {
                 // 如果IP冲突，需要发送横幅通知
                 m_managerThread->sendNotify((item->itemType() & NET_WIRED ? "notification-network-wired-local" : "notification-network-wireless-local"), tr("IP conflict"), tr("Network"), "dde-control-center", -1, {}, {}, 3000);
             }
@@ -652,39 +788,43 @@ void NetManagerPrivate::onDataChanged(int dataType, const QString &id, const QVa
         }
     } break;
     case NetManagerThreadPrivate::HotspotEnabledChanged: {
-        NetWirelessDeviceItemPrivate *item = NetItemPrivate::toItem<NetWirelessDeviceItemPrivate>(findItem(id));
+        NetWirelessDeviceItemPrivate *item = NetItemPrivate::toItem<NetWirelessDeviceItemPrivate>(findItem(handle, id));
         if (item)
             item->updateapMode(value.toBool());
     } break;
     case NetManagerThreadPrivate::AvailableConnectionsChanged: {
-        NetWirelessDeviceItemPrivate *devItem = NetItemPrivate::toItem<NetWirelessDeviceItemPrivate>(findItem(id));
+        NetWirelessDeviceItemPrivate *devItem = NetItemPrivate::toItem<NetWirelessDeviceItemPrivate>(findItem(handle, id));
         if (devItem) {
-            const QStringList &connList = value.toStringList();
+            // 只包含有无配置发生变化的热点
+            const QVariantMap delta = value.toMap();
             NetItemPrivate *mine = findItem(id + ":Mine");
             NetItemPrivate *other = findItem(id + ":Other");
-            QVector<NetItem *> items = mine->getChildren();
-            items.append(other->getChildren());
-            for (auto &&item : items) {
-                NetWirelessItemPrivate *wirelessItem = NetItemPrivate::toItem<NetWirelessItemPrivate>(item);
+            for (const QString &apId : delta.value("connected").toStringList()) {
+                NetWirelessItemPrivate *wirelessItem = NetItemPrivate::toItem<NetWirelessItemPrivate>(findItem(apId));
                 if (wirelessItem) {
-                    if (connList.contains(wirelessItem->id())) {
-                        wirelessItem->updatehasConnection(true);
-                        if (wirelessItem->getParentPrivate() == other) {
-                            if (!mine->getParent()) {
-                                devItem->addChild(mine);
-                            }
-                            other->moveChild(wirelessItem, mine);
-                        } else if (wirelessItem->getParentPrivate() != mine) {
-                            mine->addChild(wirelessItem);
-                        }
-                    } else {
-                        wirelessItem->updatehasConnection(false);
-                        if (wirelessItem->getParentPrivate() == mine) {
-                            mine->moveChild(wirelessItem, other);
-                        } else if (wirelessItem->getParentPrivate() != other) {
-                            other->addChild(wirelessItem);
+                    wirelessItem->updatehasConnection(true);
+                    if (wirelessItem->getParentPrivate() == other) {
+                        if (!mine->getParent()) {
+                            devItem->addChild(mine);
                         }
+                        other->moveChild(wirelessItem, mine);
+                    } else if (wirelessItem->getParentPrivate() != mine) {
+                        mine->addChild(wirelessItem);
                     }
+                } else if (m_wirelessRecords.devicePath(apId) == id) {
+                    // 有配置的网络移到我的网络，需要创建数据项
+                    addItem(NetWirelessRecords::newItem(m_wirelessRecords.take(apId), true), mine);
+                }
+            }
+            for (const QString &apId : delta.value("disconnected").toStringList()) {
+                NetWirelessItemPrivate *wirelessItem = NetItemPrivate::toItem<NetWirelessItemPrivate>(findItem(apId));
+                if (!wirelessItem)
+                    continue;
+                wirelessItem->updatehasConnection(false);
+                if (wirelessItem->getParentPrivate() == mine) {
+                    mine->moveChild(wirelessItem, other);
+                } else if (wirelessItem->getParentPrivate() != other) {
+                    other->addChild(wirelessItem);
                 }
             }
             if (!mine->getParent() && mine->getChildrenNumber() != 0) {
@@ -695,62 +835,62 @@ void NetManagerPrivate::onDataChanged(int dataType, const QString &id, const QVa
         }
     } break;
     case NetManagerThreadPrivate::DetailsChanged: {
-        NetDetailsInfoItemPrivate *item = NetItemPrivate::toItem<NetDetailsInfoItemPrivate>(findItem(id));
+        NetDetailsInfoItemPrivate *item = NetItemPrivate::toItem<NetDetailsInfoItemPrivate>(findItem(handle, id));
         if (item)
             item->updatedetails(value.value<QList<QStringList>>());
     } break;
     case NetManagerThreadPrivate::IndexChanged: {
-        NetDetailsInfoItemPrivate *item = NetItemPrivate::toItem<NetDetailsInfoItemPrivate>(findItem(id));
+        NetDetailsInfoItemPrivate *item = NetItemPrivate::toItem<NetDetailsInfoItemPrivate>(findItem(handle, id));
         if (item)
             item->updateindex(value.toInt());
     } break;
     case NetManagerThreadPrivate::ProxyMethodChanged: {
-        NetSystemProxyControlItemPrivate *item = NetItemPrivate::toItem<NetSystemProxyControlItemPrivate>(findItem(id));
+        NetSystemProxyControlItemPrivate *item = NetItemPrivate::toItem<NetSystemProxyControlItemPrivate>(findItem(handle, id));
         if (item)
             item->updatemethod(value.value<NetType::ProxyMethod>());
     } break;
     case NetManagerThreadPrivate::ProxyLastMethodChanged: {
-        NetSystemProxyControlItemPrivate *item = NetItemPrivate::toItem<NetSystemProxyControlItemPrivate>(findItem(id));
+        NetSystemProxyControlItemPrivate *item = NetItemPrivate::toItem<NetSystemProxyControlItemPrivate>(findItem(handle, id));
         if (item)
             item->updatelastMethod(value.value<NetType::ProxyMethod>());
     } break;
     case NetManagerThreadPrivate::SystemAutoProxyChanged: {
-        NetSystemProxyControlItemPrivate *item = NetItemPrivate::toItem<NetSystemProxyControlItemPrivate>(findItem(id));
+        NetSystemProxyControlItemPrivate *item = NetItemPrivate::toItem<NetSystemProxyControlItemPrivate>(findItem(handle, id));
         if (item)
             item->updateautoProxy(value.toString());
     } break;
     case NetManagerThreadPrivate::SystemManualProxyChanged: {
-        NetSystemProxyControlItemPrivate *item = NetItemPrivate::toItem<NetSystemProxyControlItemPrivate>(findItem(id));
+        NetSystemProxyControlItemPrivate *item = NetItemPrivate::toItem<NetSystemProxyControlItemPrivate>(findItem(handle, id));
         if (item)
             item->updatemanualProxy(value.value<QVariantMap>());
     } break;
     case NetManagerThreadPrivate::AppProxyChanged: {
-        NetAppProxyControlItemPrivate *item = NetItemPrivate::toItem<NetAppProxyControlItemPrivate>(findItem(id));
+        NetAppProxyControlItemPrivate *item = NetItemPrivate::toItem<NetAppProxyControlItemPrivate>(findItem(handle, id));
         if (item)
             item->updateconfig(value.value<QVariantMap>());
     } break;
     case NetManagerThreadPrivate::HotspotConfigChanged: {
-        NetHotspotControlItemPrivate *item = NetItemPrivate::toItem<NetHotspotControlItemPrivate>(findItem(id));
+        NetHotspotControlItemPrivate *item = NetItemPrivate::toItem<NetHotspotControlItemPrivate>(findItem(handle, id));
         if (item)
             item->updateconfig(value.value<QVariantMap>());
     } break;
     case NetManagerThreadPrivate::HotspotOptionalDeviceChanged: {
-        NetHotspotControlItemPrivate *item = NetItemPrivate::toItem<NetHotspotControlItemPrivate>(findItem(id));
+        NetHotspotControlItemPrivate *item = NetItemPrivate::toItem<NetHotspotControlItemPrivate>(findItem(handle, id));
         if (item)
             item->updateoptionalDevice(value.value<QStringList>());
     } break;
     case NetManagerThreadPrivate::HotspotOptionalDevicePathChanged: {
-        NetHotspotControlItemPrivate *item = NetItemPrivate::toItem<NetHotspotControlItemPrivate>(findItem(id));
+        NetHotspotControlItemPrivate *item = NetItemPrivate::toItem<NetHotspotControlItemPrivate>(findItem(handle, id));
         if (item)
             item->updateoptionalDevicePath(value.value<QStringList>());
     } break;
     case NetManagerThreadPrivate::HotspotShareDeviceChanged: {
-        NetHotspotControlItemPrivate *item = NetItemPrivate::toItem<NetHotspotControlItemPrivate>(findItem(id));
+        NetHotspotControlItemPrivate *item = NetItemPrivate::toItem<NetHotspotControlItemPrivate>(findItem(handle, id));
         if (item)
             item->updateshareDevice(value.value<QStringList>());
     } break;
     case NetManagerThreadPrivate::DeviceEnabledChanged: {
-        NetHotspotControlItemPrivate *item = NetItemPrivate::toItem<NetHotspotControlItemPrivate>(findItem(id));
+        NetHotspotControlItemPrivate *item = NetItemPrivate::toItem<NetHotspotControlItemPrivate>(findItem(handle, id));
         if (item)
             item->updatedeviceEnabled(value.toBool());
     } break;
@@ -759,6 +899,13 @@ void NetManagerPrivate::onDataChanged(int dataType, const QString &id, const QVa
     }
 }
 
+void NetManagerPrivate::onDataChangedBatch(const NetDataChangeList &changes)
+{
+    for (const NetDataChange &change : changes) {
+        updateData(change.dataType, change.id, change.handle, change.value);
+    }
+}
+
 void NetManagerPrivate::sendRequest(NetManager::CmdType cmd, const QString &id, const QVariantMap &param)
 {
     qCInfo(DNC) << "Send request, cmd: " << cmd << ", id: " << id << ", param: " << param.keys();
@@ -768,7 +915,7 @@ void NetManagerPrivate::sendRequest(NetManager::CmdType cmd, const QString &id,
         if (!m_showInputId.isEmpty())
             qCWarning(DNC) << "Untreated request password:" << m_showInputId << ", new request password: " << id;
         m_showInputId = id;
-        NetWirelessItemPrivate *item = NetItemPrivate::toItem<NetWirelessItemPrivate>(findItem(id));
+        NetWirelessItemPrivate *item = NetItemPrivate::toItem<NetWirelessItemPrivate>(findWirelessItem(id));
         if (item && !item->hasConnection()) {
             NetWirelessOtherItemPrivate *otherItem = NetItemPrivate::toItem<NetWirelessOtherItemPrivate>(findItem(item->getParentPrivate()->getParentPrivate()->id() + ":Other"));
             if (otherItem)
@@ -787,6 +934,11 @@ void NetManagerPrivate::sendRequest(NetManager::CmdType cmd, const QString &id,
 
 void NetManagerPrivate::onRequestPassword(const QString &dev, const QString &id, const QVariantMap &param)
 {
+    if (m_sharedServer)
+        m_sharedServer->passwordRequested(dev, id, param);
+    // 共享后端时，任一进程启用都会发出请求，只处理本进程启用且使用密码代理时的请求
+    if (!m_enabled || !m_flags.testFlags(NetType::Net_UseSecretAgent))
+        return;
     if (m_passwordRequestData) {
         delete m_passwordRequestData;
         m_passwordRequestData = nullptr;
@@ -846,6 +998,7 @@ void NetManagerPrivate::findPasswordRequestItem()
         if (devItem) {
             switch (devItem->itemType()) {
             case NetType::NetItemType::WirelessDeviceItem: {
+                findWirelessItem(m_wirelessRecords.findByName(devItem->id(), m_passwordRequestData->id));
                 QVector<NetItem *> items = devItem->getChildren();
                 while (!items.isEmpty()) {
                     NetItem *item = items.takeFirst();
@@ -904,12 +1057,53 @@ void NetManagerPrivate::onItemDestroyed(QObject *obj)
     if (m_isDeleting || !obj)
         return;
     // 此时NetItem的成员变量已delete,只能获取QObject里的数据
-    m_dataMap.remove(obj->objectName());
+    removeFromDataMap(obj->objectName());
 }
 
 void NetManagerPrivate::onSupportWirelessChanged(bool supportWireless)
 {
     m_supportWireless = supportWireless;
+    if (m_sharedServer)
+        m_sharedServer->supportWirelessChanged(supportWireless);
+}
+
+void NetManagerPrivate::onRequest(NetManager::CmdType cmd, const QString &id, const QVariantMap &param)
+{
+    // 共享后端时，请求发给发起操作的进程
+    if (m_sharedServer && m_sharedServer->dispatchRequest(cmd, id, param))
+        return;
+    sendRequest(cmd, id, param);
+}
+
+// clang-format off
+void NetManagerPrivate::onNetworkNotify(const QString &inAppName, int replacesId, const QString &appIcon, const QString &summary, const QString &body, const QStringList &actions, const QVariantMap &hints, int expireTimeout)
+// clang-format on
+{
+    if (m_sharedServer)
+        m_sharedServer->networkNotify(inAppName, replacesId, appIcon, summary, body, actions, hints, expireTimeout);
+    if (m_enabled)
+        Q_EMIT q_ptr->networkNotify(inAppName, replacesId, appIcon, summary, body, actions, hints, expireTimeout);
+}
+
+void NetManagerPrivate::onToControlCenter()
+{
+    if (m_sharedServer)
+        m_sharedServer->toControlCenter();
+    if (m_enabled)
+        Q_EMIT q_ptr->toControlCenter();
+}
+
+void NetManagerPrivate::onSharedBackendDetached()
+{
+    // 维护数据的进程退出或不兼容，改为本进程维护数据，并尝试为其他进程提供服务
+    qCInfo(DNC) << "Shared network backend detached, use private backend";
+    m_managerThread->setSharedClient(nullptr);
+    m_sharedClient->deleteLater();
+    m_sharedClient = nullptr;
+    startSharedServer();
+    m_managerThread->init(m_flags & ~NetType::Net_SysProxyAlwaysShow);
+    updateEnabled();
+    updateAutoScanEnabled();
 }
 
 void NetManagerPrivate::setDeviceEnabled(const QString &id, bool enabled)
@@ -1061,6 +1255,56 @@ void NetManagerPrivate::updatePrimaryConnectionType(NetManager::ConnectionType t
     // }
 }
 
+void NetManagerPrivate::updateEnabled()
+{
+    // 共享后端时，任一进程启用都需要子线程发出请求和通知
+    m_managerThread->setEnabled(m_enabled || (m_sharedServer && m_sharedServer->clientEnabled()));
+}
+
+void NetManagerPrivate::updateAutoScanEnabled()
+{
+    // 共享后端时，任一进程显示网络列表都需要自动扫描
+    m_managerThread->setAutoScanEnabled(m_autoScanEnabled || (m_sharedServer && m_sharedServer->clientAutoScanEnabled()));
+}
+
+void NetManagerPrivate::initSharedBackend()
+{
+    if (startSharedServer()) {
+        // 其他进程可能需要系统代理是否存在，总是显示由各进程自己处理
+        m_managerThread->init(m_flags & ~NetType::Net_SysProxyAlwaysShow);
+        return;
+    }
+    // 已有进程维护数据，本进程只订阅数据，不再创建NM相关对象
+    const QString service = NetSharedBackend::serviceName();
+    qCInfo(DNC) << "Attach to shared network backend:" << service;
+    m_sharedClient = new NetSharedBackendClient(service, this);
+    connect(m_sharedClient, &NetSharedBackendClient::itemAdded, this, &NetManagerPrivate::onItemAdded);
+    connect(m_sharedClient, &NetSharedBackendClient::itemRemoved, this, &NetManagerPrivate::onItemRemoved);
+    connect(m_sharedClient, &NetSharedBackendClient::dataChanged, this, &NetManagerPrivate::onDataChanged);
+    connect(m_sharedClient, &NetSharedBackendClient::request, this, &NetManagerPrivate::sendRequest);
+    connect(m_sharedClient, &NetSharedBackendClient::requestInputPassword, this, &NetManagerPrivate::onRequestPassword);
+    connect(m_sharedClient, &NetSharedBackendClient::networkNotify, this, &NetManagerPrivate::onNetworkNotify);
+    connect(m_sharedClient, &NetSharedBackendClient::toControlCenter, this, &NetManagerPrivate::onToControlCenter);
+    connect(m_sharedClient, &NetSharedBackendClient::netCheckAvailableChanged, q_ptr, &NetManager::netCheckAvailableChanged);
+    connect(m_sharedClient, &NetSharedBackendClient::supportWirelessChanged, this, &NetManagerPrivate::onSupportWirelessChanged);
+    connect(m_sharedClient, &NetSharedBackendClient::detached, this, &NetManagerPrivate::onSharedBackendDetached, Qt::QueuedConnection);
+    // 后端只接受已订阅进程的操作，需先订阅再转发开关状态(同一连接上的消息按顺序送达)
+    m_sharedClient->attach(m_flags);
+    m_managerThread->setSharedClient(m_sharedClient);
+}
+
+bool NetManagerPrivate::startSharedServer()
+{
+    m_sharedServer = new NetSharedBackendServer(this);
+    if (!m_sharedServer->start(NetSharedBackend::serviceName())) {
+        delete m_sharedServer;
+        m_sharedServer = nullptr;
+        return false;
+    }
+    connect(m_managerThread, &NetManagerThreadPrivate::netCheckAvailableChanged, m_sharedServer, &NetSharedBackendServer::netCheckAvailableChanged, Qt::QueuedConnection);
+    return true;
+}
+
 void NetManagerPrivate::updatePortalUrl(const QString &id, const QString &url)
 {
     NetItemPrivate *item = findItem(id);
@@ -1114,11 +1358,97 @@ void NetManagerPrivate::removeAndDeleteItem(NetItemPrivate *item)
     items.append(item->item());
     while (!items.isEmpty()) {
         NetItem *item = items.takeFirst();
-        m_dataMap.remove(item->id());
+        removeFromDataMap(item->id());
         items.append(item->getChildren());
     }
     delete item;
 }
 
+void NetManagerPrivate::removeFromDataMap(const QString &id)
+{
+    // 删除很少发生，直接清空句柄缓存，不需要记录数据项对应的句柄
+    if (m_dataMap.remove(id))
+        m_handleItems.clear();
+}
+
+NetItemPrivate *NetManagerPrivate::findItem(quint32 handle, const QString &id)
+{
+    if (handle == 0)
+        return findItem(id);
+    auto it = m_handleItems.constFind(handle);
+    if (it != m_handleItems.constEnd())
+        return it.value();
+    // 未找到的不缓存，之后添加的数据项可以再按ID找到
+    NetItemPrivate *item = findItem(id);
+    if (item)
+        m_handleItems.insert(handle, item);
+    return item;
+}
+
+bool NetManagerPrivate::deferWireless(const QString &devPath) const
+{
+    // 其他网络收起，或分页加载时已满一页(子项包含隐藏网络)、还有未加载的网络
+    NetWirelessOtherItemPrivate *otherItem = NetItemPrivate::toItem<NetWirelessOtherItemPrivate>(findItem(devPath + ":Other"));
+    if (!otherItem)
+        return false;
+    if (!otherItem->isExpanded())
+        return true;
+    return m_wirelessPageSize > 0 && (m_wirelessRecords.count(devPath) > 0 || otherItem->getChildrenNumber() > m_wirelessPageSize);
+}
+
+void NetManagerPrivate::addWirelessItem(const QString &devPath, NetWirelessItemPrivate *item)
+{
+    NetItemPrivate *parentItem = findItem(devPath + (item->hasConnection() ? ":Mine" : ":Other"));
+    if (!parentItem) {
+        delete item;
+        return;
+    }
+    addItem(item, parentItem);
+    if (!parentItem->getParent()) {
+        addItem(parentItem, findItem(devPath));
+    }
+}
+
+void NetManagerPrivate::loadWireless(const QString &devPath, int count)
+{
+    const NetWirelessRecordList records = m_wirelessRecords.take(devPath, count);
+    for (const NetWirelessRecord &record : records) {
+        addWirelessItem(devPath, NetWirelessRecords::newItem(record, false));
+    }
+    if (!records.isEmpty())
+        qCDebug(DNC) << "Load wireless items:" << devPath << ", loaded:" << records.size() << ", remaining:" << m_wirelessRecords.count(devPath);
+}
+
+void NetManagerPrivate::onOtherExpandedChanged(const QString &devPath, bool expanded)
+{
+    if (expanded) {
+        loadWireless(devPath, m_wirelessPageSize);
+        return;
+    }
+    // 收起后转回精简数据，正在输入密码或连接的网络保留
+    NetItemPrivate *otherItem = findItem(devPath + ":Other");
+    if (!otherItem)
+        return;
+    const QVector<NetItem *> children = otherItem->getChildren();
+    for (NetItem *child : children) {
+        NetWirelessItemPrivate *wirelessItem = NetItemPrivate::toItem<NetWirelessItemPrivate>(child);
+        if (!wirelessItem || wirelessItem->id() == m_showInputId || wirelessItem->status() != NetType::NetConnectionStatus::CS_UnConnected)
+            continue;
+        m_wirelessRecords.add(devPath, NetWirelessRecords::fromItem(wirelessItem));
+        removeAndDeleteItem(wirelessItem);
+    }
+}
+
+NetItemPrivate *NetManagerPrivate::findWirelessItem(const QString &id)
+{
+    NetItemPrivate *item = findItem(id);
+    if (item || !m_wirelessRecords.contains(id))
+        return item;
+    const QString devPath = m_wirelessRecords.devicePath(id);
+    NetWirelessItemPrivate *wirelessItem = NetWirelessRecords::newItem(m_wirelessRecords.take(id), false);
+    addWirelessItem(devPath, wirelessItem);
+    return findItem(id);
+}
+
 } // namespace network
 } // namespace dde
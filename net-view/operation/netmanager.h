@@ -34,6 +34,10 @@ public:
     void setAutoScanInterval(int ms);      // 设置自动扫描无线网间隔，0为不扫描
     void setAutoScanEnabled(bool enabled); // 设置自动扫描，网络面板关闭时禁用
     void setEnabled(bool enabled);         // 禁用时不发通知，不请求交互
+    void setDataChangedInterval(int ms);   // 设置数据变化合并发送的间隔，0为不合并
+    int dataChangedQueueDepth() const;     // 当前等待合并发送的数据变化数
+    void setWirelessPageSize(int size);    // 设置展开其他网络时每次加载的网络数，0为全部加载
+    void fetchMoreWireless();              // 加载展开的其他网络中剩余的网络
     NetType::NetManagerFlags flags() const;
 
     // const bool isGreeterMode() const;
@@ -31,13 +31,16 @@ namespace network {
 NetItemPrivate::NetItemPrivate()
     : m_item(nullptr)
     , m_parent(nullptr)
+    , m_row(-1)
+    , m_dirtyRow(0)
 {
 }
 
 NetItemPrivate::~NetItemPrivate()
 {
+    // 从后往前删除，避免每次删除都重新计算位置
     while (!m_children.isEmpty()) {
-        NetItem *child = m_children.first();
+        NetItem *child = m_children.last();
         removeChild(child->dptr);
         delete child->dptr;
     }
@@ -107,13 +110,31 @@ NetItem *NetItemPrivate::getChild(int childPos) const
 
 int NetItemPrivate::getChildIndex(const NetItem *child) const
 {
-    auto it = std::find(m_children.begin(), m_children.end(), child);
-    return it == m_children.end() ? -1 : it - m_children.begin();
+    if (!child || child->dptr->m_parent != m_item) {
+        return -1;
+    }
+    if (child->dptr->m_row >= m_dirtyRow) {
+        updateRows();
+    }
+    return child->dptr->m_row;
+}
+
+void NetItemPrivate::markRowsDirty(int row) const
+{
+    m_dirtyRow = qMin(m_dirtyRow, row);
+}
+
+void NetItemPrivate::updateRows() const
+{
+    for (int i = m_dirtyRow; i < m_children.size(); ++i) {
+        m_children.at(i)->dptr->m_row = i;
+    }
+    m_dirtyRow = m_children.size();
 }
 
 bool NetItemPrivate::addChild(NetItemPrivate *child, int index)
 {
-    if (!child || m_children.contains(child->item())) {
+    if (!child || child->m_parent == m_item) {
         return false;
     }
     if (index < 0 || index >= m_children.size())
@@ -121,6 +142,13 @@ bool NetItemPrivate::addChild(NetItemPrivate *child, int index)
 
     Q_EMIT m_item->childAboutToBeAdded(m_item, index);
     m_children.insert(m_children.begin() + index, child->item());
+    child->m_row = index;
+    if (m_dirtyRow == index && index == m_children.size() - 1) {
+        // 追加到末尾时其他子项位置不变
+        m_dirtyRow = m_children.size();
+    } else {
+        markRowsDirty(index);
+    }
     child->m_item->setParent(m_item);
 
     child->m_parent = m_item;
@@ -131,12 +159,14 @@ bool NetItemPrivate::addChild(NetItemPrivate *child, int index)
 
 bool NetItemPrivate::removeChild(NetItemPrivate *child)
 {
-    auto it = std::find(m_children.begin(), m_children.end(), child->item());
-    if (it == m_children.end()) {
+    int row = getChildIndex(child->item());
+    if (row < 0) {
         return false;
     }
-    Q_EMIT m_item->childAboutToBeRemoved(m_item, it - m_children.begin());
-    m_children.erase(it);
+    Q_EMIT m_item->childAboutToBeRemoved(m_item, row);
+    m_children.remove(row);
+    markRowsDirty(row);
+    child->m_row = -1;
     child->m_parent = nullptr;
     child->item()->setParent(nullptr);
     Q_EMIT m_item->childRemoved(child->item());
@@ -149,12 +179,12 @@ bool NetItemPrivate::moveChild(NetItemPrivate *child, NetItemPrivate *newParent)
     if (!child || !newParent || child->m_parent == newParent->item()) {
         return false;
     }
-    auto it = std::find(m_children.begin(), m_children.end(), child->item());
-    if (it == m_children.end()) {
+    int row = getChildIndex(child->item());
+    if (row < 0) {
         return false;
     }
 
-    Q_EMIT m_item->childAboutToBeMoved(m_item, it - m_children.begin(), newParent->item(), newParent->getChildrenNumber());
+    Q_EMIT m_item->childAboutToBeMoved(m_item, row, newParent->item(), newParent->getChildrenNumber());
     removeChild(child);
     newParent->addChild(child);
     Q_EMIT m_item->childMoved(child->item());
@@ -31,7 +31,7 @@ public:
 
     inline const QVector<NetItem *> &getChildren() const { return m_children; }
 
-    inline int getIndex() const { return m_parent ? m_parent->getChildren().indexOf(m_item) : -1; }
+    inline int getIndex() const { return m_parent ? m_parent->dptr->getChildIndex(m_item) : -1; }
 
     NetItem *getParent() const { return m_parent; }
 
@@ -60,12 +60,18 @@ public:
 protected:
     void emitDataChanged();
     explicit NetItemPrivate();
+    void markRowsDirty(int row) const;
+    void updateRows() const;
 
 protected:
     NetItem *m_item;
     NetItem *m_parent;
     QVector<NetItem *> m_children;
     QString m_name;
+    // 在父项m_children中的位置，仅当小于父项的m_dirtyRow时有效
+    mutable int m_row;
+    // 从该位置起子项的m_row需要重新计算，等于子项数时全部有效
+    mutable int m_dirtyRow;
     friend class NetManager;
     friend class NetManagerPrivate;
 };
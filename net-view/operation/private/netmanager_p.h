@@ -7,9 +7,12 @@
 
 #include "netitem.h"
 #include "netmanager.h"
+#include "netwirelessrecords.h"
 
+#include <QHash>
 #include <QMap>
 #include <QObject>
+#include <QVector>
 
 #define WirelessDeviceIndex 0
 #define WiredDeviceIndex 1
@@ -18,10 +21,14 @@
 namespace dde {
 namespace network {
 class NetManagerThreadPrivate;
+class NetSharedBackendServer;
+class NetSharedBackendClient;
 class NetManager;
 class NetItem;
 class NetControlItemPrivate;
 class NetDeviceItem;
+class NetWirelessItemPrivate;
+struct NetDataChange;
 enum class NetConnectionStatus;
 struct PasswordRequest;
 
@@ -36,6 +43,10 @@ public:
     void setAutoScanInterval(int ms);
     void setAutoScanEnabled(bool enabled);
     void setEnabled(bool enabled);
+    void setDataChangedInterval(int ms);
+    int dataChangedQueueDepth() const;
+    void setWirelessPageSize(int size);
+    void fetchMoreWireless();
     void setServerKey(const QString &serverKey);
     void init(NetType::NetManagerFlags flags);
     NetType::NetManagerFlags flags() const;
@@ -52,6 +63,7 @@ protected Q_SLOTS:
     void exec(NetManager::CmdType cmd, const QString &id, const QVariantMap &param);
     // 获取数据
     void onItemAdded(const QString &parentID, NetItemPrivate *item);
+    void onWirelessRecordsAdded(const QString &devPath, const NetWirelessRecordList &records);
     void onItemRemoved(const QString &id);
     void onDataChanged(int dataType, const QString &id, const QVariant &value);
 
@@ -63,8 +75,17 @@ protected Q_SLOTS:
     void retranslateUi();
     void onItemDestroyed(QObject *obj);
     void onSupportWirelessChanged(bool supportWireless);
+    void onRequest(NetManager::CmdType cmd, const QString &id, const QVariantMap &param);
+    // clang-format off
+    void onNetworkNotify(const QString &inAppName, int replacesId, const QString &appIcon, const QString &summary, const QString &body, const QStringList &actions, const QVariantMap &hints, int expireTimeout);
+    // clang-format on
+    void onToControlCenter();
+    void onSharedBackendDetached();
 
 protected:
+    void onDataChangedBatch(const QVector<NetDataChange> &changes);
+    void updateData(int dataType, const QString &id, quint32 handle, const QVariant &value);
+    NetItemPrivate *findItem(quint32 handle, const QString &id); // 按子线程句柄查找，未缓存时按ID查找
     void setDeviceEnabled(const QString &id, bool enabled);
     void setDeviceEnabled(NetControlItemPrivate *controlItem, bool enabled);
     void updateControl();
@@ -73,10 +94,21 @@ protected:
     void updateAirplaneMode(bool enabled);
     void updatePrimaryConnectionType(NetManager::ConnectionType type);
     void updatePortalUrl(const QString &id, const QString &url);
+    void updateEnabled();
+    void updateAutoScanEnabled();
+    void initSharedBackend();
+    bool startSharedServer();
 
     void addItem(NetItemPrivate *item, NetItemPrivate *parentItem = nullptr);
     void removeItem(NetItemPrivate *item);
     void removeAndDeleteItem(NetItemPrivate *item);
+    void removeFromDataMap(const QString &id);
+    // 其他网络中的无线网络，收起时只保存精简数据
+    bool deferWireless(const QString &devPath) const;
+    void addWirelessItem(const QString &devPath, NetWirelessItemPrivate *item);
+    void loadWireless(const QString &devPath, int count);
+    void onOtherExpandedChanged(const QString &devPath, bool expanded);
+    NetItemPrivate *findWirelessItem(const QString &id); // 未创建数据项的网络先创建
 
     inline NetItemPrivate *findItem(const QString &id) const { return m_dataMap.value(id, nullptr); }
 
@@ -90,7 +122,15 @@ private:
     bool m_secretAgent;
     bool m_autoAddConnection;
     NetManagerThreadPrivate *m_managerThread;
-    QMap<QString, NetItemPrivate *> m_dataMap;
+    NetSharedBackendServer *m_sharedServer;
+    NetSharedBackendClient *m_sharedClient;
+    NetType::NetManagerFlags m_flags;
+    bool m_enabled;
+    bool m_autoScanEnabled;
+    QHash<QString, NetItemPrivate *> m_dataMap;
+    QHash<quint32, NetItemPrivate *> m_handleItems; // 子线程句柄到数据项的缓存，删除数据项时清空
+    NetWirelessRecords m_wirelessRecords;
+    int m_wirelessPageSize;
     PasswordRequest *m_passwordRequestData;
     QString m_showInputId;
     QString m_lastShowPortalItemId;
@@ -102,6 +142,7 @@ private:
     Q_DECLARE_PUBLIC(NetManager)
 
     friend class NetManager;
+    friend class NetSharedBackendServer;
 };
 
 } // namespace network
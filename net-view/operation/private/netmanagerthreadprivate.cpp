@@ -10,8 +10,10 @@
 #include "impl/networkmanager/nmnetworkmanager.h"
 #include "nethotspotcontroller.h"
 #include "netitemprivate.h"
+#include "netscanscheduler.h"
 #include "netsecretagent.h"
 #include "netsecretagentforui.h"
+#include "netsharedbackend.h"
 #include "netwirelessconnect.h"
 #include "networkcontroller.h"
 #include "networkdetails.h"
@@ -39,6 +41,8 @@
 
 #include <QCoreApplication>
 #include <QDBusConnection>
+#include <QDBusPendingCallWatcher>
+#include <QDBusPendingReply>
 #include <QProcess>
 #include <QThread>
 
@@ -93,8 +97,12 @@ NetManagerThreadPrivate::NetManagerThreadPrivate()
     , m_enabled(true)
     , m_autoScanInterval(0)
     , m_autoScanEnabled(false)
-    , m_autoScanTimer(nullptr)
+    , m_scanScheduler(nullptr)
+    , m_sharedClient(nullptr)
     , m_lastThroughTime(0)
+    , m_dataChangedInterval(-1)
+    , m_dataChangedTimer(nullptr)
+    , m_detailsTimer(nullptr)
     , m_lastState(NetworkManager::Device::State::UnknownState)
     , m_secretAgent(nullptr)
     , m_netCheckAvailable(false)
@@ -102,7 +110,14 @@ NetManagerThreadPrivate::NetManagerThreadPrivate()
     , m_showPageTimer(nullptr)
     , m_vpnStateUpdateTimer(nullptr)
     , m_supportWireless(false)
-{
+    , m_availableConnectionsTimer(nullptr)
+{
+    // 增删项之前先发送缓存的数据变化，保证与itemAdded/itemRemoved的顺序一致
+    // 需在外部连接这两个信号之前连接
+    connect(this, &NetManagerThreadPrivate::itemAdded, this, &NetManagerThreadPrivate::flushDataChanged, Qt::DirectConnection);
+    connect(this, &NetManagerThreadPrivate::itemRemoved, this, &NetManagerThreadPrivate::flushDataChanged, Qt::DirectConnection);
+    // 缓存的数据变化发送后再释放句柄
+    connect(this, &NetManagerThreadPrivate::itemRemoved, this, &NetManagerThreadPrivate::releaseItemHandle, Qt::DirectConnection);
     moveToThread(m_thread);
     m_thread->start();
 }
@@ -209,6 +224,8 @@ AccessPoints *NetManagerThreadPrivate::fromApID(const QString &id)
 void NetManagerThreadPrivate::setEnabled(bool enabled)
 {
     m_enabled = enabled;
+    if (m_sharedClient)
+        m_sharedClient->call(NetSharedBackend::SetEnabled, { enabled });
 }
 
 void NetManagerThreadPrivate::setAutoScanInterval(int ms)
@@ -221,6 +238,10 @@ void NetManagerThreadPrivate::setAutoScanInterval(int ms)
 void NetManagerThreadPrivate::setAutoScanEnabled(bool enabled)
 {
     m_autoScanEnabled = enabled;
+    if (m_sharedClient) {
+        m_sharedClient->call(NetSharedBackend::SetAutoScanEnabled, { enabled });
+        return;
+    }
     if (m_isInitialized) {
         QMetaObject::invokeMethod(this, "updateAutoScan", Qt::QueuedConnection);
         if (m_autoScanEnabled)
@@ -228,11 +249,32 @@ void NetManagerThreadPrivate::setAutoScanEnabled(bool enabled)
     }
 }
 
+void NetManagerThreadPrivate::setDataChangedInterval(int ms)
+{
+    m_dataChangedInterval = ms;
+    if (m_isInitialized && m_dataChangedInterval <= 0)
+        QMetaObject::invokeMethod(this, "flushDataChanged", Qt::QueuedConnection);
+}
+
+int NetManagerThreadPrivate::dataChangedQueueDepth() const
+{
+    return m_dataChangedQueueDepth.loadRelaxed();
+}
+
 void NetManagerThreadPrivate::setServerKey(const QString &serverKey)
 {
     m_serverKey = serverKey;
 }
 
+void NetManagerThreadPrivate::setSharedClient(NetSharedBackendClient *client)
+{
+    m_sharedClient = client;
+    if (m_sharedClient) {
+        m_sharedClient->call(NetSharedBackend::SetEnabled, { m_enabled });
+        m_sharedClient->call(NetSharedBackend::SetAutoScanEnabled, { m_autoScanEnabled });
+    }
+}
+
 void NetManagerThreadPrivate::init(NetType::NetManagerFlags flags)
 {
     // 在主线程中先安装翻译器，因为直接在子线程中安装翻译器可能会引起崩溃
@@ -241,6 +283,13 @@ void NetManagerThreadPrivate::init(NetType::NetManagerFlags flags)
     QMetaObject::invokeMethod(this, &NetManagerThreadPrivate::doInit, Qt::QueuedConnection);
 }
 
+void NetManagerThreadPrivate::addFlags(NetType::NetManagerFlags flags)
+{
+    QMetaObject::invokeMethod(this, [this, flags] {
+        doAddFlags(flags);
+    }, Qt::QueuedConnection);
+}
+
 NetType::NetManagerFlags NetManagerThreadPrivate::flags() const
 {
     return m_flags;
@@ -258,63 +307,107 @@ QString NetManagerThreadPrivate::wpaEapAuthmethod() const
 
 void NetManagerThreadPrivate::setDeviceEnabled(const QString &id, bool enabled)
 {
+    if (m_sharedClient) {
+        m_sharedClient->call(NetSharedBackend::SetDeviceEnabled, { id, enabled });
+        return;
+    }
     if (m_isInitialized)
         QMetaObject::invokeMethod(this, "doSetDeviceEnabled", Qt::QueuedConnection, Q_ARG(QString, id), Q_ARG(bool, enabled));
 }
 
 void NetManagerThreadPrivate::requestScan(const QString &id)
 {
+    if (m_sharedClient) {
+        m_sharedClient->call(NetSharedBackend::RequestScan, { id });
+        return;
+    }
     if (m_isInitialized)
         QMetaObject::invokeMethod(this, "doRequestScan", Qt::QueuedConnection, Q_ARG(QString, id));
 }
 
 void NetManagerThreadPrivate::disconnectDevice(const QString &id)
 {
+    if (m_sharedClient) {
+        m_sharedClient->call(NetSharedBackend::DisconnectDevice, { id });
+        return;
+    }
     if (m_isInitialized)
         QMetaObject::invokeMethod(this, "doDisconnectDevice", Qt::QueuedConnection, Q_ARG(QString, id));
 }
 
 void NetManagerThreadPrivate::disconnectConnection(const QString &path)
 {
+    if (m_sharedClient) {
+        m_sharedClient->call(NetSharedBackend::DisconnectConnection, { path });
+        return;
+    }
     QMetaObject::invokeMethod(this, "doDisconnectConnection", Qt::QueuedConnection, Q_ARG(QString, path));
 }
 
 void NetManagerThreadPrivate::connectHidden(const QString &id, const QString &ssid)
 {
+    if (m_sharedClient) {
+        m_sharedClient->call(NetSharedBackend::ConnectHidden, { id, ssid });
+        return;
+    }
     if (m_isInitialized)
         QMetaObject::invokeMethod(this, "doConnectHidden", Qt::QueuedConnection, Q_ARG(QString, id), Q_ARG(QString, ssid));
 }
 
 void NetManagerThreadPrivate::connectWired(const QString &id, const QVariantMap &param)
 {
+    if (m_sharedClient) {
+        m_sharedClient->call(NetSharedBackend::ConnectWired, { id, param });
+        return;
+    }
     if (m_isInitialized)
         QMetaObject::invokeMethod(this, "doConnectWired", Qt::QueuedConnection, Q_ARG(QString, id), Q_ARG(QVariantMap, param));
 }
 
 void NetManagerThreadPrivate::connectWireless(const QString &id, const QVariantMap &param)
 {
+    if (m_sharedClient) {
+        m_sharedClient->call(NetSharedBackend::ConnectWireless, { id, param });
+        return;
+    }
     if (m_isInitialized)
         QMetaObject::invokeMethod(this, "doConnectWireless", Qt::QueuedConnection, Q_ARG(QString, id), Q_ARG(QVariantMap, param));
 }
 
 void NetManagerThreadPrivate::connectHotspot(const QString &id, const QVariantMap &param, bool connect)
 {
+    if (m_sharedClient) {
+        m_sharedClient->call(NetSharedBackend::ConnectHotspot, { id, param, connect });
+        return;
+    }
     if (m_isInitialized)
         QMetaObject::invokeMethod(this, "doConnectHotspot", Qt::QueuedConnection, Q_ARG(QString, id), Q_ARG(QVariantMap, param), Q_ARG(bool, connect));
 }
 
 void NetManagerThreadPrivate::gotoControlCenter(const QString &page, const QString &token)
 {
+    if (m_sharedClient) {
+        m_sharedClient->call(NetSharedBackend::GotoControlCenter, { page, token });
+        return;
+    }
     QMetaObject::invokeMethod(this, "doGotoControlCenter", Qt::QueuedConnection, Q_ARG(QString, page), Q_ARG(QString, token));
 }
 
 void NetManagerThreadPrivate::gotoSecurityTools(const QString &page)
 {
+    if (m_sharedClient) {
+        m_sharedClient->call(NetSharedBackend::GotoSecurityTools, { page });
+        return;
+    }
     QMetaObject::invokeMethod(this, "doGotoSecurityTools", Qt::QueuedConnection, Q_ARG(QString, page));
 }
 
 void NetManagerThreadPrivate::userCancelRequest(const QString &id)
 {
+    if (m_sharedClient) {
+        m_sharedClient->call(NetSharedBackend::UserCancelRequest, { id });
+        return;
+    }
     if (m_isInitialized)
         QMetaObject::invokeMethod(this, "doUserCancelRequest", Qt::QueuedConnection, Q_ARG(QString, id));
 }
@@ -362,36 +455,64 @@ void NetManagerThreadPrivate::onAirplaneModePropertiesChanged(const QVariantMap
 
 void NetManagerThreadPrivate::connectOrInfo(const QString &id, NetType::NetItemType type, const QVariantMap &param)
 {
+    if (m_sharedClient) {
+        m_sharedClient->call(NetSharedBackend::ConnectOrInfo, { id, int(type), param });
+        return;
+    }
     QMetaObject::invokeMethod(this, "doConnectOrInfo", Qt::QueuedConnection, Q_ARG(QString, id), Q_ARG(NetType::NetItemType, type), Q_ARG(QVariantMap, param));
 }
 
 void NetManagerThreadPrivate::getConnectInfo(const QString &id, NetType::NetItemType type, const QVariantMap &param)
 {
+    if (m_sharedClient) {
+        m_sharedClient->call(NetSharedBackend::GetConnectInfo, { id, int(type), param });
+        return;
+    }
     QMetaObject::invokeMethod(this, "doGetConnectInfo", Qt::QueuedConnection, Q_ARG(QString, id), Q_ARG(NetType::NetItemType, type), Q_ARG(QVariantMap, param));
 }
 
 void NetManagerThreadPrivate::setConnectInfo(const QString &id, NetType::NetItemType type, const QVariantMap &param)
 {
+    if (m_sharedClient) {
+        m_sharedClient->call(NetSharedBackend::SetConnectInfo, { id, int(type), param });
+        return;
+    }
     QMetaObject::invokeMethod(this, "doSetConnectInfo", Qt::QueuedConnection, Q_ARG(QString, id), Q_ARG(NetType::NetItemType, type), Q_ARG(QVariantMap, param));
 }
 
 void NetManagerThreadPrivate::deleteConnect(const QString &uuid)
 {
+    if (m_sharedClient) {
+        m_sharedClient->call(NetSharedBackend::DeleteConnect, { uuid });
+        return;
+    }
     QMetaObject::invokeMethod(this, "doDeleteConnect", Qt::QueuedConnection, Q_ARG(QString, uuid));
 }
 
 void NetManagerThreadPrivate::importConnect(const QString &id, const QString &file)
 {
+    if (m_sharedClient) {
+        m_sharedClient->call(NetSharedBackend::ImportConnect, { id, file });
+        return;
+    }
     QMetaObject::invokeMethod(this, "doImportConnect", Qt::QueuedConnection, Q_ARG(QString, id), Q_ARG(QString, file));
 }
 
 void NetManagerThreadPrivate::exportConnect(const QString &id, const QString &file)
 {
+    if (m_sharedClient) {
+        m_sharedClient->call(NetSharedBackend::ExportConnect, { id, file });
+        return;
+    }
     QMetaObject::invokeMethod(this, "doExportConnect", Qt::QueuedConnection, Q_ARG(QString, id), Q_ARG(QString, file));
 }
 
 void NetManagerThreadPrivate::showPage(const QString &cmd)
 {
+    if (m_sharedClient) {
+        m_sharedClient->call(NetSharedBackend::ShowPage, { cmd });
+        return;
+    }
     QMetaObject::invokeMethod(this, "doShowPage", Qt::QueuedConnection, Q_ARG(QString, cmd));
 }
 
@@ -415,15 +536,13 @@ void NetManagerThreadPrivate::doInit()
     connect(networkController, &NetworkController::deviceRemoved, this, &NetManagerThreadPrivate::onDeviceRemoved);
     connect(networkController, &NetworkController::connectivityChanged, this, &NetManagerThreadPrivate::onConnectivityChanged);
 
-    if (m_flags.testFlag(NetType::NetManagerFlag::Net_UseSecretAgent)) {
-        // 密码代理按设置来，不与ConfigSetting::instance()->serviceFromNetworkManager()同步
-        if (m_flags.testFlag(NetType::NetManagerFlag::Net_ServiceNM)) {
-            m_secretAgent = new NetSecretAgent(std::bind(&NetManagerThreadPrivate::requestPassword, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3), true, this);
-        } else {
-            m_secretAgent = new NetSecretAgentForUI(std::bind(&NetManagerThreadPrivate::requestPassword, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3), m_serverKey, this);
-        }
-    }
+    if (m_flags.testFlag(NetType::NetManagerFlag::Net_UseSecretAgent))
+        initSecretAgent();
 
+    if (m_dataChangedInterval < 0) { // 没有设置则以配置中值设置下
+        m_dataChangedInterval = ConfigSetting::instance()->dataChangedInterval();
+        connect(ConfigSetting::instance(), &ConfigSetting::dataChangedIntervalChanged, this, &NetManagerThreadPrivate::setDataChangedInterval);
+    }
     onDeviceAdded(networkController->devices());
     if (m_autoScanInterval == 0) { // 没有设置则以配置中值设置下
         m_autoScanInterval = ConfigSetting::instance()->wirelessScanInterval();
@@ -431,18 +550,61 @@ void NetManagerThreadPrivate::doInit()
     }
     updateAutoScan();
 
+    m_netCheckAvailable = false;
+    getNetCheckAvailableFromDBus();
+
+    QDBusConnection::systemBus().connect("com.deepin.defender.netcheck", "/com/deepin/defender/netcheck", "org.freedesktop.DBus.Properties", "PropertiesChanged", this, SLOT(onNetCheckPropertiesChanged(QString, QVariantMap, QStringList)));
+    QDBusConnection::systemBus().connect("org.freedesktop.login1", "/org/freedesktop/login1", "org.freedesktop.login1.Manager", "PrepareForSleep", this, SLOT(onPrepareForSleep(bool)));
+
+
+    // 只有配置为promp和openandpromp的情况下，才会给出提示
+    if (ConfigSetting::instance()->supportPortalPromp()) {
+        QDBusConnection::systemBus().connect("org.deepin.dde.Network1",
+                                             "/org/deepin/service/SystemNetwork",
+                                             "org.deepin.service.SystemNetwork",
+                                             "PortalDetected",
+                                             this,
+                                             SLOT(onPortalDetected(const QString &)));
+    }
+
+    // 优先网络
+    auto updadePrimaryConnectionType = [this] {
+        postDataChanged(DataChanged::primaryConnectionTypeChanged, "", NetworkManager::primaryConnectionType());
+    };
+    connect(NetworkManager::notifier(), &NetworkManager::Notifier::primaryConnectionTypeChanged, this, updadePrimaryConnectionType);
+    updadePrimaryConnectionType();
+
+    initItems(m_flags);
+    m_isInitialized = true;
+    // 初始化的关键参数,保留格式
+    qCInfo(DNC) << "Interface Version :" << INTERFACE_VERSION;
+    qCInfo(DNC) << "Manager Flags     :" << m_flags;
+    qCInfo(DNC) << "Service From NM   :" << m_flags.testFlag(NetType::NetManagerFlag::Net_ServiceNM) << "Config:" << ConfigSetting::instance()->serviceFromNetworkManager();
+    qCInfo(DNC) << "Use Secret Agent  :" << m_flags.testFlag(NetType::NetManagerFlag::Net_UseSecretAgent);
+    qCInfo(DNC) << "Secret Agent      :" << (dynamic_cast<QObject *>(m_secretAgent));
+    qCInfo(DNC) << "Auto Scan Interval:" << m_autoScanInterval;
+    qCInfo(DNC) << "Data Interval     :" << m_dataChangedInterval;
+}
+
+void NetManagerThreadPrivate::initSecretAgent()
+{
+    // 密码代理按设置来，不与ConfigSetting::instance()->serviceFromNetworkManager()同步
+    if (m_flags.testFlag(NetType::NetManagerFlag::Net_ServiceNM)) {
+        m_secretAgent = new NetSecretAgent(std::bind(&NetManagerThreadPrivate::requestPassword, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3), true, this);
+    } else {
+        m_secretAgent = new NetSecretAgentForUI(std::bind(&NetManagerThreadPrivate::requestPassword, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3), m_serverKey, this);
+    }
+}
+
+void NetManagerThreadPrivate::initItems(NetType::NetManagerFlags flags)
+{
+    NetworkController *networkController = NetworkController::instance();
     // VPN
-    if (m_flags.testFlags(NetType::NetManagerFlag::Net_VPN)) {
+    if (flags.testFlags(NetType::NetManagerFlag::Net_VPN)) {
         NetVPNControlItemPrivate *vpnControlItem = NetItemNew(VPNControlItem, "NetVPNControlItem");
         vpnControlItem->updatename("VPN");
         vpnControlItem->updateenabled(networkController->vpnController()->enabled());
         vpnControlItem->item()->moveToThread(m_parentThread);
-        if (m_flags.testFlags(NetType::NetManagerFlag::Net_VPNTips)) {
-            NetVPNTipsItemPrivate *vpnTipsItem = NetItemNew(VPNTipsItem, "NetVPNTipsItem");
-            vpnTipsItem->updatelinkActivatedText("networkVpn");
-            vpnTipsItem->updatetipsLinkEnabled(m_flags.testFlags(NetType::NetManagerFlag::Net_tipsLinkEnabled));
-            vpnControlItem->addChild(vpnTipsItem);
-        }
         Q_EMIT itemAdded("Root", vpnControlItem);
 
         m_vpnStateUpdateTimer = new QTimer(this);
@@ -456,14 +618,32 @@ void NetManagerThreadPrivate::doInit()
                 if (item->status() == ConnectionStatus::Activated || item->status() == ConnectionStatus::Activating || item->status() == ConnectionStatus::Deactivating) {
                     state = toNetDeviceStatus(item->status());
                     if (item->status() == ConnectionStatus::Activated)
-                        Q_EMIT dataChanged(DataChanged::IPChanged, "NetVPNControlItem", QVariant::fromValue(item->connection()->id()));
+                        postDataChanged(DataChanged::IPChanged, "NetVPNControlItem", QVariant::fromValue(item->connection()->id()));
                     break;
                 }
                 continue;
             }
-            Q_EMIT dataChanged(DataChanged::VPNConnectionStateChanged, "NetVPNControlItem", QVariant::fromValue(state));
+            postDataChanged(DataChanged::VPNConnectionStateChanged, "NetVPNControlItem", QVariant::fromValue(state));
         };
         connect(m_vpnStateUpdateTimer, &QTimer::timeout, this, updateVPNConnectionState);
+        connect(networkController->vpnController(), &VPNController::enableChanged, this, &NetManagerThreadPrivate::onVPNEnableChanged);
+        connect(networkController->vpnController(), &VPNController::activeConnectionChanged, this, &NetManagerThreadPrivate::onVpnActiveConnectionChanged);
+    }
+    // VPN刚创建时按全部标记创建子项，已创建时只处理新增的标记
+    const NetType::NetManagerFlags vpnFlags = flags.testFlags(NetType::NetManagerFlag::Net_VPN) ? m_flags : (m_flags.testFlags(NetType::NetManagerFlag::Net_VPN) ? flags : NetType::NetManagerFlags());
+    if (vpnFlags.testFlags(NetType::NetManagerFlag::Net_VPNTips)) {
+        NetVPNTipsItemPrivate *vpnTipsItem = NetItemNew(VPNTipsItem, "NetVPNTipsItem");
+        vpnTipsItem->updatelinkActivatedText("networkVpn");
+        vpnTipsItem->updatetipsLinkEnabled(m_flags.testFlags(NetType::NetManagerFlag::Net_tipsLinkEnabled));
+        vpnTipsItem->item()->moveToThread(m_parentThread);
+        Q_EMIT itemAdded("NetVPNControlItem", vpnTipsItem);
+    }
+    if (vpnFlags.testFlags(NetType::NetManagerFlag::Net_VPNChildren)) {
+        connect(networkController->vpnController(), &VPNController::itemAdded, this, &NetManagerThreadPrivate::onVPNAdded);
+        connect(networkController->vpnController(), &VPNController::itemRemoved, this, &NetManagerThreadPrivate::onVPNRemoved);
+        onVPNAdded(networkController->vpnController()->items());
+    }
+    if (vpnFlags.testFlags(NetType::NetManagerFlag::Net_VPNTips)) {
         auto vpnConnectionStateChanged = [this] {
             // 使用成员定时器，重复触发时自动重置计时，防止多次触发累积
             m_vpnStateUpdateTimer->start();
@@ -471,27 +651,18 @@ void NetManagerThreadPrivate::doInit()
 
         auto vpnItemChanged = [this, vpnConnectionStateChanged] {
             auto itemList = NetworkController::instance()->vpnController()->items();
-            Q_EMIT dataChanged(DataChanged::DeviceAvailableChanged, "NetVPNControlItem", itemList.size() > 0);
+            postDataChanged(DataChanged::DeviceAvailableChanged, "NetVPNControlItem", itemList.size() > 0);
             vpnConnectionStateChanged();
         };
-        connect(networkController->vpnController(), &VPNController::enableChanged, this, &NetManagerThreadPrivate::onVPNEnableChanged);
-        if (m_flags.testFlags(NetType::NetManagerFlag::Net_VPNChildren)) {
-            connect(networkController->vpnController(), &VPNController::itemAdded, this, &NetManagerThreadPrivate::onVPNAdded);
-            connect(networkController->vpnController(), &VPNController::itemRemoved, this, &NetManagerThreadPrivate::onVPNRemoved);
-            onVPNAdded(networkController->vpnController()->items());
-        }
-        connect(networkController->vpnController(), &VPNController::activeConnectionChanged, this, &NetManagerThreadPrivate::onVpnActiveConnectionChanged);
-        if (m_flags.testFlags(NetType::NetManagerFlag::Net_VPNTips)) {
-            connect(networkController->vpnController(), &VPNController::itemChanged, this, vpnItemChanged);
-            connect(networkController->vpnController(), &VPNController::itemAdded, this, vpnItemChanged);
-            connect(networkController->vpnController(), &VPNController::itemRemoved, this, vpnItemChanged);
-            connect(networkController->vpnController(), &VPNController::enableChanged, this, vpnConnectionStateChanged);
-            connect(networkController->vpnController(), &VPNController::activeConnectionChanged, this, vpnConnectionStateChanged);
-            vpnItemChanged();
-        }
+        connect(networkController->vpnController(), &VPNController::itemChanged, this, vpnItemChanged);
+        connect(networkController->vpnController(), &VPNController::itemAdded, this, vpnItemChanged);
+        connect(networkController->vpnController(), &VPNController::itemRemoved, this, vpnItemChanged);
+        connect(networkController->vpnController(), &VPNController::enableChanged, this, vpnConnectionStateChanged);
+        connect(networkController->vpnController(), &VPNController::activeConnectionChanged, this, vpnConnectionStateChanged);
+        vpnItemChanged();
     }
     // 系统代理
-    if (m_flags.testFlags(NetType::NetManagerFlag::Net_SysProxy)) {
+    if (flags.testFlags(NetType::NetManagerFlag::Net_SysProxy)) {
         networkController->proxyController()->querySysProxyData();
         ProxyMethod method = networkController->proxyController()->proxyMethod();
         NetSystemProxyControlItemPrivate *item = NetItemNew(SystemProxyControlItem, "NetSystemProxyControlItem");
@@ -515,7 +686,7 @@ void NetManagerThreadPrivate::doInit()
         connect(ConfigWatcher::instance(), &ConfigWatcher::lastProxyMethodChanged, this, &NetManagerThreadPrivate::onLastProxyMethodChanged);
     }
     // 应用代理
-    if (m_flags.testFlags(NetType::NetManagerFlag::Net_AppProxy)) {
+    if (flags.testFlags(NetType::NetManagerFlag::Net_AppProxy)) {
         networkController->proxyController()->querySysProxyData();
         NetAppProxyControlItemPrivate *item = NetItemNew(AppProxyControlItem, "NetAppProxyControlItem");
         item->updatename("AppProxy");
@@ -533,31 +704,8 @@ void NetManagerThreadPrivate::doInit()
         connect(networkController->proxyController(), &ProxyController::appPortChanged, this, &NetManagerThreadPrivate::onAppProxyChanged);
     }
 
-    m_netCheckAvailable = false;
-    getNetCheckAvailableFromDBus();
-
-    QDBusConnection::systemBus().connect("com.deepin.defender.netcheck", "/com/deepin/defender/netcheck", "org.freedesktop.DBus.Properties", "PropertiesChanged", this, SLOT(onNetCheckPropertiesChanged(QString, QVariantMap, QStringList)));
-    QDBusConnection::systemBus().connect("org.freedesktop.login1", "/org/freedesktop/login1", "org.freedesktop.login1.Manager", "PrepareForSleep", this, SLOT(onPrepareForSleep(bool)));
-
-
-    // 只有配置为promp和openandpromp的情况下，才会给出提示
-    if (ConfigSetting::instance()->supportPortalPromp()) {
-        QDBusConnection::systemBus().connect("org.deepin.dde.Network1",
-                                             "/org/deepin/service/SystemNetwork",
-                                             "org.deepin.service.SystemNetwork",
-                                             "PortalDetected",
-                                             this,
-                                             SLOT(onPortalDetected(const QString &)));
-    }
-
-    // 优先网络
-    auto updadePrimaryConnectionType = [this] {
-        Q_EMIT dataChanged(DataChanged::primaryConnectionTypeChanged, "", NetworkManager::primaryConnectionType());
-    };
-    connect(NetworkManager::notifier(), &NetworkManager::Notifier::primaryConnectionTypeChanged, this, updadePrimaryConnectionType);
-    updadePrimaryConnectionType();
     // 热点
-    if (m_flags.testFlags(NetType::NetManagerFlag::Net_Hotspot)) {
+    if (flags.testFlags(NetType::NetManagerFlag::Net_Hotspot)) {
         networkController->hotspotController();
         NetHotspotController *netHotspotController = new NetHotspotController(this);
         NetHotspotControlItemPrivate *hotspotcontrolitem = NetItemNew(HotspotControlItem, "NetHotspotControlItem");
@@ -579,7 +727,7 @@ void NetManagerThreadPrivate::doInit()
         connect(netHotspotController, &NetHotspotController::deviceEnabledChanged, this, &NetManagerThreadPrivate::onHotspotDeviceEnabledChanged);
     }
     // Airplane
-    if (m_flags.testFlags(NetType::NetManagerFlag::Net_Airplane)) {
+    if (flags.testFlags(NetType::NetManagerFlag::Net_Airplane)) {
         m_airplaneModeEnabled = false;
         getAirplaneModeEnabled();
         connect(ConfigSetting::instance(), &ConfigSetting::enableAirplaneModeChanged, this, &NetManagerThreadPrivate::getAirplaneModeEnabled);
@@ -588,7 +736,7 @@ void NetManagerThreadPrivate::doInit()
         QDBusConnection::systemBus().connect("org.deepin.dde.AirplaneMode1", "/org/deepin/dde/AirplaneMode1", "org.freedesktop.DBus.Properties", "PropertiesChanged", this, SLOT(onAirplaneModeEnabledPropertiesChanged(QString, QVariantMap, QStringList)));
     }
     // DSL
-    if (m_flags.testFlags(NetType::NetManagerFlag::Net_DSL)) {
+    if (flags.testFlags(NetType::NetManagerFlag::Net_DSL)) {
         NetDSLControlItemPrivate *dslControlItem = NetItemNew(DSLControlItem, "NetDSLControlItem");
         dslControlItem->updatename("DSL");
         dslControlItem->item()->moveToThread(m_parentThread);
@@ -602,7 +750,7 @@ void NetManagerThreadPrivate::doInit()
         onDSLAdded(networkController->dslController()->items());
     }
     // Details
-    if (m_flags.testFlags(NetType::NetManagerFlag::Net_Details)) {
+    if (flags.testFlags(NetType::NetManagerFlag::Net_Details)) {
         NetDetailsItemPrivate *item = NetItemNew(DetailsItem, "Details");
         item->updatename("Details");
         item->item()->moveToThread(m_parentThread);
@@ -611,34 +759,73 @@ void NetManagerThreadPrivate::doInit()
         // connect(networkController, &NetworkController::deviceAdded, this, &NetManagerThreadPrivate::updateDetails, Qt::QueuedConnection);
         // connect(networkController, &NetworkController::deviceRemoved, this, &NetManagerThreadPrivate::updateDetails, Qt::QueuedConnection);
         // connect(networkController, &NetworkController::connectivityChanged, this, &NetManagerThreadPrivate::updateDetails, Qt::QueuedConnection);
-        connect(networkController, &NetworkController::activeConnectionChange, this, &NetManagerThreadPrivate::updateDetails, Qt::QueuedConnection);
+        connect(networkController, &NetworkController::activeConnectionChange, this, &NetManagerThreadPrivate::requestUpdateDetails, Qt::QueuedConnection);
     }
-    m_isInitialized = true;
-    // 初始化的关键参数,保留格式
-    qCInfo(DNC) << "Interface Version :" << INTERFACE_VERSION;
-    qCInfo(DNC) << "Manager Flags     :" << m_flags;
-    qCInfo(DNC) << "Service From NM   :" << m_flags.testFlag(NetType::NetManagerFlag::Net_ServiceNM) << "Config:" << ConfigSetting::instance()->serviceFromNetworkManager();
-    qCInfo(DNC) << "Use Secret Agent  :" << m_flags.testFlag(NetType::NetManagerFlag::Net_UseSecretAgent);
-    qCInfo(DNC) << "Secret Agent      :" << (dynamic_cast<QObject *>(m_secretAgent));
-    qCInfo(DNC) << "Auto Scan Interval:" << m_autoScanInterval;
+}
+
+void NetManagerThreadPrivate::doAddFlags(NetType::NetManagerFlags flags)
+{
+    // 数据来源在初始化时已确定；8021x的处理方式以维护数据的进程为准；系统代理是否总是显示由各进程自己处理
+    NetType::NetManagerFlags added = flags & ~m_flags & ~NetType::NetManagerFlags(NetType::Net_ServiceNM | NetType::Net_8021xMask | NetType::Net_SysProxyAlwaysShow);
+    if (!(m_flags & NetType::Net_8021xMask))
+        added |= flags & NetType::Net_8021xMask;
+    if (!added)
+        return;
+    m_flags |= added;
+    // 未初始化时doInit按合并后的标记创建
+    if (!m_isInitialized)
+        return;
+    qCInfo(DNC) << "Add manager flags:" << added << ", flags:" << m_flags;
+    if (added.testFlag(NetType::NetManagerFlag::Net_UseSecretAgent) && !m_secretAgent)
+        initSecretAgent();
+    if (added.testFlag(NetType::NetManagerFlag::Net_MonitorNotify)) {
+        for (NetworkDeviceBase *device : NetworkController::instance()->devices())
+            addDeviceNotify(device->path());
+    }
+    initItems(added);
 }
 
 void NetManagerThreadPrivate::clearData()
 {
     // 此函数是在线程中执行,线程中创建的对象应在此delete
-    if (m_autoScanTimer) {
-        delete m_autoScanTimer;
-        m_autoScanTimer = nullptr;
+    if (m_scanScheduler) {
+        delete m_scanScheduler;
+        m_scanScheduler = nullptr;
     }
     if (m_vpnStateUpdateTimer) {
         m_vpnStateUpdateTimer->stop();
         delete m_vpnStateUpdateTimer;
         m_vpnStateUpdateTimer = nullptr;
     }
+    if (m_dataChangedTimer) {
+        delete m_dataChangedTimer;
+        m_dataChangedTimer = nullptr;
+    }
+    if (m_availableConnectionsTimer) {
+        delete m_availableConnectionsTimer;
+        m_availableConnectionsTimer = nullptr;
+    }
+    m_pendingAvailableDevices.clear();
+    m_connectedAps.clear();
+    // 句柄计数不清零，主线程缓存的旧句柄不会指向之后的数据项
+    m_itemHandles.clear();
+    m_apHandles.clear();
+    if (m_detailsTimer) {
+        delete m_detailsTimer;
+        m_detailsTimer = nullptr;
+    }
     if (m_secretAgent) {
         delete m_secretAgent;
         m_secretAgent = nullptr;
     }
+    for (const SavedSsidCache &cache : std::as_const(m_savedSsidCache))
+        disconnect(cache.watcher);
+    m_savedSsidCache.clear();
+    for (const ConnectionSettingsCache &cache : std::as_const(m_connectionSettingsCache)) {
+        disconnect(cache.updatedWatcher);
+        disconnect(cache.removedWatcher);
+    }
+    m_connectionSettingsCache.clear();
     NetworkController::free();
 }
 
@@ -894,14 +1081,14 @@ void NetManagerThreadPrivate::updateNetCheckAvailabled(const QDBusVariant &avail
 void NetManagerThreadPrivate::updateAirplaneModeEnabled(const QDBusVariant &enabled)
 {
     m_airplaneModeEnabled = enabled.variant().toBool() && supportAirplaneMode();
-    Q_EMIT dataChanged(DataChanged::EnabledChanged, "Root", QVariant(m_airplaneModeEnabled));
-    Q_EMIT dataChanged(DataChanged::AirplaneModeEnabledChanged, "Root", QVariant(m_airplaneModeEnabled));
+    postDataChanged(DataChanged::EnabledChanged, "Root", QVariant(m_airplaneModeEnabled));
+    postDataChanged(DataChanged::AirplaneModeEnabledChanged, "Root", QVariant(m_airplaneModeEnabled));
 }
 
 void NetManagerThreadPrivate::updateAirplaneModeEnabledable(const QDBusVariant &enabledable)
 {
     bool airplaneEnabledable = enabledable.variant().toBool() && ConfigSetting::instance()->networkAirplaneMode();
-    Q_EMIT dataChanged(DataChanged::DeviceAvailableChanged, "Root", QVariant(airplaneEnabledable));
+    postDataChanged(DataChanged::DeviceAvailableChanged, "Root", QVariant(airplaneEnabledable));
 }
 
 bool NetManagerThreadPrivate::supportAirplaneMode() const
@@ -1051,6 +1238,61 @@ void NetManagerThreadPrivate::doConnectOrInfo(const QString &id, NetType::NetIte
     }
 }
 
+// 将连接配置转换为界面使用的参数,并加入可选设备
+static QVariantMap connectInfoFromSettings(const ConnectionSettings::Ptr &settings, const QString &mac)
+{
+    QVariantMap retParam;
+    const NMVariantMapMap &settingsMap = settings->toMap();
+    for (auto it = settingsMap.cbegin(); it != settingsMap.cend(); it++) {
+        retParam.insert(it.key(), it.value());
+    }
+    QVariantMap typeMap = retParam[settingsMap["connection"]["type"].toString()].value<QVariantMap>();
+    typeMap.insert("optionalDevice", QStringList(mac));
+    retParam[settingsMap["connection"]["type"].toString()] = typeMap;
+    return retParam;
+}
+
+// NetworkManagerQt的Ipv6Setting中不包含gateway,DNS也可能为空,从原始配置中补充
+static void mergeIpv6Settings(QVariantMap &retParam, const ConnectionSettings::Ptr &settings, const NMVariantMapMap &rawSettings)
+{
+    if (!rawSettings.contains("ipv6"))
+        return;
+
+    Ipv6Setting::Ptr ipv6 = settings->setting(Setting::Ipv6).dynamicCast<Ipv6Setting>();
+    QVariantMap ipv6Data = rawSettings.value("ipv6");
+    QVariantMap ipv6Map = retParam["ipv6"].value<QVariantMap>();
+
+    // 处理IPv6 gateway
+    if (ipv6->method() == Ipv6Setting::Manual && ipv6Data.contains("gateway")) {
+        QString gateway = ipv6Data.value("gateway").toString();
+        ipv6Map.insert("gateway", gateway);
+    }
+
+    // 处理IPv6 DNS - 首先从NetworkManager设置中直接读取
+    const QList<QHostAddress> &ipv6DnsFromSettings = ipv6->dns();
+    if (!ipv6DnsFromSettings.isEmpty()) {
+        QStringList dnsStringList;
+        for (const QHostAddress &dns : ipv6DnsFromSettings) {
+            dnsStringList.append(dns.toString());
+        }
+        ipv6Map.insert("dns", dnsStringList);
+    } else if (ipv6Data.contains("dns")) {
+        QVariantList dnsConfig = ipv6Data.value("dns").toList();
+        QStringList ipv6DnsList;
+        for (const QVariant &dns : dnsConfig) {
+            QString dnsStr = dns.toString();
+            if (!dnsStr.isEmpty()) {
+                ipv6DnsList.append(dnsStr);
+            }
+        }
+        if (!ipv6DnsList.isEmpty()) {
+            ipv6Map.insert("dns", ipv6DnsList);
+        }
+    }
+
+    retParam["ipv6"] = ipv6Map;
+}
+
 void NetManagerThreadPrivate::doGetConnectInfo(const QString &id, NetType::NetItemType type, const QVariantMap &param)
 {
     switch (type) {
@@ -1101,66 +1343,21 @@ void NetManagerThreadPrivate::doGetConnectInfo(const QString &id, NetType::NetIt
                         auto connectionSettings = connection->settings();
                         Setting::SettingType sType = Setting::SettingType::Security8021x;
                         QSharedPointer<Security8021xSetting> sSetting = connectionSettings->setting(sType).staticCast<Security8021xSetting>();
-                        // if (!sSetting->eapMethods().isEmpty()) {
-                        sSetting->secretsFromMap(connection->secrets(sSetting->name()).value().value(sSetting->name()));
-                        // }
-
-                        QVariantMap retParam;
-                        const NMVariantMapMap &settingsMap = connectionSettings->toMap();
-                        for (auto it = settingsMap.cbegin(); it != settingsMap.cend(); it++) {
-                            retParam.insert(it.key(), it.value());
-                        }
                         // 可选设备
                         QString mac = netDevice->realHwAdr();
                         if (mac.isEmpty()) {
                             mac = netDevice->usingHwAdr();
                         }
                         mac = mac + " (" + netDevice->interface() + ")";
-                        QVariantMap typeMap = retParam[settingsMap["connection"]["type"].toString()].value<QVariantMap>();
-                        typeMap.insert("optionalDevice", QStringList(mac));
-                        retParam[settingsMap["connection"]["type"].toString()] = typeMap;
-
-                        Ipv6Setting::Ptr ipv6 = connectionSettings->setting(Setting::Ipv6).dynamicCast<Ipv6Setting>();
-                        connection->path();
-                        // 手动获取IPv6配置（包括gateway和DNS）
-                        auto msg = QDBusMessage::createMethodCall("org.freedesktop.NetworkManager", connection->path(), "org.freedesktop.NetworkManager.Settings.Connection", "GetSettings");
-                        QDBusPendingReply<NMVariantMapMap> dbusSettingsMap = QDBusConnection::systemBus().call(msg, QDBus::Block, 100);
-                        if (!dbusSettingsMap.isError() && dbusSettingsMap.value().contains("ipv6")) {
-                            QVariantMap ipv6Data = dbusSettingsMap.value().value("ipv6");
-                            QVariantMap ipv6Map = retParam["ipv6"].value<QVariantMap>();
-
-                            // 处理IPv6 gateway
-                            if (ipv6->method() == Ipv6Setting::Manual && ipv6Data.contains("gateway")) {
-                                QString gateway = ipv6Data.value("gateway").toString();
-                                ipv6Map.insert("gateway", gateway);
-                            }
-
-                            // 处理IPv6 DNS - 首先从NetworkManager设置中直接读取
-                            const QList<QHostAddress> &ipv6DnsFromSettings = ipv6->dns();
-                            if (!ipv6DnsFromSettings.isEmpty()) {
-                                QStringList dnsStringList;
-                                for (const QHostAddress &dns : ipv6DnsFromSettings) {
-                                    dnsStringList.append(dns.toString());
-                                }
-                                ipv6Map.insert("dns", dnsStringList);
-                            } else if (ipv6Data.contains("dns")) {
-                                QVariantList dnsConfig = ipv6Data.value("dns").toList();
-                                QStringList ipv6DnsList;
-                                for (const QVariant &dns : dnsConfig) {
-                                    QString dnsStr = dns.toString();
-                                    if (!dnsStr.isEmpty()) {
-                                        ipv6DnsList.append(dnsStr);
-                                    }
-                                }
-                                if (!ipv6DnsList.isEmpty()) {
-                                    ipv6Map.insert("dns", ipv6DnsList);
-                                }
-                            }
-
-                            retParam["ipv6"] = ipv6Map;
-                        }
-
-                        Q_EMIT request(NetManager::ConnectInfo, id, retParam);
+                        // 密码和IPv6的原始配置都异步获取,获取完成后再返回
+                        requestConnectionSecrets(connection, sSetting->name(), [this, id, connection, connectionSettings, sSetting, mac](const NMVariantMapMap &secrets) {
+                            sSetting->secretsFromMap(secrets.value(sSetting->name()));
+                            requestConnectionSettings(connection, [this, id, connectionSettings, mac](const NMVariantMapMap &rawSettings) {
+                                QVariantMap retParam = connectInfoFromSettings(connectionSettings, mac);
+                                mergeIpv6Settings(retParam, connectionSettings, rawSettings);
+                                Q_EMIT request(NetManager::ConnectInfo, id, retParam);
+                            });
+                        });
                         break;
                     }
                 }
@@ -1204,74 +1401,34 @@ void NetManagerThreadPrivate::doGetConnectInfo(const QString &id, NetType::NetIt
                 sSetting->setAuthAlg(WirelessSecuritySetting::None);
                 sSetting->setInitialized(true);
             }
+            Setting::Ptr secretsSetting;
             switch (keyMgmt) {
             case WirelessSecuritySetting::Unknown:
             case WirelessSecuritySetting::WpaNone:
                 break;
-            case WirelessSecuritySetting::WpaEap: {
-                Security8021xSetting::Ptr const xSetting = settings->setting(Setting::SettingType::Security8021x).staticCast<Security8021xSetting>();
-                xSetting->secretsFromMap(con->secrets(xSetting->name()).value().value(xSetting->name()));
-            } break;
+            case WirelessSecuritySetting::WpaEap:
+                secretsSetting = settings->setting(Setting::SettingType::Security8021x);
+                break;
             default:
-                sSetting->secretsFromMap(con->secrets(sSetting->name()).value().value(sSetting->name()));
+                secretsSetting = sSetting;
                 break;
             }
-            ///////////
-            QVariantMap retParam;
-            const NMVariantMapMap &settingsMap = settings->toMap();
-            for (auto it = settingsMap.cbegin(); it != settingsMap.cend(); it++) {
-                retParam.insert(it.key(), it.value());
-            }
             // 可选设备
             QString mac = netDevice->permanentHardwareAddress().toUpper();
             if (mac.isEmpty()) {
                 mac = netDevice->hardwareAddress().toUpper();
             }
             mac = mac + " (" + netDevice->interfaceName() + ")";
-            QVariantMap typeMap = retParam[settingsMap["connection"]["type"].toString()].value<QVariantMap>();
-            typeMap.insert("optionalDevice", QStringList(mac));
-            retParam[settingsMap["connection"]["type"].toString()] = typeMap;
-
-            Ipv6Setting::Ptr ipv6 = settings->setting(Setting::Ipv6).dynamicCast<Ipv6Setting>();
-            // 手动获取IPv6配置（包括gateway和DNS）
-            QDBusMessage msg = QDBusMessage::createMethodCall("org.freedesktop.NetworkManager", con->path(), "org.freedesktop.NetworkManager.Settings.Connection", "GetSettings");
-            QDBusPendingReply<NMVariantMapMap> dbusSettingsReply = QDBusConnection::systemBus().call(msg, QDBus::Block, 100);
-            if (!dbusSettingsReply.isError() && dbusSettingsReply.value().contains("ipv6")) {
-                QVariantMap ipv6Data = dbusSettingsReply.value().value("ipv6");
-                QVariantMap ipv6Map = retParam["ipv6"].value<QVariantMap>();
-
-                // 处理IPv6 gateway
-                if (ipv6->method() == Ipv6Setting::Manual && ipv6Data.contains("gateway")) {
-                    QString gateway = ipv6Data.value("gateway").toString();
-                    ipv6Map.insert("gateway", gateway);
-                }
-
-                // 处理IPv6 DNS - 首先从NetworkManager设置中直接读取
-                const QList<QHostAddress> &ipv6DnsFromSettings = ipv6->dns();
-                if (!ipv6DnsFromSettings.isEmpty()) {
-                    QStringList dnsStringList;
-                    for (const QHostAddress &dns : ipv6DnsFromSettings) {
-                        dnsStringList.append(dns.toString());
-                    }
-                    ipv6Map.insert("dns", dnsStringList);
-                } else if (ipv6Data.contains("dns")) {
-                    QVariantList dnsConfig = ipv6Data.value("dns").toList();
-                    QStringList ipv6DnsList;
-                    for (const QVariant &dns : dnsConfig) {
-                        QString dnsStr = dns.toString();
-                        if (!dnsStr.isEmpty()) {
-                            ipv6DnsList.append(dnsStr);
-                        }
-                    }
-                    if (!ipv6DnsList.isEmpty()) {
-                        ipv6Map.insert("dns", ipv6DnsList);
-                    }
-                }
-
-                retParam["ipv6"] = ipv6Map;
-            }
-
-            Q_EMIT request(NetManager::ConnectInfo, id, retParam);
+            const QString secretsName = secretsSetting.isNull() ? QString() : secretsSetting->name();
+            requestConnectionSecrets(con, secretsName, [this, id, con, settings, secretsSetting, mac](const NMVariantMapMap &secrets) {
+                if (!secretsSetting.isNull())
+                    secretsSetting->secretsFromMap(secrets.value(secretsSetting->name()));
+                requestConnectionSettings(con, [this, id, settings, mac](const NMVariantMapMap &rawSettings) {
+                    QVariantMap retParam = connectInfoFromSettings(settings, mac);
+                    mergeIpv6Settings(retParam, settings, rawSettings);
+                    Q_EMIT request(NetManager::ConnectInfo, id, retParam);
+                });
+            });
             break;
         }
         if (settings.isNull()) { // 新项
@@ -1435,14 +1592,16 @@ void NetManagerThreadPrivate::doGetConnectInfo(const QString &id, NetType::NetIt
     } break;
     case NetType::ConnectionItem: {
         NetworkManager::Connection::Ptr conn = findConnection(id);
+        if (!conn)
+            return;
         auto settings = conn->settings();
         QStringList optionalDevice;
         QString deviceKey;
+        Setting::Ptr secretsSetting;
         switch (settings->connectionType()) {
         case ConnectionSettings::Pppoe: {
             deviceKey = "802-3-ethernet";
-            PppoeSetting::Ptr const pSetting = settings->setting(Setting::SettingType::Pppoe).staticCast<PppoeSetting>();
-            pSetting->secretsFromMap(conn->secrets(pSetting->name()).value().value(pSetting->name()));
+            secretsSetting = settings->setting(Setting::SettingType::Pppoe);
             for (NetworkDeviceBase *device : NetworkController::instance()->devices()) {
                 if (device->deviceType() == DeviceType::Wired) {
                     QString mac = device->realHwAdr();
@@ -1454,47 +1613,52 @@ void NetManagerThreadPrivate::doGetConnectInfo(const QString &id, NetType::NetIt
                 }
             }
         } break;
-        case ConnectionSettings::Vpn: {
-            VpnSetting::Ptr const vpnSetting = settings->setting(Setting::SettingType::Vpn).staticCast<VpnSetting>();
-            vpnSetting->secretsFromMap(conn->secrets(vpnSetting->name()).value().value(vpnSetting->name()));
-        } break;
+        case ConnectionSettings::Vpn:
+            secretsSetting = settings->setting(Setting::SettingType::Vpn);
+            break;
         case ConnectionSettings::Wired:
             deviceKey = "802-3-ethernet";
             break;
         default:
             break;
         }
-        QVariantMap retParam;
-        const NMVariantMapMap &settingsMap = settings->toMap();
-        for (auto it = settingsMap.cbegin(); it != settingsMap.cend(); it++) {
-            retParam.insert(it.key(), it.value());
-        }
-        if (retParam.contains(deviceKey)) {
-            QVariantMap typeMap = retParam[deviceKey].value<QVariantMap>();
-            typeMap.insert("optionalDevice", optionalDevice);
-            retParam[deviceKey] = typeMap;
-        }
-        // For VPN connections, ensure ipv6.dns-priority is preserved
-        // (NMQt's Ipv6Setting doesn't expose this field; ipv4 has native support)
-        if (settings->connectionType() == ConnectionSettings::Vpn) {
-            auto msg = QDBusMessage::createMethodCall("org.freedesktop.NetworkManager", conn->path(), "org.freedesktop.NetworkManager.Settings.Connection", "GetSettings");
-            QDBusPendingReply<NMVariantMapMap> dbusSettingsReply = QDBusConnection::systemBus().call(msg, QDBus::Block, 100);
-            if (!dbusSettingsReply.isError()) {
-                const NMVariantMapMap &rawSettings = dbusSettingsReply.value();
-                if (rawSettings.contains("ipv6")) {
-                    int dp = rawSettings["ipv6"].value("dns-priority", 0).toInt();
-                    if (dp != 0) {
-                        QVariantMap ipv6Map = retParam.value("ipv6").toMap();
-                        ipv6Map["dns-priority"] = dp;
-                        retParam["ipv6"] = ipv6Map;
-                    }
+        const bool check = param.value("check").toBool();
+        auto replyInfo = [this, id, settings, deviceKey, optionalDevice, check](const NMVariantMapMap &rawSettings) {
+            QVariantMap retParam;
+            const NMVariantMapMap &settingsMap = settings->toMap();
+            for (auto it = settingsMap.cbegin(); it != settingsMap.cend(); it++) {
+                retParam.insert(it.key(), it.value());
+            }
+            if (retParam.contains(deviceKey)) {
+                QVariantMap typeMap = retParam[deviceKey].value<QVariantMap>();
+                typeMap.insert("optionalDevice", optionalDevice);
+                retParam[deviceKey] = typeMap;
+            }
+            // For VPN connections, ensure ipv6.dns-priority is preserved
+            // (NMQt's Ipv6Setting doesn't expose this field; ipv4 has native support)
+            if (rawSettings.contains("ipv6")) {
+                int dp = rawSettings["ipv6"].value("dns-priority", 0).toInt();
+                if (dp != 0) {
+                    QVariantMap ipv6Map = retParam.value("ipv6").toMap();
+                    ipv6Map["dns-priority"] = dp;
+                    retParam["ipv6"] = ipv6Map;
                 }
             }
-        }
-        if (param.value("check").toBool()) {
-            retParam.insert("check", true);
-        }
-        Q_EMIT request(NetManager::ConnectInfo, id, retParam);
+            if (check) {
+                retParam.insert("check", true);
+            }
+            Q_EMIT request(NetManager::ConnectInfo, id, retParam);
+        };
+        const QString secretsName = secretsSetting.isNull() ? QString() : secretsSetting->name();
+        requestConnectionSecrets(conn, secretsName, [conn, settings, secretsSetting, replyInfo](const NMVariantMapMap &secrets) {
+            if (!secretsSetting.isNull())
+                secretsSetting->secretsFromMap(secrets.value(secretsSetting->name()));
+            // 只有VPN需要原始配置
+            if (settings->connectionType() == ConnectionSettings::Vpn)
+                requestConnectionSettings(conn, replyInfo);
+            else
+                replyInfo(NMVariantMapMap());
+        });
     } break;
     case NetType::HotspotControlItem:
         break;
@@ -1504,6 +1668,93 @@ void NetManagerThreadPrivate::doGetConnectInfo(const QString &id, NetType::NetIt
     }
 }
 
+void NetManagerThreadPrivate::requestConnectionSettings(const NetworkManager::Connection::Ptr &connection, const SettingsCallback &callback)
+{
+    const QString path = connection->path();
+    ConnectionSettingsCache &cache = m_connectionSettingsCache[path];
+    if (cache.valid) {
+        callback(cache.settings);
+        return;
+    }
+    if (!cache.updatedWatcher) {
+        cache.updatedWatcher = connect(connection.data(), &NetworkManager::Connection::updated, this, [this, path] {
+            invalidateConnectionSettings(path);
+        });
+        cache.removedWatcher = connect(connection.data(), &NetworkManager::Connection::removed, this, [this, path] {
+            invalidateConnectionSettings(path);
+        });
+    }
+    cache.pending.append(callback);
+    // 同一个连接已经有请求在进行中,等待其结果即可
+    if (cache.pending.size() > 1)
+        return;
+
+    const quint64 generation = cache.generation;
+    QDBusMessage msg = QDBusMessage::createMethodCall("org.freedesktop.NetworkManager", path, "org.freedesktop.NetworkManager.Settings.Connection", "GetSettings");
+    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(QDBusConnection::systemBus().asyncCall(msg, 100), this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [this, path, generation](QDBusPendingCallWatcher *w) {
+        w->deleteLater();
+        auto it = m_connectionSettingsCache.find(path);
+        if (it == m_connectionSettingsCache.end())
+            return;
+
+        QDBusPendingReply<NMVariantMapMap> reply = *w;
+        NMVariantMapMap settings;
+        if (reply.isError()) {
+            qCWarning(DNC) << "get connection settings failed:" << path << reply.error().message();
+        } else {
+            settings = reply.value();
+            // 请求期间连接被修改过,结果只返回给本次的请求,不缓存
+            if (it->generation == generation) {
+                it->settings = settings;
+                it->valid = true;
+            }
+        }
+        const QList<SettingsCallback> callbacks = it->pending;
+        it->pending.clear();
+        if (!it->valid && it->generation != generation)
+            invalidateConnectionSettings(path);
+        for (const SettingsCallback &callback : callbacks)
+            callback(settings);
+    });
+}
+
+void NetManagerThreadPrivate::requestConnectionSecrets(const NetworkManager::Connection::Ptr &connection, const QString &setting, const SettingsCallback &callback)
+{
+    if (setting.isEmpty()) {
+        callback(NMVariantMapMap());
+        return;
+    }
+    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(connection->secrets(setting), this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [callback, setting](QDBusPendingCallWatcher *w) {
+        w->deleteLater();
+        QDBusPendingReply<NMVariantMapMap> reply = *w;
+        if (reply.isError()) {
+            qCWarning(DNC) << "get connection secrets failed:" << setting << reply.error().message();
+            callback(NMVariantMapMap());
+            return;
+        }
+        callback(reply.value());
+    });
+}
+
+void NetManagerThreadPrivate::invalidateConnectionSettings(const QString &path)
+{
+    auto it = m_connectionSettingsCache.find(path);
+    if (it == m_connectionSettingsCache.end())
+        return;
+
+    // 有请求在进行中时保留等待的回调,结果返回后再清理
+    if (!it->pending.isEmpty()) {
+        it->valid = false;
+        ++it->generation;
+        return;
+    }
+    disconnect(it->updatedWatcher);
+    disconnect(it->removedWatcher);
+    m_connectionSettingsCache.erase(it);
+}
+
 void NetManagerThreadPrivate::doSetConnectInfo(const QString &id, NetType::NetItemType type, const QVariantMap &param)
 {
     QString devPath = id;
@@ -2009,6 +2260,56 @@ void NetManagerThreadPrivate::sendRequest(NetManager::CmdType cmd, const QString
     Q_EMIT request(cmd, id, param);
 }
 
+void NetManagerThreadPrivate::postDataChanged(int dataType, const QString &id, const QVariant &value)
+{
+    if (m_dataChangedInterval <= 0 || QThread::currentThread() != thread()) {
+        flushDataChanged();
+        Q_EMIT dataChanged(dataType, id, value);
+        return;
+    }
+    postDataChanged(dataType, itemHandle(id), id, value);
+}
+
+void NetManagerThreadPrivate::postDataChanged(int dataType, quint32 handle, const QString &id, const QVariant &value)
+{
+    if (m_dataChangedInterval <= 0 || QThread::currentThread() != thread()) {
+        flushDataChanged();
+        Q_EMIT dataChanged(dataType, id, value);
+        return;
+    }
+    const QPair<int, quint32> key(dataType, handle);
+    auto it = m_pendingDataIndex.constFind(key);
+    if (it != m_pendingDataIndex.cend()) {
+        // 同一项同一类型的变化只保留最新值
+        m_pendingDataChanges[it.value()].value = value;
+        return;
+    }
+    m_pendingDataIndex.insert(key, m_pendingDataChanges.size());
+    m_pendingDataChanges.append({ dataType, handle, id, value });
+    m_dataChangedQueueDepth.storeRelaxed(m_pendingDataChanges.size());
+    if (!m_dataChangedTimer) {
+        m_dataChangedTimer = new QTimer(this);
+        m_dataChangedTimer->setSingleShot(true);
+        connect(m_dataChangedTimer, &QTimer::timeout, this, &NetManagerThreadPrivate::flushDataChanged);
+    }
+    if (!m_dataChangedTimer->isActive())
+        m_dataChangedTimer->start(m_dataChangedInterval);
+}
+
+void NetManagerThreadPrivate::flushDataChanged()
+{
+    if (m_pendingDataChanges.isEmpty())
+        return;
+    if (m_dataChangedTimer)
+        m_dataChangedTimer->stop();
+    NetDataChangeList changes;
+    changes.swap(m_pendingDataChanges);
+    m_pendingDataIndex.clear();
+    m_dataChangedQueueDepth.storeRelaxed(0);
+    qCDebug(DNC) << "Flush data changed, count:" << changes.size();
+    Q_EMIT dataChangedBatch(changes);
+}
+
 void NetManagerThreadPrivate::onDeviceAdded(QList<NetworkDeviceBase *> devices)
 {
     for (NetworkDeviceBase *device : devices) {
@@ -2055,10 +2356,24 @@ void NetManagerThreadPrivate::onDeviceRemoved(QList<NetworkDeviceBase *> devices
 {
     for (auto &device : devices) {
         Q_EMIT itemRemoved(device->path());
+        // 热点ID不含设备路径，需单独释放
+        if (WirelessDevice *wirelessDevice = qobject_cast<WirelessDevice *>(device)) {
+            for (AccessPoints *ap : wirelessDevice->accessPointItems()) {
+                releaseItemHandle(apID(ap));
+                removeApHandle(ap);
+            }
+        }
+        auto it = m_savedSsidCache.find(device->path());
+        if (it != m_savedSsidCache.end()) {
+            disconnect(it->watcher);
+            m_savedSsidCache.erase(it);
+        }
+        m_pendingAvailableDevices.remove(device->path());
+        m_connectedAps.remove(device->path());
     }
     getAirplaneModeEnabled();
     if (m_flags.testFlags(NetType::Net_Details)) {
-        updateDetails();
+        requestUpdateDetails();
     }
     updateDSLEnabledable();
     updateSupportWireless();
@@ -2067,7 +2382,7 @@ void NetManagerThreadPrivate::onDeviceRemoved(QList<NetworkDeviceBase *> devices
 void NetManagerThreadPrivate::onConnectivityChanged()
 {
     for (auto &&dev : NetworkController::instance()->devices())
-        Q_EMIT dataChanged(DataChanged::DeviceStatusChanged, dev->path(), QVariant::fromValue(deviceStatus(dev)));
+        postDataChanged(DataChanged::DeviceStatusChanged, dev->path(), QVariant::fromValue(deviceStatus(dev)));
 }
 
 void NetManagerThreadPrivate::updateDSLEnabledable()
@@ -2077,11 +2392,11 @@ void NetManagerThreadPrivate::updateDSLEnabledable()
     }
     for (auto &&dev : NetworkController::instance()->devices()) {
         if (dev->deviceType() == DeviceType::Wired) {
-            Q_EMIT dataChanged(DataChanged::DeviceAvailableChanged, "NetDSLControlItem", QVariant::fromValue(true));
+            postDataChanged(DataChanged::DeviceAvailableChanged, "NetDSLControlItem", QVariant::fromValue(true));
             return;
         }
     }
-    Q_EMIT dataChanged(DataChanged::DeviceAvailableChanged, "NetDSLControlItem", QVariant::fromValue(false));
+    postDataChanged(DataChanged::DeviceAvailableChanged, "NetDSLControlItem", QVariant::fromValue(false));
 }
 
 void NetManagerThreadPrivate::onConnectionAdded(const QList<WiredConnection *> &conns)
@@ -2135,7 +2450,7 @@ void NetManagerThreadPrivate::onConnectionChanged()
             }
         }
 
-        Q_EMIT dataChanged(DataChanged::NameChanged, devPath + ":" + conn->connection()->path(), conn->connection()->id());
+        postDataChanged(DataChanged::NameChanged, devPath + ":" + conn->connection()->path(), conn->connection()->id());
     }
 }
 
@@ -2145,45 +2460,125 @@ void NetManagerThreadPrivate::onNetworkAdded(const QList<AccessPoints *> &aps)
     if (!dev)
         return;
     addNetwork(dev, aps);
+    if (m_scanScheduler)
+        m_scanScheduler->networkAdded();
 }
 
 void NetManagerThreadPrivate::onNetworkRemoved(const QList<AccessPoints *> &aps)
 {
     for (auto &ap : aps) {
+        if (m_scanScheduler)
+            m_scanScheduler->networkRemoved(apID(ap));
         Q_EMIT itemRemoved(apID(ap));
+        auto connected = m_connectedAps.find(ap->devicePath());
+        if (connected != m_connectedAps.end())
+            connected->remove(apID(ap));
+        removeApHandle(ap);
     }
 }
 
 void NetManagerThreadPrivate::addNetwork(const NetworkDeviceBase *device, QList<AccessPoints *> aps)
 {
-    QString path = device->path();
-    NetworkManager::Device::Ptr dev = NetworkManager::findNetworkInterface(path);
-    if (dev.isNull()) {
-        dev.reset(new NetworkManager::Device(path));
-    }
-    NetworkManager::Connection::List connections = dev->availableConnections();
-
+    const QSet<QByteArray> &ssids = savedSsids(device->path());
+    NetWirelessRecordList records;
     for (auto &ap : aps) {
-        NetWirelessItemPrivate *item = NetItemNew(WirelessItem, apID(ap)); // ap->path());
-        item->updatename(ap->ssid());
-        item->updateflags(static_cast<uint>(ap->type()));
-        item->updatestrength(ap->strength());
-        item->updatesecure(ap->secured());
-        item->updatestatus(toNetConnectionStatus(ap->status()));
-        item->item()->moveToThread(m_parentThread);
+        if (ssids.contains(ap->ssid().toUtf8())) {
+            NetWirelessItemPrivate *item = NetItemNew(WirelessItem, apID(ap)); // ap->path());
+            item->updatename(ap->ssid());
+            item->updateflags(static_cast<uint>(ap->type()));
+            item->updatestrength(ap->strength());
+            item->updatesecure(ap->secured());
+            item->updatestatus(toNetConnectionStatus(ap->status()));
+            item->item()->moveToThread(m_parentThread);
 
-        NetworkManager::Connection::List::iterator itConnection = std::find_if(connections.begin(), connections.end(), [ap](NetworkManager::Connection::Ptr connection) {
-            NetworkManager::WirelessSetting::Ptr wirelessSetting = connection->settings()->setting(NetworkManager::Setting::SettingType::Wireless).dynamicCast<NetworkManager::WirelessSetting>();
-            if (wirelessSetting.isNull())
-                return false;
-            return wirelessSetting->ssid() == ap->ssid() && !connection->isUnsaved();
-        });
-        item->updatehasConnection(itConnection != connections.end());
-        Q_EMIT itemAdded(device->path(), item);
+            item->updatehasConnection(true);
+            m_connectedAps[device->path()].insert(apID(ap));
+            Q_EMIT itemAdded(device->path(), item);
+        } else {
+            // 没有配置的网络在其他网络中，只发送精简数据，由主线程在显示时创建数据项
+            records.append({ apID(ap), ap->ssid(), static_cast<uint>(ap->type()), ap->strength(), ap->secured(), toNetConnectionStatus(ap->status()) });
+        }
         connect(ap, &AccessPoints::strengthChanged, this, &NetManagerThreadPrivate::onStrengthChanged);
         connect(ap, &AccessPoints::connectionStatusChanged, this, &NetManagerThreadPrivate::onAPStatusChanged);
         connect(ap, &AccessPoints::securedChanged, this, &NetManagerThreadPrivate::onAPSecureChanged);
     }
+    if (!records.isEmpty())
+        Q_EMIT wirelessRecordsAdded(device->path(), records);
+}
+
+quint32 NetManagerThreadPrivate::itemHandle(const QString &id)
+{
+    // 句柄只增不减，不会重复分配，主线程缓存的旧句柄不会指向新的数据项
+    auto it = m_itemHandles.constFind(id);
+    if (it != m_itemHandles.constEnd())
+        return it.value();
+    return m_itemHandles.insert(id, ++m_lastItemHandle).value();
+}
+
+const QPair<quint32, QString> &NetManagerThreadPrivate::apHandle(AccessPoints *ap)
+{
+    auto it = m_apHandles.constFind(ap);
+    if (it != m_apHandles.constEnd())
+        return it.value();
+    const QString id = apID(ap);
+    return m_apHandles.insert(ap, { itemHandle(id), id }).value();
+}
+
+void NetManagerThreadPrivate::removeApHandle(AccessPoints *ap)
+{
+    // 句柄在热点项移除时已释放
+    m_apHandles.remove(ap);
+}
+
+void NetManagerThreadPrivate::releaseItemHandle(const QString &id)
+{
+    m_itemHandles.remove(id);
+    // 子项ID为"父项ID:子项"(如有线连接)，随父项一起移除
+    const QString childPrefix = id + ":";
+    for (auto it = m_itemHandles.begin(); it != m_itemHandles.end();) {
+        if (it.key().startsWith(childPrefix)) {
+            it = m_itemHandles.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+const QSet<QByteArray> &NetManagerThreadPrivate::savedSsids(const QString &devPath)
+{
+    SavedSsidCache &cache = m_savedSsidCache[devPath];
+    if (cache.valid)
+        return cache.ssids;
+
+    NetworkManager::Device::Ptr device = NetworkManager::findNetworkInterface(devPath);
+    bool canWatch = !device.isNull();
+    if (device.isNull()) {
+        device.reset(new NetworkManager::Device(devPath));
+    }
+    cache.ssids.clear();
+    for (const NetworkManager::Connection::Ptr &connection : device->availableConnections()) {
+        if (connection->isUnsaved())
+            continue;
+        NetworkManager::WirelessSetting::Ptr wirelessSetting = connection->settings()->setting(NetworkManager::Setting::SettingType::Wireless).dynamicCast<NetworkManager::WirelessSetting>();
+        if (wirelessSetting.isNull())
+            continue;
+        cache.ssids.insert(wirelessSetting->ssid());
+    }
+    // 临时创建的设备对象不会收到信号，只监听NetworkManagerQt缓存的设备对象
+    if (canWatch && !cache.watcher) {
+        cache.watcher = connect(device.data(), &NetworkManager::Device::availableConnectionChanged, this, [this, devPath] {
+            invalidateSavedSsids(devPath);
+        });
+    }
+    cache.valid = true;
+    return cache.ssids;
+}
+
+void NetManagerThreadPrivate::invalidateSavedSsids(const QString &devPath)
+{
+    auto it = m_savedSsidCache.find(devPath);
+    if (it != m_savedSsidCache.end())
+        it->valid = false;
 }
 
 void NetManagerThreadPrivate::onNameChanged(const QString &name)
@@ -2191,7 +2586,7 @@ void NetManagerThreadPrivate::onNameChanged(const QString &name)
     NetworkDeviceBase *dev = qobject_cast<NetworkDeviceBase *>(sender());
     if (!dev)
         return;
-    Q_EMIT dataChanged(DataChanged::NameChanged, dev->path(), name);
+    postDataChanged(DataChanged::NameChanged, dev->path(), name);
 }
 
 void NetManagerThreadPrivate::onDevEnabledChanged(const bool enabled)
@@ -2199,8 +2594,8 @@ void NetManagerThreadPrivate::onDevEnabledChanged(const bool enabled)
     NetworkDeviceBase *dev = qobject_cast<NetworkDeviceBase *>(sender());
     if (!dev)
         return;
-    Q_EMIT dataChanged(DataChanged::EnabledChanged, dev->path(), dev->available() && enabled);
-    Q_EMIT dataChanged(DataChanged::DeviceAvailableChanged, dev->path(), dev->available());
+    postDataChanged(DataChanged::EnabledChanged, dev->path(), dev->available() && enabled);
+    postDataChanged(DataChanged::DeviceAvailableChanged, dev->path(), dev->available());
 }
 
 void NetManagerThreadPrivate::onDevAvailableChanged(const bool available)
@@ -2208,8 +2603,8 @@ void NetManagerThreadPrivate::onDevAvailableChanged(const bool available)
     NetworkDeviceBase *dev = qobject_cast<NetworkDeviceBase *>(sender());
     if (!dev)
         return;
-    Q_EMIT dataChanged(DataChanged::EnabledChanged, dev->path(), available && dev->isEnabled());
-    Q_EMIT dataChanged(DataChanged::DeviceAvailableChanged, dev->path(), available);
+    postDataChanged(DataChanged::EnabledChanged, dev->path(), available && dev->isEnabled());
+    postDataChanged(DataChanged::DeviceAvailableChanged, dev->path(), available);
 }
 
 void NetManagerThreadPrivate::onActiveConnectionChanged()
@@ -2224,7 +2619,7 @@ void NetManagerThreadPrivate::onActiveConnectionChanged()
         if (!wiredDev)
             return;
         for (auto &&conn : wiredDev->items()) {
-            Q_EMIT dataChanged(DataChanged::ConnectionStatusChanged, wiredDev->path() + ":" + conn->connection()->path(), QVariant::fromValue(toNetConnectionStatus(conn->status())));
+            postDataChanged(DataChanged::ConnectionStatusChanged, wiredDev->path() + ":" + conn->connection()->path(), QVariant::fromValue(toNetConnectionStatus(conn->status())));
         }
     } break;
     case DeviceType::Wireless:
@@ -2234,7 +2629,7 @@ void NetManagerThreadPrivate::onActiveConnectionChanged()
         break;
     }
     if (m_flags.testFlags(NetType::Net_Details)) {
-        updateDetails();
+        requestUpdateDetails();
     }
 }
 
@@ -2243,9 +2638,9 @@ void NetManagerThreadPrivate::onIpV4Changed()
     NetworkDeviceBase *dev = qobject_cast<NetworkDeviceBase *>(sender());
     if (!dev)
         return;
-    Q_EMIT dataChanged(DataChanged::IPChanged, dev->path(), QVariant::fromValue(dev->ipv4()));
+    postDataChanged(DataChanged::IPChanged, dev->path(), QVariant::fromValue(dev->ipv4()));
     if (m_flags.testFlags(NetType::Net_Details)) {
-        updateDetails();
+        requestUpdateDetails();
     }
 }
 
@@ -2254,9 +2649,9 @@ void NetManagerThreadPrivate::onDeviceStatusChanged()
     NetworkDeviceBase *dev = qobject_cast<NetworkDeviceBase *>(sender());
     if (!dev)
         return;
-    Q_EMIT dataChanged(DataChanged::DeviceStatusChanged, dev->path(), QVariant::fromValue(deviceStatus(dev)));
+    postDataChanged(DataChanged::DeviceStatusChanged, dev->path(), QVariant::fromValue(deviceStatus(dev)));
     if (m_flags.testFlags(NetType::Net_Details)) {
-        updateDetails();
+        requestUpdateDetails();
     }
 }
 
@@ -2265,7 +2660,7 @@ void NetManagerThreadPrivate::onHotspotEnabledChanged()
     WirelessDevice *dev = qobject_cast<WirelessDevice *>(sender());
     if (!dev)
         return;
-    Q_EMIT dataChanged(DataChanged::HotspotEnabledChanged, dev->path(), dev->hotspotEnabled());
+    postDataChanged(DataChanged::HotspotEnabledChanged, dev->path(), dev->hotspotEnabled());
 }
 
 void NetManagerThreadPrivate::onAvailableConnectionsChanged()
@@ -2273,31 +2668,57 @@ void NetManagerThreadPrivate::onAvailableConnectionsChanged()
     QPointer<WirelessDevice> dev = qobject_cast<WirelessDevice *>(sender());
     if (!dev)
         return;
-    // 因为在实际情况中，ConnectionsChanged信号和ActiveConnectionsChanged信号发出的前后顺序
-    // 可能会乱，先收到AvailableConnectionsChanged，后又收到WirelessStatusChanged，导致本该移除的item又加回来了
-    // TODO: 临时方案，暂时没有更好的方案
-    QTimer::singleShot(200, this, [=] {
+    // 连接增删、配置修改以及保存状态变化都会走到这里，先让SSID索引失效
+    invalidateSavedSsids(dev->path());
+    // 连接变化通常成批到来，且ConnectionsChanged和ActiveConnectionsChanged的顺序可能会乱，
+    // 先收到AvailableConnectionsChanged，后又收到WirelessStatusChanged，导致本该移除的item又加回来了
+    // 所以延迟对账，期间的变化合并为一次，热点状态变化时再推迟
+    if (m_pendingAvailableDevices.isEmpty())
+        m_availableConnectionsElapsed.start();
+    m_pendingAvailableDevices.insert(dev->path(), dev);
+    if (!m_availableConnectionsTimer) {
+        m_availableConnectionsTimer = new QTimer(this);
+        m_availableConnectionsTimer->setSingleShot(true);
+        connect(m_availableConnectionsTimer, &QTimer::timeout, this, &NetManagerThreadPrivate::reconcileAvailableConnections);
+    }
+    // 持续有变化时最多推迟1秒
+    if (!m_availableConnectionsTimer->isActive() || m_availableConnectionsElapsed.elapsed() < 1000)
+        m_availableConnectionsTimer->start(200);
+}
+
+void NetManagerThreadPrivate::reconcileAvailableConnections()
+{
+    QMap<QString, QPointer<WirelessDevice>> devices;
+    devices.swap(m_pendingAvailableDevices);
+    for (auto it = devices.cbegin(); it != devices.cend(); ++it) {
+        WirelessDevice *dev = it.value();
         if (!dev)
-            return;
-        QList<QString> availableAccessPoints;
-        NetworkManager::Device::Ptr device = NetworkManager::findNetworkInterface(dev->path());
-        if (device.isNull()) {
-            device.reset(new NetworkManager::Device(dev->path()));
-        }
-        NetworkManager::Connection::List connections = device->availableConnections();
-        for (auto &&tmpAp : dev->accessPointItems()) {
-            NetworkManager::Connection::List::iterator itConnection = std::find_if(connections.begin(), connections.end(), [tmpAp](NetworkManager::Connection::Ptr connection) {
-                NetworkManager::WirelessSetting::Ptr wirelessSetting = connection->settings()->setting(NetworkManager::Setting::SettingType::Wireless).dynamicCast<NetworkManager::WirelessSetting>();
-                if (wirelessSetting.isNull())
-                    return false;
-                return wirelessSetting->ssid() == tmpAp->ssid() && !connection->isUnsaved();
-            });
-            if (itConnection != connections.end()) {
-                availableAccessPoints.append(apID(tmpAp));
+            continue;
+        // 只发送有无配置发生变化的热点:connected为新增配置的，disconnected为失去配置的
+        const QSet<QByteArray> &ssids = savedSsids(it.key());
+        QSet<QString> &connectedAps = m_connectedAps[it.key()];
+        QStringList connected;
+        QStringList disconnected;
+        for (auto &&ap : dev->accessPointItems()) {
+            const QString id = apID(ap);
+            const bool hasConnection = ssids.contains(ap->ssid().toUtf8());
+            if (hasConnection == connectedAps.contains(id))
+                continue;
+            if (hasConnection) {
+                connectedAps.insert(id);
+                connected.append(id);
+            } else {
+                connectedAps.remove(id);
+                disconnected.append(id);
             }
         }
-        Q_EMIT dataChanged(DataChanged::AvailableConnectionsChanged, dev->path(), QVariant(availableAccessPoints));
-    });
+        if (connected.isEmpty() && disconnected.isEmpty())
+            continue;
+        qCDebug(DNC) << "Available connections changed, device:" << it.key() << ", connected:" << connected.size() << ", disconnected:" << disconnected.size();
+        // 增量数据不能与之前的值合并，先发送缓存的变化再直接发送
+        flushDataChanged();
+        Q_EMIT dataChanged(DataChanged::AvailableConnectionsChanged, it.key(), QVariantMap{ { "connected", connected }, { "disconnected", disconnected } });
+    }
 }
 
 void NetManagerThreadPrivate::onStrengthChanged(int strength)
@@ -2305,7 +2726,10 @@ void NetManagerThreadPrivate::onStrengthChanged(int strength)
     AccessPoints *ap = qobject_cast<AccessPoints *>(sender());
     if (!ap)
         return;
-    Q_EMIT dataChanged(DataChanged::StrengthChanged, apID(ap), strength);
+    const QPair<quint32, QString> &handle = apHandle(ap);
+    postDataChanged(DataChanged::StrengthChanged, handle.first, handle.second, strength);
+    if (m_scanScheduler)
+        m_scanScheduler->strengthChanged(handle.second, strength);
 }
 
 void NetManagerThreadPrivate::onAPStatusChanged(ConnectionStatus status)
@@ -2313,7 +2737,12 @@ void NetManagerThreadPrivate::onAPStatusChanged(ConnectionStatus status)
     AccessPoints *ap = qobject_cast<AccessPoints *>(sender());
     if (!ap)
         return;
-    Q_EMIT dataChanged(DataChanged::WirelessStatusChanged, apID(ap), QVariant::fromValue(toNetConnectionStatus(status)));
+    const QPair<quint32, QString> &handle = apHandle(ap);
+    postDataChanged(DataChanged::WirelessStatusChanged, handle.first, handle.second, QVariant::fromValue(toNetConnectionStatus(status)));
+    // 该设备有待处理的对账时推迟，保证对账在状态变化之后
+    if (m_availableConnectionsTimer && m_availableConnectionsTimer->isActive() && m_pendingAvailableDevices.contains(ap->devicePath())
+        && m_availableConnectionsElapsed.elapsed() < 1000)
+        m_availableConnectionsTimer->start(200);
 }
 
 void NetManagerThreadPrivate::onAPSecureChanged(bool secure)
@@ -2321,7 +2750,8 @@ void NetManagerThreadPrivate::onAPSecureChanged(bool secure)
     AccessPoints *ap = qobject_cast<AccessPoints *>(sender());
     if (!ap)
         return;
-    Q_EMIT dataChanged(DataChanged::SecuredChanged, apID(ap), secure);
+    const QPair<quint32, QString> &handle = apHandle(ap);
+    postDataChanged(DataChanged::SecuredChanged, handle.first, handle.second, secure);
 
     handleAccessPointSecure(ap);
 }
@@ -2348,7 +2778,7 @@ void NetManagerThreadPrivate::onVPNRemoved(const QList<VPNItem *> &vpns)
 
 void NetManagerThreadPrivate::onVPNEnableChanged(const bool enable)
 {
-    Q_EMIT dataChanged(DataChanged::EnabledChanged, "NetVPNControlItem", enable);
+    postDataChanged(DataChanged::EnabledChanged, "NetVPNControlItem", enable);
 }
 
 void NetManagerThreadPrivate::onVpnActiveConnectionChanged()
@@ -2358,10 +2788,10 @@ void NetManagerThreadPrivate::onVpnActiveConnectionChanged()
         return;
     }
     for (auto &&conn : vpnController->items()) {
-        Q_EMIT dataChanged(DataChanged::ConnectionStatusChanged, conn->connection()->path(), QVariant::fromValue(toNetConnectionStatus(conn->status())));
+        postDataChanged(DataChanged::ConnectionStatusChanged, conn->connection()->path(), QVariant::fromValue(toNetConnectionStatus(conn->status())));
     }
     if (m_flags.testFlags(NetType::Net_Details)) {
-        updateDetails();
+        requestUpdateDetails();
     }
 }
 
@@ -2371,28 +2801,28 @@ void NetManagerThreadPrivate::onVPNConnectionChanged()
     if (!vpnItem) {
         return;
     }
-    Q_EMIT dataChanged(DataChanged::NameChanged, vpnItem->connection()->path(), QVariant::fromValue(vpnItem->connection()->id()));
+    postDataChanged(DataChanged::NameChanged, vpnItem->connection()->path(), QVariant::fromValue(vpnItem->connection()->id()));
 }
 
 void NetManagerThreadPrivate::onSystemProxyExistChanged(bool exist)
 {
-    Q_EMIT dataChanged(DataChanged::DeviceAvailableChanged, "NetSystemProxyControlItem", exist);
+    postDataChanged(DataChanged::DeviceAvailableChanged, "NetSystemProxyControlItem", exist);
 }
 
 void NetManagerThreadPrivate::onLastProxyMethodChanged(const ProxyMethod &method)
 {
-    Q_EMIT dataChanged(DataChanged::ProxyLastMethodChanged, "NetSystemProxyControlItem", QVariant::fromValue(NetType::ProxyMethod(method)));
+    postDataChanged(DataChanged::ProxyLastMethodChanged, "NetSystemProxyControlItem", QVariant::fromValue(NetType::ProxyMethod(method)));
 }
 
 void NetManagerThreadPrivate::onSystemProxyMethodChanged(const ProxyMethod &method)
 {
-    Q_EMIT dataChanged(DataChanged::EnabledChanged, "NetSystemProxyControlItem", (method == ProxyMethod::Auto || method == ProxyMethod::Manual));
-    Q_EMIT dataChanged(DataChanged::ProxyMethodChanged, "NetSystemProxyControlItem", QVariant::fromValue(NetType::ProxyMethod(method)));
+    postDataChanged(DataChanged::EnabledChanged, "NetSystemProxyControlItem", (method == ProxyMethod::Auto || method == ProxyMethod::Manual));
+    postDataChanged(DataChanged::ProxyMethodChanged, "NetSystemProxyControlItem", QVariant::fromValue(NetType::ProxyMethod(method)));
 }
 
 void NetManagerThreadPrivate::onSystemAutoProxyChanged(const QString &url)
 {
-    Q_EMIT dataChanged(DataChanged::SystemAutoProxyChanged, "NetSystemProxyControlItem", url);
+    postDataChanged(DataChanged::SystemAutoProxyChanged, "NetSystemProxyControlItem", url);
 }
 
 void NetManagerThreadPrivate::onSystemManualProxyChanged()
@@ -2413,12 +2843,12 @@ void NetManagerThreadPrivate::onSystemManualProxyChanged()
     }
     config.insert("ignoreHosts", controller->proxyIgnoreHosts());
 
-    Q_EMIT dataChanged(DataChanged::SystemManualProxyChanged, "NetSystemProxyControlItem", config);
+    postDataChanged(DataChanged::SystemManualProxyChanged, "NetSystemProxyControlItem", config);
 }
 
 void NetManagerThreadPrivate::onAppProxyEnableChanged(bool enabled)
 {
-    Q_EMIT dataChanged(DataChanged::EnabledChanged, "NetAppProxyControlItem", enabled);
+    postDataChanged(DataChanged::EnabledChanged, "NetAppProxyControlItem", enabled);
 }
 
 void NetManagerThreadPrivate::onAppProxyChanged()
@@ -2433,42 +2863,42 @@ void NetManagerThreadPrivate::onAppProxyChanged()
     config.insert("auth", true);
     config.insert("user", proxy.username);
     config.insert("password", proxy.password);
-    Q_EMIT dataChanged(DataChanged::AppProxyChanged, "NetAppProxyControlItem", config);
+    postDataChanged(DataChanged::AppProxyChanged, "NetAppProxyControlItem", config);
 }
 
 void NetManagerThreadPrivate::updateHotspotEnabledChanged(const bool enabled)
 {
-    Q_EMIT dataChanged(DataChanged::EnabledChanged, "NetHotspotControlItem", enabled);
+    postDataChanged(DataChanged::EnabledChanged, "NetHotspotControlItem", enabled);
 }
 
 void NetManagerThreadPrivate::onHotspotEnabledableChanged(const bool enabledable)
 {
-    Q_EMIT dataChanged(DataChanged::DeviceAvailableChanged, "NetHotspotControlItem", enabledable);
+    postDataChanged(DataChanged::DeviceAvailableChanged, "NetHotspotControlItem", enabledable);
 }
 
 void NetManagerThreadPrivate::onHotspotDeviceEnabledChanged(const bool deviceEnabled)
 {
-    Q_EMIT dataChanged(DataChanged::DeviceEnabledChanged, "NetHotspotControlItem", deviceEnabled);
+    postDataChanged(DataChanged::DeviceEnabledChanged, "NetHotspotControlItem", deviceEnabled);
 }
 
 void NetManagerThreadPrivate::onHotspotConfigChanged(const QVariantMap &config)
 {
-    Q_EMIT dataChanged(DataChanged::HotspotConfigChanged, "NetHotspotControlItem", config);
+    postDataChanged(DataChanged::HotspotConfigChanged, "NetHotspotControlItem", config);
 }
 
 void NetManagerThreadPrivate::onHotspotOptionalDeviceChanged(const QStringList &optionalDevice)
 {
-    Q_EMIT dataChanged(DataChanged::HotspotOptionalDeviceChanged, "NetHotspotControlItem", optionalDevice);
+    postDataChanged(DataChanged::HotspotOptionalDeviceChanged, "NetHotspotControlItem", optionalDevice);
 }
 
 void NetManagerThreadPrivate::onHotspotOptionalDevicePathChanged(const QStringList &optionalDevicePath)
 {
-    Q_EMIT dataChanged(DataChanged::HotspotOptionalDevicePathChanged, "NetHotspotControlItem", optionalDevicePath);
+    postDataChanged(DataChanged::HotspotOptionalDevicePathChanged, "NetHotspotControlItem", optionalDevicePath);
 }
 
 void NetManagerThreadPrivate::onHotspotShareDeviceChanged(const QStringList &shareDevice)
 {
-    Q_EMIT dataChanged(DataChanged::HotspotShareDeviceChanged, "NetHotspotControlItem", shareDevice);
+    postDataChanged(DataChanged::HotspotShareDeviceChanged, "NetHotspotControlItem", shareDevice);
 }
 
 void NetManagerThreadPrivate::onDSLAdded(const QList<DSLItem *> &dsls)
@@ -2496,15 +2926,17 @@ void NetManagerThreadPrivate::onDslActiveConnectionChanged()
         return;
     }
     for (auto &&conn : controller->items()) {
-        Q_EMIT dataChanged(DataChanged::ConnectionStatusChanged, conn->connection()->path(), QVariant::fromValue(toNetConnectionStatus(conn->status())));
+        postDataChanged(DataChanged::ConnectionStatusChanged, conn->connection()->path(), QVariant::fromValue(toNetConnectionStatus(conn->status())));
     }
     if (m_flags.testFlags(NetType::Net_Details)) {
-        updateDetails();
+        requestUpdateDetails();
     }
 }
 
 void NetManagerThreadPrivate::updateDetails()
 {
+    if (m_detailsTimer)
+        m_detailsTimer->stop();
     // 使用对象指针作为键，而不是 name()
     QSet<NetworkDetails *> currentDetails;
     for (auto &&details : NetworkController::instance()->networkDetails()) {
@@ -2523,8 +2955,7 @@ void NetManagerThreadPrivate::updateDetails()
 
     // 删除不再存在的项
     for (auto *details : toRemove) {
-        QString itemId = m_detailsItemsMap.value(details);
-        m_detailsItemsMap.remove(details);
+        QString itemId = m_detailsItemsMap.take(details).id;
         Q_EMIT itemRemoved(itemId);
     }
 
@@ -2534,15 +2965,15 @@ void NetManagerThreadPrivate::updateDetails()
         if (!details) // 空指针检查
             continue;
 
-        // 生成唯一ID：使用对象指针地址
-        QString uniqueId = QString("detail_%1").arg(reinterpret_cast<quintptr>(details));
+        auto it = m_detailsItemsMap.find(details);
+        if (it == m_detailsItemsMap.end()) {
+            // 新项，创建 NetDetailsInfoItem，生成唯一ID：使用对象指针地址
+            DetailsItemState state;
+            state.id = QString("detail_%1").arg(reinterpret_cast<quintptr>(details));
+            it = m_detailsItemsMap.insert(details, state);
+            connect(details, &NetworkDetails::infoChanged, this, &NetManagerThreadPrivate::requestUpdateDetails, Qt::QueuedConnection);
 
-        if (!m_detailsItemsMap.contains(details)) {
-            // 新项，创建 NetDetailsInfoItem
-            m_detailsItemsMap.insert(details, uniqueId);
-            connect(details, &NetworkDetails::infoChanged, this, &NetManagerThreadPrivate::updateDetails, Qt::QueuedConnection);
-
-            NetDetailsInfoItemPrivate *item = NetItemNew(DetailsInfoItem, uniqueId);
+            NetDetailsInfoItemPrivate *item = NetItemNew(DetailsInfoItem, state.id);
             item->updatename(details->name());
             item->updateindex(index);
             item->item()->moveToThread(m_parentThread);
@@ -2550,36 +2981,44 @@ void NetManagerThreadPrivate::updateDetails()
             Q_EMIT itemAdded("Details", item);
         }
 
-        // 更新数据
+        // 只发送发生变化的数据，未变化的详情不再重复发送
         QList<QStringList> data;
         for (auto &&info : details->items()) {
             data.append({ info.first, info.second });
         }
-        Q_EMIT dataChanged(DataChanged::DetailsChanged, uniqueId, QVariant::fromValue(data));
-        Q_EMIT dataChanged(DataChanged::IndexChanged, uniqueId, QVariant::fromValue(index));
+        if (it->data != data) {
+            it->data = data;
+            postDataChanged(DataChanged::DetailsChanged, it->id, QVariant::fromValue(data));
+        }
+        if (it->index != index) {
+            it->index = index;
+            postDataChanged(DataChanged::IndexChanged, it->id, QVariant::fromValue(index));
+        }
         ++index;
     }
 }
 
+void NetManagerThreadPrivate::requestUpdateDetails()
+{
+    if (!m_detailsTimer) {
+        // 设备状态、IP和活动连接的变化一般同时到来，合并后只刷新一次
+        m_detailsTimer = new QTimer(this);
+        m_detailsTimer->setSingleShot(true);
+        m_detailsTimer->setInterval(100);
+        connect(m_detailsTimer, &QTimer::timeout, this, &NetManagerThreadPrivate::updateDetails);
+    }
+    if (!m_detailsTimer->isActive())
+        m_detailsTimer->start();
+}
+
 void NetManagerThreadPrivate::updateAutoScan()
 {
-    if (m_autoScanInterval == 0) {
-        if (m_autoScanTimer) {
-            m_autoScanTimer->stop();
-            delete m_autoScanTimer;
-            m_autoScanTimer = nullptr;
-        }
-    } else {
-        if (!m_autoScanTimer) {
-            m_autoScanTimer = new QTimer(this);
-            connect(m_autoScanTimer, &QTimer::timeout, this, &NetManagerThreadPrivate::doAutoScan);
-        }
-        if (m_autoScanEnabled) {
-            m_autoScanTimer->start(m_autoScanInterval);
-        } else if (m_autoScanTimer->isActive()) {
-            m_autoScanTimer->stop();
-        }
+    if (!m_scanScheduler) {
+        m_scanScheduler = new NetScanScheduler(this);
+        connect(m_scanScheduler, &NetScanScheduler::scanRequested, this, &NetManagerThreadPrivate::doAutoScan);
     }
+    m_scanScheduler->setBaseInterval(m_autoScanInterval);
+    m_scanScheduler->setActive(m_autoScanEnabled);
 }
 
 void NetManagerThreadPrivate::doAutoScan()
@@ -2591,6 +3030,9 @@ void NetManagerThreadPrivate::doAutoScan()
     QList<NetworkDeviceBase *> devices = NetworkController::instance()->devices();
     for (NetworkDeviceBase *device : devices) {
         if (device->deviceType() == DeviceType::Wireless) {
+            // 其他进程刚扫描过的设备直接使用其扫描结果
+            if (m_scanScheduler && !m_scanScheduler->needScan(device->path()))
+                continue;
             auto *wirelessDevice = dynamic_cast<WirelessDevice *>(device);
             wirelessDevice->scanNetwork();
         }
@@ -3047,7 +3489,7 @@ void NetManagerThreadPrivate::onPortalDetected(const QString &portalUrl)
 
         // 找到有线连接对应的连接
         dde::network::WiredDevice *wiredDevice = static_cast<dde::network::WiredDevice *>(networkDevice);
-        Q_EMIT dataChanged(DataChanged::portalUrlChanged, QString("%1:%2").arg(wiredDevice->path()).arg(primaryConnection->path()), portalUrl);
+        postDataChanged(DataChanged::portalUrlChanged, QString("%1:%2").arg(wiredDevice->path()).arg(primaryConnection->path()), portalUrl);
     } else if (networkDevice->deviceType() == dde::network::DeviceType::Wireless) {
         // 找到无线设备对应的那个无线网络
         NetworkManager::WirelessSetting::Ptr wirelessSetting = primaryConnection->settings()->setting(NetworkManager::Setting::Wireless).dynamicCast<NetworkManager::WirelessSetting>();
@@ -3060,7 +3502,7 @@ void NetManagerThreadPrivate::onPortalDetected(const QString &portalUrl)
             if (ap->ssid() != wirelessSetting->ssid())
                 continue;
 
-            Q_EMIT dataChanged(DataChanged::portalUrlChanged, apID(ap), portalUrl);
+            postDataChanged(DataChanged::portalUrlChanged, apID(ap), portalUrl);
             break;
         }
     }
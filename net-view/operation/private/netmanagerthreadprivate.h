@@ -6,12 +6,23 @@
 
 #include "netitem.h"
 #include "netmanager.h"
+#include "netwirelessrecords.h"
 
+#include <NetworkManagerQt/Connection>
 #include <NetworkManagerQt/Device>
+#include <NetworkManagerQt/GenericTypes>
 #include <NetworkManagerQt/WirelessSecuritySetting>
 
+#include <QAtomicInt>
+#include <QElapsedTimer>
+#include <QHash>
 #include <QMap>
 #include <QObject>
+#include <QPointer>
+#include <QSet>
+#include <QVector>
+
+#include <functional>
 
 class QTimer;
 
@@ -29,6 +40,8 @@ class DSLItem;
 class NetDeviceItemPrivate;
 class NetSecretAgentInterface;
 class NetworkDetails;
+class NetScanScheduler;
+class NetSharedBackendClient;
 enum class NetConnectionStatus;
 enum class NetworkNotifyType;
 enum class ProxyMethod;
@@ -40,6 +53,17 @@ class AccessPoints;
 enum class ConnectionStatus;
 enum class ServiceLoadType;
 
+// 合并后的数据变化，同一(dataType, id)只保留最新的值
+// handle由子线程分配，同一NetManager内同一ID的句柄不变，主线程用它缓存查找结果
+struct NetDataChange
+{
+    int dataType;
+    quint32 handle;
+    QString id;
+    QVariant value;
+};
+typedef QVector<NetDataChange> NetDataChangeList;
+
 // 与NM交互,子线程内
 class NetManagerThreadPrivate : public QObject
 {
@@ -58,9 +82,13 @@ public:
     void setEnabled(bool enabled);
     void setAutoScanInterval(int ms);
     void setAutoScanEnabled(bool enabled);
+    void setDataChangedInterval(int ms);
+    int dataChangedQueueDepth() const;
     void setServerKey(const QString &serverKey);
+    void setSharedClient(NetSharedBackendClient *client); // 共享后端模式下，操作转发给维护数据的进程
 
     void init(NetType::NetManagerFlags flags);
+    void addFlags(NetType::NetManagerFlags flags); // 共享后端时按订阅进程的标记增加数据项，已创建的不再移除
     NetType::NetManagerFlags flags() const;
 
     QString wpaEapAuthen() const;     // 企业网EAP认证方式
@@ -101,9 +129,11 @@ Q_SIGNALS:
     void requestInputPassword(const QString &dev, const QString &id, const QVariantMap &param);
 
     void itemAdded(const QString &parentID, NetItemPrivate *item);
+    void wirelessRecordsAdded(const QString &devPath, const NetWirelessRecordList &records); // 其他网络中的无线网络
     void itemRemoved(const QString &id);
 
     void dataChanged(int dataType, const QString &id, const QVariant &value);
+    void dataChangedBatch(const NetDataChangeList &changes);
     // clang-format off
     void networkNotify(const QString &inAppName, int replacesId, const QString &appIcon, const QString &summary, const QString &body, const QStringList &actions, const QVariantMap &hints, int expireTimeout);
     // clang-format on
@@ -139,6 +169,7 @@ public Q_SLOTS:
 
 protected Q_SLOTS:
     void doInit();
+    void doAddFlags(NetType::NetManagerFlags flags);
     void clearData();
     //  执行操作
     void doSetDeviceEnabled(const QString &id, bool enabled);
@@ -160,6 +191,11 @@ protected Q_SLOTS:
     void doConnectOrInfo(const QString &id, NetType::NetItemType type, const QVariantMap &param);
     void doGetConnectInfo(const QString &id, NetType::NetItemType type, const QVariantMap &param);
     void doSetConnectInfo(const QString &id, NetType::NetItemType type, const QVariantMap &param);
+    // 异步获取连接配置,回调在本线程执行,不阻塞其他命令和数据更新
+    using SettingsCallback = std::function<void(const NMVariantMapMap &)>;
+    void requestConnectionSettings(const NetworkManager::Connection::Ptr &connection, const SettingsCallback &callback); // GetSettings的结果按连接缓存
+    void requestConnectionSecrets(const NetworkManager::Connection::Ptr &connection, const QString &setting, const SettingsCallback &callback); // 密码不缓存
+    void invalidateConnectionSettings(const QString &path);
     void doDeleteConnect(const QString &uuid);
     void changeVpnId();
     void doImportConnect(const QString &id, const QString &file);
@@ -171,6 +207,10 @@ protected Q_SLOTS:
     void doShowPage(const QString &cmd);
 
     void sendRequest(NetManager::CmdType cmd, const QString &id, const QVariantMap &param = QVariantMap());
+    // 数据变化,设置了合并间隔时先缓存,到时间后一次发送
+    void postDataChanged(int dataType, const QString &id, const QVariant &value);
+    void postDataChanged(int dataType, quint32 handle, const QString &id, const QVariant &value);
+    void flushDataChanged();
 
     // 获取数据
     // Device
@@ -187,6 +227,8 @@ protected Q_SLOTS:
     void onNetworkAdded(const QList<AccessPoints *> &aps);
     void onNetworkRemoved(const QList<AccessPoints *> &aps);
     void addNetwork(const NetworkDeviceBase *device, QList<AccessPoints *> aps);
+    const QSet<QByteArray> &savedSsids(const QString &devPath);          // 设备上已保存的无线连接的SSID
+    void invalidateSavedSsids(const QString &devPath);
     // device
     void onNameChanged(const QString &name);
     void onDevEnabledChanged(const bool enabled);
@@ -196,6 +238,7 @@ protected Q_SLOTS:
     void onDeviceStatusChanged();
     void onHotspotEnabledChanged();
     void onAvailableConnectionsChanged();
+    void reconcileAvailableConnections();
     // ap
     void onStrengthChanged(int strength);
     void onAPStatusChanged(ConnectionStatus status);
@@ -233,6 +276,7 @@ protected Q_SLOTS:
     void onDslActiveConnectionChanged();
     // 网络详情
     void updateDetails();
+    void requestUpdateDetails();                                        // 合并短时间内多次的详情刷新
 
     // 自动扫描
     void updateAutoScan();
@@ -251,11 +295,17 @@ protected Q_SLOTS:
     void onPortalDetected(const QString &portalUrl);
 
 private:
+    void initSecretAgent();
+    void initItems(NetType::NetManagerFlags flags); // 创建标记对应的数据项
     void addDevice(NetDeviceItemPrivate *deviceItem, NetworkDeviceBase *dev);
 
     void getNetCheckAvailableFromDBus();
 
     inline QString apID(AccessPoints *ap) const { return QString::number(reinterpret_cast<quintptr>(ap), 16); }
+    quint32 itemHandle(const QString &id); // 数据项ID对应的句柄，只在子线程中使用
+    const QPair<quint32, QString> &apHandle(AccessPoints *ap); // 热点的句柄和ID，避免每次变化重新生成ID
+    void removeApHandle(AccessPoints *ap);
+    void releaseItemHandle(const QString &id); // 数据项移除后释放其及子项的句柄
 
     AccessPoints *fromApID(const QString &id);
     void requestPassword(const QString &dev, const QString &id, const QVariantMap &param);
@@ -282,8 +332,18 @@ private:
     bool m_enabled;
     int m_autoScanInterval;
     bool m_autoScanEnabled;
-    QTimer *m_autoScanTimer;
+    NetScanScheduler *m_scanScheduler;
+    NetSharedBackendClient *m_sharedClient;
     int m_lastThroughTime;
+    // 数据变化合并
+    int m_dataChangedInterval;
+    QTimer *m_dataChangedTimer;
+    NetDataChangeList m_pendingDataChanges;
+    QHash<QPair<int, quint32>, int> m_pendingDataIndex;
+    QAtomicInt m_dataChangedQueueDepth;
+    QHash<QString, quint32> m_itemHandles;
+    QHash<AccessPoints *, QPair<quint32, QString>> m_apHandles;
+    quint32 m_lastItemHandle = 0;
 
     // 通知相关变量
     QString m_lastConnection;
@@ -296,15 +356,49 @@ private:
     bool m_airplaneModeEnabled;
     bool m_isSleeping;
     QString m_serverKey;
-    QMap<NetworkDetails *, QString> m_detailsItemsMap; // 存储 NetworkDetails 指针到唯一ID的映射
+    // 每个网络详情对应的项，记录上一次发送的数据，只发送变化的部分
+    struct DetailsItemState
+    {
+        QString id;
+        int index = -1;
+        QList<QStringList> data;
+    };
+    QMap<NetworkDetails *, DetailsItemState> m_detailsItemsMap; // 存储 NetworkDetails 指针到唯一ID的映射
+    QTimer *m_detailsTimer;
     QString m_showPageCmd;
     QTimer *m_showPageTimer;
     QTimer *m_vpnStateUpdateTimer;
     QString m_newVPNuuid;
     bool m_supportWireless;
+    // 每个无线设备上已保存连接的SSID索引，只在可用连接或者连接配置变化后重建
+    struct SavedSsidCache
+    {
+        QSet<QByteArray> ssids;
+        bool valid = false;
+        QMetaObject::Connection watcher;
+    };
+    QHash<QString, SavedSsidCache> m_savedSsidCache;
+    // 可用连接变化后延迟对账，每个设备最多一个待处理，只发送有无配置发生变化的热点
+    QTimer *m_availableConnectionsTimer;
+    QElapsedTimer m_availableConnectionsElapsed; // 从第一个待处理的变化开始计时，限制最长延迟
+    QMap<QString, QPointer<WirelessDevice>> m_pendingAvailableDevices;
+    QHash<QString, QSet<QString>> m_connectedAps; // 每个设备上已通知为有配置的热点
+    // 连接的原始配置(GetSettings)缓存,连接更新或者删除后失效
+    struct ConnectionSettingsCache
+    {
+        NMVariantMapMap settings;
+        bool valid = false;
+        quint64 generation = 0;
+        QList<SettingsCallback> pending;
+        QMetaObject::Connection updatedWatcher;
+        QMetaObject::Connection removedWatcher;
+    };
+    QHash<QString, ConnectionSettingsCache> m_connectionSettingsCache;
 };
 
 } // namespace network
 } // namespace dde
 
+Q_DECLARE_METATYPE(dde::network::NetDataChangeList)
+
 #endif // NETMANAGERTHREADPRIVATE_H
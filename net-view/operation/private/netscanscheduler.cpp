@@ -0,0 +1,149 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#include "netscanscheduler.h"
+
+#include "netmanager.h"
+#include "networkconst.h"
+
+#include <NetworkManagerQt/Manager>
+#include <NetworkManagerQt/WirelessDevice>
+
+#include <QDateTime>
+#include <QTimer>
+
+// 扫描结果稳定时，扫描间隔最多延长到配置间隔的倍数
+#define MAX_BACKOFF 8
+
+namespace dde {
+namespace network {
+
+NetScanScheduler::NetScanScheduler(QObject *parent)
+    : QObject(parent)
+    , m_timer(new QTimer(this))
+    , m_baseInterval(0)
+    , m_interval(0)
+    , m_active(false)
+    , m_change(NoChange)
+{
+    m_timer->setSingleShot(true);
+    connect(m_timer, &QTimer::timeout, this, &NetScanScheduler::onTimeout);
+}
+
+void NetScanScheduler::setBaseInterval(int ms)
+{
+    if (m_baseInterval == ms)
+        return;
+    m_baseInterval = ms;
+    m_interval = ms;
+    schedule();
+}
+
+void NetScanScheduler::setActive(bool active)
+{
+    if (m_active == active)
+        return;
+    m_active = active;
+    // 打开面板时按配置的间隔重新开始
+    m_interval = m_baseInterval;
+    m_change = NoChange;
+    schedule();
+    if (!m_active) {
+        qCInfo(DNC) << "Auto scan stopped, requested:" << m_statistics.requested << ", avoided by backoff:" << m_statistics.backoffAvoided
+                    << ", avoided by shared scan:" << m_statistics.sharedAvoided;
+    }
+}
+
+bool NetScanScheduler::isActive() const
+{
+    return m_active;
+}
+
+int NetScanScheduler::interval() const
+{
+    return m_interval;
+}
+
+const NetScanScheduler::Statistics &NetScanScheduler::statistics() const
+{
+    return m_statistics;
+}
+
+bool NetScanScheduler::needScan(const QString &devPath)
+{
+    // 设备最近一次扫描(可能由其他进程发起)在配置的间隔内，直接使用其结果
+    NetworkManager::WirelessDevice::Ptr device = NetworkManager::findNetworkInterface(devPath).objectCast<NetworkManager::WirelessDevice>();
+    if (device && m_baseInterval > 0) {
+        const QDateTime lastScan = device->lastScan();
+        if (lastScan.isValid() && lastScan.msecsTo(QDateTime::currentDateTime()) < m_baseInterval) {
+            ++m_statistics.sharedAvoided;
+            return false;
+        }
+    }
+    ++m_statistics.requested;
+    return true;
+}
+
+void NetScanScheduler::networkAdded()
+{
+    m_change = NetworkChanged;
+}
+
+void NetScanScheduler::networkRemoved(const QString &id)
+{
+    m_strengthLevels.remove(id);
+    m_change = NetworkChanged;
+}
+
+void NetScanScheduler::strengthChanged(const QString &id, int strength)
+{
+    // 只有信号等级变化才认为是变化，避免信号值的小幅波动影响扫描间隔
+    const int level = NetManager::StrengthLevel(strength);
+    auto it = m_strengthLevels.find(id);
+    if (it == m_strengthLevels.end()) {
+        m_strengthLevels.insert(id, level);
+        return;
+    }
+    if (it.value() == level)
+        return;
+    it.value() = level;
+    if (m_change == NoChange)
+        m_change = SignalChanged;
+}
+
+void NetScanScheduler::onTimeout()
+{
+    // 网络列表变化时恢复到配置间隔，仅信号变化时缩短一半间隔(不小于配置间隔)，没有变化则延长间隔
+    const int oldInterval = m_interval;
+    switch (m_change) {
+    case NetworkChanged:
+        m_interval = m_baseInterval;
+        break;
+    case SignalChanged:
+        m_interval = qMax(m_interval / 2, m_baseInterval);
+        break;
+    case NoChange:
+        m_interval = qMin(m_interval * 2, m_baseInterval * MAX_BACKOFF);
+        break;
+    }
+    m_change = NoChange;
+    if (oldInterval != m_interval)
+        qCDebug(DNC) << "Auto scan interval changed:" << oldInterval << "->" << m_interval;
+    // 本次等待的时间内，固定间隔扫描需要的次数
+    if (m_baseInterval > 0)
+        m_statistics.backoffAvoided += oldInterval / m_baseInterval - 1;
+    Q_EMIT scanRequested();
+    schedule();
+}
+
+void NetScanScheduler::schedule()
+{
+    if (m_active && m_interval > 0) {
+        m_timer->start(m_interval);
+    } else {
+        m_timer->stop();
+    }
+}
+
+} // namespace network
+} // namespace dde
@@ -0,0 +1,76 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#ifndef NETSCANSCHEDULER_H
+#define NETSCANSCHEDULER_H
+
+#include <QHash>
+#include <QObject>
+
+QT_BEGIN_NAMESPACE
+class QTimer;
+QT_END_NAMESPACE
+
+namespace dde {
+namespace network {
+
+/**
+ * @brief The NetScanScheduler class
+ * 无线网络自动扫描调度
+ * 扫描结果稳定时按倍数延长扫描间隔，网络列表变化时恢复到配置的间隔，信号等级变化时间隔减半
+ * 扫描前检查设备最近一次扫描时间，其他进程(任务栏、锁屏、控制中心)刚扫描过的设备不再重复扫描
+ */
+class NetScanScheduler : public QObject
+{
+    Q_OBJECT
+public:
+    // 统计避免的扫描次数
+    struct Statistics
+    {
+        quint64 requested = 0;      // 实际请求的扫描
+        quint64 backoffAvoided = 0; // 延长间隔后相比固定间隔少扫描的次数
+        quint64 sharedAvoided = 0;  // 其他进程刚扫描过而跳过的次数
+    };
+
+    explicit NetScanScheduler(QObject *parent = nullptr);
+
+    void setBaseInterval(int ms); // 配置的扫描间隔，0为不扫描
+    void setActive(bool active);  // 网络面板是否显示，不显示时停止扫描
+    bool isActive() const;
+    int interval() const;
+    const Statistics &statistics() const;
+
+    bool needScan(const QString &devPath);  // 检查设备是否需要扫描，需要扫描时计入统计
+    void networkAdded();                    // 网络列表发生变化
+    void networkRemoved(const QString &id);
+    void strengthChanged(const QString &id, int strength);
+
+Q_SIGNALS:
+    void scanRequested();
+
+private Q_SLOTS:
+    void onTimeout();
+
+private:
+    void schedule();
+
+    enum ChangeLevel {
+        NoChange,
+        SignalChanged,
+        NetworkChanged,
+    };
+
+private:
+    QTimer *m_timer;
+    int m_baseInterval;
+    int m_interval;
+    bool m_active;
+    ChangeLevel m_change;
+    QHash<QString, int> m_strengthLevels;
+    Statistics m_statistics;
+};
+
+} // namespace network
+} // namespace dde
+
+#endif // NETSCANSCHEDULER_H
@@ -19,10 +19,6 @@
 namespace dde {
 namespace network {
 
-static QMap<QString, void (NetSecretAgentForUI::*)(QLocalSocket *, const QByteArray &)> s_FunMap = {
-    { "requestSecrets", &NetSecretAgentForUI::requestSecrets },
-};
-
 NetSecretAgentForUI::NetSecretAgentForUI(PasswordCallbackFunc fun, const QString &serverKey, QObject *parent)
     : QObject(parent)
     , NetSecretAgentInterface(fun)
@@ -33,6 +29,9 @@ NetSecretAgentForUI::NetSecretAgentForUI(PasswordCallbackFunc fun, const QString
     m_reconnectTimer->setInterval(1000);
     m_reconnectTimer->setSingleShot(true);
     connect(m_reconnectTimer, &QTimer::timeout, this, &NetSecretAgentForUI::ConnectToServer);
+    m_dispatcher.registerHandler("requestSecrets", [this](QIODevice *device, const QByteArray &data) {
+        requestSecrets(qobject_cast<QLocalSocket *>(device), data);
+    });
 
     connect(m_client, &QLocalSocket::stateChanged, this, &NetSecretAgentForUI::onStateChanged);
     connect(m_client, &QLocalSocket::readyRead, this, &NetSecretAgentForUI::readyReadHandler);
@@ -61,6 +60,8 @@ void NetSecretAgentForUI::onStateChanged(QLocalSocket::LocalSocketState socketSt
     switch (socketState) {
     case QLocalSocket::UnconnectedState:
     case QLocalSocket::ClosingState:
+        // 重连后是新的数据流
+        m_codec.clear();
         if (!m_reconnectTimer->isActive()) {
             m_reconnectTimer->start();
         }
@@ -90,7 +91,7 @@ void NetSecretAgentForUI::sendSecretsResult(const QString &key, const QVariantMa
     QJsonDocument doc;
     doc.setObject(json);
     data = doc.toJson(QJsonDocument::Compact);
-    m_client->write("\nsecretsResult:" + data + "\n");
+    m_client->write(LocalFrameCodec::encode("secretsResult", data));
     m_callId.clear();
 }
 
@@ -100,19 +101,9 @@ void NetSecretAgentForUI::readyReadHandler()
     if (!socket)
         return;
 
-    QByteArray allData = socket->readAll();
-    allData = m_lastData + allData;
-    QList<QByteArray> dataArray = allData.split('\n');
-    m_lastData = dataArray.last();
-    for (const QByteArray &data : dataArray) {
-        int keyIndex = data.indexOf(':');
-        if (keyIndex != -1) {
-            QString key = data.left(keyIndex);
-            QByteArray value = data.mid(keyIndex + 1);
-            if (s_FunMap.contains(key)) {
-                (this->*s_FunMap.value(key))(socket, value);
-            }
-        }
+    if (!m_dispatcher.process(socket, &m_codec)) {
+        qWarning() << "Invalid data from secret agent, error:" << m_codec.error();
+        socket->abort();
     }
 }
 
@@ -148,7 +139,7 @@ void NetSecretAgentForUI::requestSecrets(QLocalSocket *socket, const QByteArray
         }
         requestPassword(dev, m_connectSsid, param);
     }
-    socket->write("\nreceive:" + data + "\n");
+    socket->write(LocalFrameCodec::encode("receive", data));
 }
 
 } // namespace network
@@ -5,6 +5,7 @@
 #ifndef NETSECRETAGENTFORUI_H
 #define NETSECRETAGENTFORUI_H
 
+#include "impl/localframecodec.h"
 #include "netsecretagentinterface.h"
 
 #include <QLocalSocket>
@@ -46,7 +47,8 @@ private:
     QString m_connectDev;
     QString m_connectSsid;
     QStringList m_secrets;
-    QByteArray m_lastData;
+    LocalFrameCodec m_codec;
+    LocalFrameDispatcher m_dispatcher;
 
     QLocalSocket *m_client;
 
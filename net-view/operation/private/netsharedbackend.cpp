@@ -0,0 +1,918 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#include "netsharedbackend.h"
+
+#include "netitemprivate.h"
+#include "netmanager_p.h"
+#include "netmanagerthreadprivate.h"
+#include "networkconst.h"
+
+#include <QDBusConnection>
+#include <QDBusMessage>
+#include <QDBusPendingCallWatcher>
+#include <QDBusPendingReply>
+#include <QDBusServiceWatcher>
+#include <QDataStream>
+#include <QSet>
+#include <QTimer>
+
+namespace dde {
+namespace network {
+
+const QString SharedBackendPath = "/org/deepin/dde/NetworkBackend1";
+const QString SharedBackendInterface = "org.deepin.dde.NetworkBackend1";
+
+QString NetSharedBackend::serviceName()
+{
+    // 会话总线已区分会话，服务名只包含协议版本，标记不同的进程也共享
+    return QString("org.deepin.dde.NetworkBackend1.V%1").arg(SHARED_BACKEND_VERSION);
+}
+
+NetType::NetManagerFlags NetSharedBackend::itemFlags(NetType::NetItemType type, const QString &parentID)
+{
+    switch (type) {
+    case NetType::NetItemType::VPNControlItem:
+        return NetType::Net_VPN;
+    case NetType::NetItemType::VPNTipsItem:
+        return NetType::Net_VPN | NetType::Net_VPNTips;
+    case NetType::NetItemType::SystemProxyControlItem:
+        return NetType::Net_SysProxy;
+    case NetType::NetItemType::AppProxyControlItem:
+        return NetType::Net_AppProxy;
+    case NetType::NetItemType::HotspotControlItem:
+        return NetType::Net_Hotspot;
+    case NetType::NetItemType::DSLControlItem:
+        return NetType::Net_DSL;
+    case NetType::NetItemType::DetailsItem:
+    case NetType::NetItemType::DetailsInfoItem:
+        return NetType::Net_Details;
+    case NetType::NetItemType::ConnectionItem:
+        if (parentID == "NetVPNControlItem")
+            return NetType::Net_VPN | NetType::Net_VPNChildren;
+        if (parentID == "NetDSLControlItem")
+            return NetType::Net_DSL;
+        break;
+    default:
+        break;
+    }
+    return NetType::NetManagerFlags();
+}
+
+QVariantMap NetSharedBackend::itemProperties(NetItemPrivate *item)
+{
+    QVariantMap properties;
+    properties.insert("name", item->name());
+    if (NetControlItemPrivate *controlItem = NetItemPrivate::toItem<NetControlItemPrivate>(item)) {
+        properties.insert("enabled", controlItem->isEnabled());
+        properties.insert("enabledable", controlItem->enabledable());
+    }
+    if (NetDeviceItemPrivate *deviceItem = NetItemPrivate::toItem<NetDeviceItemPrivate>(item)) {
+        properties.insert("status", int(deviceItem->status()));
+        properties.insert("ips", deviceItem->ips());
+        properties.insert("pathIndex", deviceItem->pathIndex());
+    }
+    if (NetWirelessDeviceItemPrivate *wirelessDeviceItem = NetItemPrivate::toItem<NetWirelessDeviceItemPrivate>(item)) {
+        properties.insert("apMode", wirelessDeviceItem->apMode());
+    }
+    if (NetVPNControlItemPrivate *vpnItem = NetItemPrivate::toItem<NetVPNControlItemPrivate>(item)) {
+        properties.insert("expanded", vpnItem->isExpanded());
+    }
+    if (NetConnectionItemPrivate *connectionItem = NetItemPrivate::toItem<NetConnectionItemPrivate>(item)) {
+        properties.insert("status", int(connectionItem->status()));
+    }
+    if (NetWiredItemPrivate *wiredItem = NetItemPrivate::toItem<NetWiredItemPrivate>(item)) {
+        properties.insert("portalUrl", wiredItem->portalUrl());
+    }
+    if (NetWirelessItemPrivate *wirelessItem = NetItemPrivate::toItem<NetWirelessItemPrivate>(item)) {
+        properties.insert("flags", wirelessItem->flags());
+        properties.insert("strength", wirelessItem->strength());
+        properties.insert("secure", wirelessItem->isSecure());
+        properties.insert("hasConnection", wirelessItem->hasConnection());
+        properties.insert("portalUrl", wirelessItem->portalUrl());
+    }
+    if (NetSystemProxyControlItemPrivate *proxyItem = NetItemPrivate::toItem<NetSystemProxyControlItemPrivate>(item)) {
+        properties.insert("lastMethod", int(proxyItem->lastMethod()));
+        properties.insert("method", int(proxyItem->method()));
+        properties.insert("autoProxy", proxyItem->autoProxy());
+        properties.insert("manualProxy", proxyItem->manualProxy());
+    }
+    if (NetAppProxyControlItemPrivate *appProxyItem = NetItemPrivate::toItem<NetAppProxyControlItemPrivate>(item)) {
+        properties.insert("config", appProxyItem->config());
+    }
+    if (NetHotspotControlItemPrivate *hotspotItem = NetItemPrivate::toItem<NetHotspotControlItemPrivate>(item)) {
+        properties.insert("config", hotspotItem->config());
+        properties.insert("shareDevice", hotspotItem->shareDevice());
+        properties.insert("optionalDevice", hotspotItem->optionalDevice());
+        properties.insert("optionalDevicePath", hotspotItem->optionalDevicePath());
+        properties.insert("deviceEnabled", hotspotItem->deviceEnabled());
+    }
+    if (NetDetailsInfoItemPrivate *detailsItem = NetItemPrivate::toItem<NetDetailsInfoItemPrivate>(item)) {
+        properties.insert("details", QVariant::fromValue(detailsItem->details()));
+        properties.insert("index", detailsItem->index());
+    }
+    if (NetTipsItemPrivate *tipsItem = NetItemPrivate::toItem<NetTipsItemPrivate>(item)) {
+        properties.insert("linkActivatedText", tipsItem->linkActivatedText());
+        properties.insert("tipsLinkEnabled", tipsItem->tipsLinkEnabled());
+    }
+    return properties;
+}
+
+NetItemPrivate *NetSharedBackend::newItem(NetType::NetItemType type, const QString &id, const QVariantMap &properties)
+{
+    NetItemPrivate *item = NetItemPrivate::New(type, id);
+    if (!item)
+        return nullptr;
+
+    item->updatename(properties.value("name").toString());
+    if (NetControlItemPrivate *controlItem = NetItemPrivate::toItem<NetControlItemPrivate>(item)) {
+        controlItem->updateenabled(properties.value("enabled").toBool());
+        controlItem->updateenabledable(properties.value("enabledable").toBool());
+    }
+    if (NetDeviceItemPrivate *deviceItem = NetItemPrivate::toItem<NetDeviceItemPrivate>(item)) {
+        deviceItem->updatestatus(NetType::NetDeviceStatus(properties.value("status").toInt()));
+        deviceItem->updateips(properties.value("ips").toStringList());
+        deviceItem->updatepathIndex(properties.value("pathIndex").toInt());
+    }
+    if (NetWirelessDeviceItemPrivate *wirelessDeviceItem = NetItemPrivate::toItem<NetWirelessDeviceItemPrivate>(item)) {
+        wirelessDeviceItem->updateapMode(properties.value("apMode").toBool());
+    }
+    if (NetVPNControlItemPrivate *vpnItem = NetItemPrivate::toItem<NetVPNControlItemPrivate>(item)) {
+        vpnItem->updateexpanded(properties.value("expanded").toBool());
+    }
+    if (NetConnectionItemPrivate *connectionItem = NetItemPrivate::toItem<NetConnectionItemPrivate>(item)) {
+        connectionItem->updatestatus(NetType::NetConnectionStatus(properties.value("status").toInt()));
+    }
+    if (NetWiredItemPrivate *wiredItem = NetItemPrivate::toItem<NetWiredItemPrivate>(item)) {
+        wiredItem->updateportalUrl(properties.value("portalUrl").toString());
+    }
+    if (NetWirelessItemPrivate *wirelessItem = NetItemPrivate::toItem<NetWirelessItemPrivate>(item)) {
+        wirelessItem->updateflags(properties.value("flags").toUInt());
+        wirelessItem->updatestrength(properties.value("strength").toInt());
+        wirelessItem->updatesecure(properties.value("secure").toBool());
+        wirelessItem->updatehasConnection(properties.value("hasConnection").toBool());
+        wirelessItem->updateportalUrl(properties.value("portalUrl").toString());
+    }
+    if (NetSystemProxyControlItemPrivate *proxyItem = NetItemPrivate::toItem<NetSystemProxyControlItemPrivate>(item)) {
+        proxyItem->updatelastMethod(NetType::ProxyMethod(properties.value("lastMethod").toInt()));
+        proxyItem->updatemethod(NetType::ProxyMethod(properties.value("method").toInt()));
+        proxyItem->updateautoProxy(properties.value("autoProxy").toString());
+        proxyItem->updatemanualProxy(properties.value("manualProxy").toMap());
+    }
+    if (NetAppProxyControlItemPrivate *appProxyItem = NetItemPrivate::toItem<NetAppProxyControlItemPrivate>(item)) {
+        appProxyItem->updateconfig(properties.value("config").toMap());
+    }
+    if (NetHotspotControlItemPrivate *hotspotItem = NetItemPrivate::toItem<NetHotspotControlItemPrivate>(item)) {
+        hotspotItem->updateconfig(properties.value("config").toMap());
+        hotspotItem->updateshareDevice(properties.value("shareDevice").toStringList());
+        hotspotItem->updateoptionalDevice(properties.value("optionalDevice").toStringList());
+        hotspotItem->updateoptionalDevicePath(properties.value("optionalDevicePath").toStringList());
+        hotspotItem->updatedeviceEnabled(properties.value("deviceEnabled").toBool());
+    }
+    if (NetDetailsInfoItemPrivate *detailsItem = NetItemPrivate::toItem<NetDetailsInfoItemPrivate>(item)) {
+        detailsItem->updatedetails(properties.value("details").value<QList<QStringList>>());
+        detailsItem->updateindex(properties.value("index").toInt());
+    }
+    if (NetTipsItemPrivate *tipsItem = NetItemPrivate::toItem<NetTipsItemPrivate>(item)) {
+        tipsItem->updatelinkActivatedText(properties.value("linkActivatedText").toString());
+        tipsItem->updatetipsLinkEnabled(properties.value("tipsLinkEnabled").toBool());
+    }
+    return item;
+}
+
+void NetSharedBackend::writeVariant(QDataStream &stream, const QVariant &value)
+{
+    // 枚举按整数传输，接收方通过value<T>()转换
+    if (value.metaType().flags().testFlag(QMetaType::IsEnumeration)) {
+        stream << QVariant(value.toInt());
+    } else {
+        stream << value;
+    }
+}
+
+void NetSharedBackend::ItemList::add(const QString &id, const QString &parentID, NetType::NetManagerFlags flags)
+{
+    if (m_parents.contains(id))
+        m_items.removeOne(id);
+    m_items.append(id);
+    m_parents.insert(id, parentID);
+    if (flags) {
+        m_flags.insert(id, flags);
+    } else {
+        m_flags.remove(id);
+    }
+}
+
+void NetSharedBackend::ItemList::remove(const QString &id)
+{
+    if (!m_parents.contains(id))
+        return;
+    // 父项总在子项之前，一次遍历即可移除所有子项
+    QSet<QString> removedItems = { id };
+    for (auto it = m_items.begin(); it != m_items.end();) {
+        if (removedItems.contains(*it) || removedItems.contains(m_parents.value(*it))) {
+            removedItems.insert(*it);
+            m_parents.remove(*it);
+            m_flags.remove(*it);
+            it = m_items.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void NetSharedBackend::ItemList::clear()
+{
+    m_items.clear();
+    m_parents.clear();
+    m_flags.clear();
+}
+
+QString NetSharedBackend::ItemList::parentID(const QString &id) const
+{
+    return m_parents.value(id);
+}
+
+NetType::NetManagerFlags NetSharedBackend::ItemList::flags(const QString &id) const
+{
+    return m_flags.value(id);
+}
+
+QStringList NetSharedBackend::ItemList::topLevelItems() const
+{
+    QStringList items;
+    for (const QString &id : m_items) {
+        if (!m_parents.contains(m_parents.value(id)))
+            items.append(id);
+    }
+    return items;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+NetSharedBackendServer::NetSharedBackendServer(NetManagerPrivate *manager)
+    : QObject(manager)
+    , m_manager(manager)
+    , m_pendingStream(nullptr)
+    , m_flushTimer(new QTimer(this))
+    , m_clientWatcher(new QDBusServiceWatcher(this))
+{
+    // 同一轮事件循环内的变化合并为一帧
+    m_flushTimer->setSingleShot(true);
+    m_flushTimer->setInterval(0);
+    connect(m_flushTimer, &QTimer::timeout, this, &NetSharedBackendServer::flush);
+
+    m_clientWatcher->setConnection(QDBusConnection::sessionBus());
+    m_clientWatcher->setWatchMode(QDBusServiceWatcher::WatchForUnregistration);
+    connect(m_clientWatcher, &QDBusServiceWatcher::serviceUnregistered, this, &NetSharedBackendServer::onClientUnregistered);
+}
+
+NetSharedBackendServer::~NetSharedBackendServer()
+{
+    if (!m_service.isEmpty()) {
+        QDBusConnection::sessionBus().unregisterService(m_service);
+        QDBusConnection::sessionBus().unregisterObject(SharedBackendPath);
+        qCInfo(DNC) << "Shared network backend stopped, snapshots:" << m_statistics.snapshots << ", frames:" << m_statistics.frames << ", records:" << m_statistics.records
+                    << ", bytes:" << m_statistics.bytes << ", commands:" << m_statistics.commands;
+    }
+    delete m_pendingStream;
+}
+
+bool NetSharedBackendServer::start(const QString &service)
+{
+    QDBusConnection bus = QDBusConnection::sessionBus();
+    if (!bus.registerObject(SharedBackendPath, this, QDBusConnection::ExportScriptableSlots)) {
+        qCWarning(DNC) << "Register shared network backend object failed:" << bus.lastError().message();
+        return false;
+    }
+    if (!bus.registerService(service)) {
+        bus.unregisterObject(SharedBackendPath);
+        return false;
+    }
+    m_service = service;
+    qCInfo(DNC) << "Shared network backend started:" << service;
+    return true;
+}
+
+bool NetSharedBackendServer::clientEnabled() const
+{
+    for (const ClientState &state : m_clients) {
+        if (state.enabled)
+            return true;
+    }
+    return false;
+}
+
+bool NetSharedBackendServer::clientAutoScanEnabled() const
+{
+    for (const ClientState &state : m_clients) {
+        if (state.autoScanEnabled)
+            return true;
+    }
+    return false;
+}
+
+const NetSharedBackendServer::Statistics &NetSharedBackendServer::statistics() const
+{
+    return m_statistics;
+}
+
+void NetSharedBackendServer::itemAdded(const QString &parentID, NetItemPrivate *item)
+{
+    const NetType::NetManagerFlags flags = NetSharedBackend::itemFlags(item->itemType(), parentID);
+    m_items.add(item->id(), parentID, flags);
+    if (m_clients.isEmpty())
+        return;
+    beginRecord(NetSharedBackend::ItemAddedRecord, flags) << parentID << qint32(item->itemType()) << item->id() << NetSharedBackend::itemProperties(item);
+}
+
+void NetSharedBackendServer::itemAdded(const QString &parentID, NetType::NetItemType type, const QString &id, const QVariantMap &properties)
+{
+    const NetType::NetManagerFlags flags = NetSharedBackend::itemFlags(type, parentID);
+    m_items.add(id, parentID, flags);
+    if (m_clients.isEmpty())
+        return;
+    beginRecord(NetSharedBackend::ItemAddedRecord, flags) << parentID << qint32(type) << id << properties;
+}
+
+void NetSharedBackendServer::itemRemoved(const QString &id)
+{
+    const NetType::NetManagerFlags flags = m_items.flags(id);
+    m_items.remove(id);
+    m_issuers.remove(id);
+    if (m_clients.isEmpty())
+        return;
+    beginRecord(NetSharedBackend::ItemRemovedRecord, flags) << id;
+}
+
+void NetSharedBackendServer::dataChanged(int dataType, const QString &id, const QVariant &value)
+{
+    // 非具体项的数据只保留最新值，用于快照
+    if (id.isEmpty() || id == "Root")
+        m_globals.insert(dataType, { id, value });
+    if (m_clients.isEmpty())
+        return;
+    // Root的数据都是飞行模式的数据
+    QDataStream &stream = beginRecord(NetSharedBackend::DataChangedRecord, id == "Root" ? NetType::NetManagerFlags(NetType::Net_Airplane) : m_items.flags(id));
+    stream << qint32(dataType) << id;
+    NetSharedBackend::writeVariant(stream, value);
+}
+
+void NetSharedBackendServer::passwordRequested(const QString &dev, const QString &id, const QVariantMap &param)
+{
+    if (m_clients.isEmpty())
+        return;
+    // 只有使用密码代理的进程需要处理
+    beginRecord(NetSharedBackend::PasswordRequestRecord, NetType::Net_UseSecretAgent) << dev << id << param;
+}
+
+// clang-format off
+void NetSharedBackendServer::networkNotify(const QString &inAppName, int replacesId, const QString &appIcon, const QString &summary, const QString &body, const QStringList &actions, const QVariantMap &hints, int expireTimeout)
+// clang-format on
+{
+    if (m_clients.isEmpty())
+        return;
+    beginRecord(NetSharedBackend::NotifyRecord) << inAppName << qint32(replacesId) << appIcon << summary << body << actions << hints << qint32(expireTimeout);
+}
+
+void NetSharedBackendServer::toControlCenter()
+{
+    if (m_clients.isEmpty())
+        return;
+    beginRecord(NetSharedBackend::ToControlCenterRecord);
+}
+
+void NetSharedBackendServer::supportWirelessChanged(bool supportWireless)
+{
+    if (m_clients.isEmpty())
+        return;
+    beginRecord(NetSharedBackend::SupportWirelessRecord) << supportWireless;
+}
+
+void NetSharedBackendServer::netCheckAvailableChanged(bool available)
+{
+    if (m_clients.isEmpty())
+        return;
+    beginRecord(NetSharedBackend::NetCheckAvailableRecord) << available;
+}
+
+void NetSharedBackendServer::clearIssuer(const QString &id)
+{
+    m_issuers.remove(id);
+}
+
+bool NetSharedBackendServer::dispatchRequest(NetManager::CmdType cmd, const QString &id, const QVariantMap &param)
+{
+    const QString issuer = m_issuers.value(id);
+    if (issuer.isEmpty())
+        return false;
+    // 先发送缓存的增量，保证请求的项在订阅进程中已存在
+    flush();
+    QByteArray frame;
+    QDataStream stream(&frame, QIODevice::WriteOnly);
+    stream << quint32(SHARED_BACKEND_VERSION) << quint8(NetSharedBackend::RequestRecord) << qint32(cmd) << id << param;
+    QDBusMessage message = QDBusMessage::createTargetedSignal(issuer, SharedBackendPath, SharedBackendInterface, "Request");
+    message << frame;
+    QDBusConnection::sessionBus().send(message);
+    return true;
+}
+
+QByteArray NetSharedBackendServer::Attach(uint flags)
+{
+    return attachClient(message().service(), NetType::NetManagerFlags::fromInt(flags));
+}
+
+void NetSharedBackendServer::Detach()
+{
+    removeClient(message().service());
+}
+
+void NetSharedBackendServer::Call(const QByteArray &command)
+{
+    // 只接受已订阅进程的操作，其他进程不能通过本进程操作网络
+    const QString service = message().service();
+    if (!m_clients.contains(service)) {
+        qCWarning(DNC) << "Shared network backend, reject command from unattached:" << service;
+        return;
+    }
+    QDataStream stream(command);
+    quint32 version = 0;
+    qint32 cmd = 0;
+    qint32 count = 0;
+    stream >> version >> cmd >> count;
+    if (version != SHARED_BACKEND_VERSION || stream.status() != QDataStream::Ok) {
+        qCWarning(DNC) << "Shared network backend, invalid command from:" << service << ", version:" << version;
+        return;
+    }
+    QVariantList args;
+    for (int i = 0; i < count && !stream.atEnd(); ++i) {
+        QVariant arg;
+        stream >> arg;
+        args.append(arg);
+    }
+    ++m_statistics.commands;
+    execCommand(service, NetSharedBackend::Command(cmd), args);
+}
+
+void NetSharedBackendServer::flush()
+{
+    m_flushTimer->stop();
+    if (m_pendingRecords.isEmpty())
+        return;
+    // 按订阅进程的标记过滤记录，标记相同的进程使用相同的记录
+    QHash<int, QPair<QByteArray, int>> records;
+    for (auto it = m_clients.begin(); it != m_clients.end(); ++it) {
+        auto record = records.find(it->flags.toInt());
+        if (record == records.end()) {
+            int count = 0;
+            const QByteArray data = pendingRecords(it->flags, count);
+            record = records.insert(it->flags.toInt(), { data, count });
+        }
+        if (record->second == 0)
+            continue;
+        QByteArray frame;
+        QDataStream stream(&frame, QIODevice::WriteOnly);
+        stream << quint32(SHARED_BACKEND_VERSION) << ++it->seq;
+        frame.append(record->first);
+
+        ++m_statistics.frames;
+        m_statistics.records += record->second;
+        m_statistics.bytes += frame.size();
+        QDBusMessage message = QDBusMessage::createTargetedSignal(it.key(), SharedBackendPath, SharedBackendInterface, "Changed");
+        message << frame;
+        QDBusConnection::sessionBus().send(message);
+    }
+    delete m_pendingStream;
+    m_pendingStream = nullptr;
+    m_pending.clear();
+    m_pendingRecords.clear();
+}
+
+void NetSharedBackendServer::onClientUnregistered(const QString &service)
+{
+    qCInfo(DNC) << "Shared network backend client exited:" << service;
+    removeClient(service);
+}
+
+NetSharedBackendServer::ClientState &NetSharedBackendServer::client(const QString &service)
+{
+    auto it = m_clients.find(service);
+    if (it == m_clients.end()) {
+        m_clientWatcher->addWatchedService(service);
+        it = m_clients.insert(service, ClientState());
+    }
+    return it.value();
+}
+
+void NetSharedBackendServer::removeClient(const QString &service)
+{
+    if (!m_clients.remove(service))
+        return;
+    m_clientWatcher->removeWatchedService(service);
+    for (auto it = m_issuers.begin(); it != m_issuers.end();) {
+        if (it.value() == service) {
+            it = m_issuers.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    m_manager->updateEnabled();
+    m_manager->updateAutoScanEnabled();
+}
+
+QByteArray NetSharedBackendServer::attachClient(const QString &service, NetType::NetManagerFlags flags)
+{
+    // 快照为当前状态，缓存的增量先发送，订阅进程只需处理序号更大的帧
+    flush();
+    ClientState &state = client(service);
+    state.flags = flags;
+    // 子线程按所有进程标记的并集维护数据，新增的数据项之后通过增量发送
+    m_manager->m_managerThread->addFlags(state.flags);
+
+    QByteArray frame;
+    QDataStream stream(&frame, QIODevice::WriteOnly);
+    stream << quint32(SHARED_BACKEND_VERSION) << state.seq;
+    stream << quint8(NetSharedBackend::SupportWirelessRecord) << m_manager->m_supportWireless;
+    stream << quint8(NetSharedBackend::NetCheckAvailableRecord) << m_manager->m_managerThread->NetCheckAvailable();
+    int records = 2;
+    for (const QString &id : m_items.items()) {
+        if (m_items.flags(id) & ~state.flags)
+            continue;
+        NetItemPrivate *item = m_manager->findItem(id);
+        if (item) {
+            stream << quint8(NetSharedBackend::ItemAddedRecord) << m_items.parentID(id) << qint32(item->itemType()) << id << NetSharedBackend::itemProperties(item);
+        } else if (const NetWirelessRecord *record = m_manager->m_wirelessRecords.find(id)) {
+            // 本进程未创建数据项的无线网络
+            stream << quint8(NetSharedBackend::ItemAddedRecord) << m_items.parentID(id) << qint32(NetType::NetItemType::WirelessItem) << id << NetWirelessRecords::properties(*record);
+        } else {
+            continue;
+        }
+        ++records;
+    }
+    for (auto it = m_globals.cbegin(); it != m_globals.cend(); ++it) {
+        if (it.value().first == "Root" && !state.flags.testFlags(NetType::Net_Airplane))
+            continue;
+        stream << quint8(NetSharedBackend::DataChangedRecord) << qint32(it.key()) << it.value().first;
+        NetSharedBackend::writeVariant(stream, it.value().second);
+        ++records;
+    }
+    ++m_statistics.snapshots;
+    qCInfo(DNC) << "Shared network backend attached by:" << service << ", flags:" << state.flags << ", records:" << records << ", bytes:" << frame.size() << ", clients:" << m_clients.size();
+    return frame;
+}
+
+QDataStream &NetSharedBackendServer::beginRecord(NetSharedBackend::RecordType type, NetType::NetManagerFlags flags)
+{
+    if (!m_pendingStream)
+        m_pendingStream = new QDataStream(&m_pending, QIODevice::WriteOnly);
+    m_pendingRecords.append({ int(m_pending.size()), flags });
+    if (!m_flushTimer->isActive())
+        m_flushTimer->start();
+    *m_pendingStream << quint8(type);
+    return *m_pendingStream;
+}
+
+QByteArray NetSharedBackendServer::pendingRecords(NetType::NetManagerFlags flags, int &count) const
+{
+    QByteArray data;
+    count = 0;
+    for (int i = 0; i < m_pendingRecords.size(); ++i) {
+        const PendingRecord &record = m_pendingRecords.at(i);
+        if (record.flags & ~flags)
+            continue;
+        const int end = i + 1 < m_pendingRecords.size() ? m_pendingRecords.at(i + 1).offset : int(m_pending.size());
+        data.append(m_pending.constData() + record.offset, end - record.offset);
+        ++count;
+    }
+    return data;
+}
+
+void NetSharedBackendServer::execCommand(const QString &service, NetSharedBackend::Command command, const QVariantList &args)
+{
+    switch (command) {
+    case NetSharedBackend::SetEnabled:
+        m_clients[service].enabled = args.value(0).toBool();
+        m_manager->updateEnabled();
+        return;
+    case NetSharedBackend::SetAutoScanEnabled:
+        m_clients[service].autoScanEnabled = args.value(0).toBool();
+        m_manager->updateAutoScanEnabled();
+        return;
+    default:
+        break;
+    }
+
+    // 记录发起操作的进程，操作产生的请求发给该进程
+    const QString id = args.value(0).toString();
+    if (!id.isEmpty())
+        m_issuers.insert(id, service);
+    NetManagerThreadPrivate *managerThread = m_manager->m_managerThread;
+    switch (command) {
+    case NetSharedBackend::SetDeviceEnabled:
+        managerThread->setDeviceEnabled(id, args.value(1).toBool());
+        break;
+    case NetSharedBackend::RequestScan:
+        managerThread->requestScan(id);
+        break;
+    case NetSharedBackend::DisconnectDevice:
+        managerThread->disconnectDevice(id);
+        break;
+    case NetSharedBackend::DisconnectConnection:
+        managerThread->disconnectConnection(id);
+        break;
+    case NetSharedBackend::ConnectHidden:
+        managerThread->connectHidden(id, args.value(1).toString());
+        break;
+    case NetSharedBackend::ConnectWired:
+        managerThread->connectWired(id, args.value(1).toMap());
+        break;
+    case NetSharedBackend::ConnectWireless:
+        managerThread->connectWireless(id, args.value(1).toMap());
+        break;
+    case NetSharedBackend::ConnectHotspot:
+        managerThread->connectHotspot(id, args.value(1).toMap(), args.value(2).toBool());
+        break;
+    case NetSharedBackend::GotoControlCenter:
+        managerThread->gotoControlCenter(id, args.value(1).toString());
+        break;
+    case NetSharedBackend::GotoSecurityTools:
+        managerThread->gotoSecurityTools(id);
+        break;
+    case NetSharedBackend::UserCancelRequest:
+        managerThread->userCancelRequest(id);
+        break;
+    case NetSharedBackend::ConnectOrInfo:
+        managerThread->connectOrInfo(id, NetType::NetItemType(args.value(1).toInt()), args.value(2).toMap());
+        break;
+    case NetSharedBackend::GetConnectInfo:
+        managerThread->getConnectInfo(id, NetType::NetItemType(args.value(1).toInt()), args.value(2).toMap());
+        break;
+    case NetSharedBackend::SetConnectInfo:
+        managerThread->setConnectInfo(id, NetType::NetItemType(args.value(1).toInt()), args.value(2).toMap());
+        break;
+    case NetSharedBackend::DeleteConnect:
+        managerThread->deleteConnect(id);
+        break;
+    case NetSharedBackend::ImportConnect:
+        managerThread->importConnect(id, args.value(1).toString());
+        break;
+    case NetSharedBackend::ExportConnect:
+        managerThread->exportConnect(id, args.value(1).toString());
+        break;
+    case NetSharedBackend::ShowPage:
+        managerThread->showPage(id);
+        break;
+    default:
+        qCWarning(DNC) << "Shared network backend, unknown command:" << command << ", from:" << service;
+        break;
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////
+NetSharedBackendClient::NetSharedBackendClient(const QString &service, QObject *parent)
+    : QObject(parent)
+    , m_service(service)
+    , m_attached(false)
+    , m_detached(false)
+    , m_seq(0)
+    , m_netCheckAvailable(false)
+    , m_serviceWatcher(new QDBusServiceWatcher(service, QDBusConnection::sessionBus(), QDBusServiceWatcher::WatchForUnregistration, this))
+{
+    qRegisterMetaType<QList<QStringList>>();
+    connect(m_serviceWatcher, &QDBusServiceWatcher::serviceUnregistered, this, &NetSharedBackendClient::onServiceUnregistered);
+    // 先订阅增量再获取快照，避免遗漏快照之后的变化
+    QDBusConnection::sessionBus().connect(m_service, SharedBackendPath, SharedBackendInterface, "Changed", this, SLOT(onChanged(QByteArray)));
+    QDBusConnection::sessionBus().connect(m_service, SharedBackendPath, SharedBackendInterface, "Request", this, SLOT(onRequest(QByteArray)));
+}
+
+NetSharedBackendClient::~NetSharedBackendClient()
+{
+    QDBusConnection::sessionBus().disconnect(m_service, SharedBackendPath, SharedBackendInterface, "Changed", this, SLOT(onChanged(QByteArray)));
+    QDBusConnection::sessionBus().disconnect(m_service, SharedBackendPath, SharedBackendInterface, "Request", this, SLOT(onRequest(QByteArray)));
+    if (!m_detached) {
+        QDBusMessage message = QDBusMessage::createMethodCall(m_service, SharedBackendPath, SharedBackendInterface, "Detach");
+        QDBusConnection::sessionBus().send(message);
+    }
+    qCInfo(DNC) << "Shared network backend client stopped, snapshots:" << m_statistics.snapshots << ", frames:" << m_statistics.frames << ", resyncs:" << m_statistics.resyncs;
+}
+
+void NetSharedBackendClient::attach(NetType::NetManagerFlags flags)
+{
+    m_flags = flags;
+    requestSnapshot();
+}
+
+void NetSharedBackendClient::call(NetSharedBackend::Command command, const QVariantList &args)
+{
+    if (m_detached)
+        return;
+    QByteArray frame;
+    QDataStream stream(&frame, QIODevice::WriteOnly);
+    stream << quint32(SHARED_BACKEND_VERSION) << qint32(command) << qint32(args.size());
+    for (const QVariant &arg : args) {
+        NetSharedBackend::writeVariant(stream, arg);
+    }
+    QDBusMessage message = QDBusMessage::createMethodCall(m_service, SharedBackendPath, SharedBackendInterface, "Call");
+    message << frame;
+    QDBusConnection::sessionBus().send(message);
+}
+
+bool NetSharedBackendClient::netCheckAvailable() const
+{
+    return m_netCheckAvailable;
+}
+
+const NetSharedBackendClient::Statistics &NetSharedBackendClient::statistics() const
+{
+    return m_statistics;
+}
+
+void NetSharedBackendClient::onAttachFinished(QDBusPendingCallWatcher *watcher)
+{
+    watcher->deleteLater();
+    QDBusPendingReply<QByteArray> reply = *watcher;
+    if (reply.isError()) {
+        qCWarning(DNC) << "Attach shared network backend failed:" << reply.error().message();
+        detach();
+        return;
+    }
+    const QByteArray frame = reply.value();
+    QDataStream stream(frame);
+    quint32 version = 0;
+    quint64 seq = 0;
+    stream >> version >> seq;
+    if (version != SHARED_BACKEND_VERSION) {
+        qCWarning(DNC) << "Shared network backend is incompatible, version:" << version;
+        detach();
+        return;
+    }
+    // 重新获取快照时先清除之前的数据
+    clearItems();
+    m_seq = seq;
+    m_attached = true;
+    ++m_statistics.snapshots;
+    applyRecords(stream);
+    qCInfo(DNC) << "Shared network backend attached:" << m_service << ", seq:" << m_seq << ", items:" << m_items.items().size() << ", bytes:" << frame.size();
+
+    const QList<QByteArray> frames = m_pendingFrames;
+    m_pendingFrames.clear();
+    for (const QByteArray &pendingFrame : frames) {
+        onChanged(pendingFrame);
+    }
+}
+
+void NetSharedBackendClient::onChanged(const QByteArray &frame)
+{
+    if (m_detached)
+        return;
+    if (!m_attached) {
+        m_pendingFrames.append(frame);
+        return;
+    }
+    QDataStream stream(frame);
+    quint32 version = 0;
+    quint64 seq = 0;
+    stream >> version >> seq;
+    if (version != SHARED_BACKEND_VERSION)
+        return;
+    if (seq <= m_seq)
+        return;
+    if (seq != m_seq + 1) {
+        // 增量不连续(丢失了信号)，重新获取快照
+        qCWarning(DNC) << "Shared network backend frame lost, expect:" << m_seq + 1 << ", received:" << seq;
+        ++m_statistics.resyncs;
+        m_attached = false;
+        m_pendingFrames.clear();
+        requestSnapshot();
+        return;
+    }
+    m_seq = seq;
+    ++m_statistics.frames;
+    applyRecords(stream);
+}
+
+void NetSharedBackendClient::onRequest(const QByteArray &frame)
+{
+    if (m_detached)
+        return;
+    QDataStream stream(frame);
+    quint32 version = 0;
+    stream >> version;
+    if (version == SHARED_BACKEND_VERSION)
+        applyRecords(stream);
+}
+
+void NetSharedBackendClient::onServiceUnregistered()
+{
+    qCInfo(DNC) << "Shared network backend exited:" << m_service;
+    detach();
+}
+
+void NetSharedBackendClient::requestSnapshot()
+{
+    QDBusMessage message = QDBusMessage::createMethodCall(m_service, SharedBackendPath, SharedBackendInterface, "Attach");
+    message << uint(m_flags.toInt());
+    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(QDBusConnection::sessionBus().asyncCall(message), this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, &NetSharedBackendClient::onAttachFinished);
+}
+
+void NetSharedBackendClient::applyRecords(QDataStream &stream)
+{
+    while (!stream.atEnd()) {
+        quint8 type = 0;
+        stream >> type;
+        switch (type) {
+        case NetSharedBackend::ItemAddedRecord: {
+            QString parentID;
+            qint32 itemType = 0;
+            QString id;
+            QVariantMap properties;
+            stream >> parentID >> itemType >> id >> properties;
+            NetItemPrivate *item = NetSharedBackend::newItem(NetType::NetItemType(itemType), id, properties);
+            if (item) {
+                m_items.add(id, parentID);
+                Q_EMIT itemAdded(parentID, item);
+            }
+        } break;
+        case NetSharedBackend::ItemRemovedRecord: {
+            QString id;
+            stream >> id;
+            m_items.remove(id);
+            Q_EMIT itemRemoved(id);
+        } break;
+        case NetSharedBackend::DataChangedRecord: {
+            qint32 dataType = 0;
+            QString id;
+            QVariant value;
+            stream >> dataType >> id >> value;
+            Q_EMIT dataChanged(dataType, id, value);
+        } break;
+        case NetSharedBackend::RequestRecord: {
+            qint32 cmd = 0;
+            QString id;
+            QVariantMap param;
+            stream >> cmd >> id >> param;
+            Q_EMIT request(NetManager::CmdType(cmd), id, param);
+        } break;
+        case NetSharedBackend::PasswordRequestRecord: {
+            QString dev;
+            QString id;
+            QVariantMap param;
+            stream >> dev >> id >> param;
+            Q_EMIT requestInputPassword(dev, id, param);
+        } break;
+        case NetSharedBackend::NotifyRecord: {
+            QString inAppName, appIcon, summary, body;
+            qint32 replacesId = -1;
+            qint32 expireTimeout = 0;
+            QStringList actions;
+            QVariantMap hints;
+            stream >> inAppName >> replacesId >> appIcon >> summary >> body >> actions >> hints >> expireTimeout;
+            Q_EMIT networkNotify(inAppName, replacesId, appIcon, summary, body, actions, hints, expireTimeout);
+        } break;
+        case NetSharedBackend::ToControlCenterRecord:
+            Q_EMIT toControlCenter();
+            break;
+        case NetSharedBackend::NetCheckAvailableRecord:
+            stream >> m_netCheckAvailable;
+            Q_EMIT netCheckAvailableChanged(m_netCheckAvailable);
+            break;
+        case NetSharedBackend::SupportWirelessRecord: {
+            bool supportWireless = false;
+            stream >> supportWireless;
+            Q_EMIT supportWirelessChanged(supportWireless);
+        } break;
+        default:
+            // 未知记录无法确定长度，丢弃剩余数据
+            qCWarning(DNC) << "Shared network backend, unknown record:" << type;
+            return;
+        }
+        if (stream.status() != QDataStream::Ok) {
+            qCWarning(DNC) << "Shared network backend, corrupt frame, status:" << stream.status();
+            return;
+        }
+    }
+}
+
+void NetSharedBackendClient::clearItems()
+{
+    // 只需移除顶层项，子项随父项删除
+    const QStringList items = m_items.topLevelItems();
+    for (auto it = items.crbegin(); it != items.crend(); ++it) {
+        Q_EMIT itemRemoved(*it);
+    }
+    m_items.clear();
+}
+
+void NetSharedBackendClient::detach()
+{
+    if (m_detached)
+        return;
+    m_detached = true;
+    m_attached = false;
+    m_pendingFrames.clear();
+    clearItems();
+    Q_EMIT detached();
+}
+
+} // namespace network
+} // namespace dde
@@ -0,0 +1,249 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#ifndef NETSHAREDBACKEND_H
+#define NETSHAREDBACKEND_H
+
+#include "netmanager.h"
+
+#include <QDBusContext>
+#include <QHash>
+#include <QObject>
+#include <QStringList>
+#include <QVariantMap>
+
+// 协议版本，数据帧和命令帧格式变化时增加
+#define SHARED_BACKEND_VERSION 2
+
+QT_BEGIN_NAMESPACE
+class QDataStream;
+class QDBusPendingCallWatcher;
+class QDBusServiceWatcher;
+class QTimer;
+QT_END_NAMESPACE
+
+namespace dde {
+namespace network {
+class NetItemPrivate;
+class NetManagerPrivate;
+
+/**
+ * 共享后端模式
+ * 会话内协议版本相同的NetManager共用一份网络数据：
+ * 第一个启动的进程注册服务并维护NM数据(NetSharedBackendServer)，
+ * 其他进程不再创建自己的NM数据，通过会话总线获取快照和增量(NetSharedBackendClient)
+ * 维护数据的进程按所有进程标记的并集创建数据项，快照和增量按各进程的标记过滤后发送
+ *
+ * 数据帧: version(quint32) seq(quint64,每个订阅进程单独计数) 记录...
+ * 记录: type(quint8) 字段...
+ * 命令帧: version(quint32) command(qint32) args(QVariantList)
+ */
+namespace NetSharedBackend {
+enum RecordType : quint8 {
+    ItemAddedRecord = 1,   // parentID(QString) itemType(qint32) id(QString) properties(QVariantMap)
+    ItemRemovedRecord,     // id(QString)
+    DataChangedRecord,     // dataType(qint32) id(QString) value(QVariant)
+    RequestRecord,         // cmd(qint32) id(QString) param(QVariantMap)，只发给发起操作的进程
+    PasswordRequestRecord, // dev(QString) id(QString) param(QVariantMap)
+    NotifyRecord,          // inAppName replacesId appIcon summary body actions hints expireTimeout
+    ToControlCenterRecord,
+    NetCheckAvailableRecord, // available(bool)
+    SupportWirelessRecord,   // supportWireless(bool)
+};
+
+enum Command : qint32 {
+    SetEnabled = 1,
+    SetAutoScanEnabled,
+    SetDeviceEnabled,
+    RequestScan,
+    DisconnectDevice,
+    DisconnectConnection,
+    ConnectHidden,
+    ConnectWired,
+    ConnectWireless,
+    ConnectHotspot,
+    GotoControlCenter,
+    GotoSecurityTools,
+    UserCancelRequest,
+    ConnectOrInfo,
+    GetConnectInfo,
+    SetConnectInfo,
+    DeleteConnect,
+    ImportConnect,
+    ExportConnect,
+    ShowPage,
+};
+
+QString serviceName();
+NetType::NetManagerFlags itemFlags(NetType::NetItemType type, const QString &parentID); // 显示该项需要的标记
+QVariantMap itemProperties(NetItemPrivate *item);
+NetItemPrivate *newItem(NetType::NetItemType type, const QString &id, const QVariantMap &properties);
+void writeVariant(QDataStream &stream, const QVariant &value);
+
+// 子线程添加的项，按添加顺序保存(父项在前)，用于生成快照及清理
+class ItemList
+{
+public:
+    void add(const QString &id, const QString &parentID, NetType::NetManagerFlags flags = NetType::NetManagerFlags());
+    void remove(const QString &id); // 同时移除子项
+    void clear();
+    QString parentID(const QString &id) const;
+    NetType::NetManagerFlags flags(const QString &id) const;
+    QStringList topLevelItems() const; // 父项不在列表中的项
+    inline const QStringList &items() const { return m_items; }
+
+private:
+    QStringList m_items;
+    QHash<QString, QString> m_parents;
+    QHash<QString, NetType::NetManagerFlags> m_flags; // 只保存需要标记的项
+};
+} // namespace NetSharedBackend
+
+// 维护数据的进程，导出快照并广播增量
+class NetSharedBackendServer : public QObject, protected QDBusContext
+{
+    Q_OBJECT
+    Q_CLASSINFO("D-Bus Interface", "org.deepin.dde.NetworkBackend1")
+
+public:
+    struct Statistics
+    {
+        quint64 snapshots = 0;  // 发出的快照数
+        quint64 frames = 0;     // 广播的增量帧数
+        quint64 records = 0;    // 广播的记录数
+        quint64 bytes = 0;      // 广播的字节数
+        quint64 commands = 0;   // 收到其他进程的命令数
+    };
+
+    explicit NetSharedBackendServer(NetManagerPrivate *manager);
+    ~NetSharedBackendServer() override;
+
+    bool start(const QString &service); // 注册服务，已有其他进程注册返回false
+    bool clientEnabled() const;         // 是否有订阅进程启用
+    bool clientAutoScanEnabled() const; // 是否有订阅进程需要自动扫描
+    const Statistics &statistics() const;
+
+    // 由NetManagerPrivate在处理完子线程数据后调用
+    void itemAdded(const QString &parentID, NetItemPrivate *item);
+    void itemAdded(const QString &parentID, NetType::NetItemType type, const QString &id, const QVariantMap &properties);
+    void itemRemoved(const QString &id);
+    void dataChanged(int dataType, const QString &id, const QVariant &value);
+    void passwordRequested(const QString &dev, const QString &id, const QVariantMap &param);
+    // clang-format off
+    void networkNotify(const QString &inAppName, int replacesId, const QString &appIcon, const QString &summary, const QString &body, const QStringList &actions, const QVariantMap &hints, int expireTimeout);
+    // clang-format on
+    void toControlCenter();
+    void supportWirelessChanged(bool supportWireless);
+    void netCheckAvailableChanged(bool available);
+    void clearIssuer(const QString &id);                                                   // 本进程发起的操作
+    bool dispatchRequest(NetManager::CmdType cmd, const QString &id, const QVariantMap &param); // 请求发给发起操作的订阅进程，返回false由本进程处理
+
+public Q_SLOTS:
+    Q_SCRIPTABLE QByteArray Attach(uint flags);
+    Q_SCRIPTABLE void Detach();
+    Q_SCRIPTABLE void Call(const QByteArray &command);
+
+private Q_SLOTS:
+    void flush();
+    void onClientUnregistered(const QString &service);
+
+private:
+    struct ClientState
+    {
+        bool enabled = false;
+        bool autoScanEnabled = false;
+        NetType::NetManagerFlags flags;
+        quint64 seq = 0;
+    };
+
+    struct PendingRecord
+    {
+        int offset;                     // 在m_pending中的位置
+        NetType::NetManagerFlags flags; // 接收该记录需要的标记
+    };
+
+    ClientState &client(const QString &service);
+    void removeClient(const QString &service);
+    QByteArray attachClient(const QString &service, NetType::NetManagerFlags flags); // 登记订阅进程，返回按其标记过滤的快照
+    QDataStream &beginRecord(NetSharedBackend::RecordType type, NetType::NetManagerFlags flags = NetType::NetManagerFlags());
+    QByteArray pendingRecords(NetType::NetManagerFlags flags, int &count) const; // 订阅进程可以接收的缓存记录
+    void execCommand(const QString &service, NetSharedBackend::Command command, const QVariantList &args);
+
+private:
+    NetManagerPrivate *m_manager;
+    QString m_service;
+    QByteArray m_pending;
+    QDataStream *m_pendingStream;
+    QList<PendingRecord> m_pendingRecords;
+    QTimer *m_flushTimer;
+    QDBusServiceWatcher *m_clientWatcher;
+    QHash<QString, ClientState> m_clients;
+    QHash<QString, QString> m_issuers; // 项ID -> 发起操作的订阅进程
+    NetSharedBackend::ItemList m_items;
+    QHash<int, QPair<QString, QVariant>> m_globals; // 与项无关的数据(主连接类型、飞行模式)
+    Statistics m_statistics;
+};
+
+// 订阅数据的进程，信号与NetManagerThreadPrivate一致
+class NetSharedBackendClient : public QObject
+{
+    Q_OBJECT
+public:
+    struct Statistics
+    {
+        quint64 snapshots = 0; // 收到的快照数
+        quint64 frames = 0;    // 收到的增量帧数
+        quint64 resyncs = 0;   // 增量不连续重新获取快照的次数
+    };
+
+    explicit NetSharedBackendClient(const QString &service, QObject *parent = nullptr);
+    ~NetSharedBackendClient() override;
+
+    void attach(NetType::NetManagerFlags flags);
+    void call(NetSharedBackend::Command command, const QVariantList &args);
+    bool netCheckAvailable() const;
+    const Statistics &statistics() const;
+
+Q_SIGNALS:
+    void request(NetManager::CmdType cmd, const QString &id, const QVariantMap &param);
+    void requestInputPassword(const QString &dev, const QString &id, const QVariantMap &param);
+    void itemAdded(const QString &parentID, NetItemPrivate *item);
+    void itemRemoved(const QString &id);
+    void dataChanged(int dataType, const QString &id, const QVariant &value);
+    // clang-format off
+    void networkNotify(const QString &inAppName, int replacesId, const QString &appIcon, const QString &summary, const QString &body, const QStringList &actions, const QVariantMap &hints, int expireTimeout);
+    // clang-format on
+    void toControlCenter();
+    void netCheckAvailableChanged(const bool &netCheckAvailable);
+    void supportWirelessChanged(bool supportWireless);
+    void detached(); // 后端进程退出或不可用，需要改为本进程维护数据
+
+private Q_SLOTS:
+    void onAttachFinished(QDBusPendingCallWatcher *watcher);
+    void onChanged(const QByteArray &frame);
+    void onRequest(const QByteArray &frame);
+    void onServiceUnregistered();
+
+private:
+    void requestSnapshot();
+    void applyRecords(QDataStream &stream);
+    void clearItems();
+    void detach();
+
+private:
+    QString m_service;
+    NetType::NetManagerFlags m_flags;
+    bool m_attached;
+    bool m_detached;
+    quint64 m_seq;
+    bool m_netCheckAvailable;
+    QList<QByteArray> m_pendingFrames; // 快照返回前收到的增量
+    QDBusServiceWatcher *m_serviceWatcher;
+    NetSharedBackend::ItemList m_items;
+    Statistics m_statistics;
+};
+
+} // namespace network
+} // namespace dde
+
+#endif // NETSHAREDBACKEND_H
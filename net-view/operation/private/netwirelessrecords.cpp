@@ -0,0 +1,173 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#include "netwirelessrecords.h"
+
+#include "netitemprivate.h"
+
+#include <algorithm>
+#include <functional>
+
+namespace dde {
+namespace network {
+
+void NetWirelessRecords::add(const QString &devPath, const NetWirelessRecord &record)
+{
+    auto it = m_index.constFind(record.id);
+    if (it != m_index.constEnd()) {
+        if (m_devices.at(it.value()) != devPath) {
+            removeAt(it.value());
+            add(devPath, record);
+            return;
+        }
+        m_records[it.value()] = record;
+        return;
+    }
+    m_index.insert(record.id, m_records.size());
+    m_records.append(record);
+    m_devices.append(devPath);
+    ++m_counts[devPath];
+}
+
+bool NetWirelessRecords::remove(const QString &id)
+{
+    auto it = m_index.constFind(id);
+    if (it == m_index.constEnd())
+        return false;
+    removeAt(it.value());
+    return true;
+}
+
+void NetWirelessRecords::removeDevice(const QString &devPath)
+{
+    for (int i = m_records.size() - 1; i >= 0; --i) {
+        if (m_devices.at(i) == devPath)
+            removeAt(i);
+    }
+}
+
+void NetWirelessRecords::clear()
+{
+    m_records.clear();
+    m_devices.clear();
+    m_index.clear();
+    m_counts.clear();
+}
+
+NetWirelessRecord *NetWirelessRecords::find(const QString &id)
+{
+    auto it = m_index.constFind(id);
+    return it == m_index.constEnd() ? nullptr : &m_records[it.value()];
+}
+
+QString NetWirelessRecords::devicePath(const QString &id) const
+{
+    auto it = m_index.constFind(id);
+    return it == m_index.constEnd() ? QString() : m_devices.at(it.value());
+}
+
+QString NetWirelessRecords::findByName(const QString &devPath, const QString &name) const
+{
+    for (int i = 0; i < m_records.size(); ++i) {
+        if (m_devices.at(i) == devPath && m_records.at(i).name == name)
+            return m_records.at(i).id;
+    }
+    return QString();
+}
+
+int NetWirelessRecords::count(const QString &devPath) const
+{
+    return m_counts.value(devPath, 0);
+}
+
+QStringList NetWirelessRecords::devices() const
+{
+    return m_counts.keys();
+}
+
+NetWirelessRecord NetWirelessRecords::take(const QString &id)
+{
+    auto it = m_index.constFind(id);
+    if (it == m_index.constEnd())
+        return NetWirelessRecord();
+    NetWirelessRecord record = m_records.at(it.value());
+    removeAt(it.value());
+    return record;
+}
+
+NetWirelessRecordList NetWirelessRecords::take(const QString &devPath, int count)
+{
+    QVector<int> indexes;
+    for (int i = 0; i < m_devices.size(); ++i) {
+        if (m_devices.at(i) == devPath)
+            indexes.append(i);
+    }
+    if (count <= 0 || count > indexes.size())
+        count = indexes.size();
+    auto strongerThan = [this](int left, int right) {
+        return m_records.at(left).strength > m_records.at(right).strength;
+    };
+    std::partial_sort(indexes.begin(), indexes.begin() + count, indexes.end(), strongerThan);
+    indexes.resize(count);
+
+    NetWirelessRecordList records;
+    records.reserve(count);
+    for (int index : indexes) {
+        records.append(m_records.at(index));
+    }
+    // 从后往前删除，避免填补时移动待删除的项
+    std::sort(indexes.begin(), indexes.end(), std::greater<int>());
+    for (int index : indexes) {
+        removeAt(index);
+    }
+    return records;
+}
+
+NetWirelessRecord NetWirelessRecords::fromItem(NetWirelessItemPrivate *item)
+{
+    return { item->id(), item->name(), item->flags(), item->strength(), item->isSecure(), item->status() };
+}
+
+NetWirelessItemPrivate *NetWirelessRecords::newItem(const NetWirelessRecord &record, bool hasConnection)
+{
+    NetWirelessItemPrivate *item = NetItemNew(WirelessItem, record.id);
+    item->updatename(record.name);
+    item->updateflags(record.flags);
+    item->updatestrength(record.strength);
+    item->updatesecure(record.secure);
+    item->updatestatus(record.status);
+    item->updatehasConnection(hasConnection);
+    return item;
+}
+
+QVariantMap NetWirelessRecords::properties(const NetWirelessRecord &record)
+{
+    return {
+        { "name", record.name },
+        { "status", int(record.status) },
+        { "flags", record.flags },
+        { "strength", record.strength },
+        { "secure", record.secure },
+        { "hasConnection", false },
+        { "portalUrl", QString() },
+    };
+}
+
+void NetWirelessRecords::removeAt(int index)
+{
+    m_index.remove(m_records.at(index).id);
+    auto it = m_counts.find(m_devices.at(index));
+    if (--it.value() == 0)
+        m_counts.erase(it);
+    const int last = m_records.size() - 1;
+    if (index != last) {
+        m_records[index] = m_records.at(last);
+        m_devices[index] = m_devices.at(last);
+        m_index[m_records.at(index).id] = index;
+    }
+    m_records.removeLast();
+    m_devices.removeLast();
+}
+
+} // namespace network
+} // namespace dde
@@ -0,0 +1,76 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#ifndef NETWIRELESSRECORDS_H
+#define NETWIRELESSRECORDS_H
+
+#include "nettype.h"
+
+#include <QHash>
+#include <QMetaType>
+#include <QString>
+#include <QStringList>
+#include <QVariantMap>
+#include <QVector>
+
+namespace dde {
+namespace network {
+class NetWirelessItemPrivate;
+
+// 无线网络的精简数据，未创建数据项时使用
+struct NetWirelessRecord
+{
+    QString id;
+    QString name;
+    uint flags;
+    int strength;
+    bool secure;
+    NetType::NetConnectionStatus status;
+};
+typedef QVector<NetWirelessRecord> NetWirelessRecordList;
+
+/**
+ * @brief The NetWirelessRecords class
+ * 其他网络中未创建数据项的无线网络
+ * 其他网络收起时只保存精简数据，展开时按信号强度从强到弱分页创建数据项，收起后再转回精简数据
+ * 数据保存在连续数组中，删除时用最后一项填补
+ */
+class NetWirelessRecords
+{
+public:
+    void add(const QString &devPath, const NetWirelessRecord &record);
+    bool remove(const QString &id);
+    void removeDevice(const QString &devPath);
+    void clear();
+    NetWirelessRecord *find(const QString &id);
+    QString devicePath(const QString &id) const;
+    QString findByName(const QString &devPath, const QString &name) const; // 返回id
+    int count(const QString &devPath) const;
+    QStringList devices() const;
+    NetWirelessRecord take(const QString &id);
+    NetWirelessRecordList take(const QString &devPath, int count); // 按信号强度从强到弱取出，count<=0时全部取出
+
+    inline bool contains(const QString &id) const { return m_index.contains(id); }
+
+    inline int size() const { return m_records.size(); }
+
+    static NetWirelessRecord fromItem(NetWirelessItemPrivate *item);
+    static NetWirelessItemPrivate *newItem(const NetWirelessRecord &record, bool hasConnection);
+    static QVariantMap properties(const NetWirelessRecord &record); // 与共享后端中数据项的属性一致
+
+private:
+    void removeAt(int index);
+
+private:
+    QVector<NetWirelessRecord> m_records;
+    QVector<QString> m_devices; // 与m_records对应的设备路径
+    QHash<QString, int> m_index;
+    QHash<QString, int> m_counts; // 每个设备的网络数
+};
+
+} // namespace network
+} // namespace dde
+
+Q_DECLARE_METATYPE(dde::network::NetWirelessRecordList)
+
+#endif // NETWIRELESSRECORDS_H
@@ -9,6 +9,7 @@
 #include "configsetting.h"
 
 #include <QDebug>
+#include <QElapsedTimer>
 #include <QEvent>
 #include <QJsonDocument>
 #include <QTimer>
@@ -63,15 +64,15 @@ NetStatus::NetStatus(NetManager *manager, QObject *parent)
     , m_vpnAndProxyBut(nullptr)
     , m_tipsLabel(nullptr)
     , m_vpnAndProxyIconVisibel(true)
+    , m_dirtyFlags(0)
+    , m_allDevicesDirty(false)
+    , m_devStatus{ NetType::DS_Unknown, NetType::DS_Unknown }
 {
     NetItem *root = m_manager->root();
     connect(root, &NetItem::childRemoved, this, &NetStatus::onChildRemoved);
 
-    connect(this, &NetStatus::networkStatusChanged, this, &NetStatus::updateNetworkTips);
-    connect(this, &NetStatus::networkStatusChanged, this, &NetStatus::updateNetworkIcon);
-    connect(m_manager, &NetManager::languageChange, this, &NetStatus::updateNetworkTips);
-    connect(m_manager, &NetManager::primaryConnectionTypeChanged, this, &NetStatus::updateNetworkIcon);
-    connect(m_manager, &NetManager::primaryConnectionTypeChanged, this, &NetStatus::updateNetworkTips);
+    connect(m_manager, &NetManager::languageChange, this, &NetStatus::onLanguageChanged);
+    connect(m_manager, &NetManager::primaryConnectionTypeChanged, this, &NetStatus::onPrimaryConnectionTypeChanged);
     connect(m_statusTimer, &QTimer::timeout, this, &NetStatus::doUpdateStatus);
     m_statusTimer->setInterval(100);
     m_statusTimer->setSingleShot(true);
@@ -352,6 +353,7 @@ void NetStatus::initQuickData()
     m_quickAnimationTimer = new QTimer(this);
     m_quickAnimationTimer->setInterval(250);
     connect(m_quickAnimationTimer, &QTimer::timeout, this, &NetStatus::nextQuickAnimation);
+    requestUpdate(DirtyQuick);
 }
 
 bool NetStatus::networkActive() const
@@ -401,37 +403,39 @@ void NetStatus::onChildAdded(const NetItem *child)
         switch (obj->itemType()) {
         case NetType::VPNControlItem: {
             const NetVPNControlItem *deviceItem = qobject_cast<const NetVPNControlItem *>(obj);
-            connect(deviceItem, &NetDeviceItem::statusChanged, this, &NetStatus::updateVpnAndProxyStatus);
-            connect(deviceItem, &NetDeviceItem::ipsChanged, this, &NetStatus::updateVpnAndProxyStatus);
-            connect(deviceItem, &NetDeviceItem::nameChanged, this, &NetStatus::updateVpnAndProxyStatus);
-            connect(deviceItem, &NetDeviceItem::enabledableChanged, this, &NetStatus::updateVpnAndProxyStatus);
-            connect(deviceItem, &NetDeviceItem::enabledChanged, this, &NetStatus::updateVpnAndProxyStatus);
-            connect(m_manager, &NetManager::vpnStatusChanged, this, &NetStatus::updateVpnAndProxyStatus);
+            m_vpnControlItem = const_cast<NetVPNControlItem *>(deviceItem);
+            connect(deviceItem, &NetDeviceItem::statusChanged, this, &NetStatus::onVpnAndProxyChanged);
+            connect(deviceItem, &NetDeviceItem::ipsChanged, this, &NetStatus::onVpnAndProxyChanged);
+            connect(deviceItem, &NetDeviceItem::nameChanged, this, &NetStatus::onVpnAndProxyChanged);
+            connect(deviceItem, &NetDeviceItem::enabledableChanged, this, &NetStatus::onVpnAndProxyChanged);
+            connect(deviceItem, &NetDeviceItem::enabledChanged, this, &NetStatus::onVpnAndProxyChanged);
+            connect(m_manager, &NetManager::vpnStatusChanged, this, &NetStatus::onVpnAndProxyChanged, Qt::UniqueConnection);
             updateVpnAndProxyStatus();
         } break;
         case NetType::SystemProxyControlItem: {
             const NetSystemProxyControlItem *deviceItem = qobject_cast<const NetSystemProxyControlItem *>(obj);
-            connect(deviceItem, &NetControlItem::enabledChanged, this, &NetStatus::updateVpnAndProxyStatus);
-            connect(deviceItem, &NetControlItem::enabledableChanged, this, &NetStatus::updateVpnAndProxyStatus);
+            m_systemProxyControlItem = const_cast<NetSystemProxyControlItem *>(deviceItem);
+            connect(deviceItem, &NetControlItem::enabledChanged, this, &NetStatus::onVpnAndProxyChanged);
+            connect(deviceItem, &NetControlItem::enabledableChanged, this, &NetStatus::onVpnAndProxyChanged);
             updateVpnAndProxyStatus();
         } break;
         case NetType::WiredDeviceItem:
         case NetType::WirelessDeviceItem: {
             const NetDeviceItem *deviceItem = qobject_cast<const NetDeviceItem *>(obj);
-            connect(deviceItem, &NetDeviceItem::statusChanged, this, &NetStatus::updateStatus);
+            connect(deviceItem, &NetDeviceItem::statusChanged, this, &NetStatus::onDeviceChanged);
             // 有线网无网线连接时不再发出status变化信号，因此还需要处理enable
-            connect(deviceItem, &NetDeviceItem::enabledChanged, this, &NetStatus::updateStatus);
-            connect(deviceItem, &NetDeviceItem::ipsChanged, this, &NetStatus::updateStatus);
-            connect(deviceItem, &NetDeviceItem::nameChanged, this, &NetStatus::updateStatus);
-            updateStatus();
+            connect(deviceItem, &NetDeviceItem::enabledChanged, this, &NetStatus::onDeviceChanged);
+            connect(deviceItem, &NetDeviceItem::ipsChanged, this, &NetStatus::onDeviceChanged);
+            connect(deviceItem, &NetDeviceItem::nameChanged, this, &NetStatus::onDeviceChanged);
+            markDeviceDirty(deviceItem);
         } break;
         case NetType::WiredItem: {
             const NetWiredItem *item = qobject_cast<const NetWiredItem *>(obj);
-            connect(item, &NetWiredItem::statusChanged, this, &NetStatus::updateStatus);
+            connect(item, &NetWiredItem::statusChanged, this, &NetStatus::onConnectionStatusChanged);
         } break;
         case NetType::WirelessItem: {
             const NetWirelessItem *item = qobject_cast<const NetWirelessItem *>(obj);
-            connect(item, &NetWirelessItem::statusChanged, this, &NetStatus::updateStatus);
+            connect(item, &NetWirelessItem::statusChanged, this, &NetStatus::onConnectionStatusChanged);
             connect(item, &NetWirelessItem::strengthLevelChanged, this, &NetStatus::onStrengthLevelChanged);
         } break;
         default:
@@ -449,33 +453,62 @@ void NetStatus::onChildAdded(const NetItem *child)
 void NetStatus::onChildRemoved(const NetItem *child)
 {
     disconnect(child, nullptr, this, nullptr);
-    updateStatus();
+    m_deviceStates.remove(child);
+    m_dirtyDevices.remove(child);
+    if (child == m_vpnControlItem)
+        m_vpnControlItem = nullptr;
+    if (child == m_systemProxyControlItem)
+        m_systemProxyControlItem = nullptr;
+    // 移除的可能是设备或者连接，已缓存的其他设备状态仍有效，只需重新汇总
+    requestUpdate(DirtyDevice | DirtyIcon | DirtyQuick | DirtyVpnAndProxy);
 }
 
 void NetStatus::onStrengthLevelChanged()
 {
+    // 信号强度只影响当前连接的无线网络的图标
     const NetWirelessItem *item = qobject_cast<const NetWirelessItem *>(sender());
     if (item && item->status() != NetType::CS_UnConnected) {
+        requestUpdate(DirtyIcon);
+    }
+}
+
+void NetStatus::onDeviceChanged()
+{
+    const NetItem *device = qobject_cast<const NetItem *>(sender());
+    if (device) {
+        markDeviceDirty(device);
+    } else {
         updateStatus();
     }
-    updateNetworkIcon();
+}
+
+void NetStatus::onConnectionStatusChanged()
+{
+    // 设备状态会单独通知，连接状态只影响图标和快捷面板中显示的连接
+    requestUpdate(DirtyIcon | DirtyQuick);
+}
+
+void NetStatus::onVpnAndProxyChanged()
+{
+    requestUpdate(DirtyVpnAndProxy);
+}
+
+void NetStatus::onPrimaryConnectionTypeChanged()
+{
+    // IP冲突时是否显示IP与主连接相关
+    m_allDevicesDirty = true;
+    requestUpdate(DirtyDevice | DirtyTips | DirtyIcon | DirtyQuick);
+}
+
+void NetStatus::onLanguageChanged()
+{
+    requestUpdate(DirtyTips | DirtyQuick | DirtyVpnAndProxy);
 }
 
 void NetStatus::updateVpnAndProxyStatus()
 {
-    NetItem *root = m_manager->root();
-    NetVPNControlItem *vpnControlItem = nullptr;
-    NetSystemProxyControlItem *systemProxyControlItem = nullptr;
-    for(const auto &it : root->getChildren()){
-        if (NetType::VPNControlItem == it->itemType()) {
-            vpnControlItem = qobject_cast<NetVPNControlItem *>(it);
-        }
-        if (NetType::SystemProxyControlItem == it->itemType()) {
-            systemProxyControlItem = qobject_cast<NetSystemProxyControlItem *>(it);
-        }
-        if (vpnControlItem && systemProxyControlItem)
-            break;
-    }
+    NetVPNControlItem *vpnControlItem = m_vpnControlItem.data();
+    NetSystemProxyControlItem *systemProxyControlItem = m_systemProxyControlItem.data();
 
     m_vpnItem.Availabled = vpnControlItem && vpnControlItem->enabledable();
     m_vpnItem.Enabled = vpnControlItem && vpnControlItem->isEnabled();
@@ -517,63 +550,137 @@ bool NetStatus::vpnAndProxyIconVisibel() const
 
 void NetStatus::updateStatus()
 {
+    // 无法确定变化来源时，全部重新计算
+    m_allDevicesDirty = true;
+    requestUpdate(DirtyAll);
+}
+
+void NetStatus::requestUpdate(unsigned flags)
+{
+    m_dirtyFlags |= flags;
     if (!m_statusTimer->isActive()) {
         m_statusTimer->start();
     }
 }
 
+void NetStatus::markDeviceDirty(const NetItem *device)
+{
+    m_dirtyDevices.insert(device);
+    requestUpdate(DirtyDevice);
+}
+
 void NetStatus::doUpdateStatus()
 {
-    NetItem *root = m_manager->root();
-    QStringList iphtml[DEVICE_ITEM_COUNT];
-    unsigned devStatus[DEVICE_ITEM_COUNT] = { NetType::DS_Unknown, NetType::DS_Unknown };
-    m_deviceFlag = 0;
-    // 获取各设备状态
-    for(const auto &it : root->getChildren()){
-    // for (auto it = root->childBegin(); it != root->childEnd(); ++it) {
-        int index = WIRELESS_DEVICE_INDEX;
-        switch (it->itemType()) {
-        case NetType::WiredDeviceItem:
-            index = WIRED_DEVICE_INDEX;
-            [[clang::fallthrough]]; // 去无break警告
-        case NetType::WirelessDeviceItem: {
-            NetDeviceItem *devItem = qobject_cast<NetDeviceItem *>(it);
-            bool needShowIp = false;
-            if (devItem && devItem->isEnabled() && !devItem->ips().isEmpty()) {
-                if (devItem->status() == NetType::DS_Connected) {
-                    needShowIp = true;
-                } else if (devItem->status() == NetType::DS_IpConflicted) {
-                    // IP冲突的情况下，如果当前设备是有线连接，且主连接是无线连接，那么此时需显示可上网的图标
-                    // 需要显示IP；相反如果当前设备是无线连接，且主连接是有线连接，那么此时需要显示可上网，需显示IP
-                    if (it->itemType() == NetType::WiredDeviceItem) {
-                        // 获取当前的主连接
-                        needShowIp = (m_manager->primaryConnectionType() == NetManager::Wireless);
-                    } else if (it->itemType() == NetType::WirelessDeviceItem) {
-                        // 如果当前主连接为有线连接，则需要显示IP
-                        needShowIp = (m_manager->primaryConnectionType() == NetManager::Wired);
-                    }
-                }
-            }
-            if (needShowIp) {
-                QStringList ips = devItem->ips();
-                if (ips.count() > 3) {
-                    ips.erase(ips.begin() + 3, ips.end());
-                    ips.append("......");
-                }
-                iphtml[index] << QString("<tr><td>%1 : </td><td>%2</td></tr>").arg(devItem->name()).arg(ips.join("<br/>"));
-            }
-            devStatus[index] |= devItem->status();
+    QElapsedTimer elapsed;
+    elapsed.start();
+    ++m_statistics.updateCount;
+    // 各部分计算过程中可能标记其依赖的部分，按依赖顺序处理
+    if (m_dirtyFlags & DirtyDevice) {
+        m_dirtyFlags &= ~DirtyDevice;
+        updateDeviceStatus();
+    }
+    if (m_dirtyFlags & DirtyVpnAndProxy) {
+        m_dirtyFlags &= ~DirtyVpnAndProxy;
+        ++m_statistics.vpnAndProxyCount;
+        updateVpnAndProxyStatus();
+    }
+    if (m_dirtyFlags & DirtyTips) {
+        m_dirtyFlags &= ~DirtyTips;
+        ++m_statistics.tipsCount;
+        updateNetworkTips();
+    }
+    if (m_dirtyFlags & DirtyIcon) {
+        m_dirtyFlags &= ~DirtyIcon;
+        ++m_statistics.iconCount;
+        updateNetworkIcon();
+    }
+    if (m_dirtyFlags & DirtyQuick) {
+        m_dirtyFlags &= ~DirtyQuick;
+        if (m_quickAnimationTimer)
+            ++m_statistics.quickCount;
+        updateQuick(m_devStatus[WIRELESS_DEVICE_INDEX], m_devStatus[WIRED_DEVICE_INDEX]);
+    }
+    m_statistics.cost += elapsed.nsecsElapsed();
+    qCDebug(DNC) << "Update status statistics, update:" << m_statistics.updateCount << ", device:" << m_statistics.deviceCount
+                 << ", tips:" << m_statistics.tipsCount << ", icon:" << m_statistics.iconCount << ", quick:" << m_statistics.quickCount
+                 << ", vpn and proxy:" << m_statistics.vpnAndProxyCount << ", cost(ns):" << m_statistics.cost;
+}
 
-            m_deviceFlag |= (HAS_WIRELESS_DEVICE << index);
-            if (devItem->isEnabled())
-                m_deviceFlag |= (ENABLED_WIRELESS_DEVICE << index);
-            if (devItem->enabledable())
-                m_deviceFlag |= (ENABLEDABLE_WIRELESS_DEVICE << index);
+void NetStatus::updateDeviceState(const NetItem *device)
+{
+    ++m_statistics.deviceCount;
+    const NetDeviceItem *devItem = qobject_cast<const NetDeviceItem *>(device);
+    if (!devItem) {
+        m_deviceStates.remove(device);
+        return;
+    }
+    DeviceState state;
+    state.index = devItem->itemType() == NetType::WiredDeviceItem ? WIRED_DEVICE_INDEX : WIRELESS_DEVICE_INDEX;
+    state.status = devItem->status();
+    state.enabled = devItem->isEnabled();
+    state.enabledable = devItem->enabledable();
+
+    bool needShowIp = false;
+    if (devItem->isEnabled() && !devItem->ips().isEmpty()) {
+        if (devItem->status() == NetType::DS_Connected) {
+            needShowIp = true;
+        } else if (devItem->status() == NetType::DS_IpConflicted) {
+            // IP冲突的情况下，如果当前设备是有线连接，且主连接是无线连接，那么此时需显示可上网的图标
+            // 需要显示IP；相反如果当前设备是无线连接，且主连接是有线连接，那么此时需要显示可上网，需显示IP
+            if (devItem->itemType() == NetType::WiredDeviceItem) {
+                // 获取当前的主连接
+                needShowIp = (m_manager->primaryConnectionType() == NetManager::Wireless);
+            } else if (devItem->itemType() == NetType::WirelessDeviceItem) {
+                // 如果当前主连接为有线连接，则需要显示IP
+                needShowIp = (m_manager->primaryConnectionType() == NetManager::Wired);
+            }
+        }
+    }
+    if (needShowIp) {
+        QStringList ips = devItem->ips();
+        if (ips.count() > 3) {
+            ips.erase(ips.begin() + 3, ips.end());
+            ips.append("......");
+        }
+        state.ipHtml = QString("<tr><td>%1 : </td><td>%2</td></tr>").arg(devItem->name()).arg(ips.join("<br/>"));
+    }
+    m_deviceStates.insert(device, state);
+}
 
-        } break;
-        default:
-            break;
+void NetStatus::updateDeviceStatus()
+{
+    // 只重新计算发生变化的设备，其余设备使用缓存的状态
+    if (m_allDevicesDirty) {
+        m_allDevicesDirty = false;
+        m_dirtyDevices.clear();
+        m_deviceStates.clear();
+        for (const auto &it : m_manager->root()->getChildren()) {
+            if (it->itemType() == NetType::WiredDeviceItem || it->itemType() == NetType::WirelessDeviceItem)
+                updateDeviceState(it);
         }
+    } else {
+        for (const NetItem *device : std::as_const(m_dirtyDevices))
+            updateDeviceState(device);
+        m_dirtyDevices.clear();
+    }
+
+    QStringList iphtml[DEVICE_ITEM_COUNT];
+    unsigned devStatus[DEVICE_ITEM_COUNT] = { NetType::DS_Unknown, NetType::DS_Unknown };
+    unsigned deviceFlag = 0;
+    bool hasConnectedDevice = false;
+    // 汇总各设备状态
+    for (const DeviceState &state : std::as_const(m_deviceStates)) {
+        if (!state.ipHtml.isEmpty())
+            iphtml[state.index] << state.ipHtml;
+        devStatus[state.index] |= state.status;
+        if (state.status == NetType::DS_Connected)
+            hasConnectedDevice = true;
+
+        deviceFlag |= (HAS_WIRELESS_DEVICE << state.index);
+        if (state.enabled)
+            deviceFlag |= (ENABLED_WIRELESS_DEVICE << state.index);
+        if (state.enabledable)
+            deviceFlag |= (ENABLEDABLE_WIRELESS_DEVICE << state.index);
     }
     iphtml[WIRELESS_DEVICE_INDEX].sort();
     iphtml[WIRED_DEVICE_INDEX].sort();
@@ -584,18 +691,8 @@ void NetStatus::doUpdateStatus()
         bool hasConnectingState = (netStatus == NetType::DS_Connecting) ||
                                   (netStatus == NetType::DS_ObtainingIP) ||
                                   (netStatus == NetType::DS_Authenticating);
-        if (hasConnectingState) {
-            for (const auto &it : root->getChildren()) {
-                if (it->itemType() != NetType::WiredDeviceItem && it->itemType() != NetType::WirelessDeviceItem)
-                    continue;
-
-                NetDeviceItem *devItem = qobject_cast<NetDeviceItem *>(it);
-                if (!devItem || devItem->status() != NetType::DS_Connected)
-                    continue;
-
-                netStatus = NetType::DS_Connected;
-                break;
-            }
+        if (hasConnectingState && hasConnectedDevice) {
+            netStatus = NetType::DS_Connected;
         }
     }
     bool isWirelessStatus = netStatus == devStatus[WIRELESS_DEVICE_INDEX];
@@ -705,8 +802,11 @@ void NetStatus::doUpdateStatus()
         break;
     }
 
+    bool changed = false;
     if (m_networkStatus != networkStatus) {
         m_networkStatus = networkStatus;
+        changed = true;
+        m_dirtyFlags |= DirtyTips | DirtyIcon;
 
         bool hasDevice = m_networkStatus != NetworkStatus::Unknown;
         if (m_hasDevice != hasDevice) {
@@ -718,11 +818,23 @@ void NetStatus::doUpdateStatus()
     QString ipTips = iphtml[WIRELESS_DEVICE_INDEX].join(QString()) + iphtml[WIRED_DEVICE_INDEX].join(QString());
     if (ipTips != m_iphtml) {
         m_iphtml = ipTips;
-        updateNetworkTips();
+        changed = true;
+        m_dirtyFlags |= DirtyTips;
+    }
+    if (m_devStatus[WIRELESS_DEVICE_INDEX] != devStatus[WIRELESS_DEVICE_INDEX] || m_devStatus[WIRED_DEVICE_INDEX] != devStatus[WIRED_DEVICE_INDEX]) {
+        m_devStatus[WIRELESS_DEVICE_INDEX] = devStatus[WIRELESS_DEVICE_INDEX];
+        m_devStatus[WIRED_DEVICE_INDEX] = devStatus[WIRED_DEVICE_INDEX];
+        changed = true;
+        m_dirtyFlags |= DirtyQuick;
+    }
+    if (m_deviceFlag != deviceFlag) {
+        m_deviceFlag = deviceFlag;
+        changed = true;
+    }
+    if (changed) {
+        qCInfo(DNC) << "Update status, wireless network: " << NetType::NetDeviceStatus(devStatus[WIRELESS_DEVICE_INDEX]) << ", wired network: " << NetType::NetDeviceStatus(devStatus[WIRED_DEVICE_INDEX])
+                << ", status: " << networkStatus << ", device flag: " << QString::number(m_deviceFlag, 16) << ", ip: " << m_iphtml;
     }
-    updateQuick(devStatus[WIRELESS_DEVICE_INDEX], devStatus[WIRED_DEVICE_INDEX]);
-    qCInfo(DNC) << "Update status, wireless network: " << NetType::NetDeviceStatus(devStatus[WIRELESS_DEVICE_INDEX]) << ", wired network: " << NetType::NetDeviceStatus(devStatus[WIRED_DEVICE_INDEX])
-            << ", status: " << networkStatus << ", device flag: " << QString::number(m_deviceFlag, 16) << ", ip: " << m_iphtml;
 }
 
 void NetStatus::updateNetworkTips()
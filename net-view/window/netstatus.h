@@ -7,10 +7,12 @@
 #include "private/neticonbutton.h"
 
 #include <QBoxLayout>
+#include <QHash>
 #include <QIcon>
 #include <QLabel>
 #include <QObject>
 #include <QPointer>
+#include <QSet>
 
 class QLabel;
 
@@ -20,6 +22,8 @@ namespace network {
 class NetManager;
 class NetItem;
 class NetWirelessItem;
+class NetVPNControlItem;
+class NetSystemProxyControlItem;
 
 //  网络状态，仅界面无业务
 class NetStatus : public QObject
@@ -69,6 +73,17 @@ public:
         bool Connected;
     };
 
+    // 状态重新计算的统计，时间单位为纳秒
+    struct StatusStatistics {
+        quint64 updateCount = 0;      // doUpdateStatus执行次数
+        quint64 deviceCount = 0;      // 重新计算的设备数
+        quint64 tipsCount = 0;
+        quint64 iconCount = 0;
+        quint64 quickCount = 0;
+        quint64 vpnAndProxyCount = 0;
+        qint64 cost = 0;
+    };
+
     void invokeMenuItem(const QString &menuId);
     bool needShowControlCenter() const;
     const QString contextMenu(bool hasSetting) const;
@@ -98,6 +113,7 @@ public:
     QIcon quickIcon() const;
 
     inline NetworkStatus networkStatus() const { return m_networkStatus; }
+    inline const StatusStatistics &statistics() const { return m_statistics; }
 
 public Q_SLOTS:
     void toggleNetworkActive();
@@ -109,6 +125,11 @@ protected Q_SLOTS:
     void onChildAdded(const NetItem *child);
     void onChildRemoved(const NetItem *child);
     void onStrengthLevelChanged();
+    void onDeviceChanged();
+    void onConnectionStatusChanged();
+    void onVpnAndProxyChanged();
+    void onPrimaryConnectionTypeChanged();
+    void onLanguageChanged();
     void updateStatus();
     void doUpdateStatus();
 
@@ -139,8 +160,30 @@ Q_SIGNALS:
     void quickIconChanged(const QIcon &icon);
 
 private:
+    // 各部分的输入发生变化时标记，在doUpdateStatus中只重新计算标记的部分
+    enum DirtyFlag : unsigned {
+        DirtyDevice = 0x01,      // 设备状态及IP，需重新汇总
+        DirtyTips = 0x02,        // 网络提示
+        DirtyIcon = 0x04,        // 网络图标
+        DirtyQuick = 0x08,       // 快捷面板
+        DirtyVpnAndProxy = 0x10, // VPN和代理的提示及图标
+        DirtyAll = 0x1F,
+    };
+
+    struct DeviceState {
+        int index;
+        unsigned status;
+        bool enabled;
+        bool enabledable;
+        QString ipHtml;
+    };
+
     QVector<NetItem *> getDeviceConnections(unsigned type, unsigned connectType) const;
     void updateItemWidgetSize();
+    void requestUpdate(unsigned flags);
+    void markDeviceDirty(const NetItem *device);
+    void updateDeviceState(const NetItem *device);
+    void updateDeviceStatus();
 
 private:
     NetManager *m_manager;
@@ -178,6 +221,15 @@ private:
     NetIconButton *m_vpnAndProxyBut;
     QLabel *m_tipsLabel;
     bool m_vpnAndProxyIconVisibel;
+
+    unsigned m_dirtyFlags;
+    bool m_allDevicesDirty;
+    QSet<const NetItem *> m_dirtyDevices;
+    QHash<const NetItem *, DeviceState> m_deviceStates;
+    unsigned m_devStatus[2];
+    QPointer<NetVPNControlItem> m_vpnControlItem;
+    QPointer<NetSystemProxyControlItem> m_systemProxyControlItem;
+    StatusStatistics m_statistics;
 };
 
 } // namespace network
@@ -21,6 +21,9 @@
 #include <QSortFilterProxyModel>
 #include <QTimer>
 
+// 展开其他网络时每次加载的网络数，滚动到底部时再加载下一页
+#define WIRELESS_PAGE_SIZE 20
+
 DWIDGET_USE_NAMESPACE
 
 namespace dde {
@@ -41,6 +44,7 @@ NetView::NetView(NetManager *manager)
     setForegroundRole(QPalette::BrightText);
     setFrameShape(QFrame::NoFrame);
 
+    m_manager->setWirelessPageSize(WIRELESS_PAGE_SIZE);
     m_model = new NetModel(this);
     m_model->setRoot(m_manager->root());
 
@@ -297,6 +301,15 @@ void NetView::updateByScrollbar()
             setCurrentIndex(indexAt(posInVp));
     }
     m_updateCurrent = true;
+    fetchMoreIfNeeded();
+}
+
+void NetView::fetchMoreIfNeeded()
+{
+    // 显示区域未占满或滚动到接近底部时加载剩余的网络
+    QScrollBar *bar = verticalScrollBar();
+    if (bar->value() >= bar->maximum() - bar->pageStep())
+        m_manager->fetchMoreWireless();
 }
 
 void NetView::onExec(NetManager::CmdType cmd, const QString &id, const QVariantMap &param)
@@ -479,6 +492,7 @@ void NetView::updateGeometries()
     }
     setFixedHeight(h);
     Q_EMIT updateSize();
+    QMetaObject::invokeMethod(this, "fetchMoreIfNeeded", Qt::QueuedConnection);
 }
 
 QModelIndex NetView::indexAt(const QPoint &p) const
@@ -54,6 +54,7 @@ protected:
 
 protected Q_SLOTS:
     void updateByScrollbar();
+    void fetchMoreIfNeeded();
 
     void onExec(NetManager::CmdType cmd, const QString &id, const QVariantMap &param);
     void onActivated(const QModelIndex &index);
@@ -4,12 +4,14 @@
 #include "netsortproxymodel.h"
 
 #include "netitem.h"
+#include "netmodel.h"
 
 namespace dde {
 namespace network {
 
 NetSortProxyModel::NetSortProxyModel(QObject *parent)
     : QSortFilterProxyModel(parent)
+    , m_sortPending(false)
 {
 }
 
@@ -56,27 +58,51 @@ void NetSortProxyModel::onRowsInserted(const QModelIndex &parent, int first, int
             indexes.append(model->index(j, 0, index));
         }
     }
-    updateSort();
+    // 新插入的行由QSortFilterProxyModel按顺序插入，不需要再排序
 }
 
 void NetSortProxyModel::updateSort()
 {
-    void *send = sender();
-    if (!send)
+    NetItem *item = qobject_cast<NetItem *>(sender());
+    if (!item)
         return;
-    auto model = sourceModel();
-    QList<QModelIndex> indexes;
-    indexes.append(QModelIndex());
-    while (!indexes.isEmpty()) {
-        QModelIndex i = indexes.takeFirst();
-        if (i.internalPointer() == send) {
-            Q_EMIT model->dataChanged(i, i, { sortRole() });
-            break;
-        }
-        for (int j = 0; j < model->rowCount(i); j++) {
-            indexes.append(model->index(j, 0, i));
+    auto it = m_sortItems.find(item);
+    if (it == m_sortItems.end() || it.value().isNull()) {
+        m_sortItems.insert(item, item);
+    }
+    if (!m_sortPending) {
+        m_sortPending = true;
+        QMetaObject::invokeMethod(this, &NetSortProxyModel::doUpdateSort, Qt::QueuedConnection);
+    }
+}
+
+void NetSortProxyModel::doUpdateSort()
+{
+    m_sortPending = false;
+    QHash<NetItem *, QPointer<NetItem>> items;
+    items.swap(m_sortItems);
+    NetModel *model = qobject_cast<NetModel *>(sourceModel());
+    if (!model)
+        return;
+    // 按父项合并变化的行，每个父项只通知一次
+    QHash<QModelIndex, QPair<int, int>> ranges;
+    for (auto &&item : items) {
+        if (item.isNull())
+            continue;
+        QModelIndex index = model->index(item.data());
+        if (!index.isValid())
+            continue;
+        auto it = ranges.find(index.parent());
+        if (it == ranges.end()) {
+            ranges.insert(index.parent(), { index.row(), index.row() });
+        } else {
+            it.value().first = qMin(it.value().first, index.row());
+            it.value().second = qMax(it.value().second, index.row());
         }
     }
+    for (auto it = ranges.cbegin(); it != ranges.cend(); ++it) {
+        Q_EMIT model->dataChanged(model->index(it.value().first, 0, it.key()), model->index(it.value().second, 0, it.key()), { sortRole() });
+    }
 }
 
 } // namespace network
@@ -4,10 +4,13 @@
 #ifndef NETSORTPROXYMODEL_H
 #define NETSORTPROXYMODEL_H
 
+#include <QHash>
+#include <QPointer>
 #include <QSortFilterProxyModel>
 
 namespace dde {
 namespace network {
+class NetItem;
 
 class NetSortProxyModel : public QSortFilterProxyModel
 {
@@ -22,6 +25,12 @@ protected:
 protected Q_SLOTS:
     void onRowsInserted(const QModelIndex &parent, int first, int last);
     void updateSort();
+    void doUpdateSort();
+
+private:
+    // 等待重新排序的项，同一事件循环内只处理一次
+    QHash<NetItem *, QPointer<NetItem>> m_sortItems;
+    bool m_sortPending;
 };
 } // namespace network
 } // namespace dde
@@ -33,6 +33,13 @@ InterfaceServer::InterfaceServer(AccountManager *accountManager, NetworkConfig *
     , m_networkConfig(conf)
     , m_needAuthen(false)
 {
+    // 消息帧的名称为消息类型，数据为JSON；旧连接按JSON中的type分发
+    m_dispatcher.registerHandler("authen", [this](QIODevice *device, const QByteArray &data) {
+        reply(device, authen(data));
+    });
+    m_dispatcher.registerHandler("disconnect", [this](QIODevice *device, const QByteArray &data) {
+        reply(device, disconnectNetwork(data));
+    });
     m_localServer->removeServer("PAMServer");
     m_localServer->setSocketOptions(QLocalServer::WorldAccessOption);
     if (m_localServer->listen("PAMServer")) {
@@ -83,72 +90,119 @@ void InterfaceServer::readyReadHandler()
     if (!socket)
         return;
 
+    // 消息帧以长度开头，第一个字节总是0；旧的客户端直接发送JSON
+    if (!m_codecs.contains(socket) && !m_legacyData.contains(socket)) {
+        char first = 0;
+        if (socket->peek(&first, 1) != 1)
+            return;
+        if (first == 0) {
+            m_codecs.insert(socket, dde::network::LocalFrameCodec());
+        } else {
+            m_legacyData.insert(socket, QByteArray());
+        }
+    }
+
     do {
         if (m_accountManager->account().isEmpty()) {
             QString message = "current account is empty";
             qCWarning(DSM) << message;
-            socket->write(message.toStdString().c_str());
+            reply(socket, message);
             break;
         }
 
-        QByteArray allData = socket->readAll();
+        if (m_codecs.contains(socket)) {
+            dde::network::LocalFrameCodec &codec = m_codecs[socket];
+            if (!m_dispatcher.process(socket, &codec)) {
+                QString errMsg = QString("invalid frame, error:%1").arg(codec.error());
+                qCWarning(DSM) << errMsg;
+                reply(socket, errMsg);
+                break;
+            }
+            // 帧还没有收完整时继续等待
+            if (codec.bufferedSize() != 0)
+                return;
+            break;
+        }
+
+        QByteArray &allData = m_legacyData[socket];
+        allData += socket->readAll();
         qCDebug(DSM) << "Recieve data from client: " << allData;
         QJsonParseError error;
         QJsonDocument json = QJsonDocument::fromJson(allData, &error);
+        // JSON还没有收完整时继续等待，超时后会断开连接
+        if (error.error == QJsonParseError::UnterminatedObject || error.error == QJsonParseError::UnterminatedArray
+            || error.error == QJsonParseError::UnterminatedString || (error.error != QJsonParseError::NoError && error.offset >= allData.size()))
+            return;
         if (!json.isObject()) {
             QString errMsg = QString("json is not valid, error message:%1, content:%2").arg(error.errorString()).arg(QString(allData));
             qCWarning(DSM) << errMsg;
-            socket->write(errMsg.toStdString().c_str());
+            reply(socket, errMsg);
             break;
         }
 
-        QVariantMap authenInfo;
         QJsonObject jsonObject = json.object();
         if (!jsonObject.contains("type")) {
             QString errMsg = "message must contain type";
-            socket->write(errMsg.toStdString().c_str());
+            reply(socket, errMsg);
             break;
         }
-        QString type = jsonObject.value("type").toString();
-        if (type == "authen") {
-            m_authen.clear();
-            m_needAuthen = false;
-            if (jsonObject.contains("identity"))
-                authenInfo.insert("identity", jsonObject.value("identity").toString());
-            if (jsonObject.contains("password"))
-                authenInfo.insert("password", jsonObject.value("password").toString());
-
-            QString account = m_accountManager->account();
-            if (m_accountManager->accountExist(account)) {
-                qCInfo(DSM) << "account exist, start authen, current acocunt:" << account;
-                m_authenInfo[m_accountManager->account()] = authenInfo;
-                emit requestAuthen(authenInfo);
-            } else {
-                // 如果当前账户信息为空，则先记录下认证信息，等待账户返回后，再请求连接
-                qCWarning(DSM) << "account can't exist, wait for it added, account name:" << account;
-                m_authen = authenInfo;
-                m_needAuthen = true;
-            }
-            socket->write("success");
-        } else if (type == "disconnect") {
-            // 这个消息由客户端发送，用于手动断开连接，此时主要用于记录手动断开连接的流程
-            if (!jsonObject.contains("interface") || !jsonObject.contains("id")) {
-                QString message = "does not have interface and id";
-                qCWarning(DSM) << message;
-                socket->write(message.toStdString().c_str());
-                break;
-            }
-            QString id = jsonObject.value("id").toString();
-            QString deviceInterface = jsonObject.value("interface").toString();
-            qCInfo(DSM) << deviceInterface << " disconnect network" << id;
-            m_networkConfig->removeNetwork(m_accountManager->account(), id, deviceInterface);
-            socket->write("success");
-        }
+        m_dispatcher.dispatch(socket, jsonObject.value("type").toString().toUtf8(), allData);
     } while (0);
 
     socket->disconnectFromServer();
 }
 
+QString InterfaceServer::authen(const QByteArray &data)
+{
+    QJsonObject jsonObject = QJsonDocument::fromJson(data).object();
+    QVariantMap authenInfo;
+    m_authen.clear();
+    m_needAuthen = false;
+    if (jsonObject.contains("identity"))
+        authenInfo.insert("identity", jsonObject.value("identity").toString());
+    if (jsonObject.contains("password"))
+        authenInfo.insert("password", jsonObject.value("password").toString());
+
+    QString account = m_accountManager->account();
+    if (m_accountManager->accountExist(account)) {
+        qCInfo(DSM) << "account exist, start authen, current acocunt:" << account;
+        m_authenInfo[m_accountManager->account()] = authenInfo;
+        emit requestAuthen(authenInfo);
+    } else {
+        // 如果当前账户信息为空，则先记录下认证信息，等待账户返回后，再请求连接
+        qCWarning(DSM) << "account can't exist, wait for it added, account name:" << account;
+        m_authen = authenInfo;
+        m_needAuthen = true;
+    }
+    return "success";
+}
+
+QString InterfaceServer::disconnectNetwork(const QByteArray &data)
+{
+    // 这个消息由客户端发送，用于手动断开连接，此时主要用于记录手动断开连接的流程
+    QJsonObject jsonObject = QJsonDocument::fromJson(data).object();
+    if (!jsonObject.contains("interface") || !jsonObject.contains("id")) {
+        QString message = "does not have interface and id";
+        qCWarning(DSM) << message;
+        return message;
+    }
+    QString id = jsonObject.value("id").toString();
+    QString deviceInterface = jsonObject.value("interface").toString();
+    qCInfo(DSM) << deviceInterface << " disconnect network" << id;
+    m_networkConfig->removeNetwork(m_accountManager->account(), id, deviceInterface);
+    return "success";
+}
+
+void InterfaceServer::reply(QIODevice *device, const QString &message)
+{
+    QLocalSocket *socket = qobject_cast<QLocalSocket *>(device);
+    if (m_codecs.contains(socket)) {
+        device->write(dde::network::LocalFrameCodec::encode("result", message.toUtf8()));
+    } else {
+        device->write(message.toStdString().c_str());
+    }
+}
+
 void InterfaceServer::disconnectedHandler()
 {
     QLocalSocket *socket = qobject_cast<QLocalSocket *>(sender());
@@ -156,5 +210,7 @@ void InterfaceServer::disconnectedHandler()
         return;
 
     m_clients.removeAll(socket);
+    m_codecs.remove(socket);
+    m_legacyData.remove(socket);
     socket->deleteLater();
 }
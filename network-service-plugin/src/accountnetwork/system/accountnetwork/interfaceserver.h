@@ -5,6 +5,9 @@
 #ifndef INTERFACESERVER_H
 #define INTERFACESERVER_H
 
+#include "localframecodec.h"
+
+#include <QHash>
 #include <QObject>
 #include <QVariantMap>
 
@@ -38,9 +41,17 @@ private slots:
     void readyReadHandler();
     void disconnectedHandler();
 
+private:
+    QString authen(const QByteArray &data);
+    QString disconnectNetwork(const QByteArray &data);
+    void reply(QIODevice *device, const QString &message);
+
 private:
     QLocalServer *m_localServer;
     QList<QLocalSocket *> m_clients;
+    QHash<QLocalSocket *, dde::network::LocalFrameCodec> m_codecs; // 使用消息帧的连接
+    QHash<QLocalSocket *, QByteArray> m_legacyData;                  // 直接发送JSON的旧连接，收到完整的JSON后处理
+    dde::network::LocalFrameDispatcher m_dispatcher;
     QMap<QString, QVariantMap> m_authenInfo;
     AccountManager *m_accountManager;
     NetworkConfig *m_networkConfig;
@@ -3,21 +3,115 @@
 // SPDX-License-Identifier: LGPL-3.0-or-later
 
 #include "networkconfig.h"
+#include "constants.h"
 
+#include <QCoreApplication>
 #include <QDebug>
 #include <QFile>
+#include <QFileInfo>
 #include <QJsonDocument>
 #include <QJsonArray>
 #include <QJsonObject>
+#include <QThread>
+#include <QTimer>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
 
 using namespace accountnetwork::systemservice;
 
 #define CONFIGFILE "/etc/network/accountnetwork"
 
+// 修改后延迟写入的时间，期间的修改合并为一次写入
+static const int SaveDelay = 500;
+
+NetworkConfigWriter::NetworkConfigWriter(const QString &fileName, QObject *parent)
+    : QObject(parent)
+    , m_fileName(fileName)
+{
+}
+
+bool NetworkConfigWriter::write(const QJsonObject &config)
+{
+    const QByteArray data = QJsonDocument(config).toJson();
+    const QByteArray fileName = QFile::encodeName(m_fileName);
+    const QByteArray tempFileName = fileName + ".tmp";
+
+    int fd = ::open(tempFileName.constData(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        qCWarning(DSM) << "open config file failed:" << tempFileName << strerror(errno);
+        return false;
+    }
+
+    qint64 written = 0;
+    bool ok = true;
+    while (written < data.size()) {
+        const ssize_t size = ::write(fd, data.constData() + written, data.size() - written);
+        if (size < 0) {
+            if (errno == EINTR)
+                continue;
+            qCWarning(DSM) << "write config file failed:" << tempFileName << strerror(errno);
+            ok = false;
+            break;
+        }
+        if (size == 0) {
+            qCWarning(DSM) << "write config file failed:" << tempFileName << "short write," << written << "of" << data.size() << "bytes written";
+            ok = false;
+            break;
+        }
+        written += size;
+    }
+    // 重命名之前数据必须已经落盘，否则掉电后可能得到空文件
+    if (ok && ::fsync(fd) != 0) {
+        qCWarning(DSM) << "sync config file failed:" << tempFileName << strerror(errno);
+        ok = false;
+    }
+    ::close(fd);
+    if (!ok) {
+        ::unlink(tempFileName.constData());
+        return false;
+    }
+    if (::rename(tempFileName.constData(), fileName.constData()) != 0) {
+        qCWarning(DSM) << "rename config file failed:" << fileName << strerror(errno);
+        ::unlink(tempFileName.constData());
+        return false;
+    }
+
+    // 同步目录，保证重命名也已经落盘
+    const QByteArray dirName = QFile::encodeName(QFileInfo(m_fileName).absolutePath());
+    int dirFd = ::open(dirName.constData(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (dirFd >= 0) {
+        ::fsync(dirFd);
+        ::close(dirFd);
+    }
+    return true;
+}
+
 NetworkConfig::NetworkConfig(QObject *parent)
+    : NetworkConfig(CONFIGFILE, parent)
+{
+}
+
+NetworkConfig::NetworkConfig(const QString &fileName, QObject *parent)
     : QObject (parent)
+    , m_fileName(fileName)
+    , m_loaded(false)
+    , m_saveTimer(new QTimer(this))
+    , m_thread(new QThread(this))
+    , m_writer(new NetworkConfigWriter(fileName))
 {
-    loadConfig();
+    m_saveTimer->setSingleShot(true);
+    m_saveTimer->setInterval(SaveDelay);
+    connect(m_saveTimer, &QTimer::timeout, this, &NetworkConfig::saveConfig);
+    m_writer->moveToThread(m_thread);
+    connect(m_thread, &QThread::finished, m_writer, &QObject::deleteLater);
+    m_thread->start();
+    // 服务退出时不一定会析构，退出前把还在等待的修改写入
+    if (QCoreApplication::instance())
+        connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, this, &NetworkConfig::flush);
 }
 
 void NetworkConfig::removeNetwork(const QString &account)
@@ -25,11 +119,14 @@ void NetworkConfig::removeNetwork(const QString &account)
     if (account.isEmpty())
         return;
 
-    if (!m_accountNetwork.contains(account))
+    loadConfig();
+    if (!m_config.contains(account))
         return;
 
     m_accountNetwork.remove(account);
-    saveConfig(m_accountNetwork);
+    m_config.remove(account);
+    // 删除立即写入，不等待合并
+    saveConfig();
 }
 
 void NetworkConfig::removeNetwork(const QString &account, const QString &id, const QString &interfaceName)
@@ -37,38 +134,55 @@ void NetworkConfig::removeNetwork(const QString &account, const QString &id, con
     if (account.isEmpty() || id.isEmpty() || interfaceName.isEmpty())
         return;
 
-    if (!m_accountNetwork.contains(account))
+    QMap<QString, QString> *interfaceIds = accountNetwork(account);
+    if (!interfaceIds)
         return;
 
-    if (!m_accountNetwork[account].contains(interfaceName))
+    if (!interfaceIds->contains(interfaceName))
         return;
 
-    if (m_accountNetwork[account][interfaceName] != id)
+    if (interfaceIds->value(interfaceName) != id)
         return;
 
-    m_accountNetwork[account].remove(interfaceName);
-    saveConfig(m_accountNetwork);
+    interfaceIds->remove(interfaceName);
+    updateAccount(account, true);
 }
 
-NetworkConfig::~NetworkConfig() = default;
+NetworkConfig::~NetworkConfig()
+{
+    flush();
+    m_thread->quit();
+    m_thread->wait();
+}
 
 void NetworkConfig::saveNetwork(const QString &account, const QString &id, const QString &interfaceName)
 {
     if (account.isEmpty() || id.isEmpty() || interfaceName.isEmpty())
         return;
 
-    m_accountNetwork[account][interfaceName] = id;
-    saveConfig(m_accountNetwork);
+    QMap<QString, QString> *interfaceIds = accountNetwork(account);
+    if (!interfaceIds)
+        interfaceIds = &m_accountNetwork[account];
+    else if (interfaceIds->value(interfaceName) == id)
+        return;
+
+    interfaceIds->insert(interfaceName, id);
+    updateAccount(account, false);
 }
 
 QMap<QString, QString> NetworkConfig::network(const QString &account) const
 {
-    return m_accountNetwork.value(account);
+    QMap<QString, QString> *interfaceIds = accountNetwork(account);
+    return interfaceIds ? *interfaceIds : QMap<QString, QString>();
 }
 
-void NetworkConfig::loadConfig()
+void NetworkConfig::loadConfig() const
 {
-    QFile file(CONFIGFILE);
+    if (m_loaded)
+        return;
+
+    m_loaded = true;
+    QFile file(m_fileName);
     if (!file.exists())
         return;
 
@@ -79,34 +193,61 @@ void NetworkConfig::loadConfig()
     if (!json.isObject())
         return;
 
-    m_accountNetwork.clear();
-    QJsonObject topObject = json.object();
-    for (auto it = topObject.begin(); it != topObject.end(); it++) {
-        QJsonObject jsonObject = it.value().toObject();
-        QMap<QString, QString> mapObject;
-        for (auto itid = jsonObject.begin(); itid != jsonObject.end(); itid++) {
-            mapObject[itid.key()] = itid.value().toString();
-        }
-        m_accountNetwork[it.key()] = mapObject;
+    m_config = json.object();
+}
+
+QMap<QString, QString> *NetworkConfig::accountNetwork(const QString &account) const
+{
+    auto it = m_accountNetwork.find(account);
+    if (it != m_accountNetwork.end())
+        return &it.value();
+
+    loadConfig();
+    if (!m_config.contains(account))
+        return nullptr;
+
+    // 第一次访问账户时才从文件内容中解析
+    QJsonObject jsonObject = m_config.value(account).toObject();
+    QMap<QString, QString> mapObject;
+    for (auto itid = jsonObject.begin(); itid != jsonObject.end(); itid++) {
+        mapObject[itid.key()] = itid.value().toString();
     }
+    return &m_accountNetwork.insert(account, mapObject).value();
 }
 
-void NetworkConfig::saveConfig(const QMap<QString, QMap<QString, QString> > &accountNetwork)
+void NetworkConfig::updateAccount(const QString &account, bool immediately)
 {
-    QJsonObject topObject;
-    for (auto it = accountNetwork.begin(); it != accountNetwork.end(); it++) {
-        QJsonObject jsonTypeId;
-        QMap<QString, QString> idType = it.value();
-        for (auto itid = idType.begin(); itid != idType.end(); itid++) {
-            jsonTypeId.insert(itid.key(), itid.value());
-        }
-        topObject.insert(it.key(), jsonTypeId);
+    // 只重新生成修改过的账户，整个文件的序列化在写入线程中进行
+    QJsonObject jsonTypeId;
+    const QMap<QString, QString> &idType = m_accountNetwork[account];
+    for (auto itid = idType.begin(); itid != idType.end(); itid++) {
+        jsonTypeId.insert(itid.key(), itid.value());
     }
-    QJsonDocument json;
-    json.setObject(topObject);
+    m_config.insert(account, jsonTypeId);
+    if (immediately) {
+        saveConfig();
+    } else if (!m_saveTimer->isActive()) {
+        // 定时器已经启动时不重新计时，保证修改最多延迟SaveDelay写入
+        m_saveTimer->start();
+    }
+}
 
-    QFile file(CONFIGFILE);
-    file.open(QFile::OpenModeFlag::WriteOnly);
-    file.write(json.toJson());
-    file.close();
+void NetworkConfig::flush()
+{
+    // 还没有写入的修改立即写入，并等待已经提交的写入全部完成
+    if (m_saveTimer->isActive())
+        saveConfig();
+    QMetaObject::invokeMethod(m_writer, [] {}, Qt::BlockingQueuedConnection);
+}
+
+void NetworkConfig::saveConfig()
+{
+    // 当前的快照包含了所有还在等待的修改
+    m_saveTimer->stop();
+    // QJsonObject是隐式共享的，这里只复制引用，之后修改时才会分离
+    NetworkConfigWriter *writer = m_writer;
+    QJsonObject config = m_config;
+    QMetaObject::invokeMethod(m_writer, [writer, config] {
+        writer->write(config);
+    }, Qt::QueuedConnection);
 }
@@ -7,16 +7,42 @@
 
 #include <QObject>
 #include <QVariantMap>
+#include <QJsonObject>
+
+class QTimer;
+class QThread;
 
 namespace accountnetwork {
 namespace systemservice {
 
+/**
+ * @brief The NetworkConfigWriter class
+ * 在后台线程中序列化配置并写入文件，先写临时文件并同步到磁盘，再重命名替换原文件
+ */
+class NetworkConfigWriter : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit NetworkConfigWriter(const QString &fileName, QObject *parent = Q_NULLPTR);
+    bool write(const QJsonObject &config);
+
+private:
+    QString m_fileName;
+};
+
+/**
+ * @brief The NetworkConfig class
+ * 账户和网络的对应关系，首次使用时才读取文件，每个账户的数据在访问时才解析
+ * 新增的修改延迟一段时间合并写入，删除立即写入，写文件在后台线程中进行，服务退出前写入等待中的修改
+ */
 class NetworkConfig : public QObject
 {
     Q_OBJECT
 
 public:
     NetworkConfig(QObject *parent = Q_NULLPTR);
+    explicit NetworkConfig(const QString &fileName, QObject *parent = Q_NULLPTR);
     ~NetworkConfig();
     void removeNetwork(const QString &account);
     void removeNetwork(const QString &account, const QString &id, const QString &interfaceName);
@@ -24,11 +50,20 @@ public:
     QMap<QString, QString> network(const QString &account) const;
 
 private:
-    void loadConfig();
-    void saveConfig(const QMap<QString, QMap<QString, QString>> &accountNetwork);
+    void loadConfig() const;
+    QMap<QString, QString> *accountNetwork(const QString &account) const;
+    void updateAccount(const QString &account, bool immediately); // 删除立即写入，其他修改延迟合并写入
+    void flush();                                                 // 写入等待中的修改并等待写入完成
+    void saveConfig();
 
 private:
-    QMap<QString, QMap<QString, QString>> m_accountNetwork;
+    QString m_fileName;
+    mutable bool m_loaded;
+    mutable QJsonObject m_config;                                   // 文件中的内容，修改后同步更新
+    mutable QMap<QString, QMap<QString, QString>> m_accountNetwork; // 已经解析过的账户
+    QTimer *m_saveTimer;
+    QThread *m_thread;
+    NetworkConfigWriter *m_writer;
 };
 
 }
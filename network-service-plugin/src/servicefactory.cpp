@@ -70,6 +70,9 @@ QObject *ServiceFactory::createServiceObject(bool isSystem)
         QDBusConnection::RegisterOptions opts = QDBusConnection::ExportAllSlots | QDBusConnection::ExportAllSignals | QDBusConnection::ExportAllProperties;
         network::sessionservice::NetworkProxyChains *networkProxyChains = new network::sessionservice::NetworkProxyChains(*m_dbusConnection, stateHandler, this);
         m_dbusConnection->registerObject("/org/deepin/dde/Network1/ProxyChains", networkProxyChains, opts);
+        // 只导出属性，代理的其他槽函数不能暴露在会话总线上
+        network::sessionservice::NetworkSecretAgentStatus *secretAgentStatus = new network::sessionservice::NetworkSecretAgentStatus(secretAgent, this);
+        m_dbusConnection->registerObject("/org/deepin/dde/Network1/SecretAgent", secretAgentStatus, QDBusConnection::ExportAllProperties);
         return networkProxy;
     }
 }
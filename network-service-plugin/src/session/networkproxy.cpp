@@ -8,6 +8,7 @@
 
 #include <QDBusConnection>
 #include <QDBusMessage>
+#include <QDBusMetaType>
 #include <QFile>
 #include <QGSettings>
 #include <QVariant>
@@ -57,6 +58,7 @@ NetworkProxy::NetworkProxy(QDBusConnection &dbusConnection, NetworkStateHandler
     , m_proxyChildSettingsFtp(nullptr)
     , m_proxyChildSettingsSocks(nullptr)
 {
+    qDBusRegisterMetaType<NMVariantMapMap>();
     if (!QGSettings::isSchemaInstalled(GSettingsIdProxy)) {
         return;
     }
@@ -323,6 +325,14 @@ QString NetworkProxy::GetActiveConnectionInfo()
     return "[]";
 }
 
+NMVariantMapMap NetworkProxy::GetObjects(const QString &kind)
+{
+    network::service::dbusDebug(message().service(), __FUNCTION__);
+    Q_UNUSED(kind)
+
+    return NMVariantMapMap();
+}
+
 QStringList NetworkProxy::GetSupportedConnectionTypes()
 {
     network::service::dbusDebug(message().service(), __FUNCTION__);
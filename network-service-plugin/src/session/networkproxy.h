@@ -9,6 +9,8 @@
 #include <QDBusObjectPath>
 #include <QObject>
 
+#include <NetworkManagerQt/GenericTypes>
+
 class QGSettings;
 
 namespace network {
@@ -109,6 +111,10 @@ class NetworkProxy : public QObject, protected QDBusContext
                 "    <method name='GetActiveConnectionInfo'>\n"
                 "        <arg name='acinfosJSON' type='s' direction='out'></arg>\n"
                 "    </method>\n"
+                "    <method name='GetObjects'>\n"
+                "        <arg name='kind' type='s' direction='in'></arg>\n"
+                "        <arg name='objects' type='a{sa{sv}}' direction='out'></arg>\n"
+                "    </method>\n"
                 "    <method name='GetSupportedConnectionTypes'>\n"
                 "        <arg name='types' type='as' direction='out'></arg>\n"
                 "    </method>\n"
@@ -154,6 +160,11 @@ class NetworkProxy : public QObject, protected QDBusContext
                 "        <arg name='ip' type='s'></arg>\n"
                 "        <arg name='mac' type='s'></arg>\n"
                 "    </signal>\n"
+                "    <signal name='ObjectsChanged'>\n"
+                "        <arg name='kind' type='s'></arg>\n"
+                "        <arg name='changed' type='a{sa{sv}}'></arg>\n"
+                "        <arg name='removed' type='as'></arg>\n"
+                "    </signal>\n"
                 "    <property name='WirelessAccessPoints' type='s' access='read'></property>\n"
                 "    <property name='State' type='u' access='read'></property>\n"
                 "    <property name='Connectivity' type='u' access='read'></property>\n"
@@ -217,6 +228,9 @@ public Q_SLOTS:
     void EnableWirelessHotspotMode(const QDBusObjectPath &devPath);
     QString GetAccessPoints(const QDBusObjectPath &path);
     QString GetActiveConnectionInfo();
+    // 与Devices、Connections、ActiveConnections、WirelessAccessPoints属性对应的类型化数据，以对象路径为键
+    // 设备和连接通过Type字段区分类型，热点通过Device字段指明所在的设备
+    NMVariantMapMap GetObjects(const QString &kind);
     QStringList GetSupportedConnectionTypes();
     bool IsDeviceEnabled(const QDBusObjectPath &devPath);
     bool IsWirelessHotspotModeEnabled(const QDBusObjectPath &devPath);
@@ -228,6 +242,8 @@ public Q_SLOTS:
 Q_SIGNALS:
     void ProxyMethodChanged(const QString &proxyMode);
     void proxyChanged(const QString &type, const QString &value);
+    // 类型化数据的增量，changed为新增或者变化的对象，removed为移除的对象路径
+    void ObjectsChanged(const QString &kind, const NMVariantMapMap &changed, const QStringList &removed);
 
 private Q_SLOTS:
     void onConfigChanged(const QString &key);
@@ -46,11 +46,6 @@ const QStringList EapKeys = { "md5", "fast", "ttls", "peap", "leap" };
 // GetSecrets超时时间，参考NM中nm-secret-agent.c中函数nm_secret_agent_get_secrets里的设置
 #define GET_SECRETS_TIMEOUT 120000
 
-static QMap<QString, void (NetworkSecretAgent::*)(QLocalSocket *, const QByteArray &)> s_FunMap = {
-    { "requestSecrets", &NetworkSecretAgent::requestSecrets },
-    { "secretsResult", &NetworkSecretAgent::secretsResult },
-};
-
 struct SettingItem
 {
     QString settingName;
@@ -64,10 +59,18 @@ NetworkSecretAgent::NetworkSecretAgent(QObject *parent)
     , m_callNextId(0)
     , m_secretService(new SecretService(this))
     , m_waitClientTimer(new QTimer(this))
+    , m_waitTime(0)
+    , m_maxWaitTime(0)
 {
     m_waitClientTimer->setSingleShot(true);
     m_waitClientTimer->setInterval(5000);
     connect(m_waitClientTimer, &QTimer::timeout, this, &NetworkSecretAgent::waitClientTimeOut);
+    m_dispatcher.registerHandler("requestSecrets", [this](QIODevice *device, const QByteArray &data) {
+        requestSecrets(qobject_cast<QLocalSocket *>(device), data);
+    });
+    m_dispatcher.registerHandler("secretsResult", [this](QIODevice *device, const QByteArray &data) {
+        secretsResult(qobject_cast<QLocalSocket *>(device), data);
+    });
     m_server = new QLocalServer(this);
     connect(m_server, &QLocalServer::newConnection, this, &NetworkSecretAgent::newConnectionHandler);
     m_server->setSocketOptions(QLocalServer::WorldAccessOption);
@@ -154,7 +157,7 @@ void NetworkSecretAgent::onGetSecretsTimeout()
         SecretsRequest request = m_calls.at(i);
         if (request.type == SecretsRequest::GetSecrets && request.createTime <= time) {
             qCDebug(DSM()) << "Process finished (Timeout):" << request.ssid;
-            m_calls.removeAt(i);
+            finishRequest(request.callId);
             break;
         }
     }
@@ -223,6 +226,7 @@ void NetworkSecretAgent::newConnectionHandler()
     connect(socket, &QLocalSocket::disconnected, this, &NetworkSecretAgent::disconnectedHandler);
     QTimer::singleShot(GET_SECRETS_TIMEOUT, socket, &QLocalSocket::disconnectFromServer);
     m_clients.append(socket);
+    m_codecs.insert(socket, dde::network::LocalFrameCodec());
     m_waitClientTimer->stop();
     waitClientTimeOut();
 }
@@ -232,6 +236,7 @@ void NetworkSecretAgent::disconnectedHandler()
     auto *socket = dynamic_cast<QLocalSocket *>(sender());
     if (socket) {
         m_clients.removeAll(socket);
+        m_codecs.remove(socket);
         socket->deleteLater();
     }
 }
@@ -242,19 +247,10 @@ void NetworkSecretAgent::readyReadHandler()
     if (!socket)
         return;
 
-    QByteArray allData = socket->readAll();
-    allData = m_lastData + allData;
-    QList<QByteArray> dataArray = allData.split('\n');
-    m_lastData = dataArray.last();
-    for (const QByteArray &data : dataArray) {
-        int keyIndex = data.indexOf(':');
-        if (keyIndex != -1) {
-            QString key = data.left(keyIndex);
-            QByteArray value = data.mid(keyIndex + 1);
-            if (s_FunMap.contains(key)) {
-                (this->*s_FunMap.value(key))(socket, value);
-            }
-        }
+    dde::network::LocalFrameCodec &codec = m_codecs[socket];
+    if (!m_dispatcher.process(socket, &codec)) {
+        qCWarning(DSM()) << "invalid data from client, error:" << codec.error();
+        socket->disconnectFromServer();
     }
 }
 
@@ -366,7 +362,7 @@ void NetworkSecretAgent::vpnDialogReadAllOutput(bool isEnd)
         request->result.insert("secrets", newVpnSecretData);
         dbusConnection().send(request->message.createReply(QVariant::fromValue(request->result)));
         request->status = SecretsRequest::End;
-        m_calls.removeAll(*request);
+        finishRequest(request->callId);
     }
 }
 
@@ -448,7 +444,7 @@ void NetworkSecretAgent::doSecretsResult(QString callId, const QByteArray &data,
         if (isEnd) {
             sendError(Error::UserCanceled, "user canceled", request->message);
             request->status = SecretsRequest::End;
-            m_calls.removeAll(*request);
+            finishRequest(request->callId);
         }
         return;
     }
@@ -460,8 +456,8 @@ void NetworkSecretAgent::doSecretsResult(QString callId, const QByteArray &data,
     if (secrets.size() != settingKeys.size()) {
         sendError(Error::NoSecrets, "secretAgent.askPasswords: length not equal", request->message);
         request->status = SecretsRequest::End;
-        m_calls.removeAll(*request);
         qCWarning(DSM()) << "secretAgent.askPasswords: length not equal" << secrets.size() << settingKeys.size() << secrets << settingKeys << request->inputCache;
+        finishRequest(request->callId);
         return;
     }
     NMStringMap result;
@@ -528,7 +524,7 @@ void NetworkSecretAgent::doSecretsResult(QString callId, const QByteArray &data,
     request->result.insert(request->settingName, setting);
     dbusConnection().send(request->message.createReply(QVariant::fromValue(request->result)));
     request->status = SecretsRequest::End;
-    m_calls.removeAll(*request);
+    finishRequest(request->callId);
 }
 
 void NetworkSecretAgent::runAuthDialog(SecretsRequest &request)
@@ -538,7 +534,7 @@ void NetworkSecretAgent::runAuthDialog(SecretsRequest &request)
     // 无线网密码拉起任务栏网络面板，其他使用密码输入弹窗
     if (connType == "802-11-wireless" && !m_clients.isEmpty()) {
         for (auto &&client : m_clients) {
-            client->write("\nrequestSecrets:" + request.inputCache + "\n");
+            client->write(dde::network::LocalFrameCodec::encode("requestSecrets", request.inputCache));
         }
     } else {
         // run auth dialog
@@ -580,7 +576,12 @@ void NetworkSecretAgent::processNext()
         if (request.status == SecretsRequest::Begin) {
             switch (request.type) {
             case SecretsRequest::GetSecrets:
+                // 同一连接有请求在等待交互时先不处理，用户输入的密码保存后可能直接从密钥环获取
+                if (isConnectionWaiting(request.connectionPath))
+                    break;
                 deleteAfter = processGetSecrets(request);
+                if (deleteAfter)
+                    recordWaitTime(request);
                 break;
             case SecretsRequest::SaveSecrets:
                 deleteAfter = processSaveSecrets(request);
@@ -599,6 +600,79 @@ void NetworkSecretAgent::processNext()
             ++it;
         }
     }
+    startNextInteraction();
+}
+
+void NetworkSecretAgent::finishRequest(const QString &callId)
+{
+    m_calls.removeIf([&callId](const SecretsRequest &request) {
+        return request.callId == callId;
+    });
+    // 请求结束后处理排队和等待中的请求，在事件循环中执行，调用方可能还在使用请求的数据
+    QTimer::singleShot(0, this, &NetworkSecretAgent::processNext);
+}
+
+bool NetworkSecretAgent::hasActiveInteraction() const
+{
+    return std::any_of(m_calls.cbegin(), m_calls.cend(), [](const SecretsRequest &request) {
+        return request.status == SecretsRequest::WaitClient || request.status == SecretsRequest::WaitDialog;
+    });
+}
+
+bool NetworkSecretAgent::isConnectionWaiting(const QDBusObjectPath &connectionPath) const
+{
+    return std::any_of(m_calls.cbegin(), m_calls.cend(), [&connectionPath](const SecretsRequest &request) {
+        return request.type == SecretsRequest::GetSecrets && request.connectionPath == connectionPath
+                && (request.status == SecretsRequest::WaitInteraction || request.status == SecretsRequest::WaitClient || request.status == SecretsRequest::WaitDialog);
+    });
+}
+
+void NetworkSecretAgent::queueInteraction(SecretsRequest &request, const std::function<void(SecretsRequest &)> &interaction)
+{
+    if (hasActiveInteraction()) {
+        request.status = SecretsRequest::WaitInteraction;
+        request.interaction = interaction;
+        qCInfo(DSM()) << "Queue interactive request:" << request.callId << request.connectionPath.path() << ", queue depth:" << queueDepth();
+        return;
+    }
+    recordWaitTime(request);
+    interaction(request);
+}
+
+void NetworkSecretAgent::startNextInteraction()
+{
+    if (hasActiveInteraction())
+        return;
+    auto it = std::find_if(m_calls.begin(), m_calls.end(), [](const SecretsRequest &request) {
+        return request.status == SecretsRequest::WaitInteraction;
+    });
+    if (it == m_calls.end())
+        return;
+    std::function<void(SecretsRequest &)> interaction;
+    interaction.swap(it->interaction);
+    recordWaitTime(*it);
+    qCInfo(DSM()) << "Start queued interactive request:" << it->callId << it->connectionPath.path() << ", waited:" << m_waitTime << "ms, queue depth:" << queueDepth() - 1;
+    interaction(*it);
+}
+
+int NetworkSecretAgent::queueDepth() const
+{
+    return std::count_if(m_calls.cbegin(), m_calls.cend(), [](const SecretsRequest &request) {
+        return request.status == SecretsRequest::WaitInteraction;
+    });
+}
+
+void NetworkSecretAgent::recordWaitTime(const SecretsRequest &request)
+{
+    m_waitTime = QDateTime::currentDateTime().toMSecsSinceEpoch() - request.createTime;
+    m_maxWaitTime = qMax(m_maxWaitTime, m_waitTime);
+    qCDebug(DSM()) << "Secrets request" << request.callId << "waited:" << m_waitTime << "ms, max:" << m_maxWaitTime << "ms";
+}
+
+NetworkSecretAgentStatus::NetworkSecretAgentStatus(NetworkSecretAgent *agent, QObject *parent)
+    : QObject(parent)
+    , m_agent(agent)
+{
 }
 
 bool NetworkSecretAgent::processGetSecrets(SecretsRequest &request)
@@ -634,8 +708,10 @@ bool NetworkSecretAgent::processGetSecrets(SecretsRequest &request)
     if (request.settingName == "vpn") {
         if (request.connection.value("vpn").value("service-type").toString() == ServiceTypeOpenConnect) {
             // 调用nm的VPN对话框
-            request.status = SecretsRequest::WaitDialog;
-            createPendingKey(request);
+            queueInteraction(request, [this](SecretsRequest &req) {
+                req.status = SecretsRequest::WaitDialog;
+                createPendingKey(req);
+            });
             return false;
         } else {
             vpnSecretsData = qdbus_cast<NMStringMap>(request.connection.value("vpn").value("secrets").value<QDBusArgument>());
@@ -651,8 +727,10 @@ bool NetworkSecretAgent::processGetSecrets(SecretsRequest &request)
             }
             if (allowInteraction && !askItems.isEmpty()) {
                 // 调用密码输入对话框
-                request.status = SecretsRequest::WaitDialog;
-                askPasswords(request, askItems, requestNew, secretFlag, propMap);
+                queueInteraction(request, [this, askItems, requestNew, secretFlag, propMap](SecretsRequest &req) {
+                    req.status = SecretsRequest::WaitDialog;
+                    askPasswords(req, askItems, requestNew, secretFlag, propMap);
+                });
                 return false;
             }
         }
@@ -726,8 +804,10 @@ bool NetworkSecretAgent::processGetSecrets(SecretsRequest &request)
             // 属性放前面问询
             props.append(askItems);
             askItems = props;
-            request.status = SecretsRequest::WaitDialog;
-            askPasswords(request, askItems, requestNew, secretFlag, propMap);
+            queueInteraction(request, [this, askItems, requestNew, secretFlag, propMap](SecretsRequest &req) {
+                req.status = SecretsRequest::WaitDialog;
+                askPasswords(req, askItems, requestNew, secretFlag, propMap);
+            });
             return false;
         }
 
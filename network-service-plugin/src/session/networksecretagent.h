@@ -4,16 +4,21 @@
 #ifndef NETWORKSECRETAGENT_H
 #define NETWORKSECRETAGENT_H
 
+#include "localframecodec.h"
+
 #include <NetworkManagerQt/SecretAgent>
 
 #include <QDBusInterface>
 #include <QDBusObjectPath>
 #include <QDateTime>
+#include <QHash>
 #include <QLocalServer>
 #include <QObject>
 #include <QProcess>
 #include <QTimer>
 
+#include <functional>
+
 namespace network {
 namespace sessionservice {
 class SecretService;
@@ -27,7 +32,7 @@ public:
         DeleteSecrets,
     };
 
-    enum Status { Begin, WaitClient, WaitDialog, End };
+    enum Status { Begin, WaitInteraction, WaitClient, WaitDialog, End };
 
     explicit SecretsRequest(Type _type)
         : type(_type)
@@ -65,6 +70,7 @@ public:
     QByteArray inputCache;  // 输入缓存
     QByteArray outputCache; // 输出缓存
     QProcess *process;      // 密码输入框进程
+    std::function<void(SecretsRequest &)> interaction; // 排队中的交互，轮到时执行
 };
 
 // 注册网络密码代理
@@ -72,12 +78,17 @@ public:
 // 注册QLocalServer，供任务栏、锁屏插件通信
 // 需要密码时，同时发给插件，由插件判断该谁处理
 // 120s超时
+// 能从密钥环获取的请求直接应答，需要交互的请求排队依次处理，同一连接的请求等前一个交互结束
 class NetworkSecretAgent : public NetworkManager::SecretAgent
 {
     Q_OBJECT
 public:
     explicit NetworkSecretAgent(QObject *parent = nullptr);
 
+    int queueDepth() const;
+    inline qint64 waitTime() const { return m_waitTime; }
+    inline qint64 maxWaitTime() const { return m_maxWaitTime; }
+
 public Q_SLOTS:
     NMVariantMapMap GetSecrets(const NMVariantMapMap &, const QDBusObjectPath &, const QString &, const QStringList &hints, uint flags) override;
     void SaveSecrets(const NMVariantMapMap &connection, const QDBusObjectPath &connectionPath) override;
@@ -118,6 +129,12 @@ private Q_SLOTS:
 private:
     QString nextId();
     void processNext();
+    void finishRequest(const QString &callId);
+    bool hasActiveInteraction() const;
+    bool isConnectionWaiting(const QDBusObjectPath &connectionPath) const;
+    void queueInteraction(SecretsRequest &request, const std::function<void(SecretsRequest &)> &interaction);
+    void startNextInteraction();
+    void recordWaitTime(const SecretsRequest &request);
     /**
      * @brief processGetSecrets requests
      * @param request the request we are processing
@@ -146,9 +163,32 @@ private:
     QList<SecretsRequest> m_calls;
     QLocalServer *m_server;
     QList<QLocalSocket *> m_clients;
-    QByteArray m_lastData;
+    QHash<QLocalSocket *, dde::network::LocalFrameCodec> m_codecs; // 每个连接的接收缓冲
+    dde::network::LocalFrameDispatcher m_dispatcher;
     SecretService *m_secretService;
     QTimer *m_waitClientTimer;
+    qint64 m_waitTime;
+    qint64 m_maxWaitTime;
+};
+
+// NetworkManager::SecretAgent只导出自己的adaptor，排队情况通过这个对象导出到会话总线
+class NetworkSecretAgentStatus : public QObject
+{
+    Q_OBJECT
+    Q_CLASSINFO("D-Bus Interface", "org.deepin.dde.Network1.SecretAgent")
+    Q_PROPERTY(int QueueDepth READ queueDepth)      // 排队等待交互的请求数
+    Q_PROPERTY(qint64 WaitTime READ waitTime)       // 最近一个请求从收到到开始处理的时间(毫秒)
+    Q_PROPERTY(qint64 MaxWaitTime READ maxWaitTime) // 最长的等待时间(毫秒)
+
+public:
+    explicit NetworkSecretAgentStatus(NetworkSecretAgent *agent, QObject *parent = nullptr);
+
+    int queueDepth() const { return m_agent->queueDepth(); }
+    qint64 waitTime() const { return m_agent->waitTime(); }
+    qint64 maxWaitTime() const { return m_agent->maxWaitTime(); }
+
+private:
+    NetworkSecretAgent *m_agent;
 };
 } // namespace sessionservice
 } // namespace network
@@ -20,6 +20,12 @@ const QString KeyringTagConnUUID = "connection-uuid";
 const QString KeyringTagSettingName = "setting-name";
 const QString KeyringTagSettingKey = "setting-key";
 
+// 条目属性缓存的有效期(毫秒)
+const qint64 AttributesCacheTimeout = 10000;
+// 耗时分布的桶数和输出间隔(次数)
+const int FetchHistogramBuckets = 12;
+const int FetchHistogramReportInterval = 32;
+
 struct SecretsData
 {
     QDBusObjectPath session;
@@ -50,6 +56,8 @@ SecretService::SecretService(QObject *parent)
     : QObject(parent)
     , m_secretService(nullptr)
     , m_defaultCollection(nullptr)
+    , m_fetchHistogram(FetchHistogramBuckets, 0)
+    , m_fetchCount(0)
 {
     qDBusRegisterMetaType<SecretsData>();
     qDBusRegisterMetaType<QMap<QDBusObjectPath, SecretsData>>();
@@ -149,6 +157,8 @@ void SecretService::tryUnlockCollection(QDBusInterface *collection)
 
 QMap<QString, QString> SecretService::getAll(const QString &uuid, const QString &settingName)
 {
+    QElapsedTimer timer;
+    timer.start();
     getDefaultCollection();
     if (!m_defaultCollection) {
         qCWarning(DSM()) << "Unlock collection";
@@ -162,7 +172,14 @@ QMap<QString, QString> SecretService::getAll(const QString &uuid, const QString
         return {};
     }
     QList<QDBusObjectPath> items = reply.value();
+    if (items.isEmpty()) {
+        recordFetchTime(timer.elapsed());
+        return {};
+    }
+    // GetSecrets和各条目的属性读取同时发出，再统一等待结果
     QDBusPendingReply<SecretsDataMap> secretsDataReply = m_secretService->asyncCall("GetSecrets", QVariant::fromValue(items), QDBusObjectPath(m_secretSessionPath));
+    const QHash<QString, QString> settingKeys = itemSettingKeys(uuid, items);
+    secretsDataReply.waitForFinished();
     if (secretsDataReply.isError()) {
         qCWarning(DSM()) << "GetSecrets error:" << secretsDataReply.error();
         return {};
@@ -170,21 +187,72 @@ QMap<QString, QString> SecretService::getAll(const QString &uuid, const QString
     QMap<QString, QString> result;
     SecretsDataMap secretsDataMap = secretsDataReply.value();
     for (auto it = secretsDataMap.begin(); it != secretsDataMap.end(); ++it) {
-        QDBusMessage msg = QDBusMessage::createMethodCall(SecretsService, it.key().path(), "org.freedesktop.DBus.Properties", "Get");
+        QString settingKey = settingKeys.value(it.key().path());
+        if (!settingKey.isEmpty()) {
+            result.insert(settingKey, it.value().value);
+        }
+    }
+    recordFetchTime(timer.elapsed());
+    return result;
+}
+
+QHash<QString, QString> SecretService::itemSettingKeys(const QString &uuid, const QList<QDBusObjectPath> &items)
+{
+    // 清理过期的缓存
+    for (auto it = m_attributesCache.begin(); it != m_attributesCache.end();) {
+        if (it->timer.hasExpired(AttributesCacheTimeout)) {
+            it = m_attributesCache.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    auto cacheIt = m_attributesCache.find(uuid);
+    if (cacheIt == m_attributesCache.end()) {
+        cacheIt = m_attributesCache.insert(uuid, {});
+        cacheIt->timer.start();
+    }
+    QHash<QString, QString> &settingKeys = cacheIt->settingKeys;
+    // 缓存中没有的条目同时读取属性
+    QList<QPair<QString, QDBusPendingCall>> pendingCalls;
+    for (const QDBusObjectPath &item : items) {
+        if (settingKeys.contains(item.path()))
+            continue;
+        QDBusMessage msg = QDBusMessage::createMethodCall(SecretsService, item.path(), "org.freedesktop.DBus.Properties", "Get");
         msg << "org.freedesktop.Secret.Item" << "Attributes";
-        QDBusPendingReply<QDBusVariant> attributesReply = QDBusConnection::sessionBus().asyncCall(msg);
+        pendingCalls.append({ item.path(), QDBusConnection::sessionBus().asyncCall(msg) });
+    }
+    for (const auto &pendingCall : pendingCalls) {
+        QDBusPendingReply<QDBusVariant> attributesReply = pendingCall.second;
         attributesReply.waitForFinished();
         if (attributesReply.isError()) {
-            qCWarning(DSM()) << "get Attributes" << it.key().path() << "failed:" << attributesReply.error();
+            // 失败的不缓存，下次重新读取
+            qCWarning(DSM()) << "get Attributes" << pendingCall.first << "failed:" << attributesReply.error();
             continue;
         }
         auto attributes = qdbus_cast<QMap<QString, QString>>(attributesReply.value().variant());
-        QString settingKey = attributes.value(KeyringTagSettingKey);
-        if (!settingKey.isEmpty()) {
-            result.insert(settingKey, it.value().value);
-        }
+        settingKeys.insert(pendingCall.first, attributes.value(KeyringTagSettingKey));
     }
-    return result;
+    return settingKeys;
+}
+
+void SecretService::recordFetchTime(qint64 msecs)
+{
+    int bucket = 0;
+    while (bucket < m_fetchHistogram.size() - 1 && (qint64(1) << bucket) <= msecs)
+        ++bucket;
+    ++m_fetchHistogram[bucket];
+    ++m_fetchCount;
+    qCDebug(DSM()) << "get secrets finished, elapsed:" << msecs << "ms";
+    if (m_fetchCount % FetchHistogramReportInterval != 0)
+        return;
+    QStringList buckets;
+    for (int i = 0; i < m_fetchHistogram.size(); i++) {
+        if (m_fetchHistogram.at(i) == 0)
+            continue;
+        const QString range = (i == m_fetchHistogram.size() - 1) ? QString(">=%1").arg(qint64(1) << (i - 1)) : QString("<%1").arg(qint64(1) << i);
+        buckets << QString("%1ms:%2").arg(range).arg(m_fetchHistogram.at(i));
+    }
+    qCInfo(DSM()) << "get secrets latency, count:" << m_fetchCount << ", histogram:" << buckets.join(" ");
 }
 
 QString SecretService::deleteAll(const QString &uuid)
@@ -194,6 +262,7 @@ QString SecretService::deleteAll(const QString &uuid)
         qCWarning(DSM()) << "Unlock collection";
         return "Unlock collection";
     }
+    m_attributesCache.remove(uuid);
     QMap<QString, QString> attributes = { { KeyringTagConnUUID, uuid } };
     QDBusPendingReply<QList<QDBusObjectPath>> reply = m_defaultCollection->asyncCall("SearchItems", QVariant::fromValue(attributes));
     reply.waitForFinished();
@@ -221,6 +290,7 @@ QString SecretService::deleteData(const QString &uuid, const QString &settingNam
         qCWarning(DSM()) << "Unlock collection";
         return "Unlock collection";
     }
+    m_attributesCache.remove(uuid);
     QMap<QString, QString> attributes = { { KeyringTagConnUUID, uuid }, { KeyringTagSettingName, settingName }, { KeyringTagSettingKey, settingKey } };
     QDBusPendingReply<QList<QDBusObjectPath>> reply = m_defaultCollection->asyncCall("SearchItems", QVariant::fromValue(attributes));
     reply.waitForFinished();
@@ -251,6 +321,7 @@ QString SecretService::setData(const QString &label, const QString &uuid, const
     itemSecret.session = QDBusObjectPath(m_secretSessionPath);
     itemSecret.value = value.toUtf8();
     itemSecret.contentType = "text/plain";
+    m_attributesCache.remove(uuid);
 
     QMap<QString, QString> attributes = { { KeyringTagConnUUID, uuid }, { KeyringTagSettingName, settingName }, { KeyringTagSettingKey, settingKey } };
 
@@ -5,7 +5,11 @@
 #define SECRETSERVICE_H
 
 #include <QDBusInterface>
+#include <QDBusObjectPath>
+#include <QElapsedTimer>
+#include <QHash>
 #include <QObject>
+#include <QVector>
 
 namespace network {
 namespace sessionservice {
@@ -29,10 +33,24 @@ public Q_SLOTS:
 private Q_SLOTS:
     void onCompleted(bool dismissed, QDBusVariant result);
 
+private:
+    QHash<QString, QString> itemSettingKeys(const QString &uuid, const QList<QDBusObjectPath> &items); // 条目路径 -> setting-key
+    void recordFetchTime(qint64 msecs);
+
 private:
     QString m_secretSessionPath;
     QDBusInterface *m_secretService;
     QDBusInterface *m_defaultCollection;
+    // 按连接UUID短时间缓存条目的setting-key，避免连续获取密码时逐个读取属性
+    struct AttributesCache
+    {
+        QElapsedTimer timer;
+        QHash<QString, QString> settingKeys;
+    };
+    QHash<QString, AttributesCache> m_attributesCache;
+    // getAll耗时分布，第i个桶为小于2^i毫秒，最后一个桶包含更长的耗时
+    QVector<int> m_fetchHistogram;
+    int m_fetchCount;
 };
 } // namespace sessionservice
 } // namespace network
@@ -35,6 +35,13 @@ LocalConnectionvityChecker::LocalConnectionvityChecker(QObject *parent)
     connect(m_statusChecker, &StatusChecker::portalDetected, this, &LocalConnectionvityChecker::onPortalDetected);
     connect(m_statusChecker, &StatusChecker::connectivityChanged, this, &LocalConnectionvityChecker::onConnectivityChanged);
     m_thread->start();
+    // 主连接或者DNS配置变化后，之前缓存的域名解析结果和连接都不再可信
+    connect(NetworkManager::notifier(), &NetworkManager::Notifier::primaryConnectionChanged, this, [] {
+        network::service::HttpManager::resetCache();
+    });
+    connect(NetworkManager::notifier(), &NetworkManager::Notifier::globalDnsConfigurationChanged, this, [] {
+        network::service::HttpManager::resetCache();
+    });
     QMetaObject::invokeMethod(m_statusChecker, &StatusChecker::initConnectivityChecker, Qt::QueuedConnection);
     if (SettingConfig::instance()->needCheckNetwork()) {
         m_internetCheckerThread = new QThread(this);
@@ -279,37 +286,13 @@ void StatusChecker::realStartCheck()
     QString prePrimaryId = !prePrimary.isNull() ? prePrimary->connection()->uuid() : QString();
 
     int httpTimeout = SettingConfig::instance()->httpRequestTimeout();
-    bool networkIsOk = false;
-    for (const QString &url : m_checkUrls) {
-        network::service::HttpManager http;
-        network::service::HttpReply *httpReply = http.get(url, httpTimeout);
-        if (m_isStop) {
-            qCDebug(DSM) << "Stop check connectivity";
-            break;
-        }
-        if (httpReply->isTimeout()) {
-            // 如果是读取超时了，则无需进行第二次检测，一般超时的情况下基本上都是网络不通
-            qCWarning(DSM) << "request network timeout";
-            break;
-        }
-        int httpCode = httpReply->httpCode();
-        if (httpCode == 0) {
-            qCWarning(DSM) << "Nework is unreachabel:" << url << httpReply->errorMessage();
-            continue;
-        }
-
-        QString portalUrl = httpReply->portal();
-        networkIsOk = true;
-        qCDebug(DSM) << "Http reply code:" << httpCode << ", portal url:" << portalUrl;
-        if (portalUrl.isEmpty()) {
-            // if the portal is empty, I think it ok
-            setConnectivity(network::service::Connectivity::Full);
-        } else {
-            setConnectivity(network::service::Connectivity::Portal);
-        }
-        setPortalUrl(portalUrl);
-        break;
-    }
+    bool networkIsOk = (SettingConfig::instance()->concurrentConnectivityCheck() && m_checkUrls.size() > 1)
+            ? checkUrlsConcurrently(httpTimeout)
+            : checkUrlsSerially(httpTimeout);
+    const network::service::HttpProbeStatistics statistics = network::service::HttpManager::statistics();
+    qCDebug(DSM) << "Probe statistics, request:" << statistics.requestCount << ", reused connection:" << statistics.reusedConnectionCount
+                 << ", cached dns:" << statistics.cachedDnsCount << ", dns:" << statistics.dnsTime << "ms, connect:" << statistics.connectTime
+                 << "ms, first byte:" << statistics.firstByteTime << "ms";
     // HTTP 检查完成后，再获取当前主连接，以检测检查期间是否发生了连接切换
     NetworkManager::ActiveConnection::Ptr pConnection = NetworkManager::primaryConnection();
     if (!pConnection.isNull()) {
@@ -335,6 +318,66 @@ void StatusChecker::realStartCheck()
     }
 }
 
+bool StatusChecker::checkUrlsSerially(int httpTimeout)
+{
+    for (const QString &url : m_checkUrls) {
+        network::service::HttpManager http;
+        network::service::HttpReply *httpReply = http.get(url, httpTimeout);
+        if (m_isStop) {
+            qCDebug(DSM) << "Stop check connectivity";
+            break;
+        }
+        if (httpReply->isTimeout()) {
+            // 如果是读取超时了，则无需进行第二次检测，一般超时的情况下基本上都是网络不通
+            qCWarning(DSM) << "request network timeout";
+            break;
+        }
+        if (httpReply->httpCode() == 0) {
+            qCWarning(DSM) << "Nework is unreachabel:" << url << httpReply->errorMessage();
+            continue;
+        }
+
+        updateConnectivityByReply(httpReply);
+        return true;
+    }
+
+    return false;
+}
+
+// 同时请求所有的检测地址，第一个返回确定结论（2xx或者认证地址）的请求即为检测结果，其余请求会被取消
+bool StatusChecker::checkUrlsConcurrently(int httpTimeout)
+{
+    network::service::HttpManager http;
+    network::service::HttpReply *httpReply = http.getFirst(m_checkUrls, httpTimeout, [this] {
+        return m_isStop;
+    });
+    if (m_isStop) {
+        qCDebug(DSM) << "Stop check connectivity";
+        return false;
+    }
+    if (httpReply->httpCode() == 0) {
+        qCWarning(DSM) << "Nework is unreachabel:" << m_checkUrls << httpReply->errorMessage();
+        return false;
+    }
+
+    qCInfo(DSM) << "Connectivity resolved by" << httpReply->url() << "in" << httpReply->elapsed() << "ms";
+    updateConnectivityByReply(httpReply);
+    return true;
+}
+
+void StatusChecker::updateConnectivityByReply(network::service::HttpReply *httpReply)
+{
+    QString portalUrl = httpReply->portal();
+    qCDebug(DSM) << "Http reply code:" << httpReply->httpCode() << ", portal url:" << portalUrl;
+    if (portalUrl.isEmpty()) {
+        // if the portal is empty, I think it ok
+        setConnectivity(network::service::Connectivity::Full);
+    } else {
+        setConnectivity(network::service::Connectivity::Portal);
+    }
+    setPortalUrl(portalUrl);
+}
+
 // 如果当前定时器没有激活，则立即执行请求，并把后续1s内的请求合并为一次请求
 // 不是一个完美的方案，但是可以大大减少请求的次数（特别是待机唤醒的场景）。
 void StatusChecker::startCheck()
@@ -17,6 +17,10 @@ class ActiveConnection;
 } // namespace NetworkManager
 
 namespace network {
+namespace service {
+class HttpReply;
+} // namespace service
+
 namespace systemservice {
 
 class StatusChecker;
@@ -94,6 +98,9 @@ private:
     void setConnectivity(const network::service::Connectivity &connectivity);
     void setPortalUrl(const QString &portalUrl);
     void initDefaultConnectivity();
+    bool checkUrlsSerially(int httpTimeout);
+    bool checkUrlsConcurrently(int httpTimeout);
+    void updateConnectivityByReply(network::service::HttpReply *httpReply);
 
 private slots:
     void onUpdataActiveState(const QSharedPointer<NetworkManager::ActiveConnection> &networks);
@@ -4,14 +4,11 @@
 
 #include "internetchecker.h"
 
-#include "httpmanager.h"
 #include "settingconfig.h"
 #include "constants.h"
 
 #include <QDebug>
 #include <QTimer>
-#include <QElapsedTimer>
-#include <QEventLoop>
 
 #include <NetworkManagerQt/Manager>
 #include <NetworkManagerQt/ActiveConnection>
@@ -21,18 +18,40 @@
 
 using namespace network::systemservice;
 
+// 主连接切换后最多检测的次数
+static const int MaxVerifyCount = 3;
+// 等待路由和DHCP就绪的最长时间，超时后直接检测
+static const int RouteReadyTimeout = 1000;
+
 InternetChecker::InternetChecker(QObject *parent)
     : QObject(parent)
     , m_tryIndex(0)
     , m_switchTimer(nullptr)
     , m_isSwitching(false)
+    , m_stage(CheckStage::Idle)
+    , m_retryCount(0)
+    , m_probe(new network::service::HttpProbe(this))
+    , m_routeTimer(new QTimer(this))
 {
+    m_routeTimer->setSingleShot(true);
+    m_routeTimer->setInterval(RouteReadyTimeout);
+    connect(m_routeTimer, &QTimer::timeout, this, [this] {
+        if (m_stage != CheckStage::WaitRoute)
+            return;
+
+        qCDebug(DSM) << "Wait route ready timeout, check internet directly";
+        clearRouteWatch();
+        startProbe(CheckStage::VerifyPrimary);
+    });
+    connect(m_probe, &network::service::HttpProbe::finished, this, &InternetChecker::onProbeFinished);
     connect(NetworkManager::notifier(), &NetworkManager::Notifier::primaryConnectionChanged,
             this, &InternetChecker::onPrimaryConnectionChanged);
 }
 
 InternetChecker::~InternetChecker()
 {
+    clearRouteWatch();
+    m_probe->abort();
     if (m_switchTimer) {
         m_switchTimer->stop();
         m_switchTimer->deleteLater();
@@ -101,83 +120,151 @@ void InternetChecker::setPrimaryDeviceNeverDefault(bool neverDefault) const
     }
 }
 
-bool InternetChecker::checkInternetAccessible() const
+void InternetChecker::changeDeviceNeverDefault(const NetworkManager::Device::Ptr &device, bool neverDefault) const
 {
-    bool timedOut = false;
-    return checkInternetAccessible(0, timedOut);
+    if (device.isNull())
+        return;
+
+    NetworkManager::ActiveConnection::Ptr activeConn = device->activeConnection();
+    if (activeConn.isNull())
+        return;
+
+    NetworkManager::Connection::Ptr conn = activeConn->connection();
+    setConnectionNeverDefault(conn, device, neverDefault);
 }
 
-bool InternetChecker::checkInternetAccessible(int timeoutSec, bool &timedOut) const
+void InternetChecker::startProbe(CheckStage stage)
 {
-    timedOut = false;
-
-    const QStringList checkUrls = SettingConfig::instance()->networkCheckerUrls();
-    for (const QString &url : checkUrls) {
-        network::service::HttpManager http;
-        network::service::HttpReply *httpReply = (timeoutSec > 0)
-                ? http.get(url, timeoutSec)
-                : http.get(url);
-        if (httpReply->httpCode() != 0) {
-            return true;
-        }
-        if (httpReply->isTimeout()) {
-            timedOut = true;
-            break;
-        }
+    m_stage = stage;
+    const QStringList urls = SettingConfig::instance()->networkCheckerUrls();
+    if (SettingConfig::instance()->concurrentConnectivityCheck() && urls.size() > 1) {
+        m_probeUrls.clear();
+        m_probe->start(urls, SettingConfig::instance()->httpRequestTimeout());
+        return;
     }
-    return false;
+    // 默认逐个检测，和 StatusChecker 的检测方式保持一致
+    m_probeUrls = urls;
+    if (!probeNextUrl())
+        m_probe->start(QStringList(), SettingConfig::instance()->httpRequestTimeout());
 }
 
-bool InternetChecker::checkInternetAccessibleWithRetry(int maxRetry) const
+bool InternetChecker::probeNextUrl()
 {
-    int httpTimeout = SettingConfig::instance()->httpRequestTimeout();
-    for (int i = 0; i < maxRetry; ++i) {
-        // 每次检测前等待1秒，让NM路由表和DHCP先稳定
-        {
-            QEventLoop loop;
-            QTimer::singleShot(1000, &loop, &QEventLoop::quit);
-            loop.exec();
-        }
-        bool timedOut = false;
-        // 首次使用20秒超时，避免在无网线路由器的环境中长时间阻塞
-        QElapsedTimer timer;
-        timer.start();
-        if (checkInternetAccessible((i == 0) ? httpTimeout : 0, timedOut)) {
-            return true;
-        }
-        if (timedOut) {
-            qCDebug(DSM) << "Request timed out after" << timer.elapsed() << "ms, skipping retries";
-            return false;
-        }
+    if (m_probeUrls.isEmpty())
+        return false;
+
+    m_probe->start({ m_probeUrls.takeFirst() }, SettingConfig::instance()->httpRequestTimeout());
+    return true;
+}
+
+bool InternetChecker::isRouteReady() const
+{
+    NetworkManager::ActiveConnection::Ptr primaryConn = NetworkManager::primaryConnection();
+    if (primaryConn.isNull())
+        return false;
+
+    return primaryConn->state() == NetworkManager::ActiveConnection::Activated
+            && (primaryConn->default4() || primaryConn->default6());
+}
+
+void InternetChecker::waitForRoute()
+{
+    clearRouteWatch();
+    m_stage = CheckStage::WaitRoute;
+    // 第一次检测时如果路由已经就绪则立即检测，重试时需要等路由或DHCP有变化后再检测
+    if (m_retryCount == 0 && isRouteReady()) {
+        startProbe(CheckStage::VerifyPrimary);
+        return;
     }
-    return false;
+
+    NetworkManager::ActiveConnection::Ptr primaryConn = NetworkManager::primaryConnection();
+    if (!primaryConn.isNull()) {
+        NetworkManager::ActiveConnection *conn = primaryConn.data();
+        m_routeConnections << connect(conn, &NetworkManager::ActiveConnection::stateChanged, this, &InternetChecker::onRouteReadyChanged);
+        m_routeConnections << connect(conn, &NetworkManager::ActiveConnection::default4Changed, this, &InternetChecker::onRouteReadyChanged);
+        m_routeConnections << connect(conn, &NetworkManager::ActiveConnection::default6Changed, this, &InternetChecker::onRouteReadyChanged);
+        m_routeConnections << connect(conn, &NetworkManager::ActiveConnection::ipV4ConfigChanged, this, &InternetChecker::onRouteReadyChanged);
+        m_routeConnections << connect(conn, &NetworkManager::ActiveConnection::ipV6ConfigChanged, this, &InternetChecker::onRouteReadyChanged);
+        m_routeConnections << connect(conn, &NetworkManager::ActiveConnection::dhcp4ConfigChanged, this, &InternetChecker::onRouteReadyChanged);
+        m_routeConnections << connect(conn, &NetworkManager::ActiveConnection::dhcp6ConfigChanged, this, &InternetChecker::onRouteReadyChanged);
+    }
+    m_routeTimer->start();
 }
 
-void InternetChecker::changeDeviceNeverDefault(const NetworkManager::Device::Ptr &device, bool neverDefault) const
+void InternetChecker::clearRouteWatch()
 {
-    if (device.isNull())
+    m_routeTimer->stop();
+    for (const QMetaObject::Connection &connection : m_routeConnections)
+        disconnect(connection);
+    m_routeConnections.clear();
+}
+
+void InternetChecker::onRouteReadyChanged()
+{
+    if (m_stage != CheckStage::WaitRoute || !isRouteReady())
         return;
 
-    NetworkManager::ActiveConnection::Ptr activeConn = device->activeConnection();
-    if (activeConn.isNull())
+    qCDebug(DSM) << "Route of primary connection is ready, check internet";
+    clearRouteWatch();
+    startProbe(CheckStage::VerifyPrimary);
+}
+
+void InternetChecker::onProbeFinished(network::service::HttpReply *reply)
+{
+    bool accessible = (reply->httpCode() != 0);
+    // 逐个检测时当前地址不通则检测下一个，超时说明网络基本不通，无需再检测其余地址
+    if (!accessible && !reply->isTimeout() && probeNextUrl())
         return;
 
-    NetworkManager::Connection::Ptr conn = activeConn->connection();
-    setConnectionNeverDefault(conn, device, neverDefault);
+    m_probeUrls.clear();
+    CheckStage stage = m_stage;
+    m_stage = CheckStage::Idle;
+    switch (stage) {
+    case CheckStage::CheckPrimary:
+        if (accessible) {
+            qCInfo(DSM) << "Primary connection is accessible, skip switching";
+            m_isSwitching = false;
+            emit switchSuccess();
+        } else {
+            startSwitch();
+        }
+        break;
+    case CheckStage::VerifyPrimary:
+        if (accessible) {
+            onVerifyFinished(true);
+        } else if (reply->isTimeout()) {
+            qCDebug(DSM) << "Request timed out after" << reply->elapsed() << "ms, skipping retries";
+            onVerifyFinished(false);
+        } else if (++m_retryCount < MaxVerifyCount) {
+            qCDebug(DSM) << "Internet is not accessible, wait route ready and retry, count:" << m_retryCount;
+            waitForRoute();
+        } else {
+            onVerifyFinished(false);
+        }
+        break;
+    default:
+        break;
+    }
 }
 
 void InternetChecker::onPrimaryConnectionChanged(const QString &uni)
 {
-    Q_UNUSED(uni)
-
     // 停止超时定时器
     if (m_switchTimer) {
         m_switchTimer->stop();
     }
 
     qCInfo(DSM) << "Primary connection changed:" << uni;
-    // NM已切换主连接，通过默认路由检测整体是否可以上网（重试3次，等待DHCP/路由生效）
-    if (checkInternetAccessibleWithRetry(3)) {
+    // NM已切换主连接，等待路由和DHCP就绪后通过默认路由检测整体是否可以上网（最多检测3次）
+    m_probe->abort();
+    m_probeUrls.clear();
+    m_retryCount = 0;
+    waitForRoute();
+}
+
+void InternetChecker::onVerifyFinished(bool accessible)
+{
+    if (accessible) {
         qCInfo(DSM) << "Found accessible device, switching done";
         // 当前主设备已经是能上网的，它的never-default本来就是false，无需额外操作
         // 此处不能恢复其他设备never default, 因为如果恢复后，NM 内部会根据每个设备的metric值又将主链接设置回去了，导致无法上网
@@ -230,19 +317,20 @@ void InternetChecker::switchInternetAccess(bool checkPrimaryConnection)
     }
 
     qCDebug(DSM) << "need check primary connection" << checkPrimaryConnection;
-    // 主连接在检测期间发生变化，需要重新检查当前主连接是否可上网
-    NetworkManager::ActiveConnection::Ptr primaryConnection = NetworkManager::primaryConnection();
-    if (checkPrimaryConnection && !primaryConnection.isNull()) {
-        int httpTimeout = SettingConfig::instance()->httpRequestTimeout();
-        bool isTimeout = false;
-        if (checkInternetAccessible(httpTimeout, isTimeout)) {
-            qCInfo(DSM) << "Primary connection is accessible, skip switching";
-            emit switchSuccess();
-            return;
-        }
+    // 主连接在检测期间发生变化，需要重新检查当前主连接是否可上网，检测完成后再决定是否切换
+    if (checkPrimaryConnection && !NetworkManager::primaryConnection().isNull()) {
+        m_isSwitching = true;
+        startProbe(CheckStage::CheckPrimary);
+        return;
     }
 
+    startSwitch();
+}
+
+void InternetChecker::startSwitch()
+{
     m_isSwitching = true;
+    NetworkManager::ActiveConnection::Ptr primaryConnection = NetworkManager::primaryConnection();
     NetworkManager::Device::List availableDevice;
     NetworkManager::Device::List devices = NetworkManager::networkInterfaces();
     for (const NetworkManager::Device::Ptr &device : devices) {
@@ -5,6 +5,8 @@
 #ifndef INTERNETCHECKER_H
 #define INTERNETCHECKER_H
 
+#include "httpmanager.h"
+
 #include <QObject>
 #include <NetworkManagerQt/Connection>
 #include <NetworkManagerQt/Device>
@@ -30,20 +32,40 @@ signals:
 private slots:
     void onPrimaryConnectionChanged(const QString &uni);
     void onPrimaryConnectionTimeout();
+    void onProbeFinished(network::service::HttpReply *reply);
+    void onRouteReadyChanged();
 
 private:
+    // 切换过程中的检测阶段
+    enum class CheckStage {
+        Idle,           // 没有正在进行的检测
+        CheckPrimary,   // 检测当前主连接是否可以上网
+        WaitRoute,      // 主连接已切换，等待路由和DHCP就绪
+        VerifyPrimary,  // 检测切换后的主连接是否可以上网
+    };
+
     void resetAllNeverDefault() const;
     bool setConnectionNeverDefault(const NetworkManager::Connection::Ptr &conn, const NetworkManager::Device::Ptr &device, bool neverDefault) const;
     void setPrimaryDeviceNeverDefault(bool neverDefault) const;
-    bool checkInternetAccessible() const;
-    bool checkInternetAccessible(int timeoutSec, bool &timedOut) const;
-    bool checkInternetAccessibleWithRetry(int maxRetry) const;
     void changeDeviceNeverDefault(const NetworkManager::Device::Ptr &device, bool neverDefault) const;
+    void startSwitch();
+    void startProbe(CheckStage stage);
+    bool probeNextUrl();
+    void waitForRoute();
+    void clearRouteWatch();
+    bool isRouteReady() const;
+    void onVerifyFinished(bool accessible);
 
     int m_tryIndex;
     NetworkManager::Device::List m_tryDevices;
     QTimer *m_switchTimer;
     bool m_isSwitching;
+    CheckStage m_stage;
+    int m_retryCount;
+    network::service::HttpProbe *m_probe;
+    QStringList m_probeUrls;  // 逐个检测时剩余待检测的地址
+    QTimer *m_routeTimer;
+    QList<QMetaObject::Connection> m_routeConnections;
 };
 
 }
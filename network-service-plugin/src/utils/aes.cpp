@@ -4,6 +4,17 @@
 
 #include "aes.h"
 
+#include <QHash>
+#include <QMutex>
+
+#include <atomic>
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <cpuid.h>
+#include <wmmintrin.h>
+#endif
+
 using namespace network::service;
 
 QByteArray AESEncryption::Crypt(AESEncryption::Aes level, AESEncryption::Mode mode, const QByteArray &rawText,
@@ -70,8 +81,68 @@ QByteArray AESEncryption::RemovePadding(const QByteArray &rawText, AESEncryption
  * Local Functions
  * */
 
+namespace network {
+namespace service {
+
+// 加密和解密的轮密钥，解密使用等价逆密码的轮密钥(逆序，中间各轮做过InvMixColumns)
+// 查表实现使用大端的字，AES-NI使用字节形式
+struct AESKeySchedule
+{
+    int rounds;
+    quint32 encWords[60];
+    quint32 decWords[60];
+    alignas(16) quint8 encBytes[240];
+    alignas(16) quint8 decBytes[240];
+};
+
+}
+}
+
 namespace {
 
+const quint8 sbox[256] = {
+    //0     1    2      3     4    5     6     7      8    9     A      B    C     D     E     F
+    0x63, 0x7c, 0x77, 0x7b, 0xf2, 0x6b, 0x6f, 0xc5, 0x30, 0x01, 0x67, 0x2b, 0xfe, 0xd7, 0xab, 0x76,
+    0xca, 0x82, 0xc9, 0x7d, 0xfa, 0x59, 0x47, 0xf0, 0xad, 0xd4, 0xa2, 0xaf, 0x9c, 0xa4, 0x72, 0xc0,
+    0xb7, 0xfd, 0x93, 0x26, 0x36, 0x3f, 0xf7, 0xcc, 0x34, 0xa5, 0xe5, 0xf1, 0x71, 0xd8, 0x31, 0x15,
+    0x04, 0xc7, 0x23, 0xc3, 0x18, 0x96, 0x05, 0x9a, 0x07, 0x12, 0x80, 0xe2, 0xeb, 0x27, 0xb2, 0x75,
+    0x09, 0x83, 0x2c, 0x1a, 0x1b, 0x6e, 0x5a, 0xa0, 0x52, 0x3b, 0xd6, 0xb3, 0x29, 0xe3, 0x2f, 0x84,
+    0x53, 0xd1, 0x00, 0xed, 0x20, 0xfc, 0xb1, 0x5b, 0x6a, 0xcb, 0xbe, 0x39, 0x4a, 0x4c, 0x58, 0xcf,
+    0xd0, 0xef, 0xaa, 0xfb, 0x43, 0x4d, 0x33, 0x85, 0x45, 0xf9, 0x02, 0x7f, 0x50, 0x3c, 0x9f, 0xa8,
+    0x51, 0xa3, 0x40, 0x8f, 0x92, 0x9d, 0x38, 0xf5, 0xbc, 0xb6, 0xda, 0x21, 0x10, 0xff, 0xf3, 0xd2,
+    0xcd, 0x0c, 0x13, 0xec, 0x5f, 0x97, 0x44, 0x17, 0xc4, 0xa7, 0x7e, 0x3d, 0x64, 0x5d, 0x19, 0x73,
+    0x60, 0x81, 0x4f, 0xdc, 0x22, 0x2a, 0x90, 0x88, 0x46, 0xee, 0xb8, 0x14, 0xde, 0x5e, 0x0b, 0xdb,
+    0xe0, 0x32, 0x3a, 0x0a, 0x49, 0x06, 0x24, 0x5c, 0xc2, 0xd3, 0xac, 0x62, 0x91, 0x95, 0xe4, 0x79,
+    0xe7, 0xc8, 0x37, 0x6d, 0x8d, 0xd5, 0x4e, 0xa9, 0x6c, 0x56, 0xf4, 0xea, 0x65, 0x7a, 0xae, 0x08,
+    0xba, 0x78, 0x25, 0x2e, 0x1c, 0xa6, 0xb4, 0xc6, 0xe8, 0xdd, 0x74, 0x1f, 0x4b, 0xbd, 0x8b, 0x8a,
+    0x70, 0x3e, 0xb5, 0x66, 0x48, 0x03, 0xf6, 0x0e, 0x61, 0x35, 0x57, 0xb9, 0x86, 0xc1, 0x1d, 0x9e,
+    0xe1, 0xf8, 0x98, 0x11, 0x69, 0xd9, 0x8e, 0x94, 0x9b, 0x1e, 0x87, 0xe9, 0xce, 0x55, 0x28, 0xdf,
+    0x8c, 0xa1, 0x89, 0x0d, 0xbf, 0xe6, 0x42, 0x68, 0x41, 0x99, 0x2d, 0x0f, 0xb0, 0x54, 0xbb, 0x16 };
+
+const quint8 rsbox[256] = {
+    0x52, 0x09, 0x6a, 0xd5, 0x30, 0x36, 0xa5, 0x38, 0xbf, 0x40, 0xa3, 0x9e, 0x81, 0xf3, 0xd7, 0xfb,
+    0x7c, 0xe3, 0x39, 0x82, 0x9b, 0x2f, 0xff, 0x87, 0x34, 0x8e, 0x43, 0x44, 0xc4, 0xde, 0xe9, 0xcb,
+    0x54, 0x7b, 0x94, 0x32, 0xa6, 0xc2, 0x23, 0x3d, 0xee, 0x4c, 0x95, 0x0b, 0x42, 0xfa, 0xc3, 0x4e,
+    0x08, 0x2e, 0xa1, 0x66, 0x28, 0xd9, 0x24, 0xb2, 0x76, 0x5b, 0xa2, 0x49, 0x6d, 0x8b, 0xd1, 0x25,
+    0x72, 0xf8, 0xf6, 0x64, 0x86, 0x68, 0x98, 0x16, 0xd4, 0xa4, 0x5c, 0xcc, 0x5d, 0x65, 0xb6, 0x92,
+    0x6c, 0x70, 0x48, 0x50, 0xfd, 0xed, 0xb9, 0xda, 0x5e, 0x15, 0x46, 0x57, 0xa7, 0x8d, 0x9d, 0x84,
+    0x90, 0xd8, 0xab, 0x00, 0x8c, 0xbc, 0xd3, 0x0a, 0xf7, 0xe4, 0x58, 0x05, 0xb8, 0xb3, 0x45, 0x06,
+    0xd0, 0x2c, 0x1e, 0x8f, 0xca, 0x3f, 0x0f, 0x02, 0xc1, 0xaf, 0xbd, 0x03, 0x01, 0x13, 0x8a, 0x6b,
+    0x3a, 0x91, 0x11, 0x41, 0x4f, 0x67, 0xdc, 0xea, 0x97, 0xf2, 0xcf, 0xce, 0xf0, 0xb4, 0xe6, 0x73,
+    0x96, 0xac, 0x74, 0x22, 0xe7, 0xad, 0x35, 0x85, 0xe2, 0xf9, 0x37, 0xe8, 0x1c, 0x75, 0xdf, 0x6e,
+    0x47, 0xf1, 0x1a, 0x71, 0x1d, 0x29, 0xc5, 0x89, 0x6f, 0xb7, 0x62, 0x0e, 0xaa, 0x18, 0xbe, 0x1b,
+    0xfc, 0x56, 0x3e, 0x4b, 0xc6, 0xd2, 0x79, 0x20, 0x9a, 0xdb, 0xc0, 0xfe, 0x78, 0xcd, 0x5a, 0xf4,
+    0x1f, 0xdd, 0xa8, 0x33, 0x88, 0x07, 0xc7, 0x31, 0xb1, 0x12, 0x10, 0x59, 0x27, 0x80, 0xec, 0x5f,
+    0x60, 0x51, 0x7f, 0xa9, 0x19, 0xb5, 0x4a, 0x0d, 0x2d, 0xe5, 0x7a, 0x9f, 0x93, 0xc9, 0x9c, 0xef,
+    0xa0, 0xe0, 0x3b, 0x4d, 0xae, 0x2a, 0xf5, 0xb0, 0xc8, 0xeb, 0xbb, 0x3c, 0x83, 0x53, 0x99, 0x61,
+    0x17, 0x2b, 0x04, 0x7e, 0xba, 0x77, 0xd6, 0x26, 0xe1, 0x69, 0x14, 0x63, 0x55, 0x21, 0x0c, 0x7d };
+
+// The round constant word array, Rcon[i], contains the values given by
+// x to th e power (i-1) being powers of x (x is denoted as {02}) in the field GF(2^8)
+// Only the first 14 elements are needed
+const quint8 Rcon[14] = {
+    0x8d, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1b, 0x36, 0x6c, 0xd8, 0xab};
+
 quint8 xTime(quint8 x)
 {
     return ((x<<1) ^ (((x>>7) & 1) * 0x1b));
@@ -83,6 +154,233 @@ quint8 multiply(quint8 x, quint8 y)
             * xTime(xTime(xTime(x)))) ^ ((y>>4 & 1) * xTime(xTime(xTime(xTime(x))))));
 }
 
+quint32 rotateRight8(quint32 x)
+{
+    return (x >> 8) | (x << 24);
+}
+
+inline quint32 loadWord(const quint8 *p)
+{
+    return (quint32(p[0]) << 24) | (quint32(p[1]) << 16) | (quint32(p[2]) << 8) | quint32(p[3]);
+}
+
+inline void storeWord(quint8 *p, quint32 x)
+{
+    p[0] = quint8(x >> 24);
+    p[1] = quint8(x >> 16);
+    p[2] = quint8(x >> 8);
+    p[3] = quint8(x);
+}
+
+inline void xorBlock(quint8 *out, const quint8 *a, const quint8 *b)
+{
+    for (int i = 0; i < AESStream::BlockSize; ++i)
+        out[i] = a[i] ^ b[i];
+}
+
+// 每一轮的SubBytes、ShiftRows、MixColumns合并成查表，te[i][x]为S盒的值乘以MixColumns的第i列
+// 解密的td同理，使用逆S盒和InvMixColumns
+struct AESTables
+{
+    quint32 te[4][256];
+    quint32 td[4][256];
+
+    AESTables()
+    {
+        for (int x = 0; x < 256; ++x) {
+            const quint8 s = sbox[x];
+            te[0][x] = (quint32(multiply(s, 2)) << 24) | (quint32(s) << 16) | (quint32(s) << 8) | quint32(multiply(s, 3));
+            const quint8 r = rsbox[x];
+            td[0][x] = (quint32(multiply(r, 0x0e)) << 24) | (quint32(multiply(r, 0x09)) << 16)
+                    | (quint32(multiply(r, 0x0d)) << 8) | quint32(multiply(r, 0x0b));
+            for (int i = 1; i < 4; ++i) {
+                te[i][x] = rotateRight8(te[i - 1][x]);
+                td[i][x] = rotateRight8(td[i - 1][x]);
+            }
+        }
+    }
+};
+
+const AESTables &tables()
+{
+    static const AESTables aesTables;
+    return aesTables;
+}
+
+quint32 subWord(quint32 x)
+{
+    return (quint32(sbox[x >> 24]) << 24) | (quint32(sbox[(x >> 16) & 0xff]) << 16)
+            | (quint32(sbox[(x >> 8) & 0xff]) << 8) | quint32(sbox[x & 0xff]);
+}
+
+void expandSchedule(AESKeySchedule *schedule, const QByteArray &key, int nk, int rounds)
+{
+    const int words = 4 * (rounds + 1);
+    quint32 *w = schedule->encWords;
+    schedule->rounds = rounds;
+    for (int i = 0; i < nk; ++i)
+        w[i] = loadWord(reinterpret_cast<const quint8 *>(key.constData()) + i * 4);
+
+    for (int i = nk; i < words; ++i) {
+        quint32 temp = w[i - 1];
+        if (i % nk == 0) {
+            // RotWord + SubWord
+            temp = subWord((temp << 8) | (temp >> 24)) ^ (quint32(Rcon[i / nk]) << 24);
+        } else if (nk > 6 && i % nk == 4) {
+            temp = subWord(temp);
+        }
+        w[i] = w[i - nk] ^ temp;
+    }
+
+    // 解密的轮密钥逆序，除第一轮和最后一轮外做InvMixColumns，td[sbox[x]]即为InvMixColumns的一列
+    const AESTables &t = tables();
+    quint32 *dw = schedule->decWords;
+    for (int round = 0; round <= rounds; ++round) {
+        for (int j = 0; j < 4; ++j) {
+            const quint32 x = w[(rounds - round) * 4 + j];
+            if (round == 0 || round == rounds) {
+                dw[round * 4 + j] = x;
+            } else {
+                dw[round * 4 + j] = t.td[0][sbox[x >> 24]] ^ t.td[1][sbox[(x >> 16) & 0xff]]
+                        ^ t.td[2][sbox[(x >> 8) & 0xff]] ^ t.td[3][sbox[x & 0xff]];
+            }
+        }
+    }
+
+    for (int i = 0; i < words; ++i) {
+        storeWord(schedule->encBytes + i * 4, w[i]);
+        storeWord(schedule->decBytes + i * 4, dw[i]);
+    }
+}
+
+void tableEncryptBlock(const AESKeySchedule *schedule, const quint8 *in, quint8 *out)
+{
+    const AESTables &t = tables();
+    const quint32 *rk = schedule->encWords;
+    quint32 s0 = loadWord(in) ^ rk[0];
+    quint32 s1 = loadWord(in + 4) ^ rk[1];
+    quint32 s2 = loadWord(in + 8) ^ rk[2];
+    quint32 s3 = loadWord(in + 12) ^ rk[3];
+
+    for (int round = 1; round < schedule->rounds; ++round) {
+        rk += 4;
+        const quint32 t0 = t.te[0][s0 >> 24] ^ t.te[1][(s1 >> 16) & 0xff] ^ t.te[2][(s2 >> 8) & 0xff] ^ t.te[3][s3 & 0xff] ^ rk[0];
+        const quint32 t1 = t.te[0][s1 >> 24] ^ t.te[1][(s2 >> 16) & 0xff] ^ t.te[2][(s3 >> 8) & 0xff] ^ t.te[3][s0 & 0xff] ^ rk[1];
+        const quint32 t2 = t.te[0][s2 >> 24] ^ t.te[1][(s3 >> 16) & 0xff] ^ t.te[2][(s0 >> 8) & 0xff] ^ t.te[3][s1 & 0xff] ^ rk[2];
+        const quint32 t3 = t.te[0][s3 >> 24] ^ t.te[1][(s0 >> 16) & 0xff] ^ t.te[2][(s1 >> 8) & 0xff] ^ t.te[3][s2 & 0xff] ^ rk[3];
+        s0 = t0;
+        s1 = t1;
+        s2 = t2;
+        s3 = t3;
+    }
+
+    // 最后一轮没有MixColumns
+    rk += 4;
+    storeWord(out, ((quint32(sbox[s0 >> 24]) << 24) | (quint32(sbox[(s1 >> 16) & 0xff]) << 16)
+                    | (quint32(sbox[(s2 >> 8) & 0xff]) << 8) | quint32(sbox[s3 & 0xff])) ^ rk[0]);
+    storeWord(out + 4, ((quint32(sbox[s1 >> 24]) << 24) | (quint32(sbox[(s2 >> 16) & 0xff]) << 16)
+                        | (quint32(sbox[(s3 >> 8) & 0xff]) << 8) | quint32(sbox[s0 & 0xff])) ^ rk[1]);
+    storeWord(out + 8, ((quint32(sbox[s2 >> 24]) << 24) | (quint32(sbox[(s3 >> 16) & 0xff]) << 16)
+                        | (quint32(sbox[(s0 >> 8) & 0xff]) << 8) | quint32(sbox[s1 & 0xff])) ^ rk[2]);
+    storeWord(out + 12, ((quint32(sbox[s3 >> 24]) << 24) | (quint32(sbox[(s0 >> 16) & 0xff]) << 16)
+                         | (quint32(sbox[(s1 >> 8) & 0xff]) << 8) | quint32(sbox[s2 & 0xff])) ^ rk[3]);
+}
+
+void tableDecryptBlock(const AESKeySchedule *schedule, const quint8 *in, quint8 *out)
+{
+    const AESTables &t = tables();
+    const quint32 *rk = schedule->decWords;
+    quint32 s0 = loadWord(in) ^ rk[0];
+    quint32 s1 = loadWord(in + 4) ^ rk[1];
+    quint32 s2 = loadWord(in + 8) ^ rk[2];
+    quint32 s3 = loadWord(in + 12) ^ rk[3];
+
+    for (int round = 1; round < schedule->rounds; ++round) {
+        rk += 4;
+        const quint32 t0 = t.td[0][s0 >> 24] ^ t.td[1][(s3 >> 16) & 0xff] ^ t.td[2][(s2 >> 8) & 0xff] ^ t.td[3][s1 & 0xff] ^ rk[0];
+        const quint32 t1 = t.td[0][s1 >> 24] ^ t.td[1][(s0 >> 16) & 0xff] ^ t.td[2][(s3 >> 8) & 0xff] ^ t.td[3][s2 & 0xff] ^ rk[1];
+        const quint32 t2 = t.td[0][s2 >> 24] ^ t.td[1][(s1 >> 16) & 0xff] ^ t.td[2][(s0 >> 8) & 0xff] ^ t.td[3][s3 & 0xff] ^ rk[2];
+        const quint32 t3 = t.td[0][s3 >> 24] ^ t.td[1][(s2 >> 16) & 0xff] ^ t.td[2][(s1 >> 8) & 0xff] ^ t.td[3][s0 & 0xff] ^ rk[3];
+        s0 = t0;
+        s1 = t1;
+        s2 = t2;
+        s3 = t3;
+    }
+
+    rk += 4;
+    storeWord(out, ((quint32(rsbox[s0 >> 24]) << 24) | (quint32(rsbox[(s3 >> 16) & 0xff]) << 16)
+                    | (quint32(rsbox[(s2 >> 8) & 0xff]) << 8) | quint32(rsbox[s1 & 0xff])) ^ rk[0]);
+    storeWord(out + 4, ((quint32(rsbox[s1 >> 24]) << 24) | (quint32(rsbox[(s0 >> 16) & 0xff]) << 16)
+                        | (quint32(rsbox[(s3 >> 8) & 0xff]) << 8) | quint32(rsbox[s2 & 0xff])) ^ rk[1]);
+    storeWord(out + 8, ((quint32(rsbox[s2 >> 24]) << 24) | (quint32(rsbox[(s1 >> 16) & 0xff]) << 16)
+                        | (quint32(rsbox[(s0 >> 8) & 0xff]) << 8) | quint32(rsbox[s3 & 0xff])) ^ rk[2]);
+    storeWord(out + 12, ((quint32(rsbox[s3 >> 24]) << 24) | (quint32(rsbox[(s2 >> 16) & 0xff]) << 16)
+                         | (quint32(rsbox[(s1 >> 8) & 0xff]) << 8) | quint32(rsbox[s0 & 0xff])) ^ rk[3]);
+}
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define AES_HAS_AESNI
+
+__attribute__((target("aes,sse2")))
+void aesniEncryptBlock(const AESKeySchedule *schedule, const quint8 *in, quint8 *out)
+{
+    const __m128i *rk = reinterpret_cast<const __m128i *>(schedule->encBytes);
+    __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in));
+    block = _mm_xor_si128(block, _mm_load_si128(rk));
+    for (int round = 1; round < schedule->rounds; ++round)
+        block = _mm_aesenc_si128(block, _mm_load_si128(rk + round));
+    block = _mm_aesenclast_si128(block, _mm_load_si128(rk + schedule->rounds));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out), block);
+}
+
+__attribute__((target("aes,sse2")))
+void aesniDecryptBlock(const AESKeySchedule *schedule, const quint8 *in, quint8 *out)
+{
+    const __m128i *rk = reinterpret_cast<const __m128i *>(schedule->decBytes);
+    __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in));
+    block = _mm_xor_si128(block, _mm_load_si128(rk));
+    for (int round = 1; round < schedule->rounds; ++round)
+        block = _mm_aesdec_si128(block, _mm_load_si128(rk + round));
+    block = _mm_aesdeclast_si128(block, _mm_load_si128(rk + schedule->rounds));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out), block);
+}
+
+bool cpuSupportsAESNI()
+{
+    unsigned int eax, ebx, ecx, edx;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+        return false;
+    return (ecx & bit_AES) && (edx & bit_SSE2);
+}
+#else
+bool cpuSupportsAESNI()
+{
+    return false;
+}
+#endif
+
+std::atomic<bool> hardwareAccelerationEnabled(true);
+
+// 扩展后的密钥按用户密钥缓存，账户网络的密码都使用同一个密钥
+QSharedPointer<const AESKeySchedule> keySchedule(const QByteArray &key, int nk, int rounds)
+{
+    static const int MaxCachedKeys = 16;
+    static QMutex mutex;
+    static QHash<QByteArray, QSharedPointer<const AESKeySchedule>> cache;
+
+    QMutexLocker locker(&mutex);
+    QSharedPointer<const AESKeySchedule> schedule = cache.value(key);
+    if (schedule)
+        return schedule;
+
+    QSharedPointer<AESKeySchedule> newSchedule(new AESKeySchedule);
+    expandSchedule(newSchedule.data(), key, nk, rounds);
+    if (cache.size() >= MaxCachedKeys)
+        cache.clear();
+    cache.insert(key, newSchedule);
+    return newSchedule;
+}
+
 }
 
 /*
@@ -95,7 +393,6 @@ AESEncryption::AESEncryption(Aes level, Mode mode, Padding padding)
     , m_level(level)
     , m_mode(mode)
     , m_padding(padding)
-    , m_aesNIAvailable(false)
 {
     switch (level) {
     case AES_128: {
@@ -133,398 +430,262 @@ AESEncryption::AESEncryption(Aes level, Mode mode, Padding padding)
     }
 }
 
-QByteArray AESEncryption::getPadding(int currSize, int alignment)
-{
-    int size = (alignment - currSize % alignment) % alignment;
-    switch (m_padding) {
-    case Padding::ZERO:
-        return QByteArray(size, 0x00);
-    case Padding::PKCS7:
-        if (size == 0)
-            size = alignment;
-        return QByteArray(size, size);
-    case Padding::ISO:
-        if (size > 0)
-            return QByteArray (size - 1, 0x00).prepend('\x80');
-        break;
-    default:
-        return QByteArray(size, 0x00);
-    }
-
-    return QByteArray();
-}
-
 QByteArray AESEncryption::expandKey(const QByteArray &key, bool isEncryptionKey)
 {
     Q_UNUSED(isEncryptionKey)
-    int i, k;
-    quint8 tempa[4]; // Used for the column/row operations
-    QByteArray roundKey(key); // The first round key is the key itself.
-
-    // All other round keys are found from the previous round keys.
-    //i == Nk
-    for (i = m_nk; i < m_nb * (m_nr + 1); i++) {
-        tempa[0] = (quint8) roundKey.at((i-1) * 4 + 0);
-        tempa[1] = (quint8) roundKey.at((i-1) * 4 + 1);
-        tempa[2] = (quint8) roundKey.at((i-1) * 4 + 2);
-        tempa[3] = (quint8) roundKey.at((i-1) * 4 + 3);
-
-        if (i % m_nk == 0) {
-            // This function shifts the 4 bytes in a word to the left once.
-            // [a0,a1,a2,a3] becomes [a1,a2,a3,a0]
-
-            // Function RotWord()
-            k = tempa[0];
-            tempa[0] = tempa[1];
-            tempa[1] = tempa[2];
-            tempa[2] = tempa[3];
-            tempa[3] = k;
-
-            // Function Subword()
-            tempa[0] = getSBoxValue(tempa[0]);
-            tempa[1] = getSBoxValue(tempa[1]);
-            tempa[2] = getSBoxValue(tempa[2]);
-            tempa[3] = getSBoxValue(tempa[3]);
-
-            tempa[0] =  tempa[0] ^ Rcon[i/m_nk];
-        }
-
-        if (m_level == AES_256 && i % m_nk == 4) {
-            // Function Subword()
-            tempa[0] = getSBoxValue(tempa[0]);
-            tempa[1] = getSBoxValue(tempa[1]);
-            tempa[2] = getSBoxValue(tempa[2]);
-            tempa[3] = getSBoxValue(tempa[3]);
-        }
-        roundKey.insert(i * 4 + 0, (quint8) roundKey.at((i - m_nk) * 4 + 0) ^ tempa[0]);
-        roundKey.insert(i * 4 + 1, (quint8) roundKey.at((i - m_nk) * 4 + 1) ^ tempa[1]);
-        roundKey.insert(i * 4 + 2, (quint8) roundKey.at((i - m_nk) * 4 + 2) ^ tempa[2]);
-        roundKey.insert(i * 4 + 3, (quint8) roundKey.at((i - m_nk) * 4 + 3) ^ tempa[3]);
-    }
+    if (key.size() != m_keyLen)
+        return QByteArray();
 
-    return roundKey;
+    QSharedPointer<const AESKeySchedule> schedule = keySchedule(key, m_nk, m_nr);
+    return QByteArray(reinterpret_cast<const char *>(schedule->encBytes), m_nb * (m_nr + 1) * 4);
 }
 
-// This function adds the round key to state.
-// The round key is added to the state by an XOR function.
-void AESEncryption::addRoundKey(const quint8 round, const QByteArray &expKey)
+QByteArray AESEncryption::printArray(uchar* arr, int size)
 {
-    QByteArray::iterator it = m_state.begin();
-    for (int i = 0; i < 16; ++i)
-        it[i] = (quint8) it[i] ^ (quint8) expKey.at(round * m_nb * 4 + (i / 4) * m_nb + (i % 4));
-}
+    QByteArray print("");
+    for (int i = 0; i < size; i++)
+        print.append(arr[i]);
 
-// The SubBytes Function Substitutes the values in the
-// state matrix with values in an S-box.
-void AESEncryption::subBytes()
-{
-    QByteArray::iterator it = m_state.begin();
-    for (int i = 0; i < 16; i++)
-        it[i] = getSBoxValue((quint8) it[i]);
+    return print.toHex();
 }
 
-// The ShiftRows() function shifts the rows in the state to the left.
-// Each row is shifted with different offset.
-// Offset = Row number. So the first row is not shifted.
-void AESEncryption::shiftRows()
+QByteArray AESEncryption::encode(const QByteArray &rawText, const QByteArray &key, const QByteArray &iv)
 {
-    QByteArray::iterator it = m_state.begin();
-    quint8 temp;
-    //Keep in mind that QByteArray is column-driven!!
-
-     //Shift 1 to left
-    temp = (quint8)it[1];
-    it[1] = (quint8)it[5];
-    it[5] = (quint8)it[9];
-    it[9] = (quint8)it[13];
-    it[13] = (quint8)temp;
-
-    //Shift 2 to left
-    temp = (quint8)it[2];
-    it[2] = (quint8)it[10];
-    it[10] = (quint8)temp;
-    temp = (quint8)it[6];
-    it[6] = (quint8)it[14];
-    it[14] = (quint8)temp;
+    AESStream stream(Aes(m_level), Mode(m_mode), Padding(m_padding), AESStream::Encrypt);
+    if (!stream.init(key, iv))
+        return QByteArray();
 
-    //Shift 3 to left
-    temp = (quint8)it[3];
-    it[3] = (quint8)it[15];
-    it[15] = (quint8)it[11];
-    it[11] = (quint8)it[7];
-    it[7] = (quint8)temp;
+    // 一次分配好输出，加密直接写入
+    QByteArray ret(rawText.size() + m_blocklen, Qt::Uninitialized);
+    int length = stream.update(rawText.constData(), rawText.size(), ret.data());
+    length += stream.final(ret.data() + length);
+    ret.resize(length);
+    return ret;
 }
 
-// MixColumns function mixes the columns of the state matrix
-//optimized!!
-void AESEncryption::mixColumns()
+QByteArray AESEncryption::decode(const QByteArray &rawText, const QByteArray &key, const QByteArray &iv)
 {
-    QByteArray::iterator it = m_state.begin();
-    quint8 tmp, tm, t;
-
-    for (int i = 0; i < 16; i += 4) {
-        t = (quint8)it[i];
-        tmp = (quint8)it[i] ^ (quint8)it[i + 1] ^ (quint8)it[i + 2] ^ (quint8)it[i + 3];
-
-        tm = xTime((quint8)it[i] ^ (quint8)it[i + 1]);
-        it[i] = (quint8)it[i] ^ (quint8)tm ^ (quint8)tmp;
-
-        tm = xTime((quint8)it[i + 1] ^ (quint8)it[i + 2]);
-        it[i+1] = (quint8)it[i + 1] ^ (quint8)tm ^ (quint8)tmp;
-
-        tm = xTime((quint8)it[i + 2] ^ (quint8)it[i + 3]);
-        it[i+2] = (quint8)it[i + 2] ^ (quint8)tm ^ (quint8)tmp;
+    AESStream stream(Aes(m_level), Mode(m_mode), Padding(m_padding), AESStream::Decrypt);
+    if (!stream.init(key, iv))
+        return QByteArray();
 
-        tm = xTime((quint8)it[i + 3] ^ (quint8)t);
-        it[i+3] =(quint8)it[i + 3] ^ (quint8)tm ^ (quint8)tmp;
-    }
+    QByteArray ret(rawText.size() + m_blocklen, Qt::Uninitialized);
+    int length = stream.update(rawText.constData(), rawText.size(), ret.data());
+    length += stream.final(ret.data() + length);
+    ret.resize(length);
+    return ret;
 }
 
-// MixColumns function mixes the columns of the state matrix.
-// The method used to multiply may be difficult to understand for the inexperienced.
-// Please use the references to gain more information.
-void AESEncryption::invMixColumns()
+QByteArray AESEncryption::removePadding(const QByteArray &rawText)
 {
-    QByteArray::iterator it = m_state.begin();
-    quint8 a, b, c, d;
-    for (int i = 0; i < 16; i += 4) {
-        a = (quint8) it[i];
-        b = (quint8) it[i + 1];
-        c = (quint8) it[i + 2];
-        d = (quint8) it[i + 3];
-
-        it[i] = (quint8)(multiply(a, 0x0e) ^ multiply(b, 0x0b) ^ multiply(c, 0x0d) ^ multiply(d, 0x09));
-        it[i + 1] = (quint8)(multiply(a, 0x09) ^ multiply(b, 0x0e) ^ multiply(c, 0x0b) ^ multiply(d, 0x0d));
-        it[i + 2] = (quint8)(multiply(a, 0x0d) ^ multiply(b, 0x09) ^ multiply(c, 0x0e) ^ multiply(d, 0x0b));
-        it[i + 3] = (quint8)(multiply(a, 0x0b) ^ multiply(b, 0x0d) ^ multiply(c, 0x09) ^ multiply(d, 0x0e));
-    }
+    return RemovePadding(rawText, (Padding)m_padding);
 }
 
-// The SubBytes Function Substitutes the values in the
-// state matrix with values in an S-box.
-void AESEncryption::invSubBytes()
+bool AESEncryption::hardwareAccelerated()
 {
-    QByteArray::iterator it = m_state.begin();
-    for (int i = 0; i < 16; ++i)
-        it[i] = getSBoxInvert((quint8) it[i]);
+    static const bool supported = cpuSupportsAESNI();
+    return supported && hardwareAccelerationEnabled.load(std::memory_order_relaxed);
 }
 
-void AESEncryption::invShiftRows()
+void AESEncryption::setHardwareAccelerationEnabled(bool enabled)
 {
-    QByteArray::iterator it = m_state.begin();
-    uint8_t temp;
-
-    //Keep in mind that QByteArray is column-driven!!
-
-    //Shift 1 to right
-    temp = (quint8)it[13];
-    it[13] = (quint8)it[9];
-    it[9] = (quint8)it[5];
-    it[5] = (quint8)it[1];
-    it[1] = (quint8)temp;
-
-    //Shift 2
-    temp = (quint8)it[10];
-    it[10] = (quint8)it[2];
-    it[2] = (quint8)temp;
-    temp = (quint8)it[14];
-    it[14] = (quint8)it[6];
-    it[6] = (quint8)temp;
-
-    //Shift 3
-    temp = (quint8)it[7];
-    it[7] = (quint8)it[11];
-    it[11] = (quint8)it[15];
-    it[15] = (quint8)it[3];
-    it[3] = (quint8)temp;
+    hardwareAccelerationEnabled.store(enabled, std::memory_order_relaxed);
 }
 
-QByteArray AESEncryption::byteXor(const QByteArray &a, const QByteArray &b)
+AESStream::AESStream(AESEncryption::Aes level, AESEncryption::Mode mode, AESEncryption::Padding padding, Direction direction)
+    : m_level(level)
+    , m_mode(mode)
+    , m_padding(padding)
+    , m_direction(direction)
+    , m_encryptBlock(tableEncryptBlock)
+    , m_decryptBlock(tableDecryptBlock)
+    , m_buffered(0)
+    , m_total(0)
 {
-    QByteArray::const_iterator it_a = a.begin();
-    QByteArray::const_iterator it_b = b.begin();
-    QByteArray ret;
-
-    for (int i = 0; i < std::min(a.size(), b.size()); i++)
-        ret.insert(i,it_a[i] ^ it_b[i]);
-
-    return ret;
+    memset(m_iv, 0, sizeof(m_iv));
+    memset(m_buffer, 0, sizeof(m_buffer));
 }
 
-// Cipher is the main function that encrypts the PlainText.
-QByteArray AESEncryption::cipher(const QByteArray &expKey, const QByteArray &in)
+AESStream::~AESStream()
 {
-    //m_state is the input buffer...
-    QByteArray output(in);
-    m_state = std::move(output);
-
-    // Add the First round key to the state before starting the rounds.
-    addRoundKey(0, expKey);
+    memset(m_iv, 0, sizeof(m_iv));
+    memset(m_buffer, 0, sizeof(m_buffer));
+}
 
-    // There will be Nr rounds.
-    // The first Nr-1 rounds are identical.
-    // These Nr-1 rounds are executed in the loop below.
-    for (quint8 round = 1; round < m_nr; ++round) {
-        subBytes();
-        shiftRows();
-        mixColumns();
-        addRoundKey(round, expKey);
+bool AESStream::init(const QByteArray &key, const QByteArray &iv)
+{
+    m_schedule.reset();
+    m_buffered = 0;
+    m_total = 0;
+
+    int nk, rounds;
+    switch (m_level) {
+    case AESEncryption::AES_192:
+        nk = 6;
+        rounds = 12;
+        break;
+    case AESEncryption::AES_256:
+        nk = 8;
+        rounds = 14;
+        break;
+    default:
+        nk = 4;
+        rounds = 10;
+        break;
     }
-
-    // The last round is given below.
-    // The MixColumns function is not here in the last round.
-    subBytes();
-    shiftRows();
-    addRoundKey(m_nr, expKey);
-
-    return m_state;
+    if ((m_mode >= AESEncryption::CBC && iv.size() != BlockSize) || key.size() != nk * 4)
+        return false;
+
+    m_schedule = keySchedule(key, nk, rounds);
+    if (m_mode >= AESEncryption::CBC)
+        memcpy(m_iv, iv.constData(), BlockSize);
+
+#ifdef AES_HAS_AESNI
+    if (AESEncryption::hardwareAccelerated()) {
+        m_encryptBlock = aesniEncryptBlock;
+        m_decryptBlock = aesniDecryptBlock;
+    } else
+#endif
+    {
+        m_encryptBlock = tableEncryptBlock;
+        m_decryptBlock = tableDecryptBlock;
+    }
+    return true;
 }
 
-QByteArray AESEncryption::invCipher(const QByteArray &expKey, const QByteArray &in)
+void AESStream::processBlocks(const quint8 *in, quint8 *out, int blocks)
 {
-    //m_state is the input buffer.... handle it!
-    QByteArray output(in);
-    m_state = std::move(output);
-
-    // Add the First round key to the state before starting the rounds.
-    addRoundKey(m_nr, expKey);
-
-    // There will be Nr rounds.
-    // The first Nr-1 rounds are identical.
-    // These Nr-1 rounds are executed in the loop below.
-    for (quint8 round = m_nr - 1; round > 0 ; round--) {
-        invShiftRows();
-        invSubBytes();
-        addRoundKey(round, expKey);
-        invMixColumns();
+    const AESKeySchedule *schedule = m_schedule.data();
+    quint8 temp[BlockSize];
+    for (int i = 0; i < blocks; ++i, in += BlockSize, out += BlockSize) {
+        switch (m_mode) {
+        case AESEncryption::ECB:
+            if (m_direction == Encrypt)
+                m_encryptBlock(schedule, in, out);
+            else
+                m_decryptBlock(schedule, in, out);
+            break;
+        case AESEncryption::CBC:
+            if (m_direction == Encrypt) {
+                xorBlock(temp, in, m_iv);
+                m_encryptBlock(schedule, temp, out);
+                memcpy(m_iv, out, BlockSize);
+            } else {
+                // 原地解密时先保存密文，作为下一块的初始向量
+                memcpy(temp, in, BlockSize);
+                m_decryptBlock(schedule, temp, out);
+                xorBlock(out, out, m_iv);
+                memcpy(m_iv, temp, BlockSize);
+            }
+            break;
+        case AESEncryption::CFB:
+            m_encryptBlock(schedule, m_iv, temp);
+            if (m_direction == Encrypt) {
+                xorBlock(out, in, temp);
+                memcpy(m_iv, out, BlockSize);
+            } else {
+                memcpy(m_iv, in, BlockSize);
+                xorBlock(out, in, temp);
+            }
+            break;
+        case AESEncryption::OFB:
+            m_encryptBlock(schedule, m_iv, m_iv);
+            xorBlock(out, in, m_iv);
+            break;
+        }
     }
-
-    // The last round is given below.
-    // The MixColumns function is not here in the last round.
-    invShiftRows();
-    invSubBytes();
-    addRoundKey(0, expKey);
-
-    return m_state;
 }
 
-QByteArray AESEncryption::printArray(uchar* arr, int size)
+int AESStream::update(const char *in, int length, char *out)
 {
-    QByteArray print("");
-    for (int i = 0; i < size; i++)
-        print.append(arr[i]);
+    if (!m_schedule || length <= 0)
+        return 0;
+
+    const quint8 *input = reinterpret_cast<const quint8 *>(in);
+    quint8 *output = reinterpret_cast<quint8 *>(out);
+    int written = 0;
+    m_total += length;
+    // 先补齐上次剩下的不完整的块
+    if (m_buffered > 0) {
+        const int size = qMin(BlockSize - m_buffered, length);
+        memcpy(m_buffer + m_buffered, input, size);
+        m_buffered += size;
+        input += size;
+        length -= size;
+        if (m_buffered < BlockSize)
+            return 0;
+        processBlocks(m_buffer, output, 1);
+        m_buffered = 0;
+        written = BlockSize;
+    }
 
-    return print.toHex();
+    const int blocks = length / BlockSize;
+    processBlocks(input, output + written, blocks);
+    written += blocks * BlockSize;
+    m_buffered = length - blocks * BlockSize;
+    memcpy(m_buffer, input + blocks * BlockSize, m_buffered);
+    return written;
 }
 
-QByteArray AESEncryption::encode(const QByteArray &rawText, const QByteArray &key, const QByteArray &iv)
+int AESStream::final(char *out)
 {
-    if ((m_mode >= CBC && (iv.isEmpty() || iv.size() != m_blocklen)) || key.size() != m_keyLen)
-        return QByteArray();
-
-    QByteArray expandedKey = expandKey(key, true);
-    QByteArray alignedText(rawText);
-
-    //Fill array with padding
-    alignedText.append(getPadding(rawText.size(), m_blocklen));
-
-    switch(m_mode) {
-    case ECB: {
-        QByteArray ret;
-        for (int i = 0; i < alignedText.size(); i += m_blocklen)
-            ret.append(cipher(expandedKey, alignedText.mid(i, m_blocklen)));
-        return ret;
-    }
-    case CBC: {
-        QByteArray ret;
-        QByteArray ivTemp(iv);
-        for (int i = 0; i < alignedText.size(); i += m_blocklen) {
-            alignedText.replace(i, m_blocklen, byteXor(alignedText.mid(i, m_blocklen),ivTemp));
-            ret.append(cipher(expandedKey, alignedText.mid(i, m_blocklen)));
-            ivTemp = ret.mid(i, m_blocklen);
-        }
-        return ret;
-    }
-    case CFB: {
-        QByteArray ret;
-        ret.append(byteXor(alignedText.left(m_blocklen), cipher(expandedKey, iv)));
-        for (int i = 0; i < alignedText.size(); i += m_blocklen) {
-            if (i + m_blocklen < alignedText.size())
-                ret.append(byteXor(alignedText.mid(i + m_blocklen, m_blocklen),
-                                   cipher(expandedKey, ret.mid(i, m_blocklen))));
+    if (!m_schedule)
+        return 0;
+
+    quint8 *output = reinterpret_cast<quint8 *>(out);
+    int written = 0;
+    if (m_direction == Encrypt) {
+        // 按总长度补齐，规则和原来的getPadding一致，补齐后正好是0或者1个块
+        int size = (BlockSize - m_total % BlockSize) % BlockSize;
+        switch (m_padding) {
+        case AESEncryption::PKCS7:
+            if (size == 0)
+                size = BlockSize;
+            memset(m_buffer + m_buffered, size, size);
+            break;
+        case AESEncryption::ISO:
+            if (size > 0) {
+                m_buffer[m_buffered] = 0x80;
+                memset(m_buffer + m_buffered + 1, 0, size - 1);
+            }
+            break;
+        default:
+            memset(m_buffer + m_buffered, 0, size);
+            break;
         }
-        return ret;
-    }
-    case OFB: {
-        QByteArray ret;
-        QByteArray ofbTemp;
-        ofbTemp.append(cipher(expandedKey, iv));
-        for (int i = m_blocklen; i < alignedText.size(); i += m_blocklen) {
-            ofbTemp.append(cipher(expandedKey, ofbTemp.right(m_blocklen)));
+        if (m_buffered + size == BlockSize) {
+            processBlocks(m_buffer, output, 1);
+            written = BlockSize;
         }
-        ret.append(byteXor(alignedText, ofbTemp));
-        return ret;
+    } else if (m_buffered > 0 && (m_mode == AESEncryption::CFB || m_mode == AESEncryption::OFB)) {
+        // 流模式最后不足一个块的数据和密钥流的前面部分异或
+        quint8 keyStream[BlockSize];
+        m_encryptBlock(m_schedule.data(), m_iv, keyStream);
+        for (int i = 0; i < m_buffered; ++i)
+            output[i] = m_buffer[i] ^ keyStream[i];
+        written = m_buffered;
     }
-    default: break;
-    }
-    return QByteArray();
+
+    m_schedule.reset();
+    m_buffered = 0;
+    m_total = 0;
+    memset(m_iv, 0, sizeof(m_iv));
+    memset(m_buffer, 0, sizeof(m_buffer));
+    return written;
 }
 
-QByteArray AESEncryption::decode(const QByteArray &rawText, const QByteArray &key, const QByteArray &iv)
+QByteArray AESStream::update(const QByteArray &data)
 {
-    if ((m_mode >= CBC && (iv.isEmpty() || iv.size() != m_blocklen)) || key.size() != m_keyLen)
-        return QByteArray();
-
-     QByteArray ret;
-     QByteArray expandedKey = expandKey(key, true);
-
-     //false or true here is very important
-     //the expandedKeys aren't the same for !aes-ni! ENcryption and DEcryption (only CBC and EBC)
-     //but if you are !NOT! using aes-ni then the expandedKeys for encryption and decryption are the SAME!!!
-
-    switch(m_mode) {
-    case ECB:
-        for (int i = 0; i < rawText.size(); i += m_blocklen)
-            ret.append(invCipher(expandedKey, rawText.mid(i, m_blocklen)));
-        break;
-    case CBC: {
-        QByteArray ivTemp(iv);
-        for (int i = 0; i < rawText.size(); i += m_blocklen) {
-            ret.append(invCipher(expandedKey, rawText.mid(i, m_blocklen)));
-            ret.replace(i, m_blocklen, byteXor(ret.mid(i, m_blocklen),ivTemp));
-            ivTemp = rawText.mid(i, m_blocklen);
-        }
-    }
-        break;
-    case CFB: {
-        ret.append(byteXor(rawText.mid(0, m_blocklen), cipher(expandedKey, iv)));
-        for (int i = 0; i < rawText.size(); i += m_blocklen) {
-            if (i + m_blocklen < rawText.size()) {
-                ret.append(byteXor(rawText.mid(i + m_blocklen, m_blocklen),
-                                   cipher(expandedKey, rawText.mid(i, m_blocklen))));
-            }
-        }
-    }
-        break;
-    case OFB: {
-        QByteArray ofbTemp;
-        ofbTemp.append(cipher(expandedKey, iv));
-        for (int i = m_blocklen; i < rawText.size(); i += m_blocklen) {
-            ofbTemp.append(cipher(expandedKey, ofbTemp.right(m_blocklen)));
-        }
-        ret.append(byteXor(rawText, ofbTemp));
-    }
-        break;
-    default:
-        //do nothing
-        break;
-    }
+    QByteArray ret(data.size() + BlockSize, Qt::Uninitialized);
+    ret.resize(update(data.constData(), data.size(), ret.data()));
     return ret;
 }
 
-QByteArray AESEncryption::removePadding(const QByteArray &rawText)
+QByteArray AESStream::final()
 {
-    return RemovePadding(rawText, (Padding)m_padding);
+    QByteArray ret(BlockSize, Qt::Uninitialized);
+    ret.resize(final(ret.data()));
+    return ret;
 }
 
 // 密码加密解密
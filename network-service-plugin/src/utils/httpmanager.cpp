@@ -9,9 +9,15 @@
 #include <QRegularExpression>
 #include <QDebug>
 #include <QUrl>
+#include <QTimer>
+#include <QSocketNotifier>
 
 #include <mutex>
 #include <atomic>
+#include <chrono>
+#include <memory>
+#include <unordered_map>
+#include <vector>
 #include <curl/curl.h>
 #include <sys/socket.h>
 #include <sys/time.h>
@@ -87,6 +93,105 @@ static int getaddrinfo_with_timeout(const std::string &node, const std::string &
     return ret;
 }
 
+// 检测请求共享的 DNS、连接和 TLS 会话缓存，避免每次检测都重新解析域名和握手
+class HttpShareCache
+{
+public:
+    static HttpShareCache *instance()
+    {
+        static HttpShareCache inst;
+        return &inst;
+    }
+
+    // 返回当前的共享句柄，请求结束前需要一直持有，失效后旧句柄在最后一个请求结束时释放
+    std::shared_ptr<CURLSH> share()
+    {
+        std::lock_guard<std::mutex> locker(m_mutex);
+        if (!m_share) {
+            CURLSH *share = curl_share_init();
+            if (!share)
+                return nullptr;
+
+            curl_share_setopt(share, CURLSHOPT_LOCKFUNC, lockCallback);
+            curl_share_setopt(share, CURLSHOPT_UNLOCKFUNC, unlockCallback);
+            curl_share_setopt(share, CURLSHOPT_USERDATA, this);
+            curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+            curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT);
+            curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+            m_share.reset(share, curl_share_cleanup);
+        }
+        return m_share;
+    }
+
+    void reset()
+    {
+        std::lock_guard<std::mutex> locker(m_mutex);
+        m_share.reset();
+        m_hosts.clear();
+    }
+
+    bool lookupHost(const std::string &host, std::string &ip)
+    {
+        std::lock_guard<std::mutex> locker(m_mutex);
+        auto it = m_hosts.find(host);
+        if (it == m_hosts.end())
+            return false;
+
+        if (std::chrono::steady_clock::now() > it->second.second) {
+            m_hosts.erase(it);
+            return false;
+        }
+        ip = it->second.first;
+        return true;
+    }
+
+    void insertHost(const std::string &host, const std::string &ip)
+    {
+        std::lock_guard<std::mutex> locker(m_mutex);
+        m_hosts[host] = std::make_pair(ip, std::chrono::steady_clock::now() + std::chrono::seconds(HostCacheTimeout));
+    }
+
+    void record(qint64 dnsTime, qint64 connectTime, qint64 firstByteTime, bool reused, bool dnsCached)
+    {
+        std::lock_guard<std::mutex> locker(m_mutex);
+        m_statistics.requestCount++;
+        if (reused)
+            m_statistics.reusedConnectionCount++;
+        if (dnsCached)
+            m_statistics.cachedDnsCount++;
+        m_statistics.dnsTime += dnsTime;
+        m_statistics.connectTime += connectTime;
+        m_statistics.firstByteTime += firstByteTime;
+    }
+
+    network::service::HttpProbeStatistics statistics()
+    {
+        std::lock_guard<std::mutex> locker(m_mutex);
+        return m_statistics;
+    }
+
+private:
+    // 与 curl 默认的 DNS 缓存时间保持一致
+    static const int HostCacheTimeout = 60;
+
+    static void lockCallback(CURL *, curl_lock_data data, curl_lock_access, void *userptr)
+    {
+        static_cast<HttpShareCache *>(userptr)->m_locks[data].lock();
+    }
+
+    static void unlockCallback(CURL *, curl_lock_data data, void *userptr)
+    {
+        static_cast<HttpShareCache *>(userptr)->m_locks[data].unlock();
+    }
+
+private:
+    std::mutex m_mutex;
+    std::mutex m_locks[CURL_LOCK_DATA_LAST];
+    std::shared_ptr<CURLSH> m_share;
+    std::unordered_map<std::string, std::pair<std::string, std::chrono::steady_clock::time_point>> m_hosts;
+    network::service::HttpProbeStatistics m_statistics;
+};
+
 } // anonymous namespace
 
 namespace network {
@@ -99,9 +204,21 @@ void HttpManager::init()
 
 void HttpManager::unInit()
 {
+    HttpShareCache::instance()->reset();
     curl_global_cleanup();
 }
 
+void HttpManager::resetCache()
+{
+    qCDebug(DSM) << "Reset http dns and connection cache";
+    HttpShareCache::instance()->reset();
+}
+
+HttpProbeStatistics HttpManager::statistics()
+{
+    return HttpShareCache::instance()->statistics();
+}
+
 HttpManager::HttpManager(QObject *parent)
     : QObject (parent)
 {
@@ -137,6 +254,27 @@ static int sockopt_callback(void *clientp, curl_socket_t sockfd, curlsocktype /*
     return CURL_SOCKOPT_OK;
 }
 
+// 带超时的 GET 请求公共参数，url、body、sockCtx 需要在请求结束前保持有效
+static void setupTimeoutRequest(CURL *curl, const std::string &url, int timeoutSec, std::string *body, CurlSockoptContext *sockCtx, CURLSH *share)
+{
+    curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+    curl_easy_setopt(curl, CURLOPT_NOPROGRESS, 1L);
+    curl_easy_setopt(curl, CURLOPT_HTTPGET, 1);
+    curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+    // 使用毫秒级超时
+    curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, static_cast<long>(timeoutSec * 1000));
+    curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT_MS, static_cast<long>(timeoutSec * 1000));
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, write_data);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, body);
+    curl_easy_setopt(curl, CURLOPT_HEADER, 1L);
+    curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
+    sockCtx->rwTimeoutSec = timeoutSec;
+    curl_easy_setopt(curl, CURLOPT_SOCKOPTFUNCTION, sockopt_callback);
+    curl_easy_setopt(curl, CURLOPT_SOCKOPTDATA, sockCtx);
+    if (share)
+        curl_easy_setopt(curl, CURLOPT_SHARE, share);
+}
+
 HttpReply *HttpManager::get(const QString &url)
 {
     HttpReply *reply = new HttpReply(this);
@@ -171,10 +309,15 @@ HttpReply *HttpManager::get(const QString &url)
     sockCtx.rwTimeoutSec = static_cast<long>(SettingConfig::instance()->httpRequestTimeout());
     curl_easy_setopt(curl, CURLOPT_SOCKOPTFUNCTION, sockopt_callback);
     curl_easy_setopt(curl, CURLOPT_SOCKOPTDATA, &sockCtx);
+    // 复用已经解析的域名和建立的连接
+    std::shared_ptr<CURLSH> share = HttpShareCache::instance()->share();
+    if (share)
+        curl_easy_setopt(curl, CURLOPT_SHARE, share.get());
     // 发送请求
     qCDebug(DSM) << "Send request to" << url;
     CURLcode curlRes = curl_easy_perform(curl);
     qCDebug(DSM) << "Request finished, ret:" << curlRes;
+    reply->updateProbeCost(curl, false);
     if (curlRes == CURLE_OK) {
         reply->setHeader(QString::fromStdString(body_data));
     } else {
@@ -198,8 +341,14 @@ HttpReply *HttpManager::get(const QString &url, int timeoutSec)
     QString host = qurl.host();
     int port = qurl.port(80);
     QString resolvedIp;
-
-    if (!host.isEmpty()) {
+    std::string cachedIp;
+    bool dnsCached = false;
+
+    if (!host.isEmpty() && HttpShareCache::instance()->lookupHost(host.toStdString(), cachedIp)) {
+        // 最近解析过的域名直接使用缓存的地址，不再创建解析线程
+        resolvedIp = QString::fromStdString(cachedIp);
+        dnsCached = true;
+    } else if (!host.isEmpty()) {
         addrinfo hints = {};
         hints.ai_family = AF_UNSPEC;
         hints.ai_socktype = SOCK_STREAM;
@@ -225,6 +374,7 @@ HttpReply *HttpManager::get(const QString &url, int timeoutSec)
             }
             resolvedIp = QString::fromLatin1(ipStr);
             freeaddrinfo(result);
+            HttpShareCache::instance()->insertHost(hostStd, resolvedIp.toStdString());
         } else if (ret == EAI_AGAIN || ret == EAI_NONAME || ret == ETIMEDOUT || ret == EAI_SYSTEM) {
             // DNS 解析失败（超时或无此域名），直接返回超时
             reply->setTimeout(true);
@@ -246,22 +396,10 @@ HttpReply *HttpManager::get(const QString &url, int timeoutSec)
     }
 
     std::string urlStd = url.toStdString();
-    curl_easy_setopt(curl, CURLOPT_URL, urlStd.c_str());
-    curl_easy_setopt(curl, CURLOPT_NOPROGRESS, 1L);
-    curl_easy_setopt(curl, CURLOPT_HTTPGET, 1);
-    curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
-    // 使用毫秒级超时
-    curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, static_cast<long>(timeoutSec * 1000));
-    curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT_MS, static_cast<long>(timeoutSec * 1000));
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, write_data);
     std::string body_data;
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &body_data);
-    curl_easy_setopt(curl, CURLOPT_HEADER, 1L);
-    curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
     CurlSockoptContext sockCtx;
-    sockCtx.rwTimeoutSec = timeoutSec;
-    curl_easy_setopt(curl, CURLOPT_SOCKOPTFUNCTION, sockopt_callback);
-    curl_easy_setopt(curl, CURLOPT_SOCKOPTDATA, &sockCtx);
+    std::shared_ptr<CURLSH> share = HttpShareCache::instance()->share();
+    setupTimeoutRequest(curl, urlStd, timeoutSec, &body_data, &sockCtx, share.get());
 
     // 如果域名解析成功，通过 CURLOPT_RESOLVE 告诉 curl 直接使用该 IP，跳过 DNS 阶段
     curl_slist *resolveList = nullptr;
@@ -273,6 +411,7 @@ HttpReply *HttpManager::get(const QString &url, int timeoutSec)
     }
 
     CURLcode curlRes = curl_easy_perform(curl);
+    reply->updateProbeCost(curl, dnsCached);
     if (curlRes == CURLE_OK) {
         reply->setHeader(QString::fromStdString(body_data));
     } else {
@@ -289,6 +428,342 @@ HttpReply *HttpManager::get(const QString &url, int timeoutSec)
     return reply;
 }
 
+// 并发探测时每个请求独立持有的数据
+struct ProbeRequest {
+    QString url;
+    std::string urlStd;
+    std::string body;
+    CurlSockoptContext sockCtx;
+    CURL *curl = nullptr;
+    bool attached = false;
+};
+
+// 基于 curl multi 的一次并发探测，由调用方决定是阻塞等待还是在事件循环中推进
+class HttpProbeSession
+{
+public:
+    explicit HttpProbeSession(QObject *replyParent)
+        : m_replyParent(replyParent)
+        , m_multi(nullptr)
+        , m_result(nullptr)
+        , m_fallback(nullptr)
+    {
+    }
+
+    ~HttpProbeSession()
+    {
+        // 取消其余还未完成的请求
+        for (const std::unique_ptr<ProbeRequest> &request : m_requests) {
+            if (request->attached) {
+                qCDebug(DSM) << "Cancel probe" << request->url;
+                curl_multi_remove_handle(m_multi, request->curl);
+            }
+            curl_easy_cleanup(request->curl);
+        }
+        if (m_multi)
+            curl_multi_cleanup(m_multi);
+    }
+
+    // probe 不为空时由 probe 监听套接字和超时，否则由调用方通过 perform/wait 推进
+    bool start(const QStringList &urls, int timeoutSec, HttpProbe *probe = nullptr)
+    {
+        m_multi = curl_multi_init();
+        if (!m_multi) {
+            qCWarning(DSM) << "Curl multi initialization failed";
+            m_errorMessage = "curl multi init failure";
+            return false;
+        }
+        if (probe) {
+            // 需在添加请求之前设置，添加请求时 curl 就会设置超时
+            curl_multi_setopt(m_multi, CURLMOPT_SOCKETFUNCTION, &HttpProbeSession::socketCallback);
+            curl_multi_setopt(m_multi, CURLMOPT_SOCKETDATA, probe);
+            curl_multi_setopt(m_multi, CURLMOPT_TIMERFUNCTION, &HttpProbeSession::timerCallback);
+            curl_multi_setopt(m_multi, CURLMOPT_TIMERDATA, probe);
+        }
+
+        m_share = HttpShareCache::instance()->share();
+        for (const QString &url : urls) {
+            CURL *curl = curl_easy_init();
+            if (!curl) {
+                qCWarning(DSM) << "Curl initialization failed for URL" << url;
+                continue;
+            }
+            std::unique_ptr<ProbeRequest> request(new ProbeRequest);
+            request->url = url;
+            request->urlStd = url.toStdString();
+            request->curl = curl;
+            // 并发模式下 DNS 解析由 curl 的异步解析器完成，超时由 CURLOPT_TIMEOUT_MS 统一控制
+            setupTimeoutRequest(curl, request->urlStd, timeoutSec, &request->body, &request->sockCtx, m_share.get());
+            curl_easy_setopt(curl, CURLOPT_PRIVATE, request.get());
+            request->attached = (curl_multi_add_handle(m_multi, curl) == CURLM_OK);
+            m_requests.push_back(std::move(request));
+        }
+
+        if (m_requests.empty()) {
+            m_errorMessage = "curl easy init failure";
+            return false;
+        }
+        qCDebug(DSM) << "Send concurrent request to" << urls;
+        return true;
+    }
+
+    // 推进所有请求，返回 true 表示已经得到确定结论或者所有请求都已结束
+    bool perform()
+    {
+        int running = 0;
+        curl_multi_perform(m_multi, &running);
+        return readMessages(running);
+    }
+
+    // 处理套接字事件或超时(fd 为 CURL_SOCKET_TIMEOUT)，返回值同 perform
+    bool socketAction(curl_socket_t fd, int events)
+    {
+        int running = 0;
+        curl_multi_socket_action(m_multi, fd, events, &running);
+        return readMessages(running);
+    }
+
+    void wait(int timeoutMs)
+    {
+        curl_multi_wait(m_multi, nullptr, 0, timeoutMs, nullptr);
+    }
+
+    HttpReply *result(bool canceled)
+    {
+        if (m_result)
+            return m_result;
+
+        if (m_fallback && !canceled)
+            return m_fallback;
+
+        HttpReply *reply = new HttpReply(m_replyParent);
+        if (!m_errorMessage.isEmpty())
+            reply->setErrorMessage(m_errorMessage);
+        else
+            reply->setErrorMessage(canceled ? "request canceled" : "no request finished");
+        return reply;
+    }
+
+private:
+    static int socketCallback(CURL *, curl_socket_t fd, int what, void *userp, void *)
+    {
+        static_cast<HttpProbe *>(userp)->watchSocket(fd, what);
+        return 0;
+    }
+
+    static int timerCallback(CURLM *, long timeoutMs, void *userp)
+    {
+        static_cast<HttpProbe *>(userp)->startTimeout(timeoutMs);
+        return 0;
+    }
+
+    bool readMessages(int running)
+    {
+        int msgsInQueue = 0;
+        while (CURLMsg *msg = curl_multi_info_read(m_multi, &msgsInQueue)) {
+            if (msg->msg != CURLMSG_DONE)
+                continue;
+
+            ProbeRequest *request = nullptr;
+            curl_easy_getinfo(msg->easy_handle, CURLINFO_PRIVATE, &request);
+            double totalTime = 0;
+            curl_easy_getinfo(msg->easy_handle, CURLINFO_TOTAL_TIME, &totalTime);
+
+            HttpReply *probeReply = new HttpReply(m_replyParent);
+            probeReply->setUrl(request->url);
+            probeReply->setElapsed(static_cast<qint64>(totalTime * 1000));
+            probeReply->updateProbeCost(msg->easy_handle, false);
+            if (msg->data.result == CURLE_OK) {
+                probeReply->setHeader(QString::fromStdString(request->body));
+            } else {
+                if (msg->data.result == CURLE_OPERATION_TIMEDOUT)
+                    probeReply->setTimeout(true);
+                probeReply->setErrorMessage(curl_easy_strerror(msg->data.result));
+            }
+            curl_multi_remove_handle(m_multi, msg->easy_handle);
+            request->attached = false;
+            qCInfo(DSM) << "Probe" << request->url << "finished in" << probeReply->elapsed() << "ms, http code:" << probeReply->httpCode()
+                        << ", error message:" << probeReply->errorMessage();
+
+            if (probeReply->isConclusive()) {
+                m_result = probeReply;
+                return true;
+            }
+            // 没有确定结论时，优先返回有 HTTP 响应的结果，其次是最后一个失败的结果
+            if (!m_fallback || m_fallback->httpCode() == 0)
+                m_fallback = probeReply;
+        }
+
+        return running == 0;
+    }
+
+private:
+    QObject *m_replyParent;
+    CURLM *m_multi;
+    std::shared_ptr<CURLSH> m_share;
+    std::vector<std::unique_ptr<ProbeRequest>> m_requests;
+    HttpReply *m_result;
+    HttpReply *m_fallback;
+    QString m_errorMessage;
+};
+
+HttpReply *HttpManager::getFirst(const QStringList &urls, int timeoutSec, const std::function<bool()> &isCanceled)
+{
+    HttpProbeSession session(this);
+    if (!session.start(urls, timeoutSec))
+        return session.result(false);
+
+    bool canceled = false;
+    while (!session.perform()) {
+        if (isCanceled && isCanceled()) {
+            canceled = true;
+            break;
+        }
+        session.wait(100);
+    }
+
+    return session.result(canceled);
+}
+
+HttpProbe::HttpProbe(QObject *parent)
+    : QObject(parent)
+    , m_session(nullptr)
+    , m_timer(new QTimer(this))
+{
+    // 超时时间由 curl 通过 CURLMOPT_TIMERFUNCTION 指定
+    m_timer->setSingleShot(true);
+    connect(m_timer, &QTimer::timeout, this, &HttpProbe::onTimeout);
+}
+
+HttpProbe::~HttpProbe()
+{
+    abort();
+}
+
+void HttpProbe::start(const QStringList &urls, int timeoutSec)
+{
+    abort();
+    // 上一次探测的结果在开始新的探测时释放
+    qDeleteAll(findChildren<HttpReply *>(QString(), Qt::FindDirectChildrenOnly));
+    m_session = new HttpProbeSession(this);
+    if (!m_session->start(urls, timeoutSec, this)) {
+        // 保持异步通知，避免调用方在 start 中收到 finished 信号
+        QTimer::singleShot(0, this, &HttpProbe::finish);
+        return;
+    }
+    // 添加请求时 curl 一般已经设置了超时，没有设置时立即推进一次
+    if (!m_timer->isActive())
+        m_timer->start(0);
+}
+
+void HttpProbe::abort()
+{
+    // 清理会话时 curl 还会回调移除套接字，之后再停止监听
+    delete m_session;
+    m_session = nullptr;
+    m_timer->stop();
+    clearNotifiers();
+}
+
+bool HttpProbe::isRunning() const
+{
+    return m_session != nullptr;
+}
+
+void HttpProbe::onTimeout()
+{
+    if (m_session && m_session->socketAction(CURL_SOCKET_TIMEOUT, 0))
+        finish();
+}
+
+void HttpProbe::finish()
+{
+    if (!m_session)
+        return;
+
+    HttpReply *reply = m_session->result(false);
+    abort();
+    emit finished(reply);
+}
+
+void HttpProbe::watchSocket(int fd, int what)
+{
+    // 在 curl 的回调中不能直接删除正在发出信号的监听对象，统一延迟删除
+    auto update = [this, fd](QHash<int, QSocketNotifier *> &notifiers, QSocketNotifier::Type type, bool enabled) {
+        QSocketNotifier *notifier = notifiers.value(fd);
+        if (!enabled) {
+            if (notifier) {
+                notifier->setEnabled(false);
+                notifier->deleteLater();
+                notifiers.remove(fd);
+            }
+            return;
+        }
+        if (notifier)
+            return;
+        notifier = new QSocketNotifier(fd, type, this);
+        const int events = (type == QSocketNotifier::Read) ? CURL_CSELECT_IN : CURL_CSELECT_OUT;
+        connect(notifier, &QSocketNotifier::activated, this, [this, fd, events] {
+            onSocketActivated(fd, events);
+        });
+        notifiers.insert(fd, notifier);
+    };
+    update(m_readNotifiers, QSocketNotifier::Read, what == CURL_POLL_IN || what == CURL_POLL_INOUT);
+    update(m_writeNotifiers, QSocketNotifier::Write, what == CURL_POLL_OUT || what == CURL_POLL_INOUT);
+}
+
+void HttpProbe::startTimeout(long timeoutMs)
+{
+    // curl 要求不能在回调中调用 curl_multi_socket_action，超时为 0 时也通过定时器推进
+    if (timeoutMs < 0) {
+        m_timer->stop();
+    } else {
+        m_timer->start(static_cast<int>(timeoutMs));
+    }
+}
+
+void HttpProbe::onSocketActivated(int fd, int events)
+{
+    if (m_session && m_session->socketAction(fd, events))
+        finish();
+}
+
+void HttpProbe::clearNotifiers()
+{
+    for (QSocketNotifier *notifier : std::as_const(m_readNotifiers)) {
+        notifier->setEnabled(false);
+        notifier->deleteLater();
+    }
+    for (QSocketNotifier *notifier : std::as_const(m_writeNotifiers)) {
+        notifier->setEnabled(false);
+        notifier->deleteLater();
+    }
+    m_readNotifiers.clear();
+    m_writeNotifiers.clear();
+}
+
+void HttpReply::updateProbeCost(void *curl, bool dnsCached)
+{
+    double dnsTime = 0;
+    double connectTime = 0;
+    double firstByteTime = 0;
+    long connects = 0;
+    curl_easy_getinfo(curl, CURLINFO_NAMELOOKUP_TIME, &dnsTime);
+    curl_easy_getinfo(curl, CURLINFO_CONNECT_TIME, &connectTime);
+    curl_easy_getinfo(curl, CURLINFO_STARTTRANSFER_TIME, &firstByteTime);
+    curl_easy_getinfo(curl, CURLINFO_NUM_CONNECTS, &connects);
+    // curl 返回的时间都是从请求开始累计的，这里换算成各阶段的耗时
+    m_dnsTime = static_cast<qint64>(dnsTime * 1000);
+    m_connectTime = static_cast<qint64>((connectTime - dnsTime) * 1000);
+    m_firstByteTime = static_cast<qint64>(firstByteTime * 1000);
+    if (m_connectTime < 0)
+        m_connectTime = 0;
+    bool reused = (connects == 0);
+    HttpShareCache::instance()->record(m_dnsTime, m_connectTime, m_firstByteTime, reused, dnsCached);
+    qCDebug(DSM) << "Probe cost, dns:" << m_dnsTime << "ms, connect:" << m_connectTime
+                 << "ms, first byte:" << m_firstByteTime << "ms, reused connection:" << reused << ", dns cached:" << dnsCached;
+}
+
 /**
  * @brief HttpReply::HttpReply
  * @param parent
@@ -297,6 +772,10 @@ HttpReply::HttpReply(QObject *parent)
     : QObject (parent)
     , m_httpCode(0)
     , m_timeout(false)
+    , m_elapsed(0)
+    , m_dnsTime(0)
+    , m_connectTime(0)
+    , m_firstByteTime(0)
 {
 }
 
@@ -375,5 +854,45 @@ bool HttpReply::isTimeout() const
     return m_timeout;
 }
 
+QString HttpReply::url() const
+{
+    return m_url;
+}
+
+qint64 HttpReply::elapsed() const
+{
+    return m_elapsed;
+}
+
+qint64 HttpReply::dnsTime() const
+{
+    return m_dnsTime;
+}
+
+qint64 HttpReply::connectTime() const
+{
+    return m_connectTime;
+}
+
+qint64 HttpReply::firstByteTime() const
+{
+    return m_firstByteTime;
+}
+
+bool HttpReply::isConclusive() const
+{
+    return (m_httpCode >= 200 && m_httpCode < 300) || !m_portalUrl.isEmpty();
+}
+
+void HttpReply::setUrl(const QString &url)
+{
+    m_url = url;
+}
+
+void HttpReply::setElapsed(qint64 elapsed)
+{
+    m_elapsed = elapsed;
+}
+
 }
 }
@@ -7,11 +7,30 @@
 
 #include <QObject>
 #include <QByteArray>
+#include <QHash>
+#include <QStringList>
+
+#include <functional>
+
+class QSocketNotifier;
+class QTimer;
 
 namespace network {
 namespace service {
 
 class HttpReply;
+class HttpProbeSession;
+
+// 网络检测请求的累计耗时统计，时间单位为毫秒
+struct HttpProbeStatistics
+{
+    qint64 requestCount = 0;
+    qint64 reusedConnectionCount = 0;
+    qint64 cachedDnsCount = 0;
+    qint64 dnsTime = 0;
+    qint64 connectTime = 0;
+    qint64 firstByteTime = 0;
+};
 
 class HttpManager : public QObject
 {
@@ -20,11 +39,16 @@ class HttpManager : public QObject
 public:
     static void init();
     static void unInit();
+    // 清空共享的 DNS 和连接缓存，主连接或者 DNS 配置变化后调用
+    static void resetCache();
+    static HttpProbeStatistics statistics();
     explicit HttpManager(QObject *parent = Q_NULLPTR);
     ~HttpManager() override = default;
     // 调用GET方法
     HttpReply *get(const QString &url);
     HttpReply *get(const QString &url, int timeoutSec);
+    // 并发请求所有地址，返回第一个有确定结论的回复，其余请求直接取消
+    HttpReply *getFirst(const QStringList &urls, int timeoutSec, const std::function<bool()> &isCanceled = nullptr);
 };
 
 /**
@@ -36,6 +60,7 @@ class HttpReply : public QObject
     Q_OBJECT
 
     friend class HttpManager;
+    friend class HttpProbeSession;
 
 public:
     ~HttpReply() override = default;
@@ -43,18 +68,73 @@ public:
     int httpCode() const;
     QString portal() const;
     bool isTimeout() const;
+    QString url() const;
+    qint64 elapsed() const;
+    qint64 dnsTime() const;
+    qint64 connectTime() const;
+    qint64 firstByteTime() const;
+    // 2xx 或者带有认证地址的回复可以直接确定网络状态
+    bool isConclusive() const;
 
 protected:
     explicit HttpReply(QObject *parent = Q_NULLPTR);
     void setHeader(const QString &html);
     void setErrorMessage(const QString &errorMessage);
     void setTimeout(bool timeout);
+    void setUrl(const QString &url);
+    void setElapsed(qint64 elapsed);
+    void updateProbeCost(void *curl, bool dnsCached);
 
 private:
     QString m_errorMessage;
     int m_httpCode;
     QString m_portalUrl;
     bool m_timeout;
+    QString m_url;
+    qint64 m_elapsed;
+    qint64 m_dnsTime;
+    qint64 m_connectTime;
+    qint64 m_firstByteTime;
+};
+
+/**
+ * @brief The HttpProbe class
+ * 异步的并发探测，在所在线程的事件循环中监听 curl 的套接字和超时，不阻塞线程
+ */
+class HttpProbe : public QObject
+{
+    Q_OBJECT
+
+    friend class HttpProbeSession;
+
+public:
+    explicit HttpProbe(QObject *parent = Q_NULLPTR);
+    ~HttpProbe() override;
+    // 开始新的探测会取消上一次未完成的探测
+    void start(const QStringList &urls, int timeoutSec);
+    void abort();
+    bool isRunning() const;
+
+signals:
+    // reply 归 HttpProbe 所有，在下一次 start 前有效
+    void finished(network::service::HttpReply *reply);
+
+private slots:
+    void onTimeout();
+    void finish();
+
+private:
+    // 由 curl 的回调调用，what 为 CURL_POLL_*，timeoutMs 为 -1 时停止超时
+    void watchSocket(int fd, int what);
+    void startTimeout(long timeoutMs);
+    void onSocketActivated(int fd, int events);
+    void clearNotifiers();
+
+private:
+    HttpProbeSession *m_session;
+    QTimer *m_timer;
+    QHash<int, QSocketNotifier *> m_readNotifiers;
+    QHash<int, QSocketNotifier *> m_writeNotifiers;
 };
 
 }
@@ -99,6 +99,11 @@ int SettingConfig::reapplyFlags() const
     return m_reapplyFlags;
 }
 
+bool SettingConfig::concurrentConnectivityCheck() const
+{
+    return m_concurrentConnectivityCheck;
+}
+
 void SettingConfig::onValueChanged(const QString &key)
 {
     if (key == "reconnectIfIpConflicted") {
@@ -135,6 +140,8 @@ void SettingConfig::onValueChanged(const QString &key)
     } else if (key == QString("reapplyFlags")) {
         int val = dConfig->value("reapplyFlags").toInt();
         m_reapplyFlags = (val >= 0 && val <= 2) ? val : 2;
+    } else if (key == QString("concurrentConnectivityCheck")) {
+        m_concurrentConnectivityCheck = dConfig->value("concurrentConnectivityCheck").toBool();
     }
 }
 
@@ -151,6 +158,7 @@ SettingConfig::SettingConfig(QObject *parent)
     , m_resetWifiOSDEnableTimeout(300)
     , m_needCheckNetwork(true)
     , m_reapplyFlags(2)
+    , m_concurrentConnectivityCheck(false)
 {
     if (!dConfig)
         dConfig = Dtk::Core::DConfig::create("org.deepin.dde.network", "org.deepin.dde.network");
@@ -207,6 +215,9 @@ SettingConfig::SettingConfig(QObject *parent)
             else
                 m_reapplyFlags = 2;
         }
+
+        if (keys.contains("concurrentConnectivityCheck"))
+            m_concurrentConnectivityCheck = dConfig->value("concurrentConnectivityCheck").toBool();
     }
     if (m_networkUrls.isEmpty())
         m_networkUrls = CheckUrls;
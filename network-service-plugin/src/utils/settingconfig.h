@@ -31,6 +31,7 @@ public:
     bool supportPortalPromp() const;                // 是否支持在任务栏或控制中心给出提示
     bool needCheckNetwork() const;                     // 是否需要检测网络
     int reapplyFlags() const;
+    bool concurrentConnectivityCheck() const;       // 是否并发请求所有网络检测地址
 
 signals:
     void enableConnectivityChanged(bool);
@@ -61,6 +62,7 @@ private:
     int m_httpConnectTimeout;
     bool m_needCheckNetwork;
     int m_reapplyFlags;
+    bool m_concurrentConnectivityCheck;
 };
 
 #endif // SERVICE_H
@@ -22,6 +22,7 @@ ConfigSetting::ConfigSetting(QObject *parent)
     , m_showUnAuthorizeSwitch(true)
     , m_connectivityCheckInterval(30000)
     , m_wirelessScanInterval(10000)
+    , m_dataChangedInterval(16)
     , m_wpaEapAuthen("peap")
     , m_wpaEapAuthmethod("gtc")
     , m_networkAirplaneMode(false)
@@ -34,6 +35,8 @@ ConfigSetting::ConfigSetting(QObject *parent)
     , m_portalProcessMode("promp")
     , m_disableConnectingAnimation(false)
     , m_disableAllNotify(false)
+    , m_typedNetworkInterface(false)
+    , m_sharedNetManagerBackend(false)
 {
     QStringList keys;
     if (!dConfig)
@@ -77,6 +80,9 @@ void ConfigSetting::onValueChanged(const QString &key)
     } else if (key == QString("wirelessScanInterval")) {
         m_wirelessScanInterval = dConfig->value(key, 10).toInt() * 1000;
         emit wirelessScanIntervalChanged(m_wirelessScanInterval);
+    } else if (key == QString("dataChangedInterval")) {
+        m_dataChangedInterval = dConfig->value(key, 16).toInt();
+        emit dataChangedIntervalChanged(m_dataChangedInterval);
     } else if (key == QString("wpaEapAuthen")) {
         m_wpaEapAuthen = dConfig->value(key).toString();
         emit wpaEapAuthenChanged(m_wpaEapAuthen);
@@ -106,6 +112,10 @@ void ConfigSetting::onValueChanged(const QString &key)
         m_disableConnectingAnimation = dConfig->value("disableConnectingAnimation", false).toBool();
     } else if (key == "disableAllNotify") {
         m_disableAllNotify = dConfig->value("disableAllNotify", false).toBool();
+    } else if (key == "typedNetworkInterface") {
+        m_typedNetworkInterface = dConfig->value("typedNetworkInterface", false).toBool();
+    } else if (key == "sharedNetManagerBackend") {
+        m_sharedNetManagerBackend = dConfig->value("sharedNetManagerBackend", false).toBool();
     }
 }
 
@@ -160,6 +170,11 @@ int ConfigSetting::wirelessScanInterval() const
     return m_wirelessScanInterval;
 }
 
+int ConfigSetting::dataChangedInterval() const
+{
+    return m_dataChangedInterval;
+}
+
 QString ConfigSetting::wpaEapAuthen() const
 {
     return m_wpaEapAuthen;
@@ -219,3 +234,13 @@ bool ConfigSetting::disableAllNotify() const
 {
     return m_disableAllNotify;
 }
+
+bool ConfigSetting::typedNetworkInterface() const
+{
+    return m_typedNetworkInterface;
+}
+
+bool ConfigSetting::sharedNetManagerBackend() const
+{
+    return m_sharedNetManagerBackend;
+}
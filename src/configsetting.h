@@ -25,6 +25,7 @@ public:
     bool showUnAuthorizeSwitch() const;     // 是否显示回退到未经授权的网络的开关
     int connectivityCheckInterval() const;  // 网络连通性检测时间间隔
     int wirelessScanInterval() const;       // 无线扫描间隔(ms)
+    int dataChangedInterval() const;        // 界面数据变化合并发送间隔(ms)，0为不合并
     QString wpaEapAuthen() const;           // 企业网EAP认证方式
     QString wpaEapAuthmethod() const;       // 企业网内部认证方式
     bool networkAirplaneMode() const;       // 控制中心是否显示飞行模式模块
@@ -37,6 +38,8 @@ public:
     bool supportPortalPromp() const;        // 是否在任务栏给出
     bool disableConnectingAnimation() const; // 是否禁用连接动画
     bool disableAllNotify() const;           // 是否禁用所有网络通知
+    bool typedNetworkInterface() const;      // 是否使用类型化的后端接口(a{sa{sv}})代替JSON字符串
+    bool sharedNetManagerBackend() const;    // 会话内的网络插件是否共享同一个网络数据后端
 
 signals:
     void checkUrlsChanged(const QStringList &);
@@ -44,6 +47,7 @@ signals:
     void checkPortalChanged(bool);
     void connectivityCheckIntervalChanged(int);
     void wirelessScanIntervalChanged(int);
+    void dataChangedIntervalChanged(int);
     void wpaEapAuthenChanged(const QString &);
     void wpaEapAuthmethodChanged(const QString &);
     void enableAirplaneModeChanged(bool);
@@ -67,6 +71,7 @@ private:
     bool m_showUnAuthorizeSwitch;
     int m_connectivityCheckInterval;
     int m_wirelessScanInterval;
+    int m_dataChangedInterval;
     QStringList m_networkUrls;
     QString m_wpaEapAuthen;
     QString m_wpaEapAuthmethod;
@@ -80,6 +85,8 @@ private:
     QString m_portalProcessMode;
     bool m_disableConnectingAnimation;
     bool m_disableAllNotify;
+    bool m_typedNetworkInterface;
+    bool m_sharedNetManagerBackend;
 };
 
 } // namespace network
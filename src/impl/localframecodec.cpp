@@ -0,0 +1,230 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "localframecodec.h"
+
+#include <QIODevice>
+#include <QtEndian>
+
+#include <cstring>
+
+using namespace dde::network;
+
+// 接收缓冲区最多保存一个最大的帧，剩余的数据留在设备中，处理完已有的帧后再读
+static const int MaxBufferedSize = LocalFrameCodec::HeaderSize + LocalFrameCodec::MaxFrameSize;
+
+static int roundUpCapacity(int size)
+{
+    int capacity = 64;
+    while (capacity < size)
+        capacity <<= 1;
+    return capacity;
+}
+
+FrameRingBuffer::FrameRingBuffer(int capacity)
+    : m_data(roundUpCapacity(capacity), Qt::Uninitialized)
+    , m_head(0)
+    , m_size(0)
+{
+}
+
+int FrameRingBuffer::size() const
+{
+    return m_size;
+}
+
+int FrameRingBuffer::capacity() const
+{
+    return m_data.size();
+}
+
+void FrameRingBuffer::clear()
+{
+    m_head = 0;
+    m_size = 0;
+}
+
+void FrameRingBuffer::reserve(int size)
+{
+    if (size <= m_data.size())
+        return;
+
+    QByteArray data(roundUpCapacity(size), Qt::Uninitialized);
+    const int first = qMin(m_size, m_data.size() - m_head);
+    memcpy(data.data(), m_data.constData() + m_head, first);
+    memcpy(data.data() + first, m_data.constData(), m_size - first);
+    m_data = data;
+    m_head = 0;
+}
+
+void FrameRingBuffer::append(const char *data, int length)
+{
+    reserve(m_size + length);
+    const int mask = m_data.size() - 1;
+    const int tail = (m_head + m_size) & mask;
+    const int first = qMin(length, m_data.size() - tail);
+    memcpy(m_data.data() + tail, data, first);
+    memcpy(m_data.data(), data + first, length - first);
+    m_size += length;
+}
+
+qint64 FrameRingBuffer::readFrom(QIODevice *device)
+{
+    const qint64 available = qMin<qint64>(device->bytesAvailable(), MaxBufferedSize - m_size);
+    if (available <= 0)
+        return 0;
+
+    reserve(m_size + available);
+    const int mask = m_data.size() - 1;
+    qint64 total = 0;
+    // 空闲空间最多分成两段，依次直接读入
+    while (total < available) {
+        const int tail = (m_head + m_size) & mask;
+        const int length = qMin<qint64>(available - total, m_data.size() - tail);
+        const qint64 bytes = device->read(m_data.data() + tail, length);
+        if (bytes < 0)
+            return -1;
+        if (bytes == 0)
+            break;
+        m_size += bytes;
+        total += bytes;
+    }
+    return total;
+}
+
+QByteArray FrameRingBuffer::peek(int offset, int length, QByteArray *scratch) const
+{
+    const int mask = m_data.size() - 1;
+    const int start = (m_head + offset) & mask;
+    if (start + length <= m_data.size())
+        return QByteArray::fromRawData(m_data.constData() + start, length);
+
+    const int first = m_data.size() - start;
+    scratch->resize(length);
+    memcpy(scratch->data(), m_data.constData() + start, first);
+    memcpy(scratch->data() + first, m_data.constData(), length - first);
+    return *scratch;
+}
+
+void FrameRingBuffer::consume(int length)
+{
+    length = qMin(length, m_size);
+    m_head = (m_head + length) & (m_data.size() - 1);
+    m_size -= length;
+    if (m_size == 0)
+        m_head = 0;
+}
+
+LocalFrameCodec::LocalFrameCodec()
+    : m_pendingConsume(0)
+    , m_error(NoError)
+{
+}
+
+QByteArray LocalFrameCodec::encode(const QByteArray &name, const QByteArray &payload)
+{
+    Q_ASSERT(name.size() <= 0xFF);
+    const quint32 length = 1 + name.size() + payload.size();
+    QByteArray frame;
+    frame.reserve(4 + length);
+    char header[4];
+    qToBigEndian<quint32>(length, header);
+    frame.append(header, 4);
+    frame.append(char(name.size()));
+    frame.append(name);
+    frame.append(payload);
+    return frame;
+}
+
+bool LocalFrameCodec::readFrom(QIODevice *device)
+{
+    consumeFrame();
+    if (m_buffer.readFrom(device) < 0)
+        m_error = ReadError;
+    return m_error == NoError;
+}
+
+void LocalFrameCodec::feed(const char *data, int length)
+{
+    consumeFrame();
+    m_buffer.append(data, length);
+}
+
+bool LocalFrameCodec::nextFrame(QByteArray *name, QByteArray *payload)
+{
+    consumeFrame();
+    if (m_error != NoError || m_buffer.size() < HeaderSize)
+        return false;
+
+    QByteArray headerScratch;
+    const QByteArray header = m_buffer.peek(0, HeaderSize, &headerScratch);
+    const quint32 length = qFromBigEndian<quint32>(header.constData());
+    const int nameLength = static_cast<uchar>(header.at(4));
+    if (length > quint32(MaxFrameSize)) {
+        m_error = FrameTooLarge;
+        return false;
+    }
+    if (length < quint32(1 + nameLength)) {
+        m_error = InvalidFrame;
+        return false;
+    }
+    if (m_buffer.size() < int(4 + length))
+        return false;
+
+    // 名称和数据直接引用缓冲区，跨越末尾时引用拷贝后的数据
+    const QByteArray body = m_buffer.peek(4, length, &m_scratch);
+    *name = QByteArray::fromRawData(body.constData() + 1, nameLength);
+    *payload = QByteArray::fromRawData(body.constData() + 1 + nameLength, length - 1 - nameLength);
+    m_pendingConsume = 4 + length;
+    return true;
+}
+
+void LocalFrameCodec::clear()
+{
+    m_buffer.clear();
+    m_scratch.clear();
+    m_pendingConsume = 0;
+    m_error = NoError;
+}
+
+void LocalFrameCodec::consumeFrame()
+{
+    if (m_pendingConsume == 0)
+        return;
+    m_buffer.consume(m_pendingConsume);
+    m_pendingConsume = 0;
+}
+
+void LocalFrameDispatcher::registerHandler(const QByteArray &name, const Handler &handler)
+{
+    m_handlers.insert(name, handler);
+}
+
+bool LocalFrameDispatcher::dispatch(QIODevice *device, const QByteArray &name, const QByteArray &payload) const
+{
+    auto it = m_handlers.constFind(name);
+    if (it == m_handlers.cend())
+        return false;
+    it.value()(device, payload);
+    return true;
+}
+
+bool LocalFrameDispatcher::process(QIODevice *device, LocalFrameCodec *codec) const
+{
+    // 缓冲区满时设备中还有数据，处理完已有的帧后继续读取，直到没有新数据被读入
+    qint64 available;
+    do {
+        available = device->bytesAvailable();
+        if (!codec->readFrom(device))
+            return false;
+        QByteArray name;
+        QByteArray payload;
+        while (codec->nextFrame(&name, &payload)) {
+            dispatch(device, name, payload);
+        }
+        if (codec->error() != LocalFrameCodec::NoError)
+            return false;
+    } while (device->bytesAvailable() > 0 && device->bytesAvailable() < available);
+    return true;
+}
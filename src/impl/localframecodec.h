@@ -0,0 +1,107 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef LOCALFRAMECODEC_H
+#define LOCALFRAMECODEC_H
+
+#include <QByteArray>
+#include <QHash>
+
+#include <functional>
+
+class QIODevice;
+
+namespace dde {
+namespace network {
+
+/**
+ * @brief The FrameRingBuffer class
+ * 环形接收缓冲区，容量为2的幂，数据直接从设备读入空闲空间
+ * 读取时数据连续则直接返回视图，跨越末尾时才拷贝
+ */
+class FrameRingBuffer
+{
+public:
+    explicit FrameRingBuffer(int capacity = 4096);
+
+    int size() const;     // 可读的字节数
+    int capacity() const;
+    void clear();
+    void reserve(int size);           // 保证至少能容纳size字节，扩容时数据整理为从头开始
+    void append(const char *data, int length);
+    qint64 readFrom(QIODevice *device); // 读入设备中所有可读的数据，返回读取的字节数，出错返回-1
+    // 读取从offset开始的length字节，连续时返回指向缓冲区的数据(不拷贝)，否则拷贝到scratch后返回
+    QByteArray peek(int offset, int length, QByteArray *scratch) const;
+    void consume(int length);
+
+private:
+    QByteArray m_data;
+    int m_head;
+    int m_size;
+};
+
+/**
+ * @brief The LocalFrameCodec class
+ * 本地套接字的消息帧编解码，每个连接一个
+ * 帧格式：4字节长度(大端，不含自身) + 1字节名称长度 + 名称 + 数据
+ * 帧长度不超过MaxFrameSize，因此帧的第一个字节总是0，可以和以'{'开头的旧JSON消息区分
+ */
+class LocalFrameCodec
+{
+public:
+    enum Error {
+        NoError,
+        FrameTooLarge,
+        InvalidFrame,
+        ReadError,
+    };
+
+    static constexpr int HeaderSize = 5;
+    static constexpr int MaxFrameSize = 1 << 20;
+
+    LocalFrameCodec();
+
+    static QByteArray encode(const QByteArray &name, const QByteArray &payload);
+
+    bool readFrom(QIODevice *device);       // 出错返回false
+    void feed(const char *data, int length); // 直接送入数据，用于测试
+    // 取下一个完整的帧，name和payload在下一次调用nextFrame或者readFrom之前有效
+    bool nextFrame(QByteArray *name, QByteArray *payload);
+    void clear();
+
+    Error error() const { return m_error; }
+    int bufferedSize() const { return m_buffer.size(); }
+
+private:
+    void consumeFrame();
+
+private:
+    FrameRingBuffer m_buffer;
+    QByteArray m_scratch;
+    int m_pendingConsume; // 上一次返回的帧，在下一次读取时移除
+    Error m_error;
+};
+
+/**
+ * @brief The LocalFrameDispatcher class
+ * 按帧名称分发消息的处理函数表
+ */
+class LocalFrameDispatcher
+{
+public:
+    using Handler = std::function<void(QIODevice *device, const QByteArray &payload)>;
+
+    void registerHandler(const QByteArray &name, const Handler &handler);
+    bool dispatch(QIODevice *device, const QByteArray &name, const QByteArray &payload) const; // 没有处理函数返回false
+    // 从设备读取数据，分发所有完整的帧，数据错误返回false，调用方应断开连接
+    bool process(QIODevice *device, LocalFrameCodec *codec) const;
+
+private:
+    QHash<QByteArray, Handler> m_handlers;
+};
+
+} // namespace network
+} // namespace dde
+
+#endif // LOCALFRAMECODEC_H
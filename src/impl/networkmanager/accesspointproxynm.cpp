@@ -3,20 +3,19 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "accesspointproxynm.h"
+#include "accesspointtable.h"
 #include "netutils.h"
 
 #include <NetworkManagerQt/WirelessSetting>
 
 using namespace dde::network;
 
-AccessPointProxyNM::AccessPointProxyNM(NetworkManager::WirelessDevice::Ptr device, NetworkManager::WirelessNetwork::Ptr network, QObject *parent)
+AccessPointProxyNM::AccessPointProxyNM(AccessPointTable *table, NetworkManager::WirelessDevice::Ptr device, NetworkManager::WirelessNetwork::Ptr network, QObject *parent)
     : AccessPointProxy(parent)
     , m_device(device)
     , m_network(network)
-    , m_status(ConnectionStatus::Unknown)
-    , m_isHidden(false)
-    , m_strength(0)
-    , m_secured(false)
+    , m_table(table)
+    , m_row(table->insert(network->ssid()))
 {
     initState();
     initConnection();
@@ -26,14 +25,14 @@ AccessPointProxyNM::AccessPointProxyNM(NetworkManager::WirelessDevice::Ptr devic
 
 AccessPointProxyNM::~AccessPointProxyNM()
 {
+    m_table->remove(m_row);
 }
 
 void AccessPointProxyNM::updateStatus(ConnectionStatus status)
 {
-    if (m_status == status)
+    if (!m_table->setStatus(m_row, status))
         return;
 
-    m_status = status;
     Q_EMIT connectionStatusChanged(status);
 }
 
@@ -57,17 +56,17 @@ bool AccessPointProxyNM::contains(const QString &uni) const
 
 QString AccessPointProxyNM::ssid() const
 {
-    return m_network->ssid();
+    return m_table->ssid(m_row);
 }
 
 int AccessPointProxyNM::strength() const
 {
-    return m_strength;
+    return m_table->strength(m_row);
 }
 
 bool AccessPointProxyNM::secured() const
 {
-    return m_secured;
+    return m_table->testFlag(m_row, AccessPointTable::Secured);
 }
 
 bool AccessPointProxyNM::securedInEap() const
@@ -77,7 +76,7 @@ bool AccessPointProxyNM::securedInEap() const
 
 int AccessPointProxyNM::frequency() const
 {
-    return static_cast<int>(m_network->referenceAccessPoint()->frequency());
+    return m_table->frequency(m_row);
 }
 
 QString AccessPointProxyNM::path() const
@@ -92,35 +91,30 @@ QString AccessPointProxyNM::devicePath() const
 
 bool AccessPointProxyNM::connected() const
 {
-    return m_status == ConnectionStatus::Activated;
+    return status() == ConnectionStatus::Activated;
 }
 
 ConnectionStatus AccessPointProxyNM::status() const
 {
-    return m_status;
+    return m_table->status(m_row);
 }
 
 bool AccessPointProxyNM::hidden() const
 {
-    return m_isHidden;
+    return m_table->testFlag(m_row, AccessPointTable::Hidden);
 }
 
 bool AccessPointProxyNM::isWlan6() const
 {
-    NetworkManager::AccessPoint::Capabilities capability = m_network->referenceAccessPoint()->capabilities();
-    if (capability.testFlag(NetworkManager::AccessPoint::Capability(0x10))) // NetworkManager::AccessPoint::Capability::He
-        return true;
-
-    return false;
+    return m_table->testFlag(m_row, AccessPointTable::Wlan6);
 }
 
 void AccessPointProxyNM::updateStrengthFromActiveAp(int strength)
 {
-    if (strength == m_strength)
+    if (!m_table->setStrength(m_row, strength))
         return;
 
-    m_strength = strength;
-    Q_EMIT strengthChanged(m_strength);
+    Q_EMIT strengthChanged(m_table->strength(m_row));
 }
 
 void AccessPointProxyNM::initState()
@@ -154,9 +148,12 @@ void AccessPointProxyNM::initConnection()
 
 void AccessPointProxyNM::updateInfo()
 {
-    m_strength = m_network->signalStrength();
+    m_table->setStrength(m_row, m_network->signalStrength());
     NetworkManager::AccessPoint::Ptr ap = m_network->referenceAccessPoint();
-    m_secured = (ap->capabilities() == NetworkManager::AccessPoint::Capability::Privacy || ap->wpaFlags() != 0 || ap->rsnFlags() != 0);
+    m_table->setFlag(m_row, AccessPointTable::Secured, ap->capabilities() == NetworkManager::AccessPoint::Capability::Privacy || ap->wpaFlags() != 0 || ap->rsnFlags() != 0);
+    // NetworkManager::AccessPoint::Capability::He
+    m_table->setFlag(m_row, AccessPointTable::Wlan6, ap->capabilities().testFlag(NetworkManager::AccessPoint::Capability(0x10)));
+    m_table->setFrequency(m_row, static_cast<int>(ap->frequency()));
 }
 
 void AccessPointProxyNM::updateConnection()
@@ -191,18 +188,18 @@ void AccessPointProxyNM::updateHiddenInfo()
     if (setting.isNull())
         return;
 
-    m_isHidden = setting->hidden();
-    qCDebug(DNC) << "update accesspoint hidden info, ssid:" << m_isHidden << ", hidden:" << m_isHidden;
+    m_table->setFlag(m_row, AccessPointTable::Hidden, setting->hidden());
+    qCDebug(DNC) << "update accesspoint hidden info, ssid:" << ssid() << ", hidden:" << hidden();
 }
 
 void AccessPointProxyNM::onUpdateNetwork()
 {
-    int strength = m_strength;
-    bool secured = m_secured;
+    int oldStrength = strength();
+    bool oldSecured = secured();
     updateInfo();
-    if (strength != m_strength)
-        emit strengthChanged(m_strength);
+    if (oldStrength != strength())
+        emit strengthChanged(strength());
 
-    if (secured != m_secured)
-        emit securedChanged(m_secured);
+    if (oldSecured != secured())
+        emit securedChanged(secured());
 }
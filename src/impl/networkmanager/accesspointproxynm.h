@@ -15,12 +15,15 @@
 namespace dde {
 namespace network {
 
+class AccessPointTable;
+
+// 热点数据保存在网卡的AccessPointTable中，本类只记录所在的行
 class AccessPointProxyNM : public AccessPointProxy
 {
     Q_OBJECT
 
 public:
-    AccessPointProxyNM(NetworkManager::WirelessDevice::Ptr device, NetworkManager::WirelessNetwork::Ptr network, QObject *parent = nullptr);
+    AccessPointProxyNM(AccessPointTable *table, NetworkManager::WirelessDevice::Ptr device, NetworkManager::WirelessNetwork::Ptr network, QObject *parent = nullptr);
     ~AccessPointProxyNM() override;
 
     void updateStatus(ConnectionStatus status);
@@ -54,10 +57,8 @@ private slots:
 private:
     NetworkManager::WirelessDevice::Ptr m_device;
     NetworkManager::WirelessNetwork::Ptr m_network;
-    ConnectionStatus m_status;
-    bool m_isHidden;
-    int m_strength;
-    bool m_secured;
+    AccessPointTable *m_table;
+    int m_row;
     QList<QMetaObject::Connection> m_connectionList;
 };
 
@@ -0,0 +1,220 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "accesspointtable.h"
+
+#include <QtGlobal>
+
+using namespace dde::network;
+
+AccessPointTable::AccessPointTable()
+    : m_generation(0)
+    , m_size(0)
+{
+}
+
+int AccessPointTable::insert(const QString &ssid)
+{
+    int row;
+    if (m_freeRows.isEmpty()) {
+        row = m_ssids.size();
+        m_ssids.append(-1);
+        m_strengths.append(0);
+        m_flags.append(0);
+        m_frequencies.append(0);
+        m_statuses.append(0);
+        m_generations.append(0);
+    } else {
+        row = m_freeRows.takeLast();
+        m_strengths[row] = 0;
+        m_flags[row] = 0;
+        m_frequencies[row] = 0;
+        m_statuses[row] = static_cast<quint8>(ConnectionStatus::Unknown);
+    }
+    m_ssids[row] = internSsid(ssid);
+    ++m_size;
+    touch(row);
+    return row;
+}
+
+void AccessPointTable::remove(int row)
+{
+    if (!isValid(row))
+        return;
+
+    releaseSsid(m_ssids.at(row));
+    m_ssids[row] = -1;
+    m_freeRows.append(row);
+    --m_size;
+    ++m_generation;
+}
+
+void AccessPointTable::clear()
+{
+    m_ssids.clear();
+    m_strengths.clear();
+    m_flags.clear();
+    m_frequencies.clear();
+    m_statuses.clear();
+    m_generations.clear();
+    m_freeRows.clear();
+    m_ssidPool.clear();
+    m_ssidRefs.clear();
+    m_freeSsids.clear();
+    m_ssidIndex.clear();
+    m_size = 0;
+    ++m_generation;
+}
+
+int AccessPointTable::size() const
+{
+    return m_size;
+}
+
+int AccessPointTable::ssidCount() const
+{
+    return m_ssidIndex.size();
+}
+
+bool AccessPointTable::isValid(int row) const
+{
+    return row >= 0 && row < m_ssids.size() && m_ssids.at(row) >= 0;
+}
+
+quint32 AccessPointTable::generation() const
+{
+    return m_generation;
+}
+
+quint32 AccessPointTable::generation(int row) const
+{
+    return isValid(row) ? m_generations.at(row) : 0;
+}
+
+int AccessPointTable::memoryUsage() const
+{
+    int bytes = sizeof(AccessPointTable);
+    bytes += m_ssids.capacity() * sizeof(qint32);
+    bytes += m_strengths.capacity() * sizeof(quint8);
+    bytes += m_flags.capacity() * sizeof(quint8);
+    bytes += m_frequencies.capacity() * sizeof(quint16);
+    bytes += m_statuses.capacity() * sizeof(quint8);
+    bytes += m_generations.capacity() * sizeof(quint32);
+    bytes += m_freeRows.capacity() * sizeof(int);
+    bytes += m_ssidPool.capacity() * sizeof(QString);
+    bytes += m_ssidRefs.capacity() * sizeof(int);
+    bytes += m_freeSsids.capacity() * sizeof(int);
+    // QHash每个节点保存键、值和哈希链
+    bytes += m_ssidIndex.capacity() * (sizeof(QString) + sizeof(int) + sizeof(void *));
+    return bytes;
+}
+
+QString AccessPointTable::ssid(int row) const
+{
+    return isValid(row) ? m_ssidPool.at(m_ssids.at(row)) : QString();
+}
+
+int AccessPointTable::strength(int row) const
+{
+    return isValid(row) ? m_strengths.at(row) : 0;
+}
+
+bool AccessPointTable::testFlag(int row, Flag flag) const
+{
+    return isValid(row) && (m_flags.at(row) & flag);
+}
+
+int AccessPointTable::frequency(int row) const
+{
+    return isValid(row) ? m_frequencies.at(row) : 0;
+}
+
+ConnectionStatus AccessPointTable::status(int row) const
+{
+    return isValid(row) ? static_cast<ConnectionStatus>(m_statuses.at(row)) : ConnectionStatus::Unknown;
+}
+
+bool AccessPointTable::setStrength(int row, int strength)
+{
+    const quint8 value = static_cast<quint8>(qBound(0, strength, 100));
+    if (!isValid(row) || m_strengths.at(row) == value)
+        return false;
+
+    m_strengths[row] = value;
+    touch(row);
+    return true;
+}
+
+bool AccessPointTable::setFlag(int row, Flag flag, bool on)
+{
+    if (!isValid(row))
+        return false;
+
+    const quint8 value = on ? (m_flags.at(row) | flag) : (m_flags.at(row) & ~flag);
+    if (m_flags.at(row) == value)
+        return false;
+
+    m_flags[row] = value;
+    touch(row);
+    return true;
+}
+
+bool AccessPointTable::setFrequency(int row, int frequency)
+{
+    const quint16 value = static_cast<quint16>(qBound(0, frequency, 0xFFFF));
+    if (!isValid(row) || m_frequencies.at(row) == value)
+        return false;
+
+    m_frequencies[row] = value;
+    touch(row);
+    return true;
+}
+
+bool AccessPointTable::setStatus(int row, ConnectionStatus status)
+{
+    const quint8 value = static_cast<quint8>(status);
+    if (!isValid(row) || m_statuses.at(row) == value)
+        return false;
+
+    m_statuses[row] = value;
+    touch(row);
+    return true;
+}
+
+int AccessPointTable::internSsid(const QString &ssid)
+{
+    auto it = m_ssidIndex.constFind(ssid);
+    if (it != m_ssidIndex.constEnd()) {
+        ++m_ssidRefs[it.value()];
+        return it.value();
+    }
+
+    int index;
+    if (m_freeSsids.isEmpty()) {
+        index = m_ssidPool.size();
+        m_ssidPool.append(ssid);
+        m_ssidRefs.append(1);
+    } else {
+        index = m_freeSsids.takeLast();
+        m_ssidPool[index] = ssid;
+        m_ssidRefs[index] = 1;
+    }
+    m_ssidIndex.insert(ssid, index);
+    return index;
+}
+
+void AccessPointTable::releaseSsid(int index)
+{
+    if (--m_ssidRefs[index] > 0)
+        return;
+
+    m_ssidIndex.remove(m_ssidPool.at(index));
+    m_ssidPool[index] = QString();
+    m_freeSsids.append(index);
+}
+
+void AccessPointTable::touch(int row)
+{
+    m_generations[row] = ++m_generation;
+}
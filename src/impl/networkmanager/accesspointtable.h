@@ -0,0 +1,84 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef ACCESSPOINTTABLE_H
+#define ACCESSPOINTTABLE_H
+
+#include "networkconst.h"
+
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+namespace dde {
+namespace network {
+
+/**
+ * @brief The AccessPointTable class
+ * 一个无线网卡上的热点数据，按列保存在连续数组中
+ * SSID保存在字符串池中，同名的SSID只保存一份；信号强度、标志、频率和状态压缩保存
+ * 删除的行放入空闲列表，新增时复用，行号在删除前保持不变
+ * 每次数据变化递增代数，可通过代数判断数据是否变化
+ */
+class AccessPointTable
+{
+public:
+    enum Flag : quint8 {
+        Secured = 0x01,
+        Hidden = 0x02,
+        Wlan6 = 0x04,
+    };
+
+    AccessPointTable();
+
+    int insert(const QString &ssid); // 返回行号
+    void remove(int row);
+    void clear();
+
+    int size() const;      // 有效的行数
+    int ssidCount() const; // 字符串池中的SSID数
+    bool isValid(int row) const;
+    quint32 generation() const;        // 整个表的代数
+    quint32 generation(int row) const; // 该行最后一次变化时的代数
+    int memoryUsage() const;           // 占用的内存(字节)，不含QString的字符数据
+
+    QString ssid(int row) const;
+    int strength(int row) const;
+    bool testFlag(int row, Flag flag) const;
+    int frequency(int row) const;
+    ConnectionStatus status(int row) const;
+
+    // 数据变化返回true
+    bool setStrength(int row, int strength);
+    bool setFlag(int row, Flag flag, bool on);
+    bool setFrequency(int row, int frequency);
+    bool setStatus(int row, ConnectionStatus status);
+
+private:
+    int internSsid(const QString &ssid);
+    void releaseSsid(int index);
+    void touch(int row);
+
+private:
+    QVector<qint32> m_ssids; // 字符串池中的位置，-1为已删除的行
+    QVector<quint8> m_strengths;
+    QVector<quint8> m_flags;
+    QVector<quint16> m_frequencies;
+    QVector<quint8> m_statuses;
+    QVector<quint32> m_generations;
+    QVector<int> m_freeRows;
+    quint32 m_generation;
+    int m_size;
+
+    // SSID字符串池
+    QVector<QString> m_ssidPool;
+    QVector<int> m_ssidRefs;
+    QVector<int> m_freeSsids;
+    QHash<QString, int> m_ssidIndex;
+};
+
+}
+}
+
+#endif // ACCESSPOINTTABLE_H
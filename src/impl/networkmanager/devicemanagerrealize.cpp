@@ -25,6 +25,7 @@
 #include <wirelessdevice.h>
 
 #include <QMetaEnum>
+#include <QTimer>
 
 #include <stdlib.h>
 #include <string.h>
@@ -40,8 +41,8 @@ const static QString networkPath = "/org/deepin/dde/Network1";
 class AccessPointInfo
 {
 public:
-    AccessPointInfo(NetworkManager::WirelessDevice::Ptr device, NetworkManager::WirelessNetwork::Ptr network)
-        : m_proxy(new AccessPointProxyNM(device, network))
+    AccessPointInfo(AccessPointTable *table, NetworkManager::WirelessDevice::Ptr device, NetworkManager::WirelessNetwork::Ptr network)
+        : m_proxy(new AccessPointProxyNM(table, device, network))
         , m_accessPoint(new AccessPoints(m_proxy))
     {
     }
@@ -573,10 +574,15 @@ bool WiredDeviceManagerRealize::carrier() const
 WirelessDeviceManagerRealize::WirelessDeviceManagerRealize(NetworkManager::WirelessDevice::Ptr device, QObject *parent)
     : DeviceManagerRealize(device, parent)
     , m_device(device)
+    , m_activeConnectionTimer(new QTimer(this))
     , m_hotspotEnabled(getHotspotIsEnabled())
     , m_netProcesser(nullptr)
     , m_available(device->interfaceFlags() & DEVICE_INTERFACE_FLAG_UP)
 {
+    // 一次扫描可能连续收到几百个networkAppeared信号，连接状态在信号结束后统一更新一次
+    m_activeConnectionTimer->setSingleShot(true);
+    m_activeConnectionTimer->setInterval(100);
+    connect(m_activeConnectionTimer, &QTimer::timeout, this, &WirelessDeviceManagerRealize::onActiveConnectionChanged);
     connect(device.data(), &NetworkManager::WirelessDevice::networkAppeared, this, &WirelessDeviceManagerRealize::onNetworkAppeared);
     connect(device.data(), &NetworkManager::WirelessDevice::networkDisappeared, this, &WirelessDeviceManagerRealize::onNetworkDisappeared);
     connect(device.data(), &NetworkManager::WirelessDevice::interfaceFlagsChanged, this, &WirelessDeviceManagerRealize::onInterfaceFlagsChanged);
@@ -596,14 +602,9 @@ WirelessDeviceManagerRealize::WirelessDeviceManagerRealize(NetworkManager::Wirel
         addNetwork(network);
 
     auto updateActiveApStrength = [this](const NetworkManager::AccessPoint::Ptr &activeAp) {
-        if (activeAp.isNull())
-            return;
-        for (AccessPointInfo *apInfo : m_accessPointInfos) {
-            if (apInfo && apInfo->proxy() && apInfo->proxy()->contains(activeAp->uni())) {
-                apInfo->proxy()->updateStrengthFromActiveAp(activeAp->signalStrength());
-                break;
-            }
-        }
+        AccessPointInfo *apInfo = findAccessPointInfo(activeAp);
+        if (apInfo)
+            apInfo->proxy()->updateStrengthFromActiveAp(activeAp->signalStrength());
     };
 
     // referenceAccessPoint 信号强度变化不及时，需要监听 activeAccessPointChanged 信号
@@ -884,18 +885,11 @@ AccessPoints *WirelessDeviceManagerRealize::activeAccessPoints() const
     if (!isEnabled())
         return nullptr;
 
-    NetworkManager::AccessPoint::Ptr activeAccessPoint = m_device->activeAccessPoint();
-    if (activeAccessPoint.isNull())
-        return nullptr;
-
-    QList<AccessPointInfo *>::const_iterator itActiveAccessPoint = std::find_if(m_accessPointInfos.begin(), m_accessPointInfos.end(), [ activeAccessPoint ](AccessPointInfo *accessPoint) {
-        return accessPoint->proxy()->contains(activeAccessPoint->uni());
-    });
-
-    if (itActiveAccessPoint == m_accessPointInfos.end())
+    AccessPointInfo *apInfo = findAccessPointInfo(m_device->activeAccessPoint());
+    if (!apInfo)
         return nullptr;
 
-    return (*itActiveAccessPoint)->accessPoint();
+    return apInfo->accessPoint();
 }
 
 void WirelessDeviceManagerRealize::addConnection(const NetworkManager::Connection::Ptr &connection)
@@ -917,32 +911,26 @@ void WirelessDeviceManagerRealize::addConnection(const NetworkManager::Connectio
     if (wirelessSetting->mode() == NetworkManager::WirelessSetting::NetworkMode::Ap)
         return;
 
-    QList<WirelessConnection *>::iterator itConnection = std::find_if(m_wirelessConnections.begin(), m_wirelessConnections.end(), [ connection ](WirelessConnection *item) {
-        return item->connection()->path() == connection->path();
-    });
-
-    if (itConnection == m_wirelessConnections.end()) {
+    WirelessConnection *existConnection = findConnection(connection->path());
+    if (!existConnection) {
         WirelessConnection *wirelessItem = new WirelessConnection;
         wirelessItem->setConnection(createJson(m_device, connection));
         wirelessItem->updateTimeStamp(connection->settings()->timestamp());
         m_wirelessConnections << wirelessItem;
+        m_pathConnections.insert(connection->path(), wirelessItem);
         connect(connection.data(), &NetworkManager::Connection::unsavedChanged, this, [this](bool changed) {
             if (!changed)
                 Q_EMIT activeConnectionChanged();
         });
         connect(connection.data(), &NetworkManager::Connection::updated, this, [this, connection] {
-            QList<WirelessConnection *>::iterator itConnection = std::find_if(m_wirelessConnections.begin(), m_wirelessConnections.end(), [ connection ](WirelessConnection *item) {
-                return item->connection()->path() == connection->path();
-            });
-            if (itConnection != m_wirelessConnections.end()) {
-                WirelessConnection *wirelessItem = *itConnection;
+            WirelessConnection *wirelessItem = findConnection(connection->path());
+            if (wirelessItem)
                 Q_EMIT wirelessConnectionPropertyChanged( { wirelessItem } );
-            }
         });
         Q_EMIT wirelessConnectionAdded( { wirelessItem } );
         qCDebug(DNC) << "new Connection id:" << connection->settings()->id() << ", path:" << connection->path();
     } else {
-        (*itConnection)->setConnection(createJson(m_device, connection));
+        existConnection->setConnection(createJson(m_device, connection));
     }
 }
 
@@ -965,12 +953,9 @@ void WirelessDeviceManagerRealize::removeConnection(const QString &connectionUni
             return;
     }
     QList<WirelessConnection *> removedConnections;
-    for (WirelessConnection *item : m_wirelessConnections) {
-        if (item->connection()->path() != connectionUni)
-            continue;
-
+    WirelessConnection *item = m_pathConnections.take(connectionUni);
+    if (item)
         removedConnections << item;
-    }
     Q_EMIT wirelessConnectionRemoved(removedConnections);
 
     if (removedConnections.size() == 0)
@@ -984,29 +969,29 @@ void WirelessDeviceManagerRealize::removeConnection(const QString &connectionUni
 
 void WirelessDeviceManagerRealize::onActiveConnectionChanged()
 {
+    // 直接调用时取消还未执行的合并更新
+    m_activeConnectionTimer->stop();
     NetworkManager::ActiveConnection::Ptr activeConnection = m_device->activeConnection();
 
     auto findAccessPoints = [this](const NetworkManager::ActiveConnection::Ptr &activeConnection)->AccessPointProxyNM *{
         if (activeConnection.isNull())
             return nullptr;
 
-        QList<AccessPointInfo *>::iterator itAccessPoint = std::find_if(m_accessPointInfos.begin(), m_accessPointInfos.end(), [ activeConnection ](AccessPointInfo *accessPoint) {
-            NetworkManager::WirelessSetting::Ptr wirelessSetting = activeConnection->connection()->settings()->setting(NetworkManager::Setting::SettingType::Wireless).dynamicCast<NetworkManager::WirelessSetting>();
-            if (!wirelessSetting.isNull())
-                return accessPoint->accessPoint()->ssid() == wirelessSetting->ssid();
-
-            return false;
-        });
-
-        if (itAccessPoint == m_accessPointInfos.end())
+        NetworkManager::WirelessSetting::Ptr wirelessSetting = activeConnection->connection()->settings()->setting(NetworkManager::Setting::SettingType::Wireless).dynamicCast<NetworkManager::WirelessSetting>();
+        if (wirelessSetting.isNull())
             return nullptr;
 
-        return (*itAccessPoint)->proxy();
+        AccessPointInfo *apInfo = m_ssidAccessPoints.value(QString::fromUtf8(wirelessSetting->ssid()));
+        return apInfo ? apInfo->proxy() : nullptr;
     };
 
+    // 每次只监听当前活动连接的状态，避免重复调用时同一个活动连接上叠加多个监听
+    if (m_activeStateConn)
+        disconnect(m_activeStateConn);
+
     AccessPointProxyNM *activeAccessPoint = findAccessPoints(activeConnection);
     if (activeAccessPoint) {
-        connect(activeConnection.data(), &NetworkManager::ActiveConnection::stateChanged, this, [ this, activeConnection, findAccessPoints ](NetworkManager::ActiveConnection::State state) {
+        m_activeStateConn = connect(activeConnection.data(), &NetworkManager::ActiveConnection::stateChanged, this, [ this, activeConnection, findAccessPoints ](NetworkManager::ActiveConnection::State state) {
             AccessPointProxyNM *activeAp = findAccessPoints(activeConnection);
             NetworkManager::Connection::Ptr conn = activeConnection->connection();
             if (activeAp && conn) {
@@ -1086,11 +1071,12 @@ bool WirelessDeviceManagerRealize::hotspotEnabled()
 void WirelessDeviceManagerRealize::addNetwork(const NetworkManager::WirelessNetwork::Ptr &network)
 {
     // 在当前的网络列表中查找同名SSID的网络，如果查找到了，就更新数据，没有查找到，就新增一条网络
-    QList<AccessPointInfo *>::iterator itApInfo = std::find_if(m_accessPointInfos.begin(), m_accessPointInfos.end(), [ network ](AccessPointInfo *accessPoint) { return accessPoint->accessPoint()->ssid() == network->ssid(); });
-    if (itApInfo == m_accessPointInfos.end()) {
+    AccessPointInfo *existApInfo = m_ssidAccessPoints.value(network->ssid());
+    if (!existApInfo) {
         // 新增的无线网络
-        AccessPointInfo *apInfo = new AccessPointInfo(m_device, network);
+        AccessPointInfo *apInfo = new AccessPointInfo(&m_accessPointTable, m_device, network);
         m_accessPointInfos << apInfo;
+        m_ssidAccessPoints.insert(network->ssid(), apInfo);
 
         NetworkManager::AccessPoint::Ptr activeAp = m_device->activeAccessPoint();
         if (!activeAp.isNull() && apInfo->proxy()->contains(activeAp->uni()))
@@ -1099,7 +1085,7 @@ void WirelessDeviceManagerRealize::addNetwork(const NetworkManager::WirelessNetw
         Q_EMIT networkAdded({ apInfo->accessPoint() });
     } else {
         // 已经存在该无线网络，只需要更新内部的数据即可
-        AccessPointInfo *apInfo = *itApInfo;
+        AccessPointInfo *apInfo = existApInfo;
         apInfo->proxy()->updateNetwork(network);
 
         NetworkManager::AccessPoint::Ptr activeAp = m_device->activeAccessPoint();
@@ -1110,13 +1096,28 @@ void WirelessDeviceManagerRealize::addNetwork(const NetworkManager::WirelessNetw
 
 WirelessConnection *WirelessDeviceManagerRealize::findConnection(const QString &path) const
 {
-    auto itConnection = std::find_if(m_wirelessConnections.begin(), m_wirelessConnections.end(), [ path ](WirelessConnection *item) { return item->connection()->path() == path; });
-    if (itConnection != m_wirelessConnections.end())
-        return *itConnection;
+    return m_pathConnections.value(path);
+}
+
+AccessPointInfo *WirelessDeviceManagerRealize::findAccessPointInfo(const NetworkManager::AccessPoint::Ptr &accessPoint) const
+{
+    if (accessPoint.isNull())
+        return nullptr;
+
+    // 同一个SSID的热点归属于同一个网络，先按照SSID查找，再确认该热点属于这个网络
+    AccessPointInfo *apInfo = m_ssidAccessPoints.value(accessPoint->ssid());
+    if (apInfo && apInfo->proxy()->contains(accessPoint->uni()))
+        return apInfo;
 
     return nullptr;
 }
 
+void WirelessDeviceManagerRealize::requestActiveConnectionChanged()
+{
+    if (!m_activeConnectionTimer->isActive())
+        m_activeConnectionTimer->start();
+}
+
 void WirelessDeviceManagerRealize::onNetworkAppeared(const QString &ssid)
 {
     NetworkManager::WirelessNetwork::Ptr network = m_device->findNetwork(ssid);
@@ -1126,19 +1127,16 @@ void WirelessDeviceManagerRealize::onNetworkAppeared(const QString &ssid)
     qCDebug(DNC) << "network appeared" << ssid;
     addNetwork(network);
     // 新增无线网络后，需要更新网络的连接状态
-    onActiveConnectionChanged();
+    requestActiveConnectionChanged();
 }
 
 void WirelessDeviceManagerRealize::onNetworkDisappeared(const QString &ssid)
 {
     // 查找移除的网络
     QList<AccessPointInfo *> removeAccessPoints;
-    for (AccessPointInfo *apInfo : m_accessPointInfos) {
-        if (apInfo->accessPoint()->ssid() != ssid)
-            continue;
-
-        removeAccessPoints << apInfo;
-    }
+    AccessPointInfo *removeApInfo = m_ssidAccessPoints.take(ssid);
+    if (removeApInfo)
+        removeAccessPoints << removeApInfo;
 
     if (removeAccessPoints.size() == 0)
         return;
@@ -1159,7 +1157,7 @@ void WirelessDeviceManagerRealize::onNetworkDisappeared(const QString &ssid)
         delete apInfo ;
 
     // 删除无线网络后，需要更新网络的连接状态
-    onActiveConnectionChanged();
+    requestActiveConnectionChanged();
 }
 
 void WirelessDeviceManagerRealize::onInterfaceFlagsChanged()
@@ -5,6 +5,7 @@
 #ifndef DEVICEMANAGERREALIZE_H
 #define DEVICEMANAGERREALIZE_H
 
+#include "accesspointtable.h"
 #include "netinterface.h"
 
 #include <NetworkManagerQt/WiredDevice>
@@ -20,6 +21,7 @@ class AccessPoint;
 }
 
 class AccessPointInfo;
+class QTimer;
 
 namespace dde {
 namespace network {
@@ -138,6 +140,8 @@ private:
     bool hotspotEnabled() override;
     void addNetwork(const NetworkManager::WirelessNetwork::Ptr &network);
     WirelessConnection *findConnection(const QString &path) const;
+    AccessPointInfo *findAccessPointInfo(const NetworkManager::AccessPoint::Ptr &accessPoint) const;
+    void requestActiveConnectionChanged();                                                // 合并一次扫描中多个网络变化引起的连接状态更新
 
 private Q_SLOTS:
     void onNetworkAppeared(const QString &ssid);
@@ -148,6 +152,11 @@ private:
     NetworkManager::WirelessDevice::Ptr m_device;
     QList<WirelessConnection *> m_wirelessConnections;
     QList<AccessPointInfo *> m_accessPointInfos;
+    QHash<QString, WirelessConnection *> m_pathConnections;                               // 以连接路径为索引，和m_wirelessConnections保持一致
+    QHash<QString, AccessPointInfo *> m_ssidAccessPoints;                                 // 以SSID为索引，和m_accessPointInfos保持一致
+    AccessPointTable m_accessPointTable;                                                  // 所有网络的数据，m_accessPointInfos中的对象只记录行号
+    QTimer *m_activeConnectionTimer;
+    QMetaObject::Connection m_activeStateConn;
     bool m_hotspotEnabled;
     ProcesserInterface *m_netProcesser;
     bool m_available;
@@ -17,6 +17,7 @@ NetworkDetailNMRealize::NetworkDetailNMRealize(NetworkManager::Device::Ptr devic
     : NetworkDetailRealize(parent)
     , m_device(device)
     , m_activeConnection(activeConnection)
+    , m_isHotspot(false)
     , m_ipConfig(new IpManager(m_device, this))
 {
     initProperties();
@@ -29,12 +30,61 @@ NetworkDetailNMRealize::~NetworkDetailNMRealize()
 
 void NetworkDetailNMRealize::initConnection()
 {
-    connect(m_activeConnection.get(), &NetworkManager::ActiveConnection::ipV4ConfigChanged, this, &NetworkDetailNMRealize::onUpdateInfo);
-    connect(m_activeConnection.get(), &NetworkManager::ActiveConnection::ipV6ConfigChanged, this, &NetworkDetailNMRealize::onUpdateInfo);
+    connect(m_activeConnection.get(), &NetworkManager::ActiveConnection::ipV4ConfigChanged, this, [ this ] {
+        onUpdateInfo(Ipv4Section);
+    });
+    connect(m_activeConnection.get(), &NetworkManager::ActiveConnection::ipV6ConfigChanged, this, [ this ] {
+        onUpdateInfo(Ipv6Section);
+    });
     connect(m_ipConfig, &IpManager::ipChanged, this, [ this ] {
-        onUpdateInfo();
-        emit infoChanged();
+        onUpdateInfo(Ipv4Section);
+    });
+    connect(m_device.get(), &NetworkManager::Device::interfaceNameChanged, this, [ this ] {
+        onUpdateInfo(HardwareSection);
     });
+    NetworkManager::Connection::Ptr connection = m_activeConnection->connection();
+    if (connection) {
+        // 连接名称和加密方式来自于连接的配置
+        connect(connection.get(), &NetworkManager::Connection::updated, this, [ this ] {
+            onUpdateInfo(WirelessSection);
+        });
+    }
+
+    switch (m_device->type()) {
+    case NetworkManager::Device::Type::Ethernet: {
+        NetworkManager::WiredDevice::Ptr wiredDevice = m_device.dynamicCast<NetworkManager::WiredDevice>();
+        if (!wiredDevice)
+            break;
+        connect(wiredDevice.get(), &NetworkManager::WiredDevice::bitRateChanged, this, [ this ] {
+            onUpdateInfo(SpeedSection);
+        });
+        connect(wiredDevice.get(), &NetworkManager::WiredDevice::hardwareAddressChanged, this, [ this ] {
+            onUpdateInfo(HardwareSection);
+        });
+        break;
+    }
+    case NetworkManager::Device::Type::Wifi: {
+        NetworkManager::WirelessDevice::Ptr wirelessDevice = m_device.dynamicCast<NetworkManager::WirelessDevice>();
+        if (!wirelessDevice)
+            break;
+        connect(wirelessDevice.get(), &NetworkManager::WirelessDevice::bitRateChanged, this, [ this ] {
+            onUpdateInfo(SpeedSection);
+        });
+        connect(wirelessDevice.get(), &NetworkManager::WirelessDevice::hardwareAddressChanged, this, [ this ] {
+            onUpdateInfo(HardwareSection);
+        });
+        connect(wirelessDevice.get(), &NetworkManager::WirelessDevice::activeAccessPointChanged, this, [ this ] {
+            onUpdateInfo(WirelessSection);
+        });
+        // 热点模式切换后名称和显示的段都不一样
+        connect(wirelessDevice.get(), &NetworkManager::WirelessDevice::modeChanged, this, [ this ] {
+            onUpdateInfo(WirelessSection);
+        });
+        break;
+    }
+    default:
+        break;
+    }
 }
 
 QString NetworkDetailNMRealize::name()
@@ -49,10 +99,34 @@ QList<QPair<QString, QString> > NetworkDetailNMRealize::items()
 
 void NetworkDetailNMRealize::initProperties()
 {
-    m_name = m_activeConnection->connection()->name();
-    bool isHotspot = false;
+    for (int i = 0; i < SectionCount; i++)
+        updateSection(static_cast<Section>(i));
+
+    updateName();
+    updateItems();
+}
+
+void NetworkDetailNMRealize::updateName()
+{
+    if (m_isHotspot) {
+        m_name = tr("Hotspot");
+        return;
+    }
+
     NetworkManager::Connection::Ptr connection = m_activeConnection->connection();
-    if (m_device->type() == NetworkManager::Device::Type::Wifi) {
+    if (connection)
+        m_name = connection->name();
+}
+
+void NetworkDetailNMRealize::updateSection(Section section)
+{
+    m_sections[section].clear();
+    switch (section) {
+    case WirelessSection: {
+        m_isHotspot = false;
+        if (m_device->type() != NetworkManager::Device::Type::Wifi)
+            break;
+
         // 获取设备的活动连接网络
         NetworkManager::WirelessDevice::Ptr wirelessDevice = m_device.staticCast<NetworkManager::WirelessDevice>();
 
@@ -75,84 +149,103 @@ void NetworkDetailNMRealize::initProperties()
             channel = NetworkManager::findChannel(static_cast<int>(activeAccessPoint->frequency()));
         }
 
-        isHotspot = (wirelessDevice->mode() == NetworkManager::WirelessDevice::OperationMode::ApMode);
-        if (isHotspot) {
-            m_name = tr("Hotspot");
-            NetworkManager::AccessPoint::Ptr activeAp = wirelessDevice->activeAccessPoint();
-            if (activeAp)
-                appendInfo(tr("SSID"), ssid);
+        m_isHotspot = (wirelessDevice->mode() == NetworkManager::WirelessDevice::OperationMode::ApMode);
+        if (m_isHotspot) {
+            if (activeAccessPoint)
+                appendInfo(section, tr("SSID"), ssid);
         } else {
-            const QString protocol = NetworkManager::ConnectionSettings::typeAsString(connection->settings()->connectionType());
+            NetworkManager::Connection::Ptr connection = m_activeConnection->connection();
+            const QString protocol = connection ? NetworkManager::ConnectionSettings::typeAsString(connection->settings()->connectionType()) : QString();
             if (!protocol.isEmpty())
-                appendInfo(tr("Protocol"), protocol);
+                appendInfo(section, tr("Protocol"), protocol);
 
             // 安全类型
-            appendInfo(tr("Security Type"), getSecurity(m_device));
+            appendInfo(section, tr("Security Type"), getSecurity(m_device));
             // 网络通道
             if (channel != 0)
-                appendInfo(tr("Channel"), QString::number(channel));
+                appendInfo(section, tr("Channel"), QString::number(channel));
         }
-        appendInfo(tr("Band"), frequencyBand);
-        if (isHotspot) {
-            appendInfo(tr("Security Type"), getSecurity(m_device));
+        appendInfo(section, tr("Band"), frequencyBand);
+        if (m_isHotspot) {
+            appendInfo(section, tr("Security Type"), getSecurity(m_device));
         }
+        break;
     }
-    // 接口名
-    appendInfo(tr("Interface"), m_device->interfaceName());
-    // MAC地址
-    const QString mac = macAddress();
-    if (!mac.isEmpty())
-        appendInfo(tr("MAC"), mac);
-
-    if (isHotspot)
-        return;
-
-    // 获取IPV4
-    NetworkManager::IpConfig ipV4Config = m_activeConnection->ipV4Config();
-    QList<NetworkManager::IpAddress> addresses;
-    if (m_ipConfig) {
-        addresses = m_ipConfig->ipAddresses();
-    } else {
-        addresses = ipV4Config.addresses();
-    }
-    for (NetworkManager::IpAddress address : addresses) {
-        QString ipv4 = address.ip().toString();
-        ipv4 = ipv4.remove("\"");
-        appendInfo(tr("IPv4"), ipv4);
-        QString netMask = prefixToNetMask(address.prefixLength());
-        if (!netMask.isEmpty())
-            appendInfo(tr("Netmask"), netMask);
+    case HardwareSection: {
+        // 接口名
+        appendInfo(section, tr("Interface"), m_device->interfaceName());
+        // MAC地址
+        const QString mac = macAddress();
+        if (!mac.isEmpty())
+            appendInfo(section, tr("MAC"), mac);
+        break;
     }
-    QString gateWay = ipV4Config.gateway();
-    if (!gateWay.isEmpty())
-        appendInfo(tr("Gateway"), gateWay);
+    case Ipv4Section: {
+        // 获取IPV4
+        NetworkManager::IpConfig ipV4Config = m_activeConnection->ipV4Config();
+        QList<NetworkManager::IpAddress> addresses;
+        if (m_ipConfig) {
+            addresses = m_ipConfig->ipAddresses();
+        } else {
+            addresses = ipV4Config.addresses();
+        }
+        for (NetworkManager::IpAddress address : addresses) {
+            QString ipv4 = address.ip().toString();
+            ipv4 = ipv4.remove("\"");
+            appendInfo(section, tr("IPv4"), ipv4);
+            QString netMask = prefixToNetMask(address.prefixLength());
+            if (!netMask.isEmpty())
+                appendInfo(section, tr("Netmask"), netMask);
+        }
+        QString gateWay = ipV4Config.gateway();
+        if (!gateWay.isEmpty())
+            appendInfo(section, tr("Gateway"), gateWay);
 
-    QList<QHostAddress> ipV4NameServers = ipV4Config.nameservers();
-    if (!ipV4NameServers.isEmpty()) {
-        appendInfo(tr("Primary DNS"), ipV4NameServers.first().toString());
+        QList<QHostAddress> ipV4NameServers = ipV4Config.nameservers();
+        if (!ipV4NameServers.isEmpty()) {
+            appendInfo(section, tr("Primary DNS"), ipV4NameServers.first().toString());
+        }
+        break;
     }
-    // 获取IPV6
-    NetworkManager::IpConfig ipV6Config = m_activeConnection->ipV6Config();
-    addresses = ipV6Config.addresses();
-    for (NetworkManager::IpAddress address : addresses) {
-        QString ip = address.ip().toString().remove("\"");
-        appendInfo(tr("IPv6"), ip);
-        appendInfo(tr("Prefix"), QString::number(address.prefixLength()));
+    case Ipv6Section: {
+        // 获取IPV6
+        NetworkManager::IpConfig ipV6Config = m_activeConnection->ipV6Config();
+        QList<NetworkManager::IpAddress> addresses = ipV6Config.addresses();
+        for (NetworkManager::IpAddress address : addresses) {
+            QString ip = address.ip().toString().remove("\"");
+            appendInfo(section, tr("IPv6"), ip);
+            appendInfo(section, tr("Prefix"), QString::number(address.prefixLength()));
+        }
+        QString gateWay = ipV6Config.gateway();
+        if (!gateWay.isEmpty() && gateWay != "::")
+            appendInfo(section, tr("Gateway"), gateWay);
+        QList<QHostAddress> ipV6NameServers = ipV6Config.nameservers();
+        if (!ipV6NameServers.isEmpty()) {
+            appendInfo(section, tr("Primary DNS"), ipV6NameServers.first().toString());
+        }
+        break;
     }
-    gateWay = ipV6Config.gateway();
-    if (!gateWay.isEmpty() && gateWay != "::")
-        appendInfo(tr("Gateway"), gateWay);
-    QList<QHostAddress> ipV6NameServers = ipV6Config.nameservers();
-    if (!ipV6NameServers.isEmpty()) {
-        appendInfo(tr("Primary DNS"), ipV6NameServers.first().toString());
+    case SpeedSection:
+        appendInfo(section, tr("Speed"), getSpeedStr());
+        break;
+    default:
+        break;
     }
+}
+
+void NetworkDetailNMRealize::updateItems()
+{
+    m_items = m_sections[WirelessSection] + m_sections[HardwareSection];
+    // 热点只显示无线和硬件信息
+    if (m_isHotspot)
+        return;
 
-    appendInfo(tr("Speed"), getSpeedStr());
+    m_items << m_sections[Ipv4Section] << m_sections[Ipv6Section] << m_sections[SpeedSection];
 }
 
-void NetworkDetailNMRealize::appendInfo(const QString &title, const QString &value)
+void NetworkDetailNMRealize::appendInfo(Section section, const QString &title, const QString &value)
 {
-    m_items << qMakePair(title, value);
+    m_sections[section] << qMakePair(title, value);
 }
 
 QString NetworkDetailNMRealize::getSecurity(const NetworkManager::Device::Ptr &device) const
@@ -278,9 +371,14 @@ QString NetworkDetailNMRealize::getSpeedStr() const
     return "0 Mbps";
 }
 
-void NetworkDetailNMRealize::onUpdateInfo()
+void NetworkDetailNMRealize::onUpdateInfo(Section section)
 {
-    // 由于目前使用的qlist+qpair的数据形式，该数据有顺序显示，所以每次数据新增只能刷新所有数据，不能直接在末尾增加
-    m_items.clear();
-    initProperties();
+    // 只重新读取发生变化的段，其他段使用缓存的数据拼接
+    const QString oldName = m_name;
+    const QList<QPair<QString, QString>> oldItems = m_items;
+    updateSection(section);
+    updateName();
+    updateItems();
+    if (m_items != oldItems || m_name != oldName)
+        emit infoChanged();
 }
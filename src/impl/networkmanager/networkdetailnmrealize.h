@@ -25,22 +25,35 @@ public:
     QList<QPair<QString, QString>> items();
 
 private:
+    // 详情按照显示的顺序分段，NM属性变化时只刷新对应的段
+    enum Section {
+        WirelessSection = 0,
+        HardwareSection,
+        Ipv4Section,
+        Ipv6Section,
+        SpeedSection,
+        SectionCount
+    };
+
     void initProperties();
-    void appendInfo(const QString &title, const QString &value);
+    void updateName();
+    void updateSection(Section section);
+    void updateItems();
+    void appendInfo(Section section, const QString &title, const QString &value);
     QString getSecurity(const NetworkManager::Device::Ptr &device) const;
     QString macAddress() const;
     QString prefixToNetMask(int prefixLength) const;
     QString getSpeedStr() const;
     void initConnection();
-
-private Q_SLOTS:
-     void onUpdateInfo();
+    void onUpdateInfo(Section section);
 
 private:
     NetworkManager::Device::Ptr m_device;
     NetworkManager::ActiveConnection::Ptr m_activeConnection;
     QString m_name;
     QList<QPair<QString, QString>> m_items;
+    QList<QPair<QString, QString>> m_sections[SectionCount];
+    bool m_isHotspot;
     IpManager *m_ipConfig;
 };
 
@@ -28,6 +28,8 @@
 #include <wireddevice.h>
 #include <wirelessdevice.h>
 
+#include <QTimer>
+
 using namespace dde::network;
 
 const static QString NetworkManagerService = "org.freedesktop.NetworkManager";
@@ -43,7 +45,12 @@ NetworkManagerProcesser::NetworkManagerProcesser(bool sync, QObject *parent)
     , m_hotspotController(Q_NULLPTR)
     , m_connectivity(dde::network::Connectivity::Unknownconnectivity)
     , m_needDetails(false)
+    , m_detailsTimer(new QTimer(this))
 {
+    // 设备状态、活动连接、IP等变化通常同时到来，合并后统一更新一次网络详情
+    m_detailsTimer->setSingleShot(true);
+    m_detailsTimer->setInterval(100);
+    connect(m_detailsTimer, &QTimer::timeout, this, &NetworkManagerProcesser::updateNetworkDetails);
     initConnections();
     if (sync) {
         NetworkManager::Device::List devices = NetworkManager::networkInterfaces();
@@ -112,7 +119,7 @@ QList<NetworkDetails *> NetworkManagerProcesser::networkDetails()
 {
     if (!m_needDetails) {
         m_needDetails = true;
-        onUpdateNetworkDetail();
+        updateNetworkDetails();
     }
 
     return ObjectManager::instance()->networkDetails();
@@ -268,8 +275,15 @@ void NetworkManagerProcesser::onUpdateNetworkDetail()
     if (!m_needDetails)
         return;
 
-    ObjectManager *creator = ObjectManager::instance();
-    creator->cleanupNetworkDetails();
+    if (!m_detailsTimer->isActive())
+        m_detailsTimer->start();
+}
+
+void NetworkManagerProcesser::updateNetworkDetails()
+{
+    m_detailsTimer->stop();
+    if (!m_needDetails)
+        return;
 
     QMap<QString, NetworkManager::Device::Ptr> avaibleDevices;
     for (dde::network::NetworkDeviceBase *device: m_devices) {
@@ -281,6 +295,12 @@ void NetworkManagerProcesser::onUpdateNetworkDetail()
             avaibleDevices[device->path()] = dev;
     }
 
+    // 已经存在的详情直接复用，属性的变化由详情自己监听刷新，这里只处理新增、删除和顺序
+    ObjectManager *creator = ObjectManager::instance();
+    QHash<QString, NetworkDetails *> oldDetails = m_networkDetails;
+    QList<NetworkDetails *> details;
+    bool changed = false;
+    m_networkDetails.clear();
     NetworkManager::ActiveConnection::List activeConns = NetworkManager::activeConnections();
     for (NetworkManager::ActiveConnection::Ptr activeConn : activeConns) {
         if (activeConn->state() != NetworkManager::ActiveConnection::State::Activated)
@@ -291,13 +311,35 @@ void NetworkManagerProcesser::onUpdateNetworkDetail()
         for (const QString &devicePath : devicePaths) {
             if (!avaibleDevices.contains(devicePath))
                 continue;
-            // 遍历每个设备的活动连接
-            NetworkDetails *detail = creator->createNetworkDetail(new NetworkDetailNMRealize(avaibleDevices.value(devicePath), activeConn));
-            connect(detail, &NetworkDetails::infoChanged, this, &NetworkManagerProcesser::activeConnectionChange);
+
+            const QString key = devicePath + ":" + activeConn->path();
+            if (m_networkDetails.contains(key))
+                continue;
+
+            NetworkDetails *detail = oldDetails.take(key);
+            if (!detail) {
+                // 遍历每个设备的活动连接
+                detail = creator->createNetworkDetail(new NetworkDetailNMRealize(avaibleDevices.value(devicePath), activeConn));
+                connect(detail, &NetworkDetails::infoChanged, this, &NetworkManagerProcesser::activeConnectionChange);
+                changed = true;
+            }
+            m_networkDetails.insert(key, detail);
+            details << detail;
         }
     }
 
-    Q_EMIT activeConnectionChange();
+    for (NetworkDetails *detail : oldDetails) {
+        creator->removeNetworkDetail(detail);
+        changed = true;
+    }
+
+    if (creator->networkDetails() != details) {
+        creator->sortNetworkDetails(details);
+        changed = true;
+    }
+
+    if (changed)
+        Q_EMIT activeConnectionChange();
 }
 
 void NetworkManagerProcesser::onDeviceAdded(const QString &uni)
@@ -11,6 +11,10 @@
 
 #include <networkmanagerqt/manager.h>
 
+#include <QHash>
+
+class QTimer;
+
 namespace dde {
 namespace network {
 
@@ -54,6 +58,7 @@ private:
     void createOrRemoveDevice(const QString &path);
     bool deviceExist(const QString &path) const;
     NetworkDeviceBase *createDevice(const NetworkManager::Device::Ptr &device);
+    void updateNetworkDetails();
 
 private slots:
     void onDeviceAdded(const QString &uni);
@@ -72,6 +77,8 @@ private:
     dde::network::Connectivity m_connectivity;
     bool m_needDetails;
     QList<NetworkManager::Device::Ptr> m_deviceList;
+    QHash<QString, NetworkDetails *> m_networkDetails;                                    // 以"设备路径:活动连接路径"为索引的网络详情
+    QTimer *m_detailsTimer;
 };
 
 }
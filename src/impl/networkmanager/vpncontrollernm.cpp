@@ -5,6 +5,7 @@
 #include "vpncontrollernm.h"
 
 #include <QDBusAbstractInterface>
+#include <QSet>
 
 #include <NetworkManagerQt/Manager>
 #include <NetworkManagerQt/Settings>
@@ -91,6 +92,7 @@ VPNItem *VPNController_NM::addVpnConnection(const NetworkManager::Connection::Pt
     vpnItem->updateTimeStamp(connection->settings()->timestamp());
     m_items << vpnItem;
     m_vpnConnectionsMap[vpnItem] = connection;
+    m_pathItems[connection->path()] = vpnItem;
     connect(connection.data(), &NetworkManager::Connection::updated, vpnItem, [ connection, vpnItem, createJson, this ] {
         // 更新数据
         vpnItem->setConnection(createJson(connection));
@@ -196,6 +198,54 @@ NetworkManager::Connection::Ptr VPNController_NM::findConnectionByVPNItem(VPNIte
     return *itVpn;
 }
 
+void VPNController_NM::watchActiveConnection(const NetworkManager::ActiveConnection::Ptr &activeConnection)
+{
+    // 活动连接对应的连接不会改变，提前记录路径，状态变化时直接通过索引查找
+    const QString connectionPath = activeConnection->connection()->path();
+    NetworkManager::ActiveConnection *ac = activeConnection.data();
+    ActiveConnectionWatcher watcher;
+    watcher.stateChanged = connect(ac, &NetworkManager::ActiveConnection::stateChanged, this, [ this, ac, connectionPath ](NetworkManager::ActiveConnection::State state) {
+        VPNItem *activeItem = m_pathItems.value(connectionPath);
+        if (!activeItem)
+            return;
+
+        ConnectionStatus status = convertStateFromNetworkManager(state);
+        activeItem->setConnectionStatus(status);
+        if (status == ConnectionStatus::Activated) {
+            ac->connection()->settings()->setTimestamp(QDateTime::currentDateTime());
+            activeItem->updateTimeStamp(ac->connection()->settings()->timestamp());
+            activeItem->setActiveConnection(ac->path());
+        }
+        qCDebug(DNC) << "vpn connection state changed" << ac->path();
+        Q_EMIT activeConnectionChanged();
+    });
+    watcher.ipV4ConfigChanged = connect(ac, &NetworkManager::ActiveConnection::ipV4ConfigChanged, this, &VPNController_NM::onVpnIp4ConfigChanged);
+    m_activeConnectionWatchers.insert(activeConnection->path(), watcher);
+}
+
+void VPNController_NM::updateActiveConnectionWatchers(const NetworkManager::ActiveConnection::List &activeConnections)
+{
+    const int oldCount = m_activeConnectionWatchers.size();
+    QSet<QString> activePaths;
+    for (const NetworkManager::ActiveConnection::Ptr &activeConnection : activeConnections) {
+        activePaths << activeConnection->path();
+        if (!m_activeConnectionWatchers.contains(activeConnection->path()))
+            watchActiveConnection(activeConnection);
+    }
+    // 断开已经消失的活动连接的监听
+    for (auto it = m_activeConnectionWatchers.begin(); it != m_activeConnectionWatchers.end();) {
+        if (activePaths.contains(it.key())) {
+            ++it;
+            continue;
+        }
+        disconnect(it->stateChanged);
+        disconnect(it->ipV4ConfigChanged);
+        it = m_activeConnectionWatchers.erase(it);
+    }
+    if (oldCount != m_activeConnectionWatchers.size())
+        qCDebug(DNC) << "vpn active connection watcher count changed:" << oldCount << "->" << m_activeConnectionWatchers.size();
+}
+
 void VPNController_NM::onConnectionAdded(const QString &path)
 {
     qCInfo(DNC) << "On connection added, new vpn connection: " << path;
@@ -221,22 +271,21 @@ void VPNController_NM::onConnectionRemoved(const QString &path)
     if (m_dnsRouteController)
         m_dnsRouteController->cleanupConnection(path);
 
-    for (VPNItem *item : m_items) {
-        if (item->connection()->path() != path)
-            continue;
+    VPNItem *item = m_pathItems.take(path);
+    if (!item)
+        return;
 
-        m_items.removeAll(item);
-        m_vpnConnectionsMap.remove(item);
-        Q_EMIT itemRemoved({ item });
-        delete item;
-        break;
-    }
+    m_items.removeAll(item);
+    m_vpnConnectionsMap.remove(item);
+    Q_EMIT itemRemoved({ item });
+    delete item;
 }
 
 void VPNController_NM::onActiveConnectionsChanged()
 {
     // 活动连接发生变化
     NetworkManager::ActiveConnection::List activeConnections = findActiveConnection();
+    updateActiveConnectionWatchers(activeConnections);
     if (activeConnections.isEmpty())
         return;
 
@@ -261,27 +310,6 @@ void VPNController_NM::onActiveConnectionsChanged()
         if (!vpnCategoryItems.contains(activeServiceType))
             continue;
 
-        // 监听当前活动连接的状态变化
-        connect(activeConnection.data(), &NetworkManager::ActiveConnection::stateChanged, this, [ this, activeConnection ](NetworkManager::ActiveConnection::State state) {
-            QList<VPNItem *>::iterator itVpnItem = std::find_if(m_items.begin(), m_items.end(), [ activeConnection ](VPNItem *item) { return item->connection()->path() == activeConnection->connection()->path(); });
-            if (itVpnItem == m_items.end())
-                return;
-
-            VPNItem *activeItem = *itVpnItem;
-            ConnectionStatus status = convertStateFromNetworkManager(state);
-            activeItem->setConnectionStatus(status);
-            if (status == ConnectionStatus::Activated) {
-                activeConnection->connection()->settings()->setTimestamp(QDateTime::currentDateTime());
-                activeItem->updateTimeStamp(activeConnection->connection()->settings()->timestamp());
-                activeItem->setActiveConnection(activeConnection->path());
-            }
-            qCDebug(DNC) << "vpn connection state changed" << activeConnection->path();
-            Q_EMIT activeConnectionChanged();
-        });
-
-        connect(activeConnection.data(), &NetworkManager::ActiveConnection::ipV4ConfigChanged,
-                this, &VPNController_NM::onVpnIp4ConfigChanged, Qt::UniqueConnection);
-
         QList<VPNItem *> vpnItems = vpnCategoryItems[activeServiceType];
         for (VPNItem *vpnItem : vpnItems) {
             // 查找该类型的VPN活动连接，并且修改其状态
@@ -409,3 +437,8 @@ QList<VPNItem *> VPNController_NM::items() const
 {
     return m_items;
 }
+
+int VPNController_NM::activeConnectionWatcherCount() const
+{
+    return m_activeConnectionWatchers.size();
+}
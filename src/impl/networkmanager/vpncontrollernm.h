@@ -7,8 +7,11 @@
 
 #include "vpncontroller.h"
 
+#include <NetworkManagerQt/ActiveConnection>
 #include <NetworkManagerQt/Connection>
 
+#include <QHash>
+
 namespace dde {
 namespace network {
 
@@ -27,6 +30,7 @@ public:
     void connectItem(const QString &uuid) override;                                      // 连接VPN(重载函数)
     void disconnectItem() override;                                                      // 断开当前活动VPN连接
     QList<VPNItem *> items() const override;                                             // 返回所有的连接
+    int activeConnectionWatcherCount() const override;                                   // 当前正在监听的VPN活动连接数量
 
 protected:
     explicit VPNController_NM(QObject *parent);
@@ -40,6 +44,8 @@ private:
     QList<VPNItem *> findAutoConnectItems() const;
     NetworkManager::ActiveConnection::List findActiveConnection() const;
     NetworkManager::Connection::Ptr findConnectionByVPNItem(VPNItem *vpnItem) const;     // 根据VPN的条目查找具体的Connection;
+    void watchActiveConnection(const NetworkManager::ActiveConnection::Ptr &activeConnection);
+    void updateActiveConnectionWatchers(const NetworkManager::ActiveConnection::List &activeConnections);
 
 private Q_SLOTS:
     void onConnectionAdded(const QString &path);
@@ -49,8 +55,17 @@ private Q_SLOTS:
     void onVpnIp4ConfigChanged();
 
 private:
+    // 每个VPN活动连接只监听一次，活动连接消失后断开
+    struct ActiveConnectionWatcher
+    {
+        QMetaObject::Connection stateChanged;
+        QMetaObject::Connection ipV4ConfigChanged;
+    };
+
     QList<VPNItem *> m_items;
     QMap<VPNItem *, NetworkManager::Connection::Ptr> m_vpnConnectionsMap;
+    QHash<QString, VPNItem *> m_pathItems;                                              // 连接路径到VPN条目的索引
+    QHash<QString, ActiveConnectionWatcher> m_activeConnectionWatchers;                  // 活动连接路径到监听的映射
     VpnDnsRouteController *m_dnsRouteController = nullptr;
 };
 
@@ -33,6 +33,18 @@ void ObjectManager::cleanupNetworkDetails()
     m_networkDetails.clear();
 }
 
+void ObjectManager::removeNetworkDetail(NetworkDetails *detail)
+{
+    if (m_networkDetails.removeOne(detail))
+        delete detail;
+}
+
+void ObjectManager::sortNetworkDetails(const QList<NetworkDetails *> &details)
+{
+    Q_ASSERT(details.size() == m_networkDetails.size());
+    m_networkDetails = details;
+}
+
 NetworkDeviceRealize *ObjectManager::deviceRealize(NetworkDeviceBase *device) const
 {
     return device->deviceRealize();
@@ -22,6 +22,8 @@ public:
     NetworkDetails *createNetworkDetail(NetworkDetailRealize *realize);
     QList<NetworkDetails *> networkDetails() const;
     void cleanupNetworkDetails();
+    void removeNetworkDetail(NetworkDetails *detail);
+    void sortNetworkDetails(const QList<NetworkDetails *> &details);   // 按照传入的顺序排列，传入的列表必须和当前的列表包含相同的对象
 
     NetworkDeviceRealize *deviceRealize(NetworkDeviceBase *device) const;
 
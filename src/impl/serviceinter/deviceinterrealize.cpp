@@ -920,8 +920,11 @@ void WirelessDeviceInterRealize::updateActiveStatus(const QSharedPointer<Network
     emit activeConnectionChanged();
 }
 
-void WirelessDeviceInterRealize::updateAccesspoint(const QJsonArray &json)
+void WirelessDeviceInterRealize::updateAccesspoint(const JsonArrayDelta &delta)
 {
+    if (delta.isEmpty())
+        return;
+
     auto isWifi6 = [](const QJsonObject &json) {
         if (json.contains("Flags")) {
             int flag = json.value("Flags").toInt();
@@ -932,63 +935,86 @@ void WirelessDeviceInterRealize::updateAccesspoint(const QJsonArray &json)
         return false;
     };
 
-    // 先过滤相同的ssid，找出信号强度最大的那个
-    QMap<QString, int> ssidMaxStrength;
-    QMap<QString, QString> ssidPath;
-    QMap<QString, int> wifi6Ssids;
-    for (const QJsonValue &jsonValue : json) {
-        const QJsonObject obj = jsonValue.toObject();
+    // 只对发生变化的SSID重新选择信号强度最大的热点
+    QStringList changedSsids;
+    auto removeAccessPoint = [ this, &changedSsids ](const QString &path) {
+        auto it = m_accessPointJson.find(path);
+        if (it == m_accessPointJson.end())
+            return;
+
+        const QString ssid = it->value("Ssid").toString();
+        QStringList &paths = m_ssidApPaths[ssid];
+        paths.removeOne(path);
+        if (paths.isEmpty())
+            m_ssidApPaths.remove(ssid);
+        m_accessPointJson.erase(it);
+        if (!changedSsids.contains(ssid))
+            changedSsids << ssid;
+    };
+    auto insertAccessPoint = [ this, &changedSsids ](const QJsonObject &obj) {
         const QString ssid = obj.value("Ssid").toString();
-        const int strength = obj.value("Strength").toInt();
         const QString path = obj.value("Path").toString();
-        if (ssidMaxStrength.contains(ssid)) {
-            const int nOldStrength = ssidMaxStrength.value(ssid);
-            if (nOldStrength < strength) {
-                // 找到了对应的热点，更新热点的信号强度
-                ssidMaxStrength[ssid] = strength;
-                ssidPath[ssid] = path;
-            }
-        } else {
-            // 第一次直接插入SSID和信号强度和路径
-            ssidMaxStrength[ssid] = strength;
-            ssidPath[ssid] = path;
-        }
-        if (isWifi6(obj))
-            wifi6Ssids[ssid] = obj.value("Flags").toInt();
+        m_accessPointJson[path] = obj;
+        m_ssidApPaths[ssid] << path;
+        if (!changedSsids.contains(ssid))
+            changedSsids << ssid;
+    };
+
+    for (const QJsonObject &obj : delta.removed)
+        removeAccessPoint(obj.value("Path").toString());
+
+    // 内容变化的热点可能连SSID也变化了(例如隐藏网络)，因此先删除再添加
+    for (const QJsonObject &obj : delta.changed) {
+        removeAccessPoint(obj.value("Path").toString());
+        insertAccessPoint(obj);
     }
 
+    for (const QJsonObject &obj : delta.added)
+        insertAccessPoint(obj);
+
     QList<AccessPoints *> newAp;
     QList<AccessPoints *> changedAp;
-    QStringList ssids;
-    for (const QJsonValue &jsonValue : json) {
-        QJsonObject accessInfo = jsonValue.toObject();
-        const QString ssid = accessInfo.value("Ssid").toString();
-        const QString maxSsidPath = ssidPath.value(ssid);
-        const QString path = accessInfo.value("Path").toString();
-        if (path != maxSsidPath)
+    QList<AccessPointInfo *> rmAccessPoints;
+    for (const QString &ssid : changedSsids) {
+        AccessPointInfo *accessPoint = findAccessPoint(ssid);
+        const QStringList paths = m_ssidApPaths.value(ssid);
+        if (paths.isEmpty()) {
+            if (accessPoint)
+                rmAccessPoints << accessPoint;
             continue;
+        }
+
+        // 先过滤相同的ssid，找出信号强度最大的那个，信号强度相同时保留当前显示的热点，避免来回切换
+        const QString currentPath = accessPoint ? accessPoint->proxy()->path() : QString();
+        QJsonObject accessInfo;
+        int maxStrength = 0;
+        int wifi6Flags = 0;
+        for (const QString &path : paths) {
+            const QJsonObject obj = m_accessPointJson.value(path);
+            const int strength = obj.value("Strength").toInt();
+            if (accessInfo.isEmpty() || strength > maxStrength || (strength == maxStrength && path == currentPath)) {
+                accessInfo = obj;
+                maxStrength = strength;
+            }
+            if (isWifi6(obj))
+                wifi6Flags = obj.value("Flags").toInt();
+        }
 
         // 如果当前的SSID存在WiFi6,就让其显示WiFi6的属性
-        if (wifi6Ssids.contains(ssid))
-            accessInfo["extendFlags"] = wifi6Ssids[ssid];
+        if (wifi6Flags != 0)
+            accessInfo["extendFlags"] = wifi6Flags;
 
-        // 从网络列表中查找现有的网络
-        AccessPointInfo *accessPoint = findAccessPoint(ssid);
         if (!accessPoint) {
             // 如果没有找到这个网络，就新建一个网络，添加到网络列表
             AccessPointInfo *apInfo = new AccessPointInfo(accessInfo, this->path());
             m_accessPointInfos << apInfo;
             newAp << apInfo->accessPoint();
         } else {
-            int strength = accessInfo.value("Strength").toInt();
-            if (accessPoint->accessPoint()->strength() != strength)
+            if (accessPoint->accessPoint()->strength() != maxStrength)
                 changedAp << accessPoint->accessPoint();
 
             accessPoint->proxy()->updateAccessPoints(accessInfo);
         }
-
-        if (!ssids.contains(ssid))
-            ssids << ssid;
     }
 
     if (changedAp.size())
@@ -997,13 +1023,6 @@ void WirelessDeviceInterRealize::updateAccesspoint(const QJsonArray &json)
     if (newAp.size() > 0)
         Q_EMIT networkAdded(newAp);
 
-    // 更新网络和连接的关系
-    QList<AccessPointInfo *> rmAccessPoints;
-    for (AccessPointInfo *ap : m_accessPointInfos) {
-        if (!ssids.contains(ap->ssid()))
-            rmAccessPoints << ap;
-    }
-
     if (rmAccessPoints.size() > 0) {
         QList<AccessPoints *> rmApItems;
         for (AccessPointInfo *ap : rmAccessPoints) {
@@ -1017,6 +1036,10 @@ void WirelessDeviceInterRealize::updateAccesspoint(const QJsonArray &json)
     for (AccessPointInfo *ap : rmAccessPoints)
         delete ap;
 
+    // 只有网络列表增加或者减少的时候才需要更新网络和连接的关系
+    if (newAp.isEmpty() && rmAccessPoints.isEmpty())
+        return;
+
     createConnection(m_connectionJson);
     syncConnectionAccessPoints();
 }
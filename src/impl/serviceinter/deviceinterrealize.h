@@ -8,6 +8,7 @@
 #include "netinterface.h"
 #include "networkconst.h"
 #include "netutils.h"
+#include "jsonsnapshot.h"
 
 #include <QJsonArray>
 #include <QObject>
@@ -152,7 +153,7 @@ protected:
     void updateActiveInfo(const QList<QJsonObject> &info) override;
     QString deviceKey() override;
     WirelessConnection *findConnectionByPath(const QString &path);
-    void updateAccesspoint(const QJsonArray &json);
+    void updateAccesspoint(const JsonArrayDelta &delta);
     void setDeviceEnabledStatus(const bool &enabled) override;
     void updateActiveConnectionInfo(const QList<QJsonObject> &infos) override;
     bool hotspotEnabled() override;
@@ -170,6 +171,8 @@ protected:
 private:
     QList<WirelessConnection *> m_connections;
     QList<AccessPointInfo *> m_accessPointInfos;
+    QHash<QString, QJsonObject> m_accessPointJson;                                                          // 按热点路径记录的原始数据
+    QHash<QString, QStringList> m_ssidApPaths;                                                              // 同名热点的路径列表
     QJsonObject m_activeHotspotInfo;
     QList<QJsonObject> m_activeAccessPoints;
     QJsonObject m_hotspotInfo;
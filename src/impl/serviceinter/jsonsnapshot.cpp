@@ -0,0 +1,104 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "jsonsnapshot.h"
+
+#include <QSet>
+
+using namespace dde::network;
+
+JsonArraySnapshot::JsonArraySnapshot(const QString &key)
+    : m_key(key)
+{
+}
+
+// 哈希值不同时数据一定变化；哈希值相同时再完整比较，避免哈希冲突时漏掉变化
+bool JsonArraySnapshot::updateEntry(Entry &entry, size_t hash, const QJsonObject &obj)
+{
+    if (entry.hash == hash && entry.value == obj)
+        return false;
+
+    entry.hash = hash;
+    entry.value = obj;
+    return true;
+}
+
+JsonArrayDelta JsonArraySnapshot::update(const QJsonArray &array)
+{
+    JsonArrayDelta delta;
+    QSet<QString> paths;
+    paths.reserve(array.size());
+    for (const QJsonValue &jsonValue : array) {
+        const QJsonObject obj = jsonValue.toObject();
+        const QString path = obj.value(m_key).toString();
+        // 同一个路径在数组中出现多次时以第一次为准
+        if (paths.contains(path))
+            continue;
+
+        paths.insert(path);
+        const size_t hash = qHash(obj);
+        auto it = m_entries.find(path);
+        if (it == m_entries.end()) {
+            m_entries.insert(path, { hash, obj });
+            delta.added << obj;
+        } else if (updateEntry(it.value(), hash, obj)) {
+            delta.changed << obj;
+        }
+    }
+
+    if (paths.size() != m_entries.size()) {
+        for (auto it = m_entries.begin(); it != m_entries.end();) {
+            if (paths.contains(it.key())) {
+                ++it;
+                continue;
+            }
+            delta.removed << it->value;
+            it = m_entries.erase(it);
+        }
+    }
+
+    return delta;
+}
+
+JsonArrayDelta JsonArraySnapshot::apply(const QList<QJsonObject> &changed, const QStringList &removed)
+{
+    JsonArrayDelta delta;
+    for (const QJsonObject &obj : changed) {
+        const QString path = obj.value(m_key).toString();
+        const size_t hash = qHash(obj);
+        auto it = m_entries.find(path);
+        if (it == m_entries.end()) {
+            m_entries.insert(path, { hash, obj });
+            delta.added << obj;
+        } else if (updateEntry(it.value(), hash, obj)) {
+            delta.changed << obj;
+        }
+    }
+
+    for (const QString &path : removed) {
+        auto it = m_entries.find(path);
+        if (it == m_entries.end())
+            continue;
+
+        delta.removed << it->value;
+        m_entries.erase(it);
+    }
+
+    return delta;
+}
+
+void JsonArraySnapshot::clear()
+{
+    m_entries.clear();
+}
+
+int JsonArraySnapshot::size() const
+{
+    return m_entries.size();
+}
+
+bool JsonArraySnapshot::contains(const QString &path) const
+{
+    return m_entries.contains(path);
+}
@@ -0,0 +1,59 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef JSONSNAPSHOT_H
+#define JSONSNAPSHOT_H
+
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QList>
+#include <QStringList>
+
+namespace dde {
+namespace network {
+
+// 两次JSON数组数据之间的差异
+struct JsonArrayDelta
+{
+    QList<QJsonObject> added;       // 新增的数据
+    QList<QJsonObject> changed;     // 内容发生变化的数据(新值)
+    QList<QJsonObject> removed;     // 被移除的数据(旧值)
+
+    bool isEmpty() const { return added.isEmpty() && changed.isEmpty() && removed.isEmpty(); }
+};
+
+/**
+ * @brief The JsonArraySnapshot class
+ * 以对象路径为索引记录JSON数组中每一项的数据和哈希值，用于计算两次数据之间的增量
+ */
+class JsonArraySnapshot
+{
+public:
+    explicit JsonArraySnapshot(const QString &key = QStringLiteral("Path"));
+
+    JsonArrayDelta update(const QJsonArray &array);
+    // 直接应用后端发出的增量，changed中不存在的路径视为新增
+    JsonArrayDelta apply(const QList<QJsonObject> &changed, const QStringList &removed);
+    void clear();
+    int size() const;
+    bool contains(const QString &path) const;
+
+private:
+    struct Entry
+    {
+        size_t hash;
+        QJsonObject value;
+    };
+
+    static bool updateEntry(Entry &entry, size_t hash, const QJsonObject &obj); // 数据变化时更新并返回true
+
+    QString m_key;
+    QHash<QString, Entry> m_entries;
+};
+
+}
+}
+
+#endif // JSONSNAPSHOT_H
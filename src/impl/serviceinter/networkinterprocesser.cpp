@@ -15,6 +15,9 @@
 #include "wireddevice.h"
 #include "wirelessdevice.h"
 #include "deviceinterrealize.h"
+#include "configsetting.h"
+
+#include <QSet>
 
 namespace dde {
 namespace network {
@@ -26,6 +29,12 @@ const static QString networkPath = "/org/deepin/dde/Network1";
 #define CHANGE_ACTIVECONNECTIONS "ActiveConnectionsChanged"
 #define CHANGE_WIRELESSACCESSPOINTS "WirelessAccessPointsChanged"
 
+// 类型化接口的数据类型，与JSON接口的属性名称一致
+const static QString KindDevices = "Devices";
+const static QString KindConnections = "Connections";
+const static QString KindActiveConnections = "ActiveConnections";
+const static QString KindAccessPoints = "WirelessAccessPoints";
+
 NetworkInterProcesser::NetworkInterProcesser(bool sync, QObject *parent)
     : NetworkProcesser(parent)
     , m_proxyController(Q_NULLPTR)
@@ -37,6 +46,7 @@ NetworkInterProcesser::NetworkInterProcesser(bool sync, QObject *parent)
     , m_sync(sync)
     , m_changedTimer(new QTimer(this))
     , m_needDetails(false)
+    , m_typedInterface(ConfigSetting::instance()->typedNetworkInterface())
 {
     initConnection();
     initDeviceService();
@@ -48,6 +58,15 @@ NetworkInterProcesser::~NetworkInterProcesser()
 
 void NetworkInterProcesser::initNetData(NetworkInter *networkInt)
 {
+    if (m_typedInterface) {
+        // 和JSON接口的处理顺序保持一致
+        fetchObjects(networkInt, KindDevices);
+        fetchObjects(networkInt, KindConnections);
+        fetchObjects(networkInt, KindAccessPoints);
+        fetchObjects(networkInt, KindActiveConnections);
+        return;
+    }
+
     onDevicesChanged(networkInt->devices());
     doChangeConnectionList(networkInt->connections());
     doChangeAccesspoint(networkInt->wirelessAccessPoints());
@@ -94,6 +113,9 @@ void NetworkInterProcesser::initConnection()
     // 但是它们都能在100毫秒内全部返回，这样在定时器里按照顺序来处理这些信号的数据，保证数据的准确性
     m_changedTimer->setInterval(100);
     auto onDataChanged = [ this ](const char *infoName, const QString infoValue) {
+        if (m_typedInterface)
+            return;
+
         // 这里需要用QStringList来保存，因为对于ActiveConnectionsChanged信号来说，在多个网卡存在的情况下，这个信号会发送多次
         // 每次的内容可能会不一样，例如断开连接，第一次发送的信号是第一个网卡的连接状态，第二次发送的信号是第二个网卡的连接状态，必须保证每个
         // 信号都能被正确接收并处理，否则就会出现信号丢失引起状态不正确的问题
@@ -118,6 +140,7 @@ void NetworkInterProcesser::initConnection()
     connect(m_networkInter, &NetworkInter::WirelessAccessPointsChanged, this, [ onDataChanged ](const QString &accessPoints) {                  // 热点发生变化
         onDataChanged(CHANGE_WIRELESSACCESSPOINTS, accessPoints);
     });
+    connect(m_networkInter, &NetworkInter::ObjectsChanged, this, &NetworkInterProcesser::onObjectsChanged);                                      // 类型化数据的增量
     connect(m_networkInter, &NetworkInter::DeviceEnabled, this, &NetworkInterProcesser::onDeviceEnableChanged);                                 // 关闭设备或启用设备
 
     connect(m_networkInter, &NetworkInter::ConnectivityChanged, this, &NetworkInterProcesser::onConnectivityChanged);                           // 网络状态发生变化
@@ -158,14 +181,34 @@ static DeviceType deviceType(const QString &type)
 
 void NetworkInterProcesser::onDevicesChanged(const QString &value)
 {
-    if (value.isEmpty())
+    if (m_typedInterface || value.isEmpty())
         return;
 
+    updateDevices(QJsonDocument::fromJson(value.toUtf8()).object());
+}
+
+void NetworkInterProcesser::updateDevices(const QJsonObject &data)
+{
     bool unManager = false;
-    const QJsonObject data = QJsonDocument::fromJson(value.toUtf8()).object();
     QStringList devPaths;
     QList<NetworkDeviceBase *> newDevices;
     QStringList keys = data.keys();
+    // 和上一次的数据对比，已经存在的设备只有数据变化时才需要更新
+    QJsonArray allDevices;
+    for (const QString &key : keys) {
+        if (deviceType(key) == DeviceType::Unknown)
+            continue;
+
+        for (const QJsonValue jsonValue : data.value(key).toArray())
+            allDevices.append(jsonValue);
+    }
+    const JsonArrayDelta delta = m_deviceSnapshot.update(allDevices);
+    QSet<QString> changedPaths;
+    for (const QJsonObject &deviceInfo : delta.added)
+        changedPaths << deviceInfo.value("Path").toString();
+    for (const QJsonObject &deviceInfo : delta.changed)
+        changedPaths << deviceInfo.value("Path").toString();
+
     for (int i = 0; i < keys.size(); i++) {
         QString key = keys[i];
         DeviceType type = deviceType(key);
@@ -219,7 +262,7 @@ void NetworkInterProcesser::onDevicesChanged(const QString &value)
                     newDevices << device;
                     m_devices << device;
                 }
-            } else {
+            } else if (changedPaths.contains(path)) {
                 DeviceInterRealize *deviceRealized = static_cast<DeviceInterRealize *>(ObjectManager::instance()->deviceRealize(device));
                 deviceRealized->updateDeviceInfo(deviceInfo);
             }
@@ -253,8 +296,10 @@ void NetworkInterProcesser::onDevicesChanged(const QString &value)
             rmDevices << device;
     }
 
-    for (NetworkDeviceBase *device : rmDevices)
+    for (NetworkDeviceBase *device : rmDevices) {
         m_devices.removeOne(device);
+        m_accessPointSnapshots.remove(device->path());
+    }
 
     if (newDevices.size() > 0 || rmDevices.size() > 0) {
         // 更新设备名称
@@ -275,11 +320,19 @@ void NetworkInterProcesser::onDevicesChanged(const QString &value)
             updateConnectionsInfo(newDevices);
             // 如果新增的设备中存在无线网卡，则同时需要更新wlan的信息，因为存在如下情况
             // 如果关闭热点的时候，会先移除设备，然后再新增设备，此时如果不更新wlan，这种情况下，新增的那个无线设备的wlan就会为空
-            if (wirelessExist)
-                doChangeAccesspoint(m_networkInter->wirelessAccessPoints());
+            if (wirelessExist) {
+                if (m_typedInterface)
+                    updateAccessPoints(typedObjects(KindAccessPoints));
+                else
+                    doChangeAccesspoint(m_networkInter->wirelessAccessPoints());
+            }
         }
-        // 设备列表发生变化的同时，需要同时更新网络连接状态
-        doChangeActiveConnections(m_networkInter->activeConnections());
+        // 设备列表发生变化的同时，需要同时更新网络连接状态，新增的设备需要完整的活动连接数据
+        m_activeConnectionSnapshot.clear();
+        if (m_typedInterface)
+            updateActiveConnections(typedObjects(KindActiveConnections));
+        else
+            doChangeActiveConnections(m_networkInter->activeConnections());
 
         // 设备列表发生变化的同时，需要同时更新DSL的相关的信息，因为DSL里面用到了设备的信息，需要获取设备路径等
         updateDSLData();
@@ -315,8 +368,10 @@ void NetworkInterProcesser::onDevicesChanged(const QString &value)
             }
 
             if (unManagerDevices.size() > 0) {
-                for (NetworkDeviceBase *device : unManagerDevices)
+                for (NetworkDeviceBase *device : unManagerDevices) {
                     m_devices.removeOne(device);
+                    m_accessPointSnapshots.remove(device->path());
+                }
 
                 for (NetworkDeviceBase *device : unManagerDevices)
                     Q_EMIT device->removed();
@@ -352,6 +407,12 @@ void NetworkInterProcesser::onConnectionInfoChanged()
     doChangedData(&NetworkInterProcesser::doChangeAccesspoint, CHANGE_WIRELESSACCESSPOINTS);
     doChangedData(&NetworkInterProcesser::doChangeConnectionList, CHANGE_CONNECTIONS);
     doChangedData(&NetworkInterProcesser::doChangeActiveConnections, CHANGE_ACTIVECONNECTIONS);
+    // 类型化接口的热点增量是直接处理的，这里只需要按照顺序处理连接和活动连接
+    if (m_typedChangedKinds.contains(KindConnections))
+        updateConnectionList(typedObjects(KindConnections));
+    if (m_typedChangedKinds.contains(KindActiveConnections))
+        updateActiveConnections(typedObjects(KindActiveConnections));
+    m_typedChangedKinds.clear();
     if (m_changedTimer->isActive())
         m_changedTimer->stop();
 }
@@ -361,18 +422,38 @@ void NetworkInterProcesser::doChangeConnectionList(const QString &connections)
     if (connections.isEmpty())
         return;
 
-    m_connections = QJsonDocument::fromJson(connections.toUtf8()).object();
-    updateConnectionsInfo(m_devices);
+    updateConnectionList(QJsonDocument::fromJson(connections.toUtf8()).object());
+}
+
+void NetworkInterProcesser::updateConnectionList(const QJsonObject &newConnections)
+{
+    // 找出连接列表发生变化的类型，只更新这些类型的数据，连接都是按照路径查找的，只有顺序变化时无需更新
+    QStringList changedTypes;
+    QStringList types = newConnections.keys() + m_connections.keys();
+    types.removeDuplicates();
+    for (const QString &type : types) {
+        if (!m_connectionSnapshots[type].update(newConnections.value(type).toArray()).isEmpty())
+            changedTypes << type;
+        if (!newConnections.contains(type))
+            m_connectionSnapshots.remove(type);
+    }
+    if (changedTypes.isEmpty())
+        return;
+
+    m_connections = newConnections;
+    updateConnectionsInfo(m_devices, changedTypes);
 
     // 更新VPN的数据
-    if (m_vpnController && m_connections.contains("vpn"))
+    if (m_vpnController && m_connections.contains("vpn") && changedTypes.contains("vpn"))
         m_vpnController->updateVPNItems(m_connections.value("vpn").toArray());
 
     // 更新DSL的数据
-    updateDSLData();
+    if (changedTypes.contains("pppoe"))
+        updateDSLData();
 
     // 更新热点的数据
-    updateDeviceHotpot();
+    if (changedTypes.contains("wireless-hotspot"))
+        updateDeviceHotpot();
 
     // 向外抛出信号告知连接发生了变化
     Q_EMIT connectionChanged();
@@ -385,6 +466,11 @@ void NetworkInterProcesser::doChangeActiveConnections(const QString &activeConne
     if (activeConnections.isEmpty())
         return;
 
+    updateActiveConnections(QJsonDocument::fromJson(activeConnections.toUtf8()).object());
+}
+
+void NetworkInterProcesser::updateActiveConnections(const QJsonObject &activeConnections)
+{
     activeInfoChanged(activeConnections);
     // 同步IP地址等信息
     QDBusPendingCallWatcher *w = new QDBusPendingCallWatcher(m_networkInter->GetActiveConnectionInfo(), this);
@@ -452,18 +538,23 @@ void NetworkInterProcesser::doChangeAccesspoint(const QString &accessPoints)
     if (accessPoints.isEmpty())
         return;
 
-    const QJsonObject json = QJsonDocument::fromJson(accessPoints.toUtf8()).object();
+    updateAccessPoints(QJsonDocument::fromJson(accessPoints.toUtf8()).object());
+}
 
+void NetworkInterProcesser::updateAccessPoints(const QJsonObject &json)
+{
     for (NetworkDeviceBase *device : m_devices) {
         // 只有无线网卡才会有wlan连接信息
         if (device->deviceType() == DeviceType::Wireless) {
             WirelessDevice *d = static_cast<WirelessDevice *>(device);
             if (json.contains(d->path())) {
-                QJsonArray array = json.value(d->path()).toArray();
-
                 WirelessDeviceInterRealize *deviceRealize = qobject_cast<WirelessDeviceInterRealize *>(d->deviceRealize());
-                if (deviceRealize)
-                    deviceRealize->updateAccesspoint(array);
+                if (!deviceRealize)
+                    continue;
+
+                // 和上一次的数据对比，只把新增、删除和变化的热点传给设备
+                const JsonArrayDelta delta = m_accessPointSnapshots[d->path()].update(json.value(d->path()).toArray());
+                deviceRealize->updateAccesspoint(delta);
             }
         }
     }
@@ -496,7 +587,7 @@ void NetworkInterProcesser::onConnectivityChanged(uint conectivity)
     Q_EMIT connectivityChanged(m_connectivity);
 }
 
-void NetworkInterProcesser::updateConnectionsInfo(const QList<NetworkDeviceBase *> &devices)
+void NetworkInterProcesser::updateConnectionsInfo(const QList<NetworkDeviceBase *> &devices, const QStringList &types)
 {
     if (devices.isEmpty() || m_connections.isEmpty())
         return;
@@ -505,6 +596,9 @@ void NetworkInterProcesser::updateConnectionsInfo(const QList<NetworkDeviceBase
         = {{ "wired", DeviceType::Wired }, { "wireless", DeviceType::Wireless }};
 
     for (const QPair<QString, DeviceType> &connInfo : devConnInfo) {
+        if (!types.contains(connInfo.first))
+            continue;
+
         if (m_connections.contains(connInfo.first)) {
             const QJsonArray &connlist = m_connections.value(connInfo.first).toArray();
             for (NetworkDeviceBase *device : devices) {
@@ -517,10 +611,31 @@ void NetworkInterProcesser::updateConnectionsInfo(const QList<NetworkDeviceBase
     }
 }
 
-void NetworkInterProcesser::activeInfoChanged(const QString &conns)
+void NetworkInterProcesser::activeInfoChanged(const QJsonObject &activeConnections)
 {
+    // 和上一次的数据对比，活动连接没有变化时无需通知设备和各个控制器
+    QJsonArray activeArray;
+    for (auto it = activeConnections.begin(); it != activeConnections.end(); ++it) {
+        QJsonObject obj = it.value().toObject();
+        if (!obj.contains("Path"))
+            obj.insert("Path", it.key());
+        activeArray.append(obj);
+    }
+    const JsonArrayDelta delta = m_activeConnectionSnapshot.update(activeArray);
+    if (delta.isEmpty())
+        return;
+
+    // 只有活动连接发生变化的设备才需要更新
+    QSet<QString> changedDevices;
+    for (const QList<QJsonObject> &objects : { delta.added, delta.changed, delta.removed }) {
+        for (const QJsonObject &obj : objects) {
+            for (const QJsonValue &value : obj.value("Devices").toArray())
+                changedDevices << value.toString();
+        }
+    }
+
     // 当前活动连接发生变化
-    m_activeConection = QJsonDocument::fromJson(conns.toUtf8()).object();
+    m_activeConection = activeConnections;
     QMap<QString, QList<QJsonObject>> devActiveConn;
     for (const QJsonValue info : m_activeConection) {
         const QJsonObject connInfo = info.toObject();
@@ -538,6 +653,9 @@ void NetworkInterProcesser::activeInfoChanged(const QString &conns)
     // 更新设备的活动连接信息
     for (auto it = devActiveConn.begin(); it != devActiveConn.end(); it++) {
         const QString devPath = it.key();
+        if (!changedDevices.contains(devPath))
+            continue;
+
         NetworkDeviceBase *device = findDevices(devPath);
         if (!device)
             continue;
@@ -556,6 +674,127 @@ void NetworkInterProcesser::activeInfoChanged(const QString &conns)
         m_vpnController->updateActiveConnection(m_activeConection);
 }
 
+void NetworkInterProcesser::fetchObjects(NetworkInter *networkInt, const QString &kind)
+{
+    QDBusPendingReply<NetworkObjectMap> reply = networkInt->GetObjects(kind);
+    if (m_sync) {
+        reply.waitForFinished();
+        onObjectsReply(kind, reply);
+        return;
+    }
+
+    QDBusPendingCallWatcher *w = new QDBusPendingCallWatcher(reply, this);
+    connect(w, &QDBusPendingCallWatcher::finished, w, &QDBusPendingCallWatcher::deleteLater);
+    connect(w, &QDBusPendingCallWatcher::finished, this, [ this, kind ](QDBusPendingCallWatcher *w) {
+        onObjectsReply(kind, *w);
+    });
+}
+
+void NetworkInterProcesser::onObjectsReply(const QString &kind, const QDBusPendingReply<NetworkObjectMap> &reply)
+{
+    // 已经回退到JSON接口，后续的返回直接丢弃
+    if (!m_typedInterface)
+        return;
+
+    if (reply.isError()) {
+        qCWarning(DNC) << "typed network interface is unavailable, fallback to json:" << reply.error().message();
+        m_typedInterface = false;
+        m_typedObjects.clear();
+        m_typedChangedKinds.clear();
+        initNetData(m_networkInter);
+        return;
+    }
+
+    m_typedObjects[kind] = reply.value();
+    updateTypedObjects(kind);
+}
+
+void NetworkInterProcesser::onObjectsChanged(const QString &kind, const NetworkObjectMap &changed, const QStringList &removed)
+{
+    if (!m_typedInterface)
+        return;
+
+    NetworkObjectMap &objects = m_typedObjects[kind];
+    for (auto it = changed.cbegin(); it != changed.cend(); ++it)
+        objects.insert(it.key(), it.value());
+    for (const QString &path : removed)
+        objects.remove(path);
+
+    if (kind == KindAccessPoints) {
+        // 热点的增量直接交给对应的设备，不再和上一次的全量数据对比
+        QHash<QString, QList<QJsonObject>> deviceAccessPoints;
+        for (auto it = changed.cbegin(); it != changed.cend(); ++it) {
+            QJsonObject accessPoint = QJsonObject::fromVariantMap(it.value());
+            if (!accessPoint.contains("Path"))
+                accessPoint.insert("Path", it.key());
+            deviceAccessPoints[accessPoint.value("Device").toString()] << accessPoint;
+        }
+
+        for (NetworkDeviceBase *device : m_devices) {
+            if (device->deviceType() != DeviceType::Wireless)
+                continue;
+
+            WirelessDeviceInterRealize *deviceRealize = qobject_cast<WirelessDeviceInterRealize *>(static_cast<WirelessDevice *>(device)->deviceRealize());
+            if (!deviceRealize)
+                continue;
+
+            const JsonArrayDelta delta = m_accessPointSnapshots[device->path()].apply(deviceAccessPoints.value(device->path()), removed);
+            if (!delta.isEmpty())
+                deviceRealize->updateAccesspoint(delta);
+        }
+        return;
+    }
+
+    if (kind == KindDevices) {
+        updateTypedObjects(kind);
+        return;
+    }
+
+    // 连接和活动连接和JSON接口一样需要合并后按顺序处理
+    if (!m_typedChangedKinds.contains(kind))
+        m_typedChangedKinds << kind;
+    if (!m_changedTimer->isActive())
+        m_changedTimer->start();
+}
+
+void NetworkInterProcesser::updateTypedObjects(const QString &kind)
+{
+    if (kind == KindDevices)
+        updateDevices(typedObjects(kind));
+    else if (kind == KindConnections)
+        updateConnectionList(typedObjects(kind));
+    else if (kind == KindAccessPoints)
+        updateAccessPoints(typedObjects(kind));
+    else if (kind == KindActiveConnections)
+        updateActiveConnections(typedObjects(kind));
+}
+
+QJsonObject NetworkInterProcesser::typedObjects(const QString &kind) const
+{
+    const NetworkObjectMap objects = m_typedObjects.value(kind);
+    QJsonObject result;
+    // 活动连接以路径为键
+    if (kind == KindActiveConnections) {
+        for (auto it = objects.cbegin(); it != objects.cend(); ++it)
+            result.insert(it.key(), QJsonObject::fromVariantMap(it.value()));
+        return result;
+    }
+
+    // 热点按照所在的设备分组，设备和连接按照类型分组
+    const QString groupKey = (kind == KindAccessPoints) ? QStringLiteral("Device") : QStringLiteral("Type");
+    QMap<QString, QJsonArray> groups;
+    for (auto it = objects.cbegin(); it != objects.cend(); ++it) {
+        QJsonObject obj = QJsonObject::fromVariantMap(it.value());
+        if (!obj.contains("Path"))
+            obj.insert("Path", it.key());
+        groups[obj.value(groupKey).toString()].append(obj);
+    }
+    for (auto it = groups.cbegin(); it != groups.cend(); ++it)
+        result.insert(it.key(), it.value());
+
+    return result;
+}
+
 Connectivity NetworkInterProcesser::connectivity()
 {
     return m_connectivity;
@@ -7,6 +7,7 @@
 
 #include "netinterface.h"
 #include "netutils.h"
+#include "jsonsnapshot.h"
 
 #include <QJsonArray>
 
@@ -41,8 +42,9 @@ protected:
     void updateSync(const bool sync);
 
     NetworkDeviceBase *findDevices(const QString &path) const;                     // 根据设备path查找设备
-    void updateConnectionsInfo(const QList<NetworkDeviceBase *> &devices);         // 更新设备连接信息
-    void activeInfoChanged(const QString &conns);                                  // 更新活动连接信息
+    void updateConnectionsInfo(const QList<NetworkDeviceBase *> &devices,
+                               const QStringList &types = { "wired", "wireless" }); // 更新设备连接信息
+    void activeInfoChanged(const QJsonObject &activeConnections);                  // 更新活动连接信息
     void activeConnInfoChanged(const QString &conns);                              // 活动连接信息发生变化
     void updateDeviceHotpot();                                                     // 更新热点设备数据
 
@@ -57,6 +59,18 @@ protected:
 
     void doChangedData(changedFunction func, const char *infoName);
 
+    void updateDevices(const QJsonObject &data);
+    void updateConnectionList(const QJsonObject &connections);
+    void updateActiveConnections(const QJsonObject &activeConnections);
+    void updateAccessPoints(const QJsonObject &accessPoints);
+
+    // 类型化接口(a{sa{sv}})，由配置typedNetworkInterface开启，后端不支持时回退到JSON接口
+    void fetchObjects(NetworkInter *networkInt, const QString &kind);
+    void onObjectsReply(const QString &kind, const QDBusPendingReply<NetworkObjectMap> &reply);
+    void onObjectsChanged(const QString &kind, const NetworkObjectMap &changed, const QStringList &removed);
+    void updateTypedObjects(const QString &kind);
+    QJsonObject typedObjects(const QString &kind) const;                            // 转换成和JSON接口相同的结构
+
 protected:
     ProxyController *proxyController() override;                                            // 返回代理控制管理器
     VPNController *vpnController() override;                                                // 返回VPN控制器
@@ -80,12 +94,19 @@ private:
     QList<NetworkDeviceBase *> m_devices;
     NetworkInter *m_networkInter;
     QJsonObject m_connections;
+    JsonArraySnapshot m_deviceSnapshot;                                             // 所有设备的数据快照
+    QHash<QString, JsonArraySnapshot> m_connectionSnapshots;                        // 每种类型的连接数据快照
+    JsonArraySnapshot m_activeConnectionSnapshot;                                   // 活动连接的数据快照
+    QHash<QString, JsonArraySnapshot> m_accessPointSnapshots;                       // 每个无线设备的热点数据快照
     Connectivity m_connectivity;
     QJsonArray m_activeConnectionInfo;
     QJsonObject m_activeConection;
     bool m_sync;
     QTimer *m_changedTimer;
     bool m_needDetails;
+    bool m_typedInterface;
+    QHash<QString, NetworkObjectMap> m_typedObjects;
+    QStringList m_typedChangedKinds;                                                // 等待合并处理的类型化数据
 };
 
 }
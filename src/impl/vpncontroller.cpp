@@ -19,6 +19,12 @@ VPNController::~VPNController()
 {
 }
 
+int VPNController::activeConnectionWatcherCount() const
+{
+    // 不直接监听活动连接的实现返回0
+    return 0;
+}
+
 /**
  * @brief UVPNItem详细项
  */
@@ -30,6 +30,7 @@ public:
     virtual void connectItem(const QString &uuid) = 0;                                      // 连接VPN(重载函数)
     virtual void disconnectItem() = 0;                                                      // 断开当前活动VPN连接
     virtual QList<VPNItem *> items() const = 0;                                             // 获取所有的VPN列表
+    virtual int activeConnectionWatcherCount() const;                                       // 当前正在监听的VPN活动连接数量
 
 Q_SIGNALS:
     void enableChanged(const bool);                                                         // 开启关闭VPN发出的信号
@@ -6,6 +6,7 @@
 NetworkInter::NetworkInter(const QString &service, const QString &path, const QDBusConnection &connection, QObject *parent)
     : Dtk::Core::DDBusInterface(service, path, NetworkInter::staticInterfaceName(), connection, parent)
 {
+    qDBusRegisterMetaType<NetworkObjectMap>();
 }
 
 void NetworkInter::setSync(bool sync) { }
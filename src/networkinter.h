@@ -15,6 +15,9 @@
 #include <QtCore/QVariant>
 #include <QtDBus/QtDBus>
 
+// 类型化接口的数据(a{sa{sv}})，以对象路径为键，值为该对象的属性
+typedef QMap<QString, QVariantMap> NetworkObjectMap;
+
 class NetworkInter : public Dtk::Core::DDBusInterface
 {
     Q_OBJECT
@@ -226,6 +229,13 @@ public Q_SLOTS: // METHODS
         return asyncCallWithArgumentList(QStringLiteral("GetAutoProxy"), argumentList);
     }
 
+    inline QDBusPendingReply<NetworkObjectMap> GetObjects(const QString &in0)
+    {
+        QList<QVariant> argumentList;
+        argumentList << QVariant::fromValue(in0);
+        return asyncCallWithArgumentList(QStringLiteral("GetObjects"), argumentList);
+    }
+
     inline QDBusPendingReply<QString, QString> GetProxy(const QString &in0)
     {
         QList<QVariant> argumentList;
@@ -422,6 +432,7 @@ Q_SIGNALS: // SIGNALS
     void IPConflict(const QString &in0, const QString &in1);
     void NeedSecrets(const QString &in0);
     void NeedSecretsFinished(const QString &in0, const QString &in1);
+    void ObjectsChanged(const QString &in0, const NetworkObjectMap &in1, const QStringList &in2);
     // begin property changed signals
     void ActiveConnectionsChanged(const QString &value) const;
     void ConnectionsChanged(const QString &value) const;
@@ -0,0 +1,203 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "accesspointtable.h"
+
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QObject>
+
+#include <gtest/gtest.h>
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+using namespace dde::network;
+
+TEST(Tst_AccessPointTable, row_test)
+{
+    AccessPointTable table;
+    const int row = table.insert("uos-wifi");
+    EXPECT_TRUE(table.isValid(row));
+    EXPECT_EQ(table.size(), 1);
+    EXPECT_EQ(table.ssid(row), QString("uos-wifi"));
+    EXPECT_EQ(table.status(row), ConnectionStatus::Unknown);
+
+    // 数据未变化时不更新代数
+    EXPECT_TRUE(table.setStrength(row, 80));
+    const quint32 generation = table.generation(row);
+    EXPECT_FALSE(table.setStrength(row, 80));
+    EXPECT_EQ(table.generation(row), generation);
+    EXPECT_EQ(table.strength(row), 80);
+
+    // 超出范围的值被截断
+    EXPECT_TRUE(table.setStrength(row, 120));
+    EXPECT_EQ(table.strength(row), 100);
+    EXPECT_TRUE(table.setFrequency(row, 5180));
+    EXPECT_EQ(table.frequency(row), 5180);
+    EXPECT_TRUE(table.setStatus(row, ConnectionStatus::Activated));
+    EXPECT_EQ(table.status(row), ConnectionStatus::Activated);
+    EXPECT_GT(table.generation(row), generation);
+
+    EXPECT_TRUE(table.setFlag(row, AccessPointTable::Secured, true));
+    EXPECT_TRUE(table.setFlag(row, AccessPointTable::Hidden, true));
+    EXPECT_FALSE(table.setFlag(row, AccessPointTable::Secured, true));
+    EXPECT_TRUE(table.setFlag(row, AccessPointTable::Hidden, false));
+    EXPECT_TRUE(table.testFlag(row, AccessPointTable::Secured));
+    EXPECT_FALSE(table.testFlag(row, AccessPointTable::Hidden));
+    EXPECT_FALSE(table.testFlag(row, AccessPointTable::Wlan6));
+
+    // 删除后行无效，新增时复用并清空数据
+    table.remove(row);
+    EXPECT_FALSE(table.isValid(row));
+    EXPECT_EQ(table.size(), 0);
+    EXPECT_EQ(table.strength(row), 0);
+    EXPECT_FALSE(table.setStrength(row, 50));
+    const int newRow = table.insert("uos-wifi-5G");
+    EXPECT_EQ(newRow, row);
+    EXPECT_EQ(table.strength(newRow), 0);
+    EXPECT_FALSE(table.testFlag(newRow, AccessPointTable::Secured));
+    EXPECT_EQ(table.status(newRow), ConnectionStatus::Unknown);
+}
+
+TEST(Tst_AccessPointTable, intern_test)
+{
+    AccessPointTable table;
+    const int row1 = table.insert("uos-wifi");
+    const int row2 = table.insert("uos-wifi");
+    const int row3 = table.insert("deepin");
+    EXPECT_EQ(table.size(), 3);
+    EXPECT_EQ(table.ssidCount(), 2);
+    // 同名的SSID共用同一份数据
+    EXPECT_TRUE(table.ssid(row1).isSharedWith(table.ssid(row2)));
+
+    table.remove(row1);
+    EXPECT_EQ(table.ssidCount(), 2);
+    EXPECT_EQ(table.ssid(row2), QString("uos-wifi"));
+    table.remove(row2);
+    EXPECT_EQ(table.ssidCount(), 1);
+    EXPECT_EQ(table.ssid(row3), QString("deepin"));
+
+    table.clear();
+    EXPECT_EQ(table.size(), 0);
+    EXPECT_EQ(table.ssidCount(), 0);
+    EXPECT_FALSE(table.isValid(row3));
+}
+
+namespace {
+// 原实现中每个热点对象自己保存的数据，用于对比
+class InlineAccessPoint : public QObject
+{
+public:
+    explicit InlineAccessPoint(const QString &ssid)
+        : m_ssid(ssid)
+    {
+    }
+
+    QString m_ssid;
+    int m_strength = 0;
+    bool m_secured = false;
+    bool m_hidden = false;
+    bool m_isWlan6 = false;
+    int m_frequency = 0;
+    ConnectionStatus m_status = ConnectionStatus::Unknown;
+};
+
+// 现实现中热点对象只记录表和行号
+class TableAccessPoint : public QObject
+{
+public:
+    TableAccessPoint(AccessPointTable *table, const QString &ssid)
+        : m_table(table)
+        , m_row(table->insert(ssid))
+    {
+    }
+
+    ~TableAccessPoint() override { m_table->remove(m_row); }
+
+    AccessPointTable *m_table;
+    int m_row;
+};
+
+// SSID从D-Bus读取，每个BSSID都是一份单独的字符串；密集环境中每4个BSSID使用同一个SSID
+QString bssidSsid(int index)
+{
+    return QString("UOS-Office-%1-5G").arg(index / 4);
+}
+
+size_t heapInUse()
+{
+#ifdef __GLIBC__
+    return mallinfo2().uordblks;
+#else
+    return 0;
+#endif
+}
+} // namespace
+
+TEST(Tst_AccessPointTable, benchmark_test)
+{
+#ifndef __GLIBC__
+    GTEST_SKIP() << "mallinfo2 is not available";
+#endif
+    const int apCount = 500;
+    const int rounds = 50;
+
+    // 原实现：500个热点对象各自保存数据
+    size_t heap = heapInUse();
+    QElapsedTimer timer;
+    timer.start();
+    QVector<InlineAccessPoint *> inlineAps;
+    inlineAps.reserve(apCount);
+    for (int i = 0; i < apCount; i++) {
+        InlineAccessPoint *ap = new InlineAccessPoint(bssidSsid(i));
+        ap->m_strength = 30 + i % 70;
+        ap->m_secured = i % 2;
+        ap->m_frequency = (i % 3) ? 5180 : 2412;
+        inlineAps << ap;
+    }
+    for (int round = 0; round < rounds; round++) {
+        for (InlineAccessPoint *ap : inlineAps)
+            ap->m_strength = (ap->m_strength + round) % 100;
+    }
+    const qint64 inlineElapsed = timer.nsecsElapsed();
+    const size_t inlineHeap = heapInUse() - heap;
+    qDeleteAll(inlineAps);
+
+    // 现实现：热点对象只是表中一行的视图
+    heap = heapInUse();
+    timer.restart();
+    AccessPointTable *table = new AccessPointTable;
+    QVector<TableAccessPoint *> tableAps;
+    tableAps.reserve(apCount);
+    for (int i = 0; i < apCount; i++) {
+        TableAccessPoint *ap = new TableAccessPoint(table, bssidSsid(i));
+        table->setStrength(ap->m_row, 30 + i % 70);
+        table->setFlag(ap->m_row, AccessPointTable::Secured, i % 2);
+        table->setFrequency(ap->m_row, (i % 3) ? 5180 : 2412);
+        tableAps << ap;
+    }
+    for (int round = 0; round < rounds; round++) {
+        for (TableAccessPoint *ap : tableAps)
+            table->setStrength(ap->m_row, (table->strength(ap->m_row) + round) % 100);
+    }
+    const qint64 tableElapsed = timer.nsecsElapsed();
+    const size_t tableHeap = heapInUse() - heap;
+
+    EXPECT_EQ(table->size(), apCount);
+    EXPECT_EQ(table->ssidCount(), apCount / 4);
+    // 每行的数据(含字符串池，不含SSID字符)不超过64字节
+    const int bytesPerRow = table->memoryUsage() / apCount;
+    EXPECT_LT(bytesPerRow, 64);
+    // 相同的SSID只保存一份，总堆内存应少于每个对象各存一份
+    EXPECT_LT(tableHeap, inlineHeap);
+    qInfo() << apCount << "BSSIDs, heap:" << inlineHeap << "bytes inline," << tableHeap << "bytes with table (" << bytesPerRow << "bytes per row,"
+            << table->ssidCount() << "interned ssids ), update:" << inlineElapsed / 1000 << "us inline," << tableElapsed / 1000 << "us with table";
+
+    qDeleteAll(tableAps);
+    EXPECT_EQ(table->size(), 0);
+    EXPECT_EQ(table->ssidCount(), 0);
+    delete table;
+}
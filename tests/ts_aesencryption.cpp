@@ -0,0 +1,243 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "aes.h"
+
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+
+#include <gtest/gtest.h>
+
+using namespace network::service;
+
+namespace {
+
+struct LegacyVector
+{
+    AESEncryption::Aes level;
+    AESEncryption::Mode mode;
+    AESEncryption::Padding padding;
+    const char *cipher;
+};
+
+// 原来逐字节实现的输出，明文 "The quick brown fox jumps over the lazy dog"
+// 密钥取 "0123456789abcdef0123456789abcdef" 的前16/24/32字节，初始向量 "fedcba9876543210"
+const LegacyVector legacyVectors[] = {
+    { AESEncryption::AES_128, AESEncryption::ECB, AESEncryption::ZERO, "08eaec72a2775e8a412e92731f4a4a2e4d8b9161a0f6411f4f7d0970100abbb0384185a397d0aa45e9d068ed55dc95d9" },
+    { AESEncryption::AES_128, AESEncryption::ECB, AESEncryption::PKCS7, "08eaec72a2775e8a412e92731f4a4a2e4d8b9161a0f6411f4f7d0970100abbb0fba1ae2433a9674ca3f58a8f2efdfba9" },
+    { AESEncryption::AES_128, AESEncryption::ECB, AESEncryption::ISO, "08eaec72a2775e8a412e92731f4a4a2e4d8b9161a0f6411f4f7d0970100abbb024790d5834c6dc81125a5c88855e182c" },
+    { AESEncryption::AES_128, AESEncryption::CBC, AESEncryption::ZERO, "edba03fe193e35946bf5215234d3f84759e7bf360a4b89e541f541c6e84fbb9cd5d32a7f1d23dbbac4f251796e936f30" },
+    { AESEncryption::AES_128, AESEncryption::CBC, AESEncryption::PKCS7, "edba03fe193e35946bf5215234d3f84759e7bf360a4b89e541f541c6e84fbb9c24d652004bf731d822d7530bd3844457" },
+    { AESEncryption::AES_128, AESEncryption::CBC, AESEncryption::ISO, "edba03fe193e35946bf5215234d3f84759e7bf360a4b89e541f541c6e84fbb9ced4d63b56b4a0605b6d1c6538a33bf42" },
+    { AESEncryption::AES_128, AESEncryption::CFB, AESEncryption::ZERO, "5f23b3518705166ad318a1a4a56b041d2aaa9447f74780316398a5500d19f155a2edd0b19d201d1fcd85f60ae86e11a9" },
+    { AESEncryption::AES_128, AESEncryption::CFB, AESEncryption::PKCS7, "5f23b3518705166ad318a1a4a56b041d2aaa9447f74780316398a5500d19f155a2edd0b19d201d1fcd85f60fed6b14ac" },
+    { AESEncryption::AES_128, AESEncryption::CFB, AESEncryption::ISO, "5f23b3518705166ad318a1a4a56b041d2aaa9447f74780316398a5500d19f155a2edd0b19d201d1fcd85f68ae86e11a9" },
+    { AESEncryption::AES_128, AESEncryption::OFB, AESEncryption::ZERO, "5f23b3518705166ad318a1a4a56b041d2eeb5863150f4994d1b9dd107bdade97732e079da77daf5625776b60cef58b0b" },
+    { AESEncryption::AES_128, AESEncryption::OFB, AESEncryption::PKCS7, "5f23b3518705166ad318a1a4a56b041d2eeb5863150f4994d1b9dd107bdade97732e079da77daf5625776b65cbf08e0e" },
+    { AESEncryption::AES_128, AESEncryption::OFB, AESEncryption::ISO, "5f23b3518705166ad318a1a4a56b041d2eeb5863150f4994d1b9dd107bdade97732e079da77daf5625776be0cef58b0b" },
+    { AESEncryption::AES_192, AESEncryption::ECB, AESEncryption::ZERO, "61234dc4b0adee86bf2420f2b1cb4f8b1e004e682ac8f56dfc049a0d8e7d12ef9095835cb9175c8568e0b161d6689c06" },
+    { AESEncryption::AES_192, AESEncryption::ECB, AESEncryption::PKCS7, "61234dc4b0adee86bf2420f2b1cb4f8b1e004e682ac8f56dfc049a0d8e7d12ef9a2c667b1388ad31f99164de884e5b5e" },
+    { AESEncryption::AES_192, AESEncryption::ECB, AESEncryption::ISO, "61234dc4b0adee86bf2420f2b1cb4f8b1e004e682ac8f56dfc049a0d8e7d12ef5ec0ac481f3695be18ce7f44e5604272" },
+    { AESEncryption::AES_192, AESEncryption::CBC, AESEncryption::ZERO, "662bd972e985da8d4bf531a741278f1893a0be50d408a8ce98a0690babb1036e52d4146bd6f0d4a1270180d6effeb87e" },
+    { AESEncryption::AES_192, AESEncryption::CBC, AESEncryption::PKCS7, "662bd972e985da8d4bf531a741278f1893a0be50d408a8ce98a0690babb1036ef3ca0d675458bdb956f3770fc7ff6899" },
+    { AESEncryption::AES_192, AESEncryption::CBC, AESEncryption::ISO, "662bd972e985da8d4bf531a741278f1893a0be50d408a8ce98a0690babb1036ec5c42bb162ad8ff8f57a050126521b8f" },
+    { AESEncryption::AES_192, AESEncryption::CFB, AESEncryption::ZERO, "ae2f2a46b86e84cf2e4f2a930b824ef4655d7b1e7c8200f1de137878546f9abe1fe424f5f6f763b5aa72bc78e80c3141" },
+    { AESEncryption::AES_192, AESEncryption::CFB, AESEncryption::PKCS7, "ae2f2a46b86e84cf2e4f2a930b824ef4655d7b1e7c8200f1de137878546f9abe1fe424f5f6f763b5aa72bc7ded093444" },
+    { AESEncryption::AES_192, AESEncryption::CFB, AESEncryption::ISO, "ae2f2a46b86e84cf2e4f2a930b824ef4655d7b1e7c8200f1de137878546f9abe1fe424f5f6f763b5aa72bcf8e80c3141" },
+    { AESEncryption::AES_192, AESEncryption::OFB, AESEncryption::ZERO, "ae2f2a46b86e84cf2e4f2a930b824ef4386f4f7257fc6e367d966385c6c0ba375ed92ed312c264de2f32938baffa6b58" },
+    { AESEncryption::AES_192, AESEncryption::OFB, AESEncryption::PKCS7, "ae2f2a46b86e84cf2e4f2a930b824ef4386f4f7257fc6e367d966385c6c0ba375ed92ed312c264de2f32938eaaff6e5d" },
+    { AESEncryption::AES_192, AESEncryption::OFB, AESEncryption::ISO, "ae2f2a46b86e84cf2e4f2a930b824ef4386f4f7257fc6e367d966385c6c0ba375ed92ed312c264de2f32930baffa6b58" },
+    { AESEncryption::AES_256, AESEncryption::ECB, AESEncryption::ZERO, "08bd9995d03ceec879e26eff0ddac112256774e22a664cc669fe5e808dedad8c7818c0c70b1b26f8d712948065ed0610" },
+    { AESEncryption::AES_256, AESEncryption::ECB, AESEncryption::PKCS7, "08bd9995d03ceec879e26eff0ddac112256774e22a664cc669fe5e808dedad8c042339760c0fffb4499d535956bfe93d" },
+    { AESEncryption::AES_256, AESEncryption::ECB, AESEncryption::ISO, "08bd9995d03ceec879e26eff0ddac112256774e22a664cc669fe5e808dedad8c6a690383db529d1537f88f8f1a42aeb5" },
+    { AESEncryption::AES_256, AESEncryption::CBC, AESEncryption::ZERO, "2028de88b57ff823637c43afd28afddbc2a1f868fe634fa4e666bc05d9d86f5f71801afd6708e6e8a5e69982f2d6c99b" },
+    { AESEncryption::AES_256, AESEncryption::CBC, AESEncryption::PKCS7, "2028de88b57ff823637c43afd28afddbc2a1f868fe634fa4e666bc05d9d86f5f154f03e01784b6925d88a7bc60944c1f" },
+    { AESEncryption::AES_256, AESEncryption::CBC, AESEncryption::ISO, "2028de88b57ff823637c43afd28afddbc2a1f868fe634fa4e666bc05d9d86f5f80df751fd167ec160cbb4e2aa9086f9a" },
+    { AESEncryption::AES_256, AESEncryption::CFB, AESEncryption::ZERO, "8a301e7fbd8527d7190484e855f7d93c9c1ed5cce221b17e673cfd9556f8720ef001374d95addba847c14b22c5fcdc7c" },
+    { AESEncryption::AES_256, AESEncryption::CFB, AESEncryption::PKCS7, "8a301e7fbd8527d7190484e855f7d93c9c1ed5cce221b17e673cfd9556f8720ef001374d95addba847c14b27c0f9d979" },
+    { AESEncryption::AES_256, AESEncryption::CFB, AESEncryption::ISO, "8a301e7fbd8527d7190484e855f7d93c9c1ed5cce221b17e673cfd9556f8720ef001374d95addba847c14ba2c5fcdc7c" },
+    { AESEncryption::AES_256, AESEncryption::OFB, AESEncryption::ZERO, "8a301e7fbd8527d7190484e855f7d93cbda1d9a9d43aacf452fc625aa4f299f13cf8fa820664805ca972d836004a7e44" },
+    { AESEncryption::AES_256, AESEncryption::OFB, AESEncryption::PKCS7, "8a301e7fbd8527d7190484e855f7d93cbda1d9a9d43aacf452fc625aa4f299f13cf8fa820664805ca972d833054f7b41" },
+    { AESEncryption::AES_256, AESEncryption::OFB, AESEncryption::ISO, "8a301e7fbd8527d7190484e855f7d93cbda1d9a9d43aacf452fc625aa4f299f13cf8fa820664805ca972d8b6004a7e44" },
+};
+
+int keyLength(AESEncryption::Aes level)
+{
+    return level == AESEncryption::AES_256 ? 32 : (level == AESEncryption::AES_192 ? 24 : 16);
+}
+
+QByteArray randomBytes(QRandomGenerator &random, int size)
+{
+    QByteArray data(size, Qt::Uninitialized);
+    for (int i = 0; i < size; i++)
+        data[i] = char(random.bounded(256));
+    return data;
+}
+
+// 查表和AES-NI两种实现都要测试，不支持AES-NI时只测试查表
+QList<bool> accelerations()
+{
+    AESEncryption::setHardwareAccelerationEnabled(true);
+    if (AESEncryption::hardwareAccelerated())
+        return { false, true };
+    return { false };
+}
+
+}
+
+TEST(Tst_AESEncryption, fips197_test)
+{
+    // FIPS-197 附录C的示例
+    const QByteArray plain = QByteArray::fromHex("00112233445566778899aabbccddeeff");
+    const QByteArray key = QByteArray::fromHex("000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f");
+    const struct {
+        AESEncryption::Aes level;
+        QByteArray cipher;
+    } vectors[] = {
+        { AESEncryption::AES_128, QByteArray::fromHex("69c4e0d86a7b0430d8cdb78070b4c55a") },
+        { AESEncryption::AES_192, QByteArray::fromHex("dda97ca4864cdfe06eaf70a0ec0d7191") },
+        { AESEncryption::AES_256, QByteArray::fromHex("8ea2b7ca516745bfeafc49904b496089") },
+    };
+
+    for (bool accelerated : accelerations()) {
+        AESEncryption::setHardwareAccelerationEnabled(accelerated);
+        for (const auto &vector : vectors) {
+            AESEncryption aes(vector.level, AESEncryption::ECB, AESEncryption::ZERO);
+            const QByteArray levelKey = key.left(keyLength(vector.level));
+            EXPECT_EQ(aes.encode(plain, levelKey), vector.cipher) << accelerated << vector.level;
+            EXPECT_EQ(aes.decode(vector.cipher, levelKey), plain) << accelerated << vector.level;
+        }
+    }
+    AESEncryption::setHardwareAccelerationEnabled(true);
+
+    // 扩展后的密钥，FIPS-197 附录A.1 最后一轮的轮密钥
+    const QByteArray expanded = AESEncryption::ExpandKey(AESEncryption::AES_128, AESEncryption::ECB,
+                                                         QByteArray::fromHex("2b7e151628aed2a6abf7158809cf4f3c"), true);
+    EXPECT_EQ(expanded.size(), 176);
+    EXPECT_EQ(expanded.right(16), QByteArray::fromHex("d014f9a8c9ee2589e13f0cc8b6630ca6"));
+}
+
+TEST(Tst_AESEncryption, legacy_output_test)
+{
+    const QByteArray plain = "The quick brown fox jumps over the lazy dog";
+    const QByteArray key = "0123456789abcdef0123456789abcdef";
+    const QByteArray iv = "fedcba9876543210";
+
+    for (bool accelerated : accelerations()) {
+        AESEncryption::setHardwareAccelerationEnabled(accelerated);
+        for (const LegacyVector &vector : legacyVectors) {
+            const QByteArray levelKey = key.left(keyLength(vector.level));
+            const QByteArray cipher = AESEncryption::Crypt(vector.level, vector.mode, plain, levelKey, iv, vector.padding);
+            EXPECT_EQ(cipher.toHex(), QByteArray(vector.cipher)) << accelerated << vector.level << vector.mode << vector.padding;
+            const QByteArray decoded = AESEncryption::Decrypt(vector.level, vector.mode, cipher, levelKey, iv, vector.padding);
+            EXPECT_EQ(AESEncryption::RemovePadding(decoded, vector.padding), plain);
+        }
+    }
+    AESEncryption::setHardwareAccelerationEnabled(true);
+}
+
+TEST(Tst_AESEncryption, password_test)
+{
+    // 账户网络保存的密码，和原来的实现以及 openssl enc -aes-128-ecb 的结果一致
+    const QString encrypted = PasswordHelper::aesEncryption("P@ssw0rd", "uniontechnetwork", "ICBCCreditSuisse");
+    EXPECT_EQ(encrypted, QString("bZIt5LItAdIHmWgeIo7VBQ=="));
+    EXPECT_EQ(PasswordHelper::aesDecryption(encrypted, "uniontechnetwork", "ICBCCreditSuisse"), QString("P@ssw0rd"));
+
+    // 密钥或者初始向量长度不对
+    AESEncryption aes(AESEncryption::AES_128, AESEncryption::CBC, AESEncryption::PKCS7);
+    EXPECT_TRUE(aes.encode("data", "short", "fedcba9876543210").isEmpty());
+    EXPECT_TRUE(aes.encode("data", "0123456789abcdef").isEmpty());
+    EXPECT_TRUE(aes.decode("0123456789abcdef", "0123456789abcdef", "iv").isEmpty());
+}
+
+TEST(Tst_AESEncryption, stream_test)
+{
+    QRandomGenerator random(20260301);
+    const QList<bool> modes = accelerations();
+    for (int round = 0; round < 200; round++) {
+        const AESEncryption::Aes level = AESEncryption::Aes(random.bounded(3));
+        const AESEncryption::Mode mode = AESEncryption::Mode(random.bounded(4));
+        const AESEncryption::Padding padding = AESEncryption::Padding(random.bounded(3));
+        const QByteArray key = randomBytes(random, keyLength(level));
+        const QByteArray iv = randomBytes(random, AESStream::BlockSize);
+        const QByteArray plain = randomBytes(random, random.bounded(300));
+
+        QByteArray expected;
+        for (bool accelerated : modes) {
+            AESEncryption::setHardwareAccelerationEnabled(accelerated);
+            AESEncryption aes(level, mode, padding);
+            const QByteArray cipher = aes.encode(plain, key, iv);
+            if (expected.isNull())
+                expected = cipher;
+            EXPECT_EQ(cipher, expected) << "accelerated:" << accelerated;
+
+            // 随机分块送入，结果和一次处理相同
+            AESStream encryptor(level, mode, padding, AESStream::Encrypt);
+            ASSERT_TRUE(encryptor.init(key, iv));
+            QByteArray streamed;
+            for (int pos = 0; pos < plain.size();) {
+                const int length = qMin<int>(random.bounded(40), plain.size() - pos);
+                streamed += encryptor.update(plain.mid(pos, length));
+                pos += length;
+            }
+            streamed += encryptor.final();
+            EXPECT_EQ(streamed, cipher);
+
+            const QByteArray decoded = aes.decode(cipher, key, iv);
+            EXPECT_EQ(decoded.left(plain.size()), plain);
+            AESStream decryptor(level, mode, padding, AESStream::Decrypt);
+            ASSERT_TRUE(decryptor.init(key, iv));
+            streamed.clear();
+            for (int pos = 0; pos < cipher.size();) {
+                const int length = qMin<int>(random.bounded(40), cipher.size() - pos);
+                streamed += decryptor.update(cipher.mid(pos, length));
+                pos += length;
+            }
+            streamed += decryptor.final();
+            EXPECT_EQ(streamed, decoded);
+
+            // 整块数据原地解密
+            QByteArray inPlace = cipher;
+            ASSERT_TRUE(decryptor.init(key, iv));
+            int length = decryptor.update(inPlace.constData(), inPlace.size(), inPlace.data());
+            length += decryptor.final(inPlace.data() + length);
+            inPlace.resize(length);
+            EXPECT_EQ(inPlace, decoded);
+        }
+    }
+    AESEncryption::setHardwareAccelerationEnabled(true);
+}
+
+TEST(Tst_AESEncryption, benchmark_test)
+{
+    const QByteArray key = "uniontechnetwork";
+    const QString password = PasswordHelper::aesEncryption("P@ssw0rd1234", "uniontechnetwork", "ICBCCreditSuisse");
+    const QByteArray data(1 << 20, 'x');
+    const QByteArray iv = "ICBCCreditSuisse";
+
+    for (bool accelerated : accelerations()) {
+        AESEncryption::setHardwareAccelerationEnabled(accelerated);
+        const int count = 10000;
+        QElapsedTimer timer;
+        timer.start();
+        for (int i = 0; i < count; i++)
+            PasswordHelper::aesDecryption(password, "uniontechnetwork", "ICBCCreditSuisse");
+        const qint64 passwordElapsed = timer.nsecsElapsed();
+
+        AESEncryption aes(AESEncryption::AES_128, AESEncryption::CBC, AESEncryption::PKCS7);
+        timer.restart();
+        const QByteArray cipher = aes.encode(data, key, iv);
+        const qint64 encodeElapsed = timer.nsecsElapsed();
+        timer.restart();
+        const QByteArray decoded = aes.decode(cipher, key, iv);
+        const qint64 decodeElapsed = timer.nsecsElapsed();
+        EXPECT_EQ(AESEncryption::RemovePadding(decoded, AESEncryption::PKCS7), data);
+
+        qInfo() << (accelerated ? "AES-NI" : "table") << "password decryption:" << passwordElapsed / count << "ns,"
+                << "1MiB CBC encode:" << (data.size() * 1000.0 / qMax<qint64>(encodeElapsed, 1)) << "MB/s,"
+                << "decode:" << (data.size() * 1000.0 / qMax<qint64>(decodeElapsed, 1)) << "MB/s";
+    }
+    AESEncryption::setHardwareAccelerationEnabled(true);
+}
@@ -0,0 +1,118 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "jsonsnapshot.h"
+
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QJsonDocument>
+
+#include <gtest/gtest.h>
+
+using namespace dde::network;
+
+static QJsonObject accessPoint(int index, int strength)
+{
+    QJsonObject obj;
+    obj.insert("Path", QString("/org/freedesktop/NetworkManager/AccessPoint/%1").arg(index));
+    obj.insert("Ssid", QString("uos-wifi-%1").arg(index / 2));
+    obj.insert("Strength", strength);
+    obj.insert("Secured", true);
+    obj.insert("SecuredInEap", false);
+    obj.insert("Frequency", 5180);
+    obj.insert("Flags", 1);
+    return obj;
+}
+
+// 按照 WirelessAccessPoints 属性的格式生成一个设备的热点数据
+static QString accessPointsPayload(const QString &devicePath, int count, int changedIndex = -1)
+{
+    QJsonArray array;
+    for (int i = 0; i < count; i++)
+        array.append(accessPoint(i, (i == changedIndex) ? 10 : 50 + i % 50));
+
+    QJsonObject payload;
+    payload.insert(devicePath, array);
+    return QString::fromUtf8(QJsonDocument(payload).toJson(QJsonDocument::Compact));
+}
+
+TEST(Tst_JsonSnapshot, delta_test)
+{
+    JsonArraySnapshot snapshot;
+    QJsonArray array { accessPoint(0, 50), accessPoint(1, 60), accessPoint(2, 70) };
+    JsonArrayDelta delta = snapshot.update(array);
+    EXPECT_EQ(delta.added.size(), 3);
+    EXPECT_TRUE(delta.changed.isEmpty());
+    EXPECT_TRUE(delta.removed.isEmpty());
+    EXPECT_EQ(snapshot.size(), 3);
+
+    // 相同的数据不产生差异
+    EXPECT_TRUE(snapshot.update(array).isEmpty());
+
+    // 修改一个，删除一个，新增一个
+    QJsonArray newArray { accessPoint(0, 55), accessPoint(1, 60), accessPoint(3, 40) };
+    delta = snapshot.update(newArray);
+    ASSERT_EQ(delta.added.size(), 1);
+    ASSERT_EQ(delta.changed.size(), 1);
+    ASSERT_EQ(delta.removed.size(), 1);
+    EXPECT_EQ(delta.added.first().value("Path").toString(), accessPoint(3, 0).value("Path").toString());
+    EXPECT_EQ(delta.changed.first().value("Strength").toInt(), 55);
+    EXPECT_EQ(delta.removed.first().value("Path").toString(), accessPoint(2, 0).value("Path").toString());
+    EXPECT_TRUE(snapshot.contains(accessPoint(3, 0).value("Path").toString()));
+    EXPECT_FALSE(snapshot.contains(accessPoint(2, 0).value("Path").toString()));
+
+    // 清空数据
+    delta = snapshot.update(QJsonArray());
+    EXPECT_EQ(delta.removed.size(), 3);
+    EXPECT_EQ(snapshot.size(), 0);
+}
+
+TEST(Tst_JsonSnapshot, apply_test)
+{
+    JsonArraySnapshot snapshot;
+    snapshot.update(QJsonArray { accessPoint(0, 50), accessPoint(1, 60) });
+
+    // 未变化的数据不产生差异，不存在的路径视为新增
+    JsonArrayDelta delta = snapshot.apply({ accessPoint(0, 50), accessPoint(1, 65), accessPoint(2, 70) }, {});
+    ASSERT_EQ(delta.added.size(), 1);
+    ASSERT_EQ(delta.changed.size(), 1);
+    EXPECT_TRUE(delta.removed.isEmpty());
+    EXPECT_EQ(delta.changed.first().value("Strength").toInt(), 65);
+    EXPECT_EQ(snapshot.size(), 3);
+
+    // 删除时返回旧值，未知的路径直接忽略
+    const QString path = accessPoint(1, 0).value("Path").toString();
+    delta = snapshot.apply({}, { path, "/org/freedesktop/NetworkManager/AccessPoint/100" });
+    ASSERT_EQ(delta.removed.size(), 1);
+    EXPECT_EQ(delta.removed.first().value("Strength").toInt(), 65);
+    EXPECT_FALSE(snapshot.contains(path));
+    EXPECT_EQ(snapshot.size(), 2);
+}
+
+TEST(Tst_JsonSnapshot, benchmark_test)
+{
+    const QString devicePath = "/org/freedesktop/NetworkManager/Devices/3";
+    const int apCount = 300;
+    const int rounds = 50;
+    const QString fullPayload = accessPointsPayload(devicePath, apCount);
+    const QString changedPayload = accessPointsPayload(devicePath, apCount, apCount / 2);
+
+    JsonArraySnapshot snapshot;
+    snapshot.update(QJsonDocument::fromJson(fullPayload.toUtf8()).object().value(devicePath).toArray());
+
+    // 每一轮只有一个热点的信号强度变化，增量结果里只应该有这一项
+    QElapsedTimer timer;
+    timer.start();
+    int changedCount = 0;
+    for (int i = 0; i < rounds; i++) {
+        const QString &payload = (i % 2 == 0) ? changedPayload : fullPayload;
+        const QJsonArray array = QJsonDocument::fromJson(payload.toUtf8()).object().value(devicePath).toArray();
+        const JsonArrayDelta delta = snapshot.update(array);
+        EXPECT_TRUE(delta.added.isEmpty());
+        EXPECT_TRUE(delta.removed.isEmpty());
+        changedCount += delta.changed.size();
+    }
+    EXPECT_EQ(changedCount, rounds);
+    qInfo() << "diff" << rounds << "payloads of" << apCount << "access points in" << timer.elapsed() << "ms";
+}
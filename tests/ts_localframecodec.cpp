@@ -0,0 +1,199 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "localframecodec.h"
+
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QLocalSocket>
+#include <QRandomGenerator>
+#include <QTimer>
+
+#include <gtest/gtest.h>
+
+#include <sys/socket.h>
+
+using namespace dde::network;
+
+static QByteArray randomBytes(QRandomGenerator &random, int size)
+{
+    QByteArray data(size, Qt::Uninitialized);
+    for (int i = 0; i < size; i++)
+        data[i] = char(random.bounded(256));
+    return data;
+}
+
+TEST(Tst_LocalFrameCodec, frame_test)
+{
+    LocalFrameCodec codec;
+    const QByteArray payload = "{\"callId\":\"1\",\"secrets\":[\"psk\"]}";
+    const QByteArray frame = LocalFrameCodec::encode("requestSecrets", payload);
+    EXPECT_EQ(frame.size(), LocalFrameCodec::HeaderSize + 14 + payload.size());
+    // 帧的第一个字节为0，可以和JSON区分
+    EXPECT_EQ(frame.at(0), 0);
+
+    QByteArray name;
+    QByteArray data;
+    // 不完整的帧不返回
+    codec.feed(frame.constData(), 3);
+    EXPECT_FALSE(codec.nextFrame(&name, &data));
+    codec.feed(frame.constData() + 3, frame.size() - 4);
+    EXPECT_FALSE(codec.nextFrame(&name, &data));
+    codec.feed(frame.constData() + frame.size() - 1, 1);
+    ASSERT_TRUE(codec.nextFrame(&name, &data));
+    EXPECT_EQ(name, QByteArray("requestSecrets"));
+    EXPECT_EQ(data, payload);
+    EXPECT_FALSE(codec.nextFrame(&name, &data));
+    EXPECT_EQ(codec.bufferedSize(), 0);
+    EXPECT_EQ(codec.error(), LocalFrameCodec::NoError);
+
+    // 空数据
+    const QByteArray emptyFrame = LocalFrameCodec::encode("receive", QByteArray());
+    codec.feed(emptyFrame.constData(), emptyFrame.size());
+    ASSERT_TRUE(codec.nextFrame(&name, &data));
+    EXPECT_EQ(name, QByteArray("receive"));
+    EXPECT_TRUE(data.isEmpty());
+
+    // 超长的帧
+    const char tooLarge[] = { 0x7F, 0, 0, 0, 1 };
+    codec.feed(tooLarge, sizeof(tooLarge));
+    EXPECT_FALSE(codec.nextFrame(&name, &data));
+    EXPECT_EQ(codec.error(), LocalFrameCodec::FrameTooLarge);
+    codec.clear();
+    EXPECT_EQ(codec.error(), LocalFrameCodec::NoError);
+
+    // 名称长度超出帧长度
+    const char invalid[] = { 0, 0, 0, 2, 9, 'a' };
+    codec.feed(invalid, sizeof(invalid));
+    EXPECT_FALSE(codec.nextFrame(&name, &data));
+    EXPECT_EQ(codec.error(), LocalFrameCodec::InvalidFrame);
+}
+
+TEST(Tst_LocalFrameCodec, ring_buffer_test)
+{
+    FrameRingBuffer buffer(64);
+    QByteArray scratch;
+    buffer.append("0123456789", 10);
+    buffer.consume(6);
+    // 写入跨越末尾
+    const QByteArray data(60, 'x');
+    buffer.append(data.constData(), data.size());
+    EXPECT_EQ(buffer.capacity(), 64);
+    EXPECT_EQ(buffer.size(), 64);
+    EXPECT_EQ(buffer.peek(0, 4, &scratch), QByteArray("6789"));
+    EXPECT_TRUE(scratch.isEmpty());
+    EXPECT_EQ(buffer.peek(2, 62, &scratch), QByteArray("89") + data);
+    EXPECT_EQ(scratch.size(), 62);
+
+    // 扩容后数据保持顺序
+    buffer.append("yz", 2);
+    EXPECT_EQ(buffer.capacity(), 128);
+    EXPECT_EQ(buffer.peek(0, 66, &scratch), QByteArray("6789") + data + "yz");
+    buffer.consume(66);
+    EXPECT_EQ(buffer.size(), 0);
+}
+
+TEST(Tst_LocalFrameCodec, fuzz_test)
+{
+    QRandomGenerator random(20260101);
+    for (int round = 0; round < 50; round++) {
+        // 随机的帧按随机的长度分块送入
+        QList<QPair<QByteArray, QByteArray>> frames;
+        QByteArray stream;
+        const int frameCount = 1 + random.bounded(40);
+        for (int i = 0; i < frameCount; i++) {
+            const QByteArray name = QByteArray("frame") + QByteArray::number(random.bounded(1000));
+            const QByteArray payload = randomBytes(random, random.bounded(random.bounded(2) ? 64 : 9000));
+            frames.append({ name, payload });
+            stream += LocalFrameCodec::encode(name, payload);
+        }
+        LocalFrameCodec codec;
+        QByteArray name;
+        QByteArray payload;
+        int received = 0;
+        for (int pos = 0; pos < stream.size();) {
+            const int length = qMin<int>(1 + random.bounded(3000), stream.size() - pos);
+            codec.feed(stream.constData() + pos, length);
+            pos += length;
+            while (codec.nextFrame(&name, &payload)) {
+                ASSERT_LT(received, frames.size());
+                EXPECT_EQ(name, frames.at(received).first);
+                EXPECT_EQ(payload, frames.at(received).second);
+                received++;
+            }
+            ASSERT_EQ(codec.error(), LocalFrameCodec::NoError);
+        }
+        EXPECT_EQ(received, frames.size());
+        EXPECT_EQ(codec.bufferedSize(), 0);
+
+        // 随机数据不能导致崩溃，要么解析出帧，要么等待更多数据，要么报错
+        LocalFrameCodec garbageCodec;
+        const QByteArray garbage = randomBytes(random, random.bounded(4096));
+        garbageCodec.feed(garbage.constData(), garbage.size());
+        int count = 0;
+        while (garbageCodec.nextFrame(&name, &payload))
+            count++;
+        EXPECT_LE(count * LocalFrameCodec::HeaderSize, garbage.size());
+    }
+}
+
+TEST(Tst_LocalFrameCodec, socketpair_test)
+{
+    int fds[2];
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+    QLocalSocket writer;
+    QLocalSocket reader;
+    ASSERT_TRUE(writer.setSocketDescriptor(fds[0]));
+    ASSERT_TRUE(reader.setSocketDescriptor(fds[1]));
+
+    const int frameCount = 2000;
+    const QByteArray payload(1024, 'p');
+    int received = 0;
+    qint64 receivedBytes = 0;
+    LocalFrameCodec codec;
+    LocalFrameDispatcher dispatcher;
+    QEventLoop loop;
+    dispatcher.registerHandler("secretsResult", [&](QIODevice *, const QByteArray &data) {
+        receivedBytes += data.size();
+        if (++received == frameCount)
+            loop.quit();
+    });
+    bool valid = true;
+    QObject::connect(&reader, &QLocalSocket::readyRead, &reader, [&] {
+        valid = valid && dispatcher.process(&reader, &codec);
+    });
+    QTimer::singleShot(10000, &loop, &QEventLoop::quit);
+
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < frameCount; i++)
+        writer.write(LocalFrameCodec::encode("secretsResult", payload));
+    loop.exec();
+    const qint64 elapsed = timer.nsecsElapsed();
+
+    EXPECT_TRUE(valid);
+    EXPECT_EQ(received, frameCount);
+    EXPECT_EQ(receivedBytes, qint64(frameCount) * payload.size());
+
+    // 对比：原来按行拼接再拆分的方式，每次收到数据都拷贝整个缓冲区
+    const QByteArray line = "\nsecretsResult:" + payload + "\n";
+    QByteArray lastData;
+    int lineCount = 0;
+    timer.restart();
+    for (int i = 0; i < frameCount; i++) {
+        QByteArray allData = lastData + line;
+        QList<QByteArray> dataArray = allData.split('\n');
+        lastData = dataArray.last();
+        for (const QByteArray &data : dataArray) {
+            if (data.indexOf(':') != -1)
+                lineCount++;
+        }
+    }
+    const qint64 lineElapsed = timer.nsecsElapsed();
+    EXPECT_EQ(lineCount, frameCount);
+
+    qInfo() << frameCount << "frames over socketpair:" << elapsed / 1000 << "us," << (receivedBytes * 1000.0 / qMax<qint64>(elapsed, 1)) << "MB/s"
+            << ", line split decode only:" << lineElapsed / 1000 << "us";
+}
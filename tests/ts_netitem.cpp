@@ -0,0 +1,145 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "netitem.h"
+#include "private/netitemprivate.h"
+
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+
+#include <gtest/gtest.h>
+
+using namespace dde::network;
+
+static NetItemPrivate *newItem(const QString &id)
+{
+    return NetItemPrivate::New(NetType::NetItemType::Item, id);
+}
+
+// 缓存的位置必须和子项在列表中的实际位置一致
+static bool checkRows(NetItemPrivate *parent)
+{
+    const QVector<NetItem *> &children = parent->getChildren();
+    for (int i = 0; i < children.size(); i++) {
+        if (children.at(i)->getIndex() != i || parent->getChildIndex(children.at(i)) != i)
+            return false;
+    }
+    return true;
+}
+
+TEST(Tst_NetItem, row_test)
+{
+    NetItemPrivate *parent = newItem("parent");
+    NetItemPrivate *other = newItem("other");
+    for (int i = 0; i < 10; i++)
+        parent->addChild(newItem(QString("item-%1").arg(i)));
+    EXPECT_TRUE(checkRows(parent));
+
+    // 插入到开头、中间
+    NetItemPrivate *first = newItem("first");
+    EXPECT_TRUE(parent->addChild(first, 0));
+    EXPECT_EQ(first->getIndex(), 0);
+    NetItemPrivate *middle = newItem("middle");
+    EXPECT_TRUE(parent->addChild(middle, 5));
+    EXPECT_EQ(middle->getIndex(), 5);
+    EXPECT_EQ(parent->getChildrenNumber(), 12);
+    EXPECT_TRUE(checkRows(parent));
+
+    // 重复添加失败
+    EXPECT_FALSE(parent->addChild(middle));
+    EXPECT_EQ(parent->getChildrenNumber(), 12);
+
+    // 删除开头、中间、末尾
+    EXPECT_TRUE(parent->removeChild(first));
+    EXPECT_EQ(first->getIndex(), -1);
+    EXPECT_EQ(parent->getChildIndex(first->item()), -1);
+    EXPECT_FALSE(parent->removeChild(first));
+    delete first;
+    EXPECT_TRUE(checkRows(parent));
+    EXPECT_TRUE(parent->removeChild(middle));
+    delete middle;
+    EXPECT_TRUE(checkRows(parent));
+    NetItemPrivate *last = NetItemPrivate::toItem<NetItemPrivate>(parent->getChildren().last());
+    EXPECT_TRUE(parent->removeChild(last));
+    delete last;
+    EXPECT_EQ(parent->getChildrenNumber(), 9);
+    EXPECT_TRUE(checkRows(parent));
+
+    // 移动到其他父项后两边的位置都要正确
+    NetItemPrivate *moved = NetItemPrivate::toItem<NetItemPrivate>(parent->getChild(3));
+    other->addChild(newItem("other-item"));
+    EXPECT_TRUE(parent->moveChild(moved, other));
+    EXPECT_EQ(parent->getChildIndex(moved->item()), -1);
+    EXPECT_EQ(moved->getIndex(), 1);
+    EXPECT_EQ(moved->getParent(), other->item());
+    EXPECT_TRUE(checkRows(parent));
+    EXPECT_TRUE(checkRows(other));
+
+    delete parent;
+    delete other;
+}
+
+TEST(Tst_NetItem, random_test)
+{
+    // 随机插入删除，每次操作后校验全部位置
+    QRandomGenerator random(2026);
+    NetItemPrivate *parent = newItem("parent");
+    int id = 0;
+    for (int i = 0; i < 2000; i++) {
+        const int count = parent->getChildrenNumber();
+        if (count == 0 || random.bounded(3) != 0) {
+            parent->addChild(newItem(QString("item-%1").arg(id++)), random.bounded(count + 1));
+        } else {
+            NetItemPrivate *child = NetItemPrivate::toItem<NetItemPrivate>(parent->getChild(random.bounded(count)));
+            parent->removeChild(child);
+            delete child;
+        }
+        // 只查询部分子项，让未刷新的位置跨越多次修改
+        if (i % 7 == 0) {
+            ASSERT_TRUE(checkRows(parent)) << "operation" << i;
+        } else if (parent->getChildrenNumber() > 0) {
+            NetItem *child = parent->getChild(random.bounded(parent->getChildrenNumber()));
+            ASSERT_EQ(child->getIndex(), parent->getChildren().indexOf(child)) << "operation" << i;
+        }
+    }
+    EXPECT_TRUE(checkRows(parent));
+    delete parent;
+}
+
+TEST(Tst_NetItem, benchmark_test)
+{
+    for (int count : { 50, 500, 5000 }) {
+        NetItemPrivate *parent = newItem("parent");
+        for (int i = 0; i < count; i++)
+            parent->addChild(newItem(QString("item-%1").arg(i)));
+        const QVector<NetItem *> children = parent->getChildren();
+
+        // 在开头插入一项，所有位置都需要重新计算
+        NetItemPrivate *first = newItem("first");
+        parent->addChild(first, 0);
+
+        QElapsedTimer timer;
+        timer.start();
+        qint64 rowSum = 0;
+        for (NetItem *child : children)
+            rowSum += child->getIndex();
+        const qint64 indexElapsed = timer.nsecsElapsed();
+
+        // 对比：在子项列表中线性查找
+        timer.restart();
+        qint64 searchSum = 0;
+        for (NetItem *child : children)
+            searchSum += parent->getChildren().indexOf(child);
+        const qint64 searchElapsed = timer.nsecsElapsed();
+
+        EXPECT_EQ(rowSum, searchSum);
+        EXPECT_EQ(rowSum, qint64(count) * (count + 1) / 2);
+        // 子项较多时线性查找是平方复杂度，缓存位置后只需要一次重新计算
+        if (count == 5000)
+            EXPECT_LT(indexElapsed, searchElapsed);
+        qInfo() << count << "children, getIndex:" << indexElapsed / count << "ns per lookup, indexOf:" << searchElapsed / count << "ns per lookup";
+        delete parent;
+    }
+}
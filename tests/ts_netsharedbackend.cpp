@@ -0,0 +1,519 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include <QCoreApplication>
+#include <QDBusConnection>
+#include <QDBusContext>
+#include <QDBusMessage>
+#include <QDBusMetaType>
+#include <QDBusPendingCallWatcher>
+#include <QDataStream>
+#include <QEventLoop>
+#include <QFile>
+#include <QHash>
+#include <QMap>
+#include <QObject>
+#include <QProcess>
+#include <QSet>
+#include <QTimer>
+#include <QVariantMap>
+#include <QVector>
+
+#include <NetworkManagerQt/Connection>
+#include <NetworkManagerQt/Device>
+#include <NetworkManagerQt/GenericTypes>
+#include <NetworkManagerQt/WirelessSecuritySetting>
+
+#include <gtest/gtest.h>
+
+#define private public
+#define protected public
+#include "configsetting.h"
+#include "netmanager.h"
+#include "private/netitemprivate.h"
+#include "private/netmanager_p.h"
+#include "private/netmanagerthreadprivate.h"
+#include "private/netsharedbackend.h"
+#undef private
+#undef protected
+
+#include <cstdio>
+
+using namespace dde::network;
+
+namespace {
+const QString TestService = "org.deepin.dde.NetworkBackend1.Test";
+const QString WiredDevice = "/test/wired0";
+const QString VPNConnection = "/test/vpn1";
+
+// 记录订阅进程收到的数据
+class ClientRecorder
+{
+public:
+    explicit ClientRecorder(NetSharedBackendClient *client)
+    {
+        QObject::connect(client, &NetSharedBackendClient::itemAdded, client, [this](const QString &parentID, NetItemPrivate *item) {
+            added.append(item->id());
+            parents.insert(item->id(), parentID);
+            names.insert(item->id(), item->name());
+            delete item;
+        });
+        QObject::connect(client, &NetSharedBackendClient::itemRemoved, client, [this](const QString &id) {
+            removed.append(id);
+        });
+        QObject::connect(client, &NetSharedBackendClient::dataChanged, client, [this](int dataType, const QString &id, const QVariant &value) {
+            changed.append({ dataType, id });
+            values.append(value);
+        });
+        QObject::connect(client, &NetSharedBackendClient::detached, client, [this] {
+            detached = true;
+        });
+    }
+
+    QStringList added;
+    QHash<QString, QString> parents;
+    QHash<QString, QString> names;
+    QStringList removed;
+    QList<QPair<int, QString>> changed;
+    QVariantList values;
+    bool detached = false;
+};
+
+QByteArray frame(quint64 seq, const QByteArray &records = QByteArray())
+{
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream << quint32(SHARED_BACKEND_VERSION) << seq;
+    data.append(records);
+    return data;
+}
+
+QByteArray itemAddedRecord(const QString &parentID, NetItemPrivate *item)
+{
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream << quint8(NetSharedBackend::ItemAddedRecord) << parentID << qint32(item->itemType()) << item->id() << NetSharedBackend::itemProperties(item);
+    return data;
+}
+
+QByteArray dataChangedRecord(int dataType, const QString &id, const QVariant &value)
+{
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream << quint8(NetSharedBackend::DataChangedRecord) << qint32(dataType) << id;
+    NetSharedBackend::writeVariant(stream, value);
+    return data;
+}
+
+// 模拟Attach的返回，快照通过已完成的调用交给订阅进程
+void attachFinished(NetSharedBackendClient *client, const QByteArray &snapshot)
+{
+    QDBusMessage call = QDBusMessage::createMethodCall(TestService, "/org/deepin/dde/NetworkBackend1", "org.deepin.dde.NetworkBackend1", "Attach");
+    QDBusPendingCall reply = QDBusPendingCall::fromCompletedCall(call.createReply(QVariant(snapshot)));
+    client->onAttachFinished(new QDBusPendingCallWatcher(reply, client));
+}
+
+NetItemPrivate *wiredDeviceItem(const QString &name)
+{
+    NetWiredDeviceItemPrivate *item = NetItemNew(WiredDeviceItem, WiredDevice);
+    item->updatename(name);
+    item->updateips({ "10.0.0.2" });
+    item->updatestatus(NetType::NetDeviceStatus::DS_Connected);
+    return item;
+}
+
+NetItemPrivate *vpnConnectionItem(const QString &id)
+{
+    NetConnectionItemPrivate *item = NetItemNew(ConnectionItem, id);
+    item->updatename("vpn");
+    item->updatestatus(NetType::NetConnectionStatus::CS_Connected);
+    return item;
+}
+
+// /proc/self/status中的VmRSS，单位KB
+qint64 residentKB()
+{
+    QFile file("/proc/self/status");
+    if (!file.open(QIODevice::ReadOnly))
+        return -1;
+    const QList<QByteArray> lines = file.readAll().split('\n');
+    for (const QByteArray &line : lines) {
+        if (line.startsWith("VmRSS:"))
+            return line.mid(6).trimmed().split(' ').value(0).toLongLong();
+    }
+    return -1;
+}
+
+// 总线为本连接登记的匹配规则数，总线未开启统计接口时返回-1
+int matchRules(const QDBusConnection &bus)
+{
+    QDBusMessage message = QDBusMessage::createMethodCall("org.freedesktop.DBus", "/org/freedesktop/DBus", "org.freedesktop.DBus.Debug.Stats", "GetConnectionStats");
+    message << bus.baseService();
+    const QDBusMessage reply = bus.call(message, QDBus::Block, 1000);
+    if (reply.type() != QDBusMessage::ReplyMessage || reply.arguments().isEmpty())
+        return -1;
+    return qdbus_cast<QVariantMap>(reply.arguments().first()).value("MatchRules", -1).toInt();
+}
+} // namespace
+
+class Tst_NetSharedBackend : public testing::Test
+{
+public:
+    void SetUp() override
+    {
+        manager = new NetManager(NetType::NetManagerFlags(NetType::Net_VPN | NetType::Net_VPNChildren));
+        d = manager->d_ptrNetManager.data();
+        server = new NetSharedBackendServer(d);
+        d->m_sharedServer = server;
+    }
+
+    void TearDown() override
+    {
+        delete manager;
+        manager = nullptr;
+    }
+
+    // 维护数据的进程中的数据：有线设备(无需标记)、VPN及其连接(需要VPN标记)、全局数据
+    void addItems()
+    {
+        d->onItemAdded("NetWiredControlItem", wiredDeviceItem("eth0"));
+        d->onItemAdded("Root", NetItemNew(VPNControlItem, "NetVPNControlItem"));
+        d->onItemAdded("NetVPNControlItem", vpnConnectionItem(VPNConnection));
+        server->dataChanged(NetManagerThreadPrivate::primaryConnectionTypeChanged, QString(), 1);
+        server->dataChanged(NetManagerThreadPrivate::AirplaneModeEnabledChanged, "Root", true);
+    }
+
+public:
+    NetManager *manager = nullptr;
+    NetManagerPrivate *d = nullptr;
+    NetSharedBackendServer *server = nullptr;
+};
+
+TEST(Tst_NetSharedBackendRecord, itemlist_test)
+{
+    NetSharedBackend::ItemList items;
+    items.add("Root", QString());
+    items.add("NetVPNControlItem", "Root", NetType::Net_VPN);
+    items.add(VPNConnection, "NetVPNControlItem", NetType::Net_VPN | NetType::Net_VPNChildren);
+    items.add(WiredDevice, "NetWiredControlItem");
+    EXPECT_EQ(items.items(), QStringList({ "Root", "NetVPNControlItem", VPNConnection, WiredDevice }));
+    EXPECT_EQ(items.topLevelItems(), QStringList({ "Root", WiredDevice }));
+    EXPECT_EQ(items.flags(VPNConnection), NetType::NetManagerFlags(NetType::Net_VPN | NetType::Net_VPNChildren));
+    EXPECT_EQ(items.flags(WiredDevice).toInt(), 0);
+
+    // 重复添加时移到末尾并更新标记
+    items.add(WiredDevice, "NetWiredControlItem", NetType::Net_Details);
+    EXPECT_EQ(items.items().last(), WiredDevice);
+    EXPECT_EQ(items.flags(WiredDevice), NetType::NetManagerFlags(NetType::Net_Details));
+
+    // 移除父项时同时移除子项
+    items.remove("Root");
+    EXPECT_EQ(items.items(), QStringList({ WiredDevice }));
+    EXPECT_TRUE(items.parentID(VPNConnection).isEmpty());
+    EXPECT_EQ(items.flags(VPNConnection).toInt(), 0);
+    items.clear();
+    EXPECT_TRUE(items.items().isEmpty());
+}
+
+TEST(Tst_NetSharedBackendRecord, record_test)
+{
+    EXPECT_EQ(NetSharedBackend::itemFlags(NetType::NetItemType::WiredDeviceItem, "NetWiredControlItem"), NetType::NetManagerFlags());
+    EXPECT_EQ(NetSharedBackend::itemFlags(NetType::NetItemType::ConnectionItem, "NetVPNControlItem"), NetType::NetManagerFlags(NetType::Net_VPN | NetType::Net_VPNChildren));
+    EXPECT_EQ(NetSharedBackend::itemFlags(NetType::NetItemType::ConnectionItem, "NetDSLControlItem"), NetType::NetManagerFlags(NetType::Net_DSL));
+
+    // 属性编码后还原的数据项与原数据项一致
+    NetItemPrivate *item = wiredDeviceItem("eth0");
+    QByteArray data;
+    {
+        QDataStream stream(&data, QIODevice::WriteOnly);
+        stream << NetSharedBackend::itemProperties(item);
+    }
+    QVariantMap properties;
+    QDataStream stream(data);
+    stream >> properties;
+    ASSERT_EQ(stream.status(), QDataStream::Ok);
+    NetItemPrivate *copy = NetSharedBackend::newItem(item->itemType(), item->id(), properties);
+    ASSERT_TRUE(copy);
+    NetWiredDeviceItemPrivate *device = NetItemPrivate::toItem<NetWiredDeviceItemPrivate>(copy);
+    ASSERT_TRUE(device);
+    EXPECT_EQ(device->id(), WiredDevice);
+    EXPECT_EQ(device->name(), QString("eth0"));
+    EXPECT_EQ(device->ips(), QStringList({ "10.0.0.2" }));
+    EXPECT_EQ(device->status(), NetType::NetDeviceStatus::DS_Connected);
+    delete copy;
+    delete item;
+
+    // 枚举按整数传输
+    data.clear();
+    {
+        QDataStream stream(&data, QIODevice::WriteOnly);
+        NetSharedBackend::writeVariant(stream, QVariant::fromValue(NetType::NetDeviceStatus::DS_Connected));
+    }
+    QVariant value;
+    QDataStream enumStream(data);
+    enumStream >> value;
+    EXPECT_EQ(value.metaType(), QMetaType::fromType<int>());
+    EXPECT_EQ(value.value<NetType::NetDeviceStatus>(), NetType::NetDeviceStatus::DS_Connected);
+}
+
+TEST(Tst_NetSharedBackendRecord, client_apply_test)
+{
+    NetSharedBackendClient client(TestService);
+    ClientRecorder recorder(&client);
+    NetItemPrivate *device = wiredDeviceItem("eth0");
+    NetItemPrivate *vpn = vpnConnectionItem(VPNConnection);
+
+    // 快照返回前收到的增量，在快照之后按序号处理
+    client.onChanged(frame(4, dataChangedRecord(NetManagerThreadPrivate::NameChanged, WiredDevice, "eth1")));
+    client.onChanged(frame(3, itemAddedRecord("NetVPNControlItem", vpn)));
+    EXPECT_TRUE(recorder.added.isEmpty());
+    attachFinished(&client, frame(3, itemAddedRecord("NetWiredControlItem", device)));
+    EXPECT_EQ(client.statistics().snapshots, 1u);
+    EXPECT_EQ(recorder.added, QStringList({ WiredDevice }));
+    EXPECT_EQ(recorder.names.value(WiredDevice), QString("eth0"));
+    EXPECT_EQ(recorder.parents.value(WiredDevice), QString("NetWiredControlItem"));
+    ASSERT_EQ(recorder.changed.size(), 1);
+    EXPECT_EQ(recorder.changed.first().second, WiredDevice);
+    EXPECT_EQ(recorder.values.first().toString(), QString("eth1"));
+    EXPECT_EQ(client.m_seq, 4u);
+
+    // 已处理的序号忽略
+    client.onChanged(frame(4, dataChangedRecord(NetManagerThreadPrivate::NameChanged, WiredDevice, "eth2")));
+    EXPECT_EQ(recorder.changed.size(), 1);
+
+    // 同一帧中的多条记录
+    QByteArray records = itemAddedRecord("NetVPNControlItem", vpn);
+    QDataStream stream(&records, QIODevice::Append);
+    stream << quint8(NetSharedBackend::ItemRemovedRecord) << WiredDevice;
+    client.onChanged(frame(5, records));
+    EXPECT_EQ(recorder.added, QStringList({ WiredDevice, VPNConnection }));
+    EXPECT_EQ(recorder.removed, QStringList({ WiredDevice }));
+    EXPECT_EQ(client.m_items.items(), QStringList({ VPNConnection }));
+    EXPECT_EQ(client.statistics().frames, 2u);
+    EXPECT_EQ(client.statistics().resyncs, 0u);
+    delete vpn;
+    delete device;
+}
+
+TEST(Tst_NetSharedBackendRecord, resync_test)
+{
+    NetSharedBackendClient client(TestService);
+    ClientRecorder recorder(&client);
+    NetItemPrivate *device = wiredDeviceItem("eth0");
+    attachFinished(&client, frame(1, itemAddedRecord("NetWiredControlItem", device)));
+    ASSERT_TRUE(client.m_attached);
+
+    // 序号不连续时丢弃增量，重新获取快照
+    client.onChanged(frame(3, dataChangedRecord(NetManagerThreadPrivate::NameChanged, WiredDevice, "eth1")));
+    EXPECT_EQ(client.statistics().resyncs, 1u);
+    EXPECT_FALSE(client.m_attached);
+    EXPECT_TRUE(recorder.changed.isEmpty());
+
+    // 新快照替换之前的数据
+    client.onChanged(frame(4, dataChangedRecord(NetManagerThreadPrivate::NameChanged, WiredDevice, "eth2")));
+    attachFinished(&client, frame(3, itemAddedRecord("NetWiredControlItem", device)));
+    EXPECT_TRUE(client.m_attached);
+    EXPECT_EQ(client.statistics().snapshots, 2u);
+    EXPECT_EQ(recorder.removed, QStringList({ WiredDevice }));
+    EXPECT_EQ(recorder.added, QStringList({ WiredDevice, WiredDevice }));
+    ASSERT_EQ(recorder.values.size(), 1);
+    EXPECT_EQ(recorder.values.first().toString(), QString("eth2"));
+    EXPECT_EQ(client.m_seq, 4u);
+
+    // 协议版本不同时改为本进程维护数据
+    QByteArray incompatible;
+    QDataStream stream(&incompatible, QIODevice::WriteOnly);
+    stream << quint32(SHARED_BACKEND_VERSION + 1) << quint64(1);
+    attachFinished(&client, incompatible);
+    EXPECT_TRUE(recorder.detached);
+    EXPECT_EQ(recorder.removed, QStringList({ WiredDevice, WiredDevice }));
+    delete device;
+}
+
+TEST_F(Tst_NetSharedBackend, attach_test)
+{
+    addItems();
+    EXPECT_EQ(server->m_items.items(), QStringList({ WiredDevice, "NetVPNControlItem", VPNConnection }));
+
+    // 快照只包含订阅进程标记需要的数据项
+    NetSharedBackendClient vpnClient(TestService);
+    ClientRecorder vpnRecorder(&vpnClient);
+    attachFinished(&vpnClient, server->attachClient(":test.vpn", NetType::NetManagerFlags(NetType::Net_VPN | NetType::Net_VPNChildren | NetType::Net_Airplane)));
+    EXPECT_EQ(vpnRecorder.added, QStringList({ WiredDevice, "NetVPNControlItem", VPNConnection }));
+    EXPECT_EQ(vpnRecorder.parents.value(VPNConnection), QString("NetVPNControlItem"));
+    EXPECT_EQ(vpnRecorder.changed.size(), 2);
+
+    NetSharedBackendClient deviceClient(TestService);
+    ClientRecorder deviceRecorder(&deviceClient);
+    attachFinished(&deviceClient, server->attachClient(":test.device", NetType::NetManagerFlags(NetType::Net_Device)));
+    EXPECT_EQ(deviceRecorder.added, QStringList({ WiredDevice }));
+    ASSERT_EQ(deviceRecorder.changed.size(), 1);
+    EXPECT_TRUE(deviceRecorder.changed.first().second.isEmpty());
+
+    EXPECT_EQ(server->m_clients.size(), 2);
+    EXPECT_EQ(server->statistics().snapshots, 2u);
+    EXPECT_EQ(vpnClient.m_seq, 0u);
+}
+
+TEST_F(Tst_NetSharedBackend, flush_test)
+{
+    addItems();
+    const NetType::NetManagerFlags vpnFlags(NetType::Net_VPN | NetType::Net_VPNChildren);
+    server->attachClient(":test.vpn", vpnFlags);
+    server->attachClient(":test.device", NetType::NetManagerFlags(NetType::Net_Device));
+    server->attachClient(":test.device2", NetType::NetManagerFlags(NetType::Net_Device));
+
+    // 增量按订阅进程的标记过滤
+    d->onItemAdded("NetVPNControlItem", vpnConnectionItem("/test/vpn2"));
+    server->dataChanged(NetManagerThreadPrivate::NameChanged, WiredDevice, "eth1");
+    server->dataChanged(NetManagerThreadPrivate::NameChanged, VPNConnection, "vpn1");
+    int vpnCount = 0;
+    const QByteArray vpnRecords = server->pendingRecords(vpnFlags, vpnCount);
+    int deviceCount = 0;
+    const QByteArray deviceRecords = server->pendingRecords(NetType::NetManagerFlags(NetType::Net_Device), deviceCount);
+    EXPECT_EQ(vpnCount, 3);
+    EXPECT_EQ(deviceCount, 1);
+
+    NetSharedBackendClient vpnClient(TestService);
+    ClientRecorder vpnRecorder(&vpnClient);
+    attachFinished(&vpnClient, frame(0));
+    vpnClient.onChanged(frame(1, vpnRecords));
+    EXPECT_EQ(vpnRecorder.added, QStringList({ "/test/vpn2" }));
+    EXPECT_EQ(vpnRecorder.changed.size(), 2);
+
+    NetSharedBackendClient deviceClient(TestService);
+    ClientRecorder deviceRecorder(&deviceClient);
+    attachFinished(&deviceClient, frame(0));
+    deviceClient.onChanged(frame(1, deviceRecords));
+    EXPECT_TRUE(deviceRecorder.added.isEmpty());
+    ASSERT_EQ(deviceRecorder.changed.size(), 1);
+    EXPECT_EQ(deviceRecorder.changed.first().second, WiredDevice);
+
+    // 每个订阅进程一帧，序号各自计数
+    server->flush();
+    EXPECT_EQ(server->statistics().frames, 3u);
+    EXPECT_EQ(server->statistics().records, 5u);
+    EXPECT_EQ(server->m_clients.value(":test.vpn").seq, 1u);
+    EXPECT_EQ(server->m_clients.value(":test.device").seq, 1u);
+    EXPECT_TRUE(server->m_pendingRecords.isEmpty());
+
+    // 没有可发送记录的订阅进程不占用序号
+    server->dataChanged(NetManagerThreadPrivate::NameChanged, VPNConnection, "vpn");
+    server->flush();
+    EXPECT_EQ(server->m_clients.value(":test.vpn").seq, 2u);
+    EXPECT_EQ(server->m_clients.value(":test.device").seq, 1u);
+
+    // 退出的订阅进程不再接收增量
+    server->removeClient(":test.vpn");
+    EXPECT_EQ(server->m_clients.size(), 2);
+    server->dataChanged(NetManagerThreadPrivate::NameChanged, VPNConnection, "vpn1");
+    server->flush();
+    EXPECT_EQ(server->statistics().frames, 4u);
+}
+
+TEST_F(Tst_NetSharedBackend, failover_test)
+{
+    // 模拟订阅模式：本进程的数据来自维护数据的进程
+    d->m_sharedServer = nullptr;
+    delete server;
+    server = nullptr;
+    NetSharedBackendClient *client = new NetSharedBackendClient(TestService, d);
+    d->m_sharedClient = client;
+    QObject::connect(client, &NetSharedBackendClient::itemAdded, d, &NetManagerPrivate::onItemAdded);
+    QObject::connect(client, &NetSharedBackendClient::itemRemoved, d, &NetManagerPrivate::onItemRemoved);
+    QObject::connect(client, &NetSharedBackendClient::detached, d, &NetManagerPrivate::onSharedBackendDetached, Qt::QueuedConnection);
+    d->m_managerThread->setSharedClient(client);
+    NetItemPrivate *device = wiredDeviceItem("eth0");
+    attachFinished(client, frame(1, itemAddedRecord("NetWiredControlItem", device)));
+    delete device;
+    EXPECT_TRUE(d->findItem(WiredDevice));
+    EXPECT_EQ(d->m_managerThread->m_sharedClient, client);
+
+    // 维护数据的进程退出后清除其数据，改为本进程维护数据
+    client->onServiceUnregistered();
+    EXPECT_FALSE(d->findItem(WiredDevice));
+    QCoreApplication::sendPostedEvents(d);
+    EXPECT_EQ(d->m_sharedClient, nullptr);
+    EXPECT_EQ(d->m_managerThread->m_sharedClient, nullptr);
+    // 会话总线可用且服务未被占用时，本进程改为提供服务
+    if (d->m_sharedServer)
+        EXPECT_EQ(d->m_sharedServer->m_service, NetSharedBackend::serviceName());
+}
+
+// 由memory_benchmark_test启动的子进程，模拟一个网络插件
+TEST(Tst_NetSharedBackendBenchmark, memory_child)
+{
+    const QByteArray mode = qgetenv("NET_SHARED_BACKEND_CHILD");
+    if (mode.isEmpty())
+        GTEST_SKIP() << "started by memory_benchmark_test";
+
+    ConfigSetting::instance()->m_sharedNetManagerBackend = (mode == "on");
+    NetManager *manager = new NetManager(NetType::NetManagerFlags::fromInt(qEnvironmentVariableIntValue("NET_SHARED_BACKEND_FLAGS")));
+    QEventLoop loop;
+    QTimer::singleShot(qEnvironmentVariableIntValue("NET_SHARED_BACKEND_WAIT"), &loop, &QEventLoop::quit);
+    loop.exec();
+    printf("NetSharedBackend rss:%lld session:%d system:%d\n", residentKB(), matchRules(QDBusConnection::sessionBus()), matchRules(QDBusConnection::systemBus()));
+    fflush(stdout);
+    delete manager;
+}
+
+// 同一会话中三个插件进程，分别统计共享后端关闭和开启时的内存及总线匹配规则
+TEST(Tst_NetSharedBackendBenchmark, memory_benchmark_test)
+{
+    if (qEnvironmentVariableIsEmpty("DDE_NETWORK_BENCHMARK"))
+        GTEST_SKIP() << "set DDE_NETWORK_BENCHMARK=1 to run, the children register the shared backend on the session bus";
+    if (!QDBusConnection::sessionBus().isConnected())
+        GTEST_SKIP() << "no session bus";
+
+    const QList<int> pluginFlags = {
+        int(NetType::Net_DockFlags & ~NetType::Net_UseSecretAgent),
+        int(NetType::Net_LockFlags & ~NetType::Net_UseSecretAgent),
+        int(NetType::Net_DccFlags),
+    };
+    for (const QString &mode : { QString("off"), QString("on") }) {
+        QList<QProcess *> processes;
+        for (int i = 0; i < pluginFlags.size(); ++i) {
+            QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
+            env.insert("NET_SHARED_BACKEND_CHILD", mode);
+            env.insert("NET_SHARED_BACKEND_FLAGS", QString::number(pluginFlags.at(i)));
+            // 第一个进程提供服务，需比其他进程晚退出
+            env.insert("NET_SHARED_BACKEND_WAIT", QString::number(i == 0 ? 6000 : 4000));
+            QProcess *process = new QProcess;
+            process->setProcessEnvironment(env);
+            process->start(QCoreApplication::applicationFilePath(), { "--gtest_filter=Tst_NetSharedBackendBenchmark.memory_child" });
+            EXPECT_TRUE(process->waitForStarted());
+            processes << process;
+            if (i == 0) {
+                QEventLoop loop;
+                QTimer::singleShot(1000, &loop, &QEventLoop::quit);
+                loop.exec();
+            }
+        }
+        qint64 rss = 0;
+        int sessionRules = 0;
+        int systemRules = 0;
+        for (QProcess *process : processes) {
+            EXPECT_TRUE(process->waitForFinished(30000));
+            const QList<QByteArray> lines = process->readAllStandardOutput().split('\n');
+            for (const QByteArray &line : lines) {
+                if (!line.startsWith("NetSharedBackend "))
+                    continue;
+                for (const QByteArray &field : line.mid(17).split(' ')) {
+                    const QList<QByteArray> pair = field.split(':');
+                    if (pair.value(0) == "rss")
+                        rss += pair.value(1).toLongLong();
+                    else if (pair.value(0) == "session")
+                        sessionRules += pair.value(1).toInt();
+                    else if (pair.value(0) == "system")
+                        systemRules += pair.value(1).toInt();
+                }
+            }
+        }
+        qDeleteAll(processes);
+        EXPECT_GT(rss, 0);
+        // 匹配规则为负数表示总线未开启统计接口
+        qInfo() << "shared network backend" << mode << ", processes:" << pluginFlags.size() << ", rss:" << rss << "KB, session bus match rules:" << sessionRules
+                << ", system bus match rules:" << systemRules;
+    }
+}
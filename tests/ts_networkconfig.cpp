@@ -0,0 +1,174 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include <QDir>
+#include <QEventLoop>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+#include <QTimer>
+#include <QVariantMap>
+
+#include <gtest/gtest.h>
+
+#define private public
+#include "networkconfig.h"
+#undef private
+
+using namespace accountnetwork::systemservice;
+
+static void waitFor(int msec)
+{
+    QEventLoop loop;
+    QTimer::singleShot(msec, &loop, &QEventLoop::quit);
+    loop.exec();
+}
+
+// 等待已经提交到写入线程的任务全部完成，不触发新的写入
+static void waitWriter(NetworkConfig *config)
+{
+    QMetaObject::invokeMethod(config->m_writer, [] {}, Qt::BlockingQueuedConnection);
+}
+
+static QJsonObject readConfig(const QString &fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QFile::ReadOnly))
+        return QJsonObject();
+
+    return QJsonDocument::fromJson(file.readAll()).object();
+}
+
+class Tst_NetworkConfig : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ASSERT_TRUE(m_dir.isValid());
+        m_fileName = m_dir.filePath("accountnetwork");
+    }
+
+    QTemporaryDir m_dir;
+    QString m_fileName;
+};
+
+TEST_F(Tst_NetworkConfig, atomic_write_test)
+{
+    NetworkConfigWriter writer(m_fileName);
+    QJsonObject config;
+    config.insert("user1", QJsonObject { { "wlan0", "uuid-1" } });
+    ASSERT_TRUE(writer.write(config));
+
+    // 写入完成后只留下目标文件，临时文件已经被重命名
+    EXPECT_EQ(QDir(m_dir.path()).entryList(QDir::Files), QStringList { "accountnetwork" });
+    EXPECT_FALSE(QFile::exists(m_fileName + ".tmp"));
+    EXPECT_EQ(readConfig(m_fileName), config);
+
+    // 覆盖已有文件时同样不会留下临时文件
+    config.insert("user2", QJsonObject { { "eth0", "uuid-2" } });
+    ASSERT_TRUE(writer.write(config));
+    EXPECT_FALSE(QFile::exists(m_fileName + ".tmp"));
+    EXPECT_EQ(readConfig(m_fileName), config);
+}
+
+TEST_F(Tst_NetworkConfig, coalesce_save_test)
+{
+    NetworkConfig config(m_fileName);
+    config.saveNetwork("user1", "uuid-1", "wlan0");
+    ASSERT_TRUE(config.m_saveTimer->isActive());
+    waitFor(config.m_saveTimer->interval() / 2);
+    const int remaining = config.m_saveTimer->remainingTime();
+
+    // 等待期间的修改不会重新计时，也不会立即写入
+    config.saveNetwork("user1", "uuid-2", "eth0");
+    config.saveNetwork("user2", "uuid-3", "wlan0");
+    EXPECT_TRUE(config.m_saveTimer->isActive());
+    EXPECT_LE(config.m_saveTimer->remainingTime(), remaining);
+    waitWriter(&config);
+    EXPECT_FALSE(QFile::exists(m_fileName));
+
+    // 定时器到期后所有修改合并为一次写入
+    waitFor(config.m_saveTimer->interval());
+    EXPECT_FALSE(config.m_saveTimer->isActive());
+    waitWriter(&config);
+    const QJsonObject json = readConfig(m_fileName);
+    EXPECT_EQ(json.value("user1").toObject(), (QJsonObject { { "wlan0", "uuid-1" }, { "eth0", "uuid-2" } }));
+    EXPECT_EQ(json.value("user2").toObject(), (QJsonObject { { "wlan0", "uuid-3" } }));
+    EXPECT_FALSE(QFile::exists(m_fileName + ".tmp"));
+}
+
+TEST_F(Tst_NetworkConfig, remove_immediately_test)
+{
+    NetworkConfig config(m_fileName);
+    config.saveNetwork("user1", "uuid-1", "wlan0");
+    config.saveNetwork("user1", "uuid-2", "eth0");
+    config.saveNetwork("user2", "uuid-3", "wlan0");
+    config.flush();
+    ASSERT_TRUE(readConfig(m_fileName).contains("user2"));
+
+    // 删除网络不经过延迟合并，直接提交写入
+    config.removeNetwork("user1", "uuid-1", "wlan0");
+    EXPECT_FALSE(config.m_saveTimer->isActive());
+    waitWriter(&config);
+    EXPECT_EQ(readConfig(m_fileName).value("user1").toObject(), (QJsonObject { { "eth0", "uuid-2" } }));
+
+    // 删除账户同样立即写入
+    config.removeNetwork("user2");
+    EXPECT_FALSE(config.m_saveTimer->isActive());
+    waitWriter(&config);
+    EXPECT_FALSE(readConfig(m_fileName).contains("user2"));
+    EXPECT_TRUE(config.network("user2").isEmpty());
+}
+
+TEST_F(Tst_NetworkConfig, flush_test)
+{
+    {
+        NetworkConfig config(m_fileName);
+        config.saveNetwork("user1", "uuid-1", "wlan0");
+        ASSERT_TRUE(config.m_saveTimer->isActive());
+        config.flush();
+        // flush 返回时等待中的修改已经写入文件
+        EXPECT_FALSE(config.m_saveTimer->isActive());
+        EXPECT_EQ(readConfig(m_fileName).value("user1").toObject(), (QJsonObject { { "wlan0", "uuid-1" } }));
+
+        // 析构时同样写入还在等待的修改
+        config.saveNetwork("user1", "uuid-2", "eth0");
+    }
+    EXPECT_EQ(readConfig(m_fileName).value("user1").toObject(), (QJsonObject { { "wlan0", "uuid-1" }, { "eth0", "uuid-2" } }));
+    EXPECT_FALSE(QFile::exists(m_fileName + ".tmp"));
+}
+
+TEST_F(Tst_NetworkConfig, lazy_load_test)
+{
+    QJsonObject content;
+    content.insert("user1", QJsonObject { { "wlan0", "uuid-1" } });
+    content.insert("user2", QJsonObject { { "eth0", "uuid-2" }, { "wlan1", "uuid-3" } });
+    {
+        NetworkConfigWriter writer(m_fileName);
+        ASSERT_TRUE(writer.write(content));
+    }
+
+    NetworkConfig config(m_fileName);
+    // 构造时不读取文件
+    EXPECT_FALSE(config.m_loaded);
+    EXPECT_TRUE(config.m_accountNetwork.isEmpty());
+
+    // 访问一个账户时只解析该账户
+    QMap<QString, QString> network = config.network("user1");
+    EXPECT_TRUE(config.m_loaded);
+    EXPECT_EQ(network.value("wlan0"), "uuid-1");
+    EXPECT_EQ(config.m_accountNetwork.keys(), QStringList { "user1" });
+    EXPECT_TRUE(config.network("user3").isEmpty());
+    EXPECT_FALSE(config.m_accountNetwork.contains("user3"));
+
+    // 修改已解析的账户后写回，未解析的账户原样保留
+    config.saveNetwork("user1", "uuid-4", "eth0");
+    config.flush();
+    EXPECT_FALSE(config.m_accountNetwork.contains("user2"));
+
+    NetworkConfig reloaded(m_fileName);
+    EXPECT_EQ(reloaded.network("user1"), (QMap<QString, QString> { { "wlan0", "uuid-1" }, { "eth0", "uuid-4" } }));
+    EXPECT_EQ(reloaded.network("user2"), (QMap<QString, QString> { { "eth0", "uuid-2" }, { "wlan1", "uuid-3" } }));
+}
@@ -8,11 +8,33 @@
 #include "vpncontroller.h"
 
 #include <QDebug>
+#include <QEventLoop>
+#include <QTimer>
+
+#include <functional>
 
 #include <gtest/gtest.h>
 
 using namespace dde::network;
 
+// 在事件循环中等待条件成立，超时返回false
+static bool waitFor(const std::function<bool()> &condition, int timeout = 30000)
+{
+    if (condition())
+        return true;
+
+    QEventLoop loop;
+    QTimer checkTimer;
+    QObject::connect(&checkTimer, &QTimer::timeout, &loop, [ & ] {
+        if (condition())
+            loop.quit();
+    });
+    checkTimer.start(100);
+    QTimer::singleShot(timeout, &loop, &QEventLoop::quit);
+    loop.exec();
+    return condition();
+}
+
 class Tst_VPNController : public testing::Test
 {
 public:
@@ -58,3 +80,39 @@ TEST_F(Tst_VPNController, dslcontroll_test)
     QObject::connect(m_controller, &VPNController::itemAdded, itemChanged);
     QObject::connect(m_controller, &VPNController::itemRemoved, itemChanged);
 }
+
+TEST_F(Tst_VPNController, activeConnectionWatcher_test)
+{
+    // 测试会真正连接和断开VPN，只在设置了环境变量的测试机器上执行
+    if (qEnvironmentVariableIsEmpty("DDE_NETWORK_VPN_TEST"))
+        GTEST_SKIP() << "set DDE_NETWORK_VPN_TEST to activate a real vpn connection";
+
+    QList<VPNItem *> items = m_controller->items();
+    if (items.isEmpty())
+        GTEST_SKIP() << "no vpn connection";
+
+    // 只有NetworkManager的实现会监听活动连接
+    if (!m_controller->inherits("dde::network::VPNController_NM"))
+        GTEST_SKIP() << "not networkmanager vpn controller";
+
+    // disconnectItem会断开所有VPN，已经有活动的VPN时不测试
+    if (m_controller->activeConnectionWatcherCount() != 0)
+        GTEST_SKIP() << "vpn connection is active";
+
+    // 连接失败时活动连接会很快消失，在状态变化的时候记录监听数量
+    int maxWatcherCount = 0;
+    QMetaObject::Connection changedConnection = QObject::connect(m_controller, &VPNController::activeConnectionChanged, [ & ] {
+        maxWatcherCount = qMax(maxWatcherCount, m_controller->activeConnectionWatcherCount());
+    });
+    m_controller->connectItem(items.first());
+    EXPECT_TRUE(waitFor([ & ] { return maxWatcherCount > 0; }));
+    // 同一个活动连接只监听一次
+    EXPECT_EQ(maxWatcherCount, 1);
+    QObject::disconnect(changedConnection);
+
+    // 断开后活动连接的监听要释放
+    m_controller->disconnectItem();
+    EXPECT_TRUE(waitFor([ this ] {
+        return m_controller->activeConnectionWatcherCount() == 0;
+    }));
+}